@@ -1143,30 +1143,16 @@ OMR::CodeGenerator::pickRegister(TR_RegisterCandidate     *rc,
                                TR_GlobalRegisterNumber & highRegisterNumber,
                                TR_LinkHead<TR_RegisterCandidate> *candidatesAlreadyAssigned)
    {
-   static volatile bool isInitialized=false;
-   static volatile uint8_t gprsWithheldFromPickRegister=0, fprsWithheldFromPickRegister=0, vrfWithheldFromPickRegister=0, gprsWithheldFromPickRegisterWhenWarm=0;
+   // Function local statics are initialized once even when several
+   // compilation threads get here at the same time
+   static char *rwgpr = feGetEnv("TR_gprsWithheldFromPickRegister");
+   static char *rwgprWarm = feGetEnv("TR_gprsWithheldFromPickRegisterWhenWarm");
+   static char *rwfpr = feGetEnv("TR_fprsWithheldFromPickRegister");
+   static const uint8_t gprsWithheldFromPickRegister = rwgpr ? atoi(rwgpr) : 0;
+   static const uint8_t gprsWithheldFromPickRegisterWhenWarm = rwgprWarm ? atoi(rwgprWarm) : gprsWithheldFromPickRegister;
+   static const uint8_t fprsWithheldFromPickRegister = rwfpr ? atoi(rwfpr) : 0;
    int32_t currentCandidateWeight =-1;
    int32_t maxCandidateWeight =-1;
-   if (!isInitialized)
-      {
-      static char *rwgpr = feGetEnv("TR_gprsWithheldFromPickRegister");
-      static char *rwgprWarm = feGetEnv("TR_gprsWithheldFromPickRegisterWhenWarm");
-      static char *rwfpr = feGetEnv("TR_fprsWithheldFromPickRegister");
-      if (rwgpr)
-         {
-         gprsWithheldFromPickRegister = atoi(rwgpr);
-         gprsWithheldFromPickRegisterWhenWarm = gprsWithheldFromPickRegister;
-         }
-      if (rwgprWarm)
-         {
-         gprsWithheldFromPickRegisterWhenWarm = atoi(rwgprWarm);
-         }
-      if (rwfpr)
-         {
-         fprsWithheldFromPickRegister = atoi(rwfpr);
-         }
-      isInitialized = true;
-      }
 
    if (self()->comp()->getOption(TR_AssignEveryGlobalRegister))
       {
@@ -219,7 +219,10 @@ TR_LiveRegisters::registerIsDead(TR::Register *reg, bool updateInterferences)
 
    reg->resetIsLive();
 #ifndef TR_TARGET_POWER
-   if (!TR::isJ9())
+   // Linear scan register allocation builds its live intervals from the
+   // start and end of each range, so keep them.
+   //
+   if (!TR::isJ9() && !cg()->getUseLinearScanRegisterAllocation())
       {
       reg->setStartOfRangeNode(NULL);
       reg->setStartOfRange(NULL);
@@ -72,6 +72,7 @@
 #include "optimizer/StructuralAnalysis.hpp"
 #include "ras/Debug.hpp"
 #include "runtime/Runtime.hpp"
+#include "env/PhaseProfiler.hpp"
 #include "env/RegionProfiler.hpp"
 
 #include <map>
@@ -131,6 +132,7 @@ OMR::CodeGenPhase::performAll()
       PhaseValue phaseToDo = PhaseList[i];
       TR::RegionProfiler rp(_cg->comp()->trMemory()->heapMemoryRegion(), *_cg->comp(), "codegen/%s/%s",
          _cg->comp()->getHotnessName(_cg->comp()->getMethodHotness()), self()->getName(phaseToDo));
+      TR::PhaseProfiler pp(_cg->comp(), _cg->comp()->trMemory()->heapMemoryRegion(), "codegen", self()->getName(phaseToDo));
       _phaseToFunctionTable[phaseToDo](_cg, self());
       }
    }
@@ -170,6 +172,8 @@ OMR::CodeGenPhase::performProcessRelocationsPhase(TR::CodeGenerator * cg, TR::Co
    cg->registerAssumptions();
 
    cg->syncCode(cg->getBinaryBufferStart(), cg->getBinaryBufferCursor() - cg->getBinaryBufferStart());
+   if (cg->getColdCodeStart())
+      cg->syncCode(cg->getColdCodeStart(), cg->getColdCodeEnd() - cg->getColdCodeStart());
 
    if (comp->getOption(TR_EnableOSR))
      {
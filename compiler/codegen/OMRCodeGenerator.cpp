@@ -165,6 +165,8 @@ OMR::CodeGenerator::CodeGenerator() :
      _methodStackMap(NULL),
      _binaryBufferStart(NULL),
      _binaryBufferCursor(NULL),
+     _coldCodeStart(NULL),
+     _coldCodeEnd(NULL),
      _largestOutgoingArgSize(0),
      _estimatedCodeLength(0),
      _estimatedSnippetStart(0),
@@ -1091,6 +1093,12 @@ OMR::CodeGenerator::needRelocationsForHelpers()
    return self()->comp()->compileRelocatableCode();
    }
 
+bool
+OMR::CodeGenerator::needStaticRelocations()
+   {
+   return self()->comp()->getOption(TR_EmitRelocatableELFFile);
+   }
+
 bool
 OMR::CodeGenerator::isGlobalVRF(TR_GlobalRegisterNumber n)
    {
@@ -1661,7 +1669,7 @@ void
 OMR::CodeGenerator::reserveCodeCache()
    {
    int32_t numReserved = 0;
-   int32_t compThreadID = 0;
+   int32_t compThreadID = self()->comp()->getCompThreadID();
 
    _codeCache = TR::CodeCacheManager::instance()->reserveCodeCache(false, 0, compThreadID, &numReserved);
 
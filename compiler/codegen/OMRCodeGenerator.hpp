@@ -745,6 +745,16 @@ class OMR_EXTENSIBLE CodeGenerator
    uint8_t *getCodeEnd()                  {return _binaryBufferCursor;}
    uint32_t getCodeLength();
 
+   /** \brief
+    *     The cold part of the method body, when the code generator has placed
+    *     the cold tail of the method in the cold code cache region. NULL if the
+    *     method body is contiguous.
+    */
+   uint8_t *getColdCodeStart()           {return _coldCodeStart;}
+   uint8_t *setColdCodeStart(uint8_t *c) {return (_coldCodeStart = c);}
+   uint8_t *getColdCodeEnd()             {return _coldCodeEnd;}
+   uint8_t *setColdCodeEnd(uint8_t *c)   {return (_coldCodeEnd = c);}
+
    uint8_t *getBinaryBufferCursor() {return _binaryBufferCursor;}
    uint8_t *setBinaryBufferCursor(uint8_t *b) { return (_binaryBufferCursor = b); }
 
@@ -1165,6 +1175,11 @@ class OMR_EXTENSIBLE CodeGenerator
    // relocation type needs a relocation record.
    bool needRelocationsForHelpers();
 
+   // Whether references from the method body to itself and to other functions
+   // must be described by TR::StaticRelocation records, so that the code can be
+   // written out and bound to a different address later.
+   bool needStaticRelocations();
+
    // --------------------------------------------------------------------------
    // Snippets
    //
@@ -1213,6 +1228,15 @@ class OMR_EXTENSIBLE CodeGenerator
    void setInternalControlFlowNestingDepth(int32_t depth) { _internalControlFlowNestingDepth = depth; }
    void setInternalControlFlowSafeNestingDepth(int32_t safeDepth) { _internalControlFlowSafeNestingDepth = safeDepth; }
 
+   // --------------------------------------------------------------------------
+   // Linear scan register allocation
+   //
+   // Set by code generators that replace GRA with a linear scan allocator
+   // for this compilation. GRA does not run when it is set.
+
+   bool getUseLinearScanRegisterAllocation() { return _enabledFlags.testAny(UseLinearScanRegisterAllocation); }
+   void setUseLinearScanRegisterAllocation() { _enabledFlags.set(UseLinearScanRegisterAllocation); }
+
    // --------------------------------------------------------------------------
    // Non-linear register assigner
 
@@ -1866,7 +1890,7 @@ class OMR_EXTENSIBLE CodeGenerator
       LockFreeSpillList                = 0x0040,  // TAROK only (until it matures)
       UseNonLinearRegisterAssigner     = 0x0080,  // TAROK only (until it matures)
       TrackRegisterUsage               = 0x0100,  // TAROK only (until it matures)
-      // AVAILABLE                     = 0x0200,
+      UseLinearScanRegisterAllocation  = 0x0200,
       // AVAILABLE                     = 0x0400,
       // AVAILABLE                     = 0x0800,
       // AVAILABLE                     = 0x1000,
@@ -1883,6 +1907,8 @@ class OMR_EXTENSIBLE CodeGenerator
    TR::list<TR::Block*> _counterBlocks;
    uint8_t *_binaryBufferStart;
    uint8_t *_binaryBufferCursor;
+   uint8_t *_coldCodeStart;
+   uint8_t *_coldCodeEnd;
    TR::SparseBitVector _extendedToInt64GlobalRegisters;
 
    TR_BitVector *_liveButMaybeUnreferencedLocals;
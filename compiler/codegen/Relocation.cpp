@@ -58,6 +58,21 @@ TR::RelocationDebugInfo* TR::Relocation::getDebugInfo()
    {
    return this->_genData;
    }
+
+// An absolute address of a location in the method itself must be rebased if the
+// code is bound to a different address; describe it with a symbol-less static
+// relocation.
+static void addSelfStaticRelocation(TR::CodeGenerator *codeGen, uint8_t *location)
+   {
+   if (codeGen->needStaticRelocations())
+      {
+      codeGen->addStaticRelocation(TR::StaticRelocation(location,
+                                                        NULL,
+                                                        sizeof(intptr_t) == 8 ? TR::StaticRelocationSize::word64 : TR::StaticRelocationSize::word32,
+                                                        TR::StaticRelocationType::Absolute));
+      }
+   }
+
 void TR::LabelRelative8BitRelocation::apply(TR::CodeGenerator *codeGen)
    {
    AOTcgDiag2(codeGen->comp(), "TR::LabelRelative8BitRelocation::apply cursor=" POINTER_PRINTF_FORMAT " label=" POINTER_PRINTF_FORMAT "\n", getUpdateLocation(), getLabel());
@@ -96,6 +111,7 @@ void TR::LabelAbsoluteRelocation::apply(TR::CodeGenerator *codeGen)
    intptr_t *cursor = (intptr_t *)getUpdateLocation();
    AOTcgDiag2(codeGen->comp(), "TR::LabelAbsoluteRelocation::apply cursor=" POINTER_PRINTF_FORMAT " label=" POINTER_PRINTF_FORMAT "\n", cursor, getLabel());
    *cursor = (intptr_t)getLabel()->getCodeLocation();
+   addSelfStaticRelocation(codeGen, (uint8_t *)cursor);
    }
 
 TR::InstructionLabelRelative16BitRelocation::InstructionLabelRelative16BitRelocation(TR::Instruction* cursor, int32_t offset, TR::LabelSymbol* l, int32_t divisor)
@@ -166,6 +182,7 @@ void TR::InstructionAbsoluteRelocation::apply(TR::CodeGenerator *codeGen)
       address += getInstruction()->getBinaryLength();
    AOTcgDiag2(codeGen->comp(), "TR::InstructionAbsoluteRelocation::apply cursor=" POINTER_PRINTF_FORMAT " instruction=" POINTER_PRINTF_FORMAT "\n", cursor, address);
    *cursor = address;
+   addSelfStaticRelocation(codeGen, (uint8_t *)cursor);
    }
 
 
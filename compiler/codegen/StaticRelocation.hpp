@@ -54,7 +54,7 @@ public:
    /**
     * @brief StaticRelocation Initializes the object.
     * @param location The address requiring relocation.
-    * @param symbol The name of the symbol to be targetted by the relocation.
+    * @param symbol The name of the symbol to be targetted by the relocation, or NULL if the relocation targets the method containing the location.
     * @param size The size of the relocation.
     * @param relocationType The type of the relocation, namely whether that relocation is absolute or relative.
     */
@@ -79,7 +79,7 @@ public:
 
    /**
     * @brief symbol Returns the name of the symbol to be targetted by the relocation.
-    * @return The name of the symbol to be targetted by the relocation.
+    * @return The name of the symbol to be targetted by the relocation, or NULL if the relocation targets the method containing the location.
     */
    const char * symbol() const { return _symbol; }
 
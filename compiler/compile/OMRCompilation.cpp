@@ -54,6 +54,7 @@
 #include "env/ObjectModel.hpp"
 #include "env/KnownObjectTable.hpp"
 #include "env/PersistentInfo.hpp"
+#include "env/PhaseProfiler.hpp"
 #include "env/StackMemoryRegion.hpp"
 #include "env/TRMemory.hpp"
 #include "env/TypeLayout.hpp"
@@ -142,6 +143,7 @@ namespace TR { class RegisterMappedSymbol; }
 namespace OMR
 {
 tlsDefine(TR::Compilation *, compilation);
+tlsDefine(void *, compilationThreadID);
 }
 
 TR::SymbolReference *
@@ -1031,6 +1033,7 @@ int32_t OMR::Compilation::compile()
    {
    LexicalTimer t("compile", self()->signature(), self()->phaseTimer());
    TR::LexicalMemProfiler mp("compile", self()->signature(), self()->phaseMemProfiler());
+   TR::PhaseProfiler pp(self(), self()->trMemory()->heapMemoryRegion(), "compilation", "compile");
 
    if (_ilGenSuccess)
       {
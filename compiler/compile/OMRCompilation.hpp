@@ -1335,6 +1335,13 @@ private:
 //
 tlsDeclare(TR::Compilation *, compilation);
 
+// extern DWORD compilationThreadID
+//
+// One more than the compilation thread ID assigned to the current OS thread,
+// so that the zero initial value means no ID has been assigned yet.
+//
+tlsDeclare(void *, compilationThreadID);
+
 }
 namespace TR {
    /// Returns the thread local compilation object.
@@ -31,6 +31,8 @@
 #include "control/Options.hpp"
 #include "control/Options_inlines.hpp"
 #include "control/Recompilation.hpp"
+#include "env/PhaseProfiler.hpp"
+#include "env/SegmentCache.hpp"
 #include "env/TRMemory.hpp"
 #include "infra/Monitor.hpp"
 #include "infra/ThreadLocal.hpp"
@@ -67,12 +69,19 @@ bool TR::CompilationController::init(TR::CompilationInfo *compInfo)
       }
 
    tlsAlloc(OMR::compilation);
+   tlsAlloc(OMR::compilationThreadID);
+
+   TR::PhaseProfiler::initialize();
+   TR::SegmentCache::initialize();
 
    return _useController;
    }
 
 void TR::CompilationController::shutdown()
    {
+   TR::SegmentCache::shutdown();
+   TR::PhaseProfiler::shutdown();
+   tlsFree(OMR::compilationThreadID);
    tlsFree(OMR::compilation);
    if (!_useController)
       return;
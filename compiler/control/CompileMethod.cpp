@@ -56,40 +56,43 @@
 #include "ras/Debug.hpp"
 #include "env/SystemSegmentProvider.hpp"
 #include "env/DebugSegmentProvider.hpp"
+#include "env/SegmentCache.hpp"
 #include "omrformatconsts.h"
 #include "runtime/CodeCacheManager.hpp"
+#include "AtomicSupport.hpp"
 
 #if defined (_MSC_VER) && _MSC_VER < 1900
 #define snprintf _snprintf
 #endif
 
-static void
-writePerfToolEntry(void *start, uint32_t size, const char *name)
+static FILE *
+openPerfToolFile()
    {
-   // race condition
-   static bool firstAttempt = true;
-   static FILE *perfFile = 0;
-
-   if (firstAttempt)
-      {
-      firstAttempt = false;
+   FILE *perfFile = 0;
 #if defined(OMR_OS_WINDOWS)
-      int jvmPid = _getpid();
+   int jvmPid = _getpid();
 #else
-      pid_t jvmPid = getpid();
+   pid_t jvmPid = getpid();
 #endif
-      static const int maxPerfFilenameSize = 15 + sizeof(jvmPid)* 3; // "/tmp/perf-%ld.map"
-      char perfFilename[maxPerfFilenameSize] = { 0 };
+   static const int maxPerfFilenameSize = 15 + sizeof(jvmPid)* 3; // "/tmp/perf-%ld.map"
+   char perfFilename[maxPerfFilenameSize] = { 0 };
 
-      int numCharsWritten = snprintf(perfFilename, maxPerfFilenameSize, "/tmp/perf-%" OMR_PRId64 ".map", static_cast<int64_t>(jvmPid));
-      if (numCharsWritten > 0 && numCharsWritten < maxPerfFilenameSize)
-         {
-         perfFile = fopen(perfFilename, "a");
-         }
-      if (!perfFile) // couldn't open the file
-         {
-         }
+   int numCharsWritten = snprintf(perfFilename, maxPerfFilenameSize, "/tmp/perf-%" OMR_PRId64 ".map", static_cast<int64_t>(jvmPid));
+   if (numCharsWritten > 0 && numCharsWritten < maxPerfFilenameSize)
+      {
+      perfFile = fopen(perfFilename, "a");
       }
+   return perfFile;
+   }
+
+static void
+writePerfToolEntry(void *start, uint32_t size, const char *name)
+   {
+   // The file is opened exactly once even when several compilation threads
+   // reach here together; each entry is written by a single fprintf, which
+   // locks the stream, so entries from different threads do not interleave.
+   static FILE *perfFile = openPerfToolFile();
+
    if (perfFile)
       {
       // perf does not want 0x leading the hex start address and length of the compiled code region
@@ -130,6 +133,25 @@ generatePerfToolEntry(uint8_t *startPC, uint8_t *endPC, const char *sig, const c
    writePerfToolEntry(startPC, endPC - startPC, name);
    }
 
+// Each OS thread that compiles is given a stable compilation thread ID the
+// first time it compiles. The ID selects the code cache the thread reserves
+// and, when logging, the per-thread log file. The first thread to compile
+// gets ID 0 so that single threaded clients keep the unsuffixed log file.
+//
+static int32_t
+getCompilationThreadID()
+   {
+   static volatile uintptr_t nextCompilationThreadID = 0;
+
+   uintptr_t idPlusOne = reinterpret_cast<uintptr_t>(tlsGet(OMR::compilationThreadID, void *));
+   if (idPlusOne == 0)
+      {
+      idPlusOne = VM_AtomicSupport::add(&nextCompilationThreadID, 1);
+      tlsSet(OMR::compilationThreadID, reinterpret_cast<void *>(idPlusOne));
+      }
+   return static_cast<int32_t>(idPlusOne - 1);
+   }
+
 #if defined(TR_TARGET_POWER)
 #include "p/codegen/PPCTableOfConstants.hpp"
 #endif
@@ -277,8 +299,9 @@ compileMethodFromDetails(
    uint64_t translationStartTime = TR::Compiler->vm.getUSecClock();
    OMR::FrontEnd &fe = OMR::FrontEnd::singleton();
    auto jitConfig = fe.jitConfig();
+   int32_t compThreadID = getCompilationThreadID();
    TR::RawAllocator rawAllocator;
-   TR::SystemSegmentProvider defaultSegmentProvider(1 << 16, rawAllocator);
+   TR::SystemSegmentProvider defaultSegmentProvider(1 << 16, rawAllocator, TR::SegmentCache::forCompilationThread(compThreadID));
    TR::DebugSegmentProvider debugSegmentProvider(1 << 16, rawAllocator);
    TR::SegmentAllocator &scratchSegmentProvider =
       TR::Options::getCmdLineOptions()->getOption(TR_EnableScratchMemoryDebugging) ?
@@ -319,6 +342,12 @@ compileMethodFromDetails(
       return 0;
       }
 
+   // First tier compilations trade code quality for compile time, so their
+   // registers are allocated by linear scan rather than by GRA.
+   //
+   if (hotness <= cold)
+      plan->setUseLinearScanRegisterAllocation(true);
+
    int32_t optionSetIndex = filterInfo ? filterInfo->getOptionSet() : 0;
    int32_t lineNumber = filterInfo ? filterInfo->getLineNumber() : 0;
    TR::Options options(
@@ -328,7 +357,8 @@ compileMethodFromDetails(
          &compilee,
          0,
          plan,
-         false);
+         false,
+         compThreadID);
 
    // FIXME: once we can do recompilation , we need to pass in the old start PC  -----------------------^
 
@@ -336,7 +366,7 @@ compileMethodFromDetails(
    // FIXME: perhaps use stack memory instead
 
    TR_ASSERT(TR::comp() == NULL, "there seems to be a current TLS TR::Compilation object %p for this thread. At this point there should be no current TR::Compilation object", TR::comp());
-   TR::Compilation compiler(0, omrVMThread, &fe, &compilee, request, options, dispatchRegion, &trMemory, plan);
+   TR::Compilation compiler(compThreadID, omrVMThread, &fe, &compilee, request, options, dispatchRegion, &trMemory, plan);
    TR_ASSERT(TR::comp() == &compiler, "the TLS TR::Compilation object %p for this thread does not match the one %p just created.", TR::comp(), &compiler);
 
    try
@@ -425,6 +455,8 @@ compileMethodFromDetails(
             if (compiler.getOption(TR_PerfTool))
                {
                generatePerfToolEntry(startPC, codeGenerator.getCodeEnd(), compiler.signature(), compiler.getHotnessName(compiler.getMethodHotness()));
+               if (codeGenerator.getColdCodeStart())
+                  generatePerfToolEntry(codeGenerator.getColdCodeStart(), codeGenerator.getColdCodeEnd(), compiler.signature(), "cold");
                }
             }
 
@@ -371,8 +371,8 @@ enum TR_CompilationOptions
    TR_DisableBDLLVersioning               = 0x00001000 + 9,
    TR_IProfilerPerformTimestampCheck      = 0x00002000 + 9,
    TR_VerboseInlineProfiling              = 0x00004000 + 9,
-   // Available                           = 0x00008000 + 9,
-   // Available                           = 0x00010000 + 9,
+   TR_SplitWarmAndColdBlocks              = 0x00008000 + 9,
+   TR_EnableLinearScanRegisterAllocation  = 0x00010000 + 9,
    TR_DisableIntegerCompareSimplification = 0x00020000 + 9,
    TR_DisableAutoSIMD                      = 0x00040000 + 9,
    TR_DisableOOL                          = 0x00080000 + 9,
@@ -380,22 +380,22 @@ enum TR_CompilationOptions
    TR_Randomize                           = 0x00200000 + 9,
    TR_BreakOnWriteBarrier                 = 0x00400000 + 9,
    BreakOnWriteBarrierSnippet             = 0x00800000 + 9,
-   // Available                           = 0x01000000 + 9,
+   TR_EnableCFGDataFlowSolver             = 0x01000000 + 9,
    TR_CountWriteBarriersRT                = 0x02000000 + 9,
    TR_DisableNoServerDuringStartup        = 0x04000000 + 9,  // set TR_NoOptServer during startup and insert GCR trees
    TR_BreakOnNew                          = 0x08000000 + 9,
-   // Available                           = 0x10000000 + 9,
-   // Available                           = 0x20000000 + 9,
-   // Available                           = 0x40000000 + 9,
+   TR_DisableCFGDataFlowSolver            = 0x10000000 + 9,
+   TR_DisableSegmentCache                 = 0x20000000 + 9,
+   TR_DisableNodeArena                    = 0x40000000 + 9,
    // Available                           = 0x80000000 + 9,
 
    // Option word 10
    //
-   // Available                           = 0x00000020 + 10,
-   // Available                           = 0x00000040 + 10,
-   // Available                           = 0x00000080 + 10,
+   TR_DisableInstructionScheduling        = 0x00000020 + 10,
+   TR_EnablePreRAInstructionScheduling    = 0x00000040 + 10,
+   TR_DisablePeephole                     = 0x00000080 + 10,
    TR_FirstLevelProfiling                 = 0x00000100 + 10,
-   // Available                           = 0x00000200 + 10,
+   TR_DisableFirstTierProfiling           = 0x00000200 + 10,
    // Available                           = 0x00000400 + 10,
    // Available                           = 0x00000800 + 10,
    // Available                           = 0x00001000 + 10,
@@ -725,7 +725,7 @@ enum TR_CompilationOptions
    TR_ProfileMemoryRegions                            = 0x00800000 + 21,
    TR_DisableConverterReducer                         = 0x01000000 + 21,
    TR_CompileTimeProfiler                             = 0x02000000 + 21,
-   // Available                                       = 0x04000000 + 21,
+   TR_ProfileCompilationPhases                        = 0x04000000 + 21,
    // Available                                       = 0x08000000 + 21,
    // Available                                       = 0x10000000 + 21,
    TR_PerformLookaheadAtWarmCold                      = 0x20000000 + 21,
@@ -1919,6 +1919,7 @@ public:
 
    bool getOptLevelDowngraded() const { return _optLevelDowngraded; }
    static char *getCompilationStrategyName() { return _compilationStrategyName; }
+   static char *getPhaseProfileReportFileName() { return _phaseProfileReportFileName; }
 
 /**   \brief Returns a threshold on the profiling method invocations to trip recompilation
  */
@@ -2215,6 +2216,7 @@ protected:
           char *         _startOptions;
           char *         _envOptions;
    static char *         _compilationStrategyName;
+   static char *         _phaseProfileReportFileName;
 
 
    static TR::OptionFunctionPtr _processingMethod[];
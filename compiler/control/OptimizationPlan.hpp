@@ -166,6 +166,9 @@ class TR_OptimizationPlan
    bool isInducedByDLT() const { return _flags.testAny(InducedByDLT); }
    void setInducedByDLT(bool b) { _flags.set(InducedByDLT, b); }
 
+   bool getUseLinearScanRegisterAllocation() const { return _flags.testAny(UseLinearScanRegisterAllocation); }
+   void setUseLinearScanRegisterAllocation(bool b) { _flags.set(UseLinearScanRegisterAllocation, b); }
+
    // --------------------------------------------------------------------------
    // GPU
    //
@@ -221,6 +224,7 @@ class TR_OptimizationPlan
       RelaxedCompilationLimits= 0x00200000, // Compilation can use larger limits because method is very very hot
       DowngradedDueToSamplingJProfiling=0x00400000, // Compilation was downgraded to cold just because we wanted to do JProfiling
       InducedByDLT             =0x00800000, // Compilation that follows a DLT compilation
+      UseLinearScanRegisterAllocation=0x01000000, // Allocate registers by linear scan rather than GRA (fast first tier compilations)
    };
    private:
    TR_OptimizationPlan  *_next;       // to link events in the pool
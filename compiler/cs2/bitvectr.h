@@ -32,6 +32,7 @@
 #include "cs2/cs2.h"
 #include "cs2/bitmanip.h"
 #include "cs2/allocator.h"
+#include "infra/BitVectorOperations.hpp"
 
 #ifdef CS2_ALLOCINFO
 #define allocate(x) allocate(x, __FILE__, __LINE__)
@@ -848,14 +849,11 @@ ABitVector<Allocator> & ABitVector<Allocator>::operator= (const ABitVector<Alloc
 template <class Allocator>
 inline
 bool ABitVector<Allocator>::operator== (const ABitVector<Allocator> &v) const {
-  uint32_t bx = 0, wx = 0,
-         minLen = Minimum(fNumBits,v.fNumBits);
+  uint32_t minLen = Minimum(fNumBits,v.fNumBits);
+  uint32_t wx = SizeInWords(minLen),
+         bx = wx * kBitWordSize;
 
-  while (bx < minLen) {
-    if (fBitWords[wx] != v.fBitWords[wx]) return false;
-    ++wx;
-    bx += kBitWordSize;
-  }
+  if (!TR::BitVectorOperations::equalWords(fBitWords, v.fBitWords, wx)) return false;
 
   if (bx < fNumBits) {
     while (bx < fNumBits) {
@@ -1094,12 +1092,7 @@ inline bool ABitVector<Allocator>::Intersects (const ABitVector<Allocator> &vect
   vectorWordSize = SizeInWords(vector.fNumBits);
   smallerWordSize = Minimum (thisWordSize, vectorWordSize);
 
-  for (wordIndex = 0; wordIndex < smallerWordSize; ++wordIndex) {
-    if ((WordAt(wordIndex) & vector.WordAt(wordIndex)) != kZeroBits)
-      return true;
-  }
-
-  return false;
+  return TR::BitVectorOperations::intersectWords(fBitWords, vector.fBitWords, smallerWordSize);
 }
 
 template <class Allocator> template <class B2>
@@ -1516,7 +1509,6 @@ bool ABitVector<Allocator>::And (const ABitVector<Allocator> &inputVector,
                                  ABitVector<Allocator> &outputVector) const {
   uint32_t  wordIndex, thisWordSize, inputWordSize, smallerWordSize,
           largerWordSize, outputWordSize;
-  BitWord inputWord, thisWord, newWord;
   bool changed = false;
 
   thisWordSize = SizeInWords(fNumBits);
@@ -1527,13 +1519,8 @@ bool ABitVector<Allocator>::And (const ABitVector<Allocator> &inputVector,
   outputVector.GrowTo(largerWordSize*kBitWordSize, false);
   outputWordSize = SizeInWords(outputVector.fNumBits);
 
-  for (wordIndex = 0; wordIndex < smallerWordSize; ++wordIndex) {
-    thisWord = WordAt(wordIndex);
-    inputWord = inputVector.WordAt(wordIndex);
-    newWord = thisWord & inputWord;
-    outputVector.WordAt(wordIndex) = newWord;
-    changed |= (newWord != thisWord);
-  }
+  changed = TR::BitVectorOperations::andWords(outputVector.fBitWords, fBitWords, inputVector.fBitWords, smallerWordSize);
+  wordIndex = smallerWordSize;
 
   changed |= (wordIndex < largerWordSize);
   for ( ; wordIndex < outputWordSize; ++wordIndex)
@@ -1552,7 +1539,6 @@ bool ABitVector<Allocator>::Andc (const ABitVector<Allocator> &inputVector,
                                   ABitVector<Allocator> &outputVector) const {
   uint32_t  wordIndex, thisWordSize, inputWordSize, smallerWordSize,
           largerWordSize, outputWordSize;
-  BitWord inputWord, thisWord, newWord;
   bool changed = false;
 
   thisWordSize = SizeInWords(fNumBits);
@@ -1563,13 +1549,8 @@ bool ABitVector<Allocator>::Andc (const ABitVector<Allocator> &inputVector,
   outputVector.GrowTo(largerWordSize*kBitWordSize, false);
   outputWordSize = SizeInWords(outputVector.fNumBits);
 
-  for (wordIndex = 0; wordIndex < smallerWordSize; ++wordIndex) {
-    thisWord = WordAt(wordIndex);
-    inputWord = inputVector.WordAt(wordIndex);
-    newWord = thisWord & ~inputWord;    // COMPLEMENT OF INPUT!!!
-    outputVector.WordAt(wordIndex) = newWord;
-    changed |= (newWord != thisWord);
-  }
+  changed = TR::BitVectorOperations::andNotWords(outputVector.fBitWords, fBitWords, inputVector.fBitWords, smallerWordSize);
+  wordIndex = smallerWordSize;
 
   if (thisWordSize > inputWordSize) {
     changed |= (wordIndex < thisWordSize);
@@ -1598,7 +1579,6 @@ bool ABitVector<Allocator>::Or (const ABitVector<Allocator> &inputVector,
                                 ABitVector<Allocator> &outputVector) const {
   uint32_t  wordIndex, thisWordSize, inputWordSize, smallerWordSize,
           largerWordSize, outputWordSize;
-  BitWord inputWord, thisWord, newWord;
   bool changed = false;
 
   thisWordSize = SizeInWords(fNumBits);
@@ -1609,13 +1589,8 @@ bool ABitVector<Allocator>::Or (const ABitVector<Allocator> &inputVector,
   outputVector.GrowTo(largerWordSize*kBitWordSize, false);
   outputWordSize = SizeInWords(outputVector.fNumBits);
 
-  for (wordIndex = 0; wordIndex < smallerWordSize; ++wordIndex) {
-    thisWord = WordAt(wordIndex);
-    inputWord = inputVector.WordAt(wordIndex);
-    newWord = thisWord | inputWord;
-    outputVector.WordAt(wordIndex) = newWord;
-    changed |= (newWord != thisWord);
-  }
+  changed = TR::BitVectorOperations::orWords(outputVector.fBitWords, fBitWords, inputVector.fBitWords, smallerWordSize);
+  wordIndex = smallerWordSize;
 
   if (thisWordSize > inputWordSize) {
     changed |= (wordIndex < thisWordSize);
@@ -38,6 +38,25 @@
 #include "il/ILOps.hpp"
 #include "il/Node.hpp"
 #include "il/Node_inlines.hpp"
+#include "infra/Monitor.hpp"
+
+// Monitors are created on first use rather than at front end construction
+// because the front end singleton may be built before the persistent
+// allocator that backs TR::Monitor is available.
+//
+static TR::Monitor *
+logMonitor()
+   {
+   static TR::Monitor *monitor = TR::Monitor::create("JITLogMonitor");
+   return monitor;
+   }
+
+static TR::Monitor *
+vlogMonitor()
+   {
+   static TR::Monitor *monitor = TR::Monitor::create("JITVerboseLogMonitor");
+   return monitor;
+   }
 
 TR::FECommon::FECommon()
    : TR_FrontEnd()
@@ -50,6 +69,18 @@ TR::FECommon::createDebug( TR::Compilation *comp)
    return createDebugObject(comp);
    }
 
+void
+TR::FECommon::acquireLogMonitor()
+   {
+   logMonitor()->enter();
+   }
+
+void
+TR::FECommon::releaseLogMonitor()
+   {
+   logMonitor()->exit();
+   }
+
 extern "C" {
 
 // use libc for all this stuff
@@ -57,12 +88,12 @@ extern "C" {
 
 void TR_VerboseLog::vlogAcquire()
    {
-   //NOT IMPLEMENTED for now
+   vlogMonitor()->enter();
    }
 
 void TR_VerboseLog::vlogRelease()
    {
-   //NOT IMPLEMENTED for now
+   vlogMonitor()->exit();
    }
 
 void TR_VerboseLog::vwrite(const char *format, va_list args)
@@ -53,6 +53,10 @@ class FECommon : public ::TR_FrontEnd
 
    virtual TR_Debug *createDebug(TR::Compilation *comp = NULL);
 
+   // Serializes access to the per-compilation-thread log files
+   virtual void acquireLogMonitor();
+   virtual void releaseLogMonitor();
+
    virtual TR_OpaqueClassBlock * getClassFromSignature(const char * sig, int32_t length, TR_ResolvedMethod *method, bool isVettedForAOT=false) { return NULL; }
    virtual TR_OpaqueClassBlock * getClassFromSignature(const char * sig, int32_t length, TR_OpaqueMethodBlock *method, bool isVettedForAOT=false) { return NULL; }
    virtual const char *       sampleSignature(TR_OpaqueMethodBlock * aMethod, char *buf, int32_t bufLen, TR_Memory *memory) { return NULL; }
@@ -171,6 +171,17 @@ public:
 
    virtual TR_OpaqueMethodBlock *getInlinedCallSiteMethod(TR_InlinedCallSite *ics);
 
+   // Escape analysis
+   /**
+    * @brief Recognize a node that allocates a new object, for escape analysis.
+    * @param node the node, usually a call
+    * @param sizeInBytes set to the size of the object if the node allocates one
+    * @return true if node returns a new, zero-initialized object of sizeInBytes
+    *         bytes to which nothing else holds a reference, and has no other side
+    *         effect, so that it can be removed if the object does not escape
+    */
+   virtual bool isObjectAllocation(TR::Compilation *comp, TR::Node *node, int32_t &sizeInBytes) { return false; }
+
    // --------------------------------------------------------------------------
    // Class hierarchy
    // --------------------------------------------------------------------------
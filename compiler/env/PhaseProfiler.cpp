@@ -0,0 +1,257 @@
+/*******************************************************************************
+ * Copyright (c) 2020, 2020 IBM Corp. and others
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at https://www.eclipse.org/legal/epl-2.0/
+ * or the Apache License, Version 2.0 which accompanies this distribution and
+ * is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following
+ * Secondary Licenses when the conditions for such availability set
+ * forth in the Eclipse Public License, v. 2.0 are satisfied: GNU
+ * General Public License, version 2 with the GNU Classpath
+ * Exception [1] and GNU General Public License, version 2 with the
+ * OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] http://openjdk.java.net/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
+ *******************************************************************************/
+
+#include "env/PhaseProfiler.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <map>
+#include <stdio.h>
+#include <string.h>
+#if defined(OMR_OS_WINDOWS)
+#include <windows.h>
+#elif defined(LINUX) || defined(OSX) || defined(AIXPPC)
+#include <time.h>
+#endif
+#include "compile/Compilation.hpp"
+#include "control/Options.hpp"
+#include "control/Options_inlines.hpp"
+#include "env/CompilerEnv.hpp"
+#include "env/PersistentAllocator.hpp"
+#include "env/Region.hpp"
+#include "env/TypedAllocator.hpp"
+#include "infra/CriticalSection.hpp"
+#include "infra/Monitor.hpp"
+#include "infra/vector.hpp"
+
+namespace
+{
+
+// Phase names are string literals, so keys refer to them rather than copy them
+struct PhaseKey
+   {
+   const char *_category;
+   const char *_name;
+   const char *_hotness;
+   };
+
+struct PhaseKeyLess
+   {
+   bool operator()(const PhaseKey &lhs, const PhaseKey &rhs) const
+      {
+      int result = strcmp(lhs._category, rhs._category);
+      if (result == 0)
+         result = strcmp(lhs._name, rhs._name);
+      if (result == 0)
+         result = strcmp(lhs._hotness, rhs._hotness);
+      return result < 0;
+      }
+   };
+
+struct PhaseTotals
+   {
+   uint64_t _count;
+   uint64_t _wallTime;      // nanoseconds
+   uint64_t _maxWallTime;   // nanoseconds
+   uint64_t _cpuTime;       // nanoseconds
+   uint64_t _regionBytes;
+   };
+
+typedef std::pair<const PhaseKey, PhaseTotals> PhaseEntry;
+typedef std::map<PhaseKey, PhaseTotals, PhaseKeyLess, TR::typed_allocator<PhaseEntry, TR::PersistentAllocator &> > PhaseTotalsMap;
+typedef TR::vector<const PhaseEntry *, TR::PersistentAllocator &> PhaseEntryList;
+
+TR::Monitor *phaseProfilerMonitor = NULL;
+PhaseTotalsMap *phaseTotals = NULL;
+
+uint64_t
+wallTime()
+   {
+   return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+   }
+
+// CPU time used by the current thread, or 0 where it cannot be measured
+uint64_t
+threadCPUTime()
+   {
+#if defined(OMR_OS_WINDOWS)
+   FILETIME creationTime, exitTime, kernelTime, userTime;
+   if (!GetThreadTimes(GetCurrentThread(), &creationTime, &exitTime, &kernelTime, &userTime))
+      return 0;
+   uint64_t kernel = (static_cast<uint64_t>(kernelTime.dwHighDateTime) << 32) | kernelTime.dwLowDateTime;
+   uint64_t user = (static_cast<uint64_t>(userTime.dwHighDateTime) << 32) | userTime.dwLowDateTime;
+   return (kernel + user) * 100;
+#elif defined(LINUX) || defined(OSX) || defined(AIXPPC)
+   struct timespec now;
+   if (clock_gettime(CLOCK_THREAD_CPUTIME_ID, &now) != 0)
+      return 0;
+   return static_cast<uint64_t>(now.tv_sec) * 1000000000 + now.tv_nsec;
+#else
+   return 0;
+#endif
+   }
+
+bool
+byWallTime(const PhaseEntry *lhs, const PhaseEntry *rhs)
+   {
+   return lhs->second._wallTime > rhs->second._wallTime;
+   }
+
+void
+writeCSVReport(FILE *file, PhaseEntryList &entries)
+   {
+   fprintf(file, "category,phase,hotness,count,wallTimeNs,maxWallTimeNs,cpuTimeNs,regionBytes\n");
+   for (auto it = entries.begin(); it != entries.end(); ++it)
+      {
+      const PhaseKey &key = (*it)->first;
+      const PhaseTotals &totals = (*it)->second;
+      fprintf(file, "%s,%s,%s,%llu,%llu,%llu,%llu,%llu\n",
+         key._category, key._name, key._hotness,
+         (unsigned long long)totals._count,
+         (unsigned long long)totals._wallTime,
+         (unsigned long long)totals._maxWallTime,
+         (unsigned long long)totals._cpuTime,
+         (unsigned long long)totals._regionBytes);
+      }
+   }
+
+void
+writeJSONReport(FILE *file, PhaseEntryList &entries)
+   {
+   fprintf(file, "[\n");
+   for (auto it = entries.begin(); it != entries.end(); ++it)
+      {
+      const PhaseKey &key = (*it)->first;
+      const PhaseTotals &totals = (*it)->second;
+      fprintf(file, "  { \"category\": \"%s\", \"phase\": \"%s\", \"hotness\": \"%s\", \"count\": %llu, \"wallTimeNs\": %llu, \"maxWallTimeNs\": %llu, \"cpuTimeNs\": %llu, \"regionBytes\": %llu }%s\n",
+         key._category, key._name, key._hotness,
+         (unsigned long long)totals._count,
+         (unsigned long long)totals._wallTime,
+         (unsigned long long)totals._maxWallTime,
+         (unsigned long long)totals._cpuTime,
+         (unsigned long long)totals._regionBytes,
+         it + 1 != entries.end() ? "," : "");
+      }
+   fprintf(file, "]\n");
+   }
+
+}
+
+TR::PhaseProfiler::PhaseProfiler(TR::Compilation *comp, TR::Region &region, const char *category, const char *name) :
+   _comp(comp),
+   _region(region),
+   _category(category),
+   _name(name),
+   _hotness(NULL),
+   _active(phaseTotals != NULL && comp->getOption(TR_ProfileCompilationPhases)),
+   _initialWallTime(0),
+   _initialCPUTime(0),
+   _initialRegionSize(0)
+   {
+   if (_active)
+      {
+      _hotness = comp->getHotnessName(comp->getMethodHotness());
+      _initialRegionSize = _region.bytesAllocated();
+      _initialCPUTime = threadCPUTime();
+      _initialWallTime = wallTime();
+      }
+   }
+
+TR::PhaseProfiler::~PhaseProfiler()
+   {
+   if (!_active)
+      return;
+
+   uint64_t elapsedWallTime = wallTime() - _initialWallTime;
+   uint64_t elapsedCPUTime = threadCPUTime() - _initialCPUTime;
+   size_t regionSize = _region.bytesAllocated();
+   uint64_t regionBytes = regionSize > _initialRegionSize ? regionSize - _initialRegionSize : 0;
+
+   PhaseKey key = { _category, _name, _hotness };
+
+   OMR::CriticalSection profiling(phaseProfilerMonitor);
+   auto it = phaseTotals->find(key);
+   if (it == phaseTotals->end())
+      {
+      PhaseTotals totals = { 0, 0, 0, 0, 0 };
+      it = phaseTotals->insert(std::make_pair(key, totals)).first;
+      }
+
+   PhaseTotals &totals = it->second;
+   totals._count++;
+   totals._wallTime += elapsedWallTime;
+   totals._maxWallTime = std::max(totals._maxWallTime, elapsedWallTime);
+   totals._cpuTime += elapsedCPUTime;
+   totals._regionBytes += regionBytes;
+   }
+
+void
+TR::PhaseProfiler::initialize()
+   {
+   if (phaseTotals != NULL || !TR::Options::getCmdLineOptions()->getOption(TR_ProfileCompilationPhases))
+      return;
+
+   phaseProfilerMonitor = TR::Monitor::create("PhaseProfilerMonitor");
+   if (phaseProfilerMonitor == NULL)
+      return;
+
+   TR::PersistentAllocator &allocator = TR::Compiler->persistentAllocator();
+   phaseTotals = new (allocator.allocate(sizeof(PhaseTotalsMap))) PhaseTotalsMap(PhaseKeyLess(), PhaseTotalsMap::allocator_type(allocator));
+   }
+
+void
+TR::PhaseProfiler::shutdown()
+   {
+   if (phaseTotals == NULL)
+      return;
+
+   TR::PersistentAllocator &allocator = TR::Compiler->persistentAllocator();
+
+      {
+      PhaseEntryList::allocator_type entryAllocator(allocator);
+      PhaseEntryList entries(entryAllocator);
+      for (auto it = phaseTotals->begin(); it != phaseTotals->end(); ++it)
+         entries.push_back(&*it);
+      std::stable_sort(entries.begin(), entries.end(), byWallTime);
+
+      const char *fileName = TR::Options::getPhaseProfileReportFileName();
+      FILE *file = fileName != NULL ? fopen(fileName, "w") : stderr;
+      if (file != NULL)
+         {
+         size_t nameLength = fileName != NULL ? strlen(fileName) : 0;
+         if (nameLength >= 5 && strcmp(fileName + nameLength - 5, ".json") == 0)
+            writeJSONReport(file, entries);
+         else
+            writeCSVReport(file, entries);
+
+         if (file != stderr)
+            fclose(file);
+         }
+      }
+
+   phaseTotals->~PhaseTotalsMap();
+   allocator.deallocate(phaseTotals);
+   phaseTotals = NULL;
+
+   TR::Monitor::destroy(phaseProfilerMonitor);
+   phaseProfilerMonitor = NULL;
+   }
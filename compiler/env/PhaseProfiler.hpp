@@ -0,0 +1,89 @@
+/*******************************************************************************
+ * Copyright (c) 2020, 2020 IBM Corp. and others
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at https://www.eclipse.org/legal/epl-2.0/
+ * or the Apache License, Version 2.0 which accompanies this distribution and
+ * is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following
+ * Secondary Licenses when the conditions for such availability set
+ * forth in the Eclipse Public License, v. 2.0 are satisfied: GNU
+ * General Public License, version 2 with the GNU Classpath
+ * Exception [1] and GNU General Public License, version 2 with the
+ * OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] http://openjdk.java.net/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
+ *******************************************************************************/
+
+#ifndef OMR_PHASE_PROFILER_HPP
+#define OMR_PHASE_PROFILER_HPP
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace TR { class Compilation; }
+namespace TR { class Region; }
+
+namespace TR {
+
+/**
+ * @class
+ * @brief The PhaseProfiler class measures one run of a compilation phase,
+ * determined lexically by the lifetime of the profiler object, and adds the
+ * measurements to totals kept for the phase across every compilation in the
+ * process.
+ *
+ * The wall time, the CPU time of the compilation thread and the growth of a
+ * region are measured. Totals are kept by phase category (such as "opt" or
+ * "codegen"), phase name and method hotness, so that the phases that cost the
+ * most can be found and disabled for services sensitive to warm-up.
+ *
+ * Profiling is enabled by the profileCompilationPhases option. The totals are
+ * reported at shutdown, sorted by wall time, to the file named by the
+ * phaseProfileReport option: as JSON if its name ends in ".json" and as CSV
+ * otherwise. Without a file name the CSV report is written to stderr.
+ */
+class PhaseProfiler
+   {
+public:
+   PhaseProfiler(TR::Compilation *comp, TR::Region &region, const char *category, const char *name);
+   ~PhaseProfiler();
+
+   /**
+    * @brief Do not add this run to the totals, such as when the phase turns
+    * out to be skipped.
+    */
+   void discard() { _active = false; }
+
+   /**
+    * @brief Prepare to collect totals if profiling is enabled on the command line.
+    */
+   static void initialize();
+
+   /**
+    * @brief Report and discard the totals collected since initialize().
+    */
+   static void shutdown();
+
+private:
+   TR::Compilation *_comp;
+   TR::Region &_region;
+   const char *_category;
+   const char *_name;
+   const char *_hotness;
+   bool _active;
+   uint64_t _initialWallTime;
+   uint64_t _initialCPUTime;
+   size_t _initialRegionSize;
+   };
+
+}
+
+#endif
@@ -0,0 +1,340 @@
+/*******************************************************************************
+ * Copyright (c) 2020, 2020 IBM Corp. and others
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at https://www.eclipse.org/legal/epl-2.0/
+ * or the Apache License, Version 2.0 which accompanies this distribution and
+ * is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following
+ * Secondary Licenses when the conditions for such availability set
+ * forth in the Eclipse Public License, v. 2.0 are satisfied: GNU
+ * General Public License, version 2 with the GNU Classpath
+ * Exception [1] and GNU General Public License, version 2 with the
+ * OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] http://openjdk.java.net/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
+ *******************************************************************************/
+
+#include "env/SegmentCache.hpp"
+
+#if (defined(LINUX) && !defined(OMRZTPF)) || defined(__APPLE__) || defined(_AIX)
+#include <sys/mman.h>
+#if defined(__APPLE__) || !defined(MAP_ANONYMOUS)
+#define MAP_ANONYMOUS MAP_ANON
+#endif
+#elif defined(OMR_OS_WINDOWS)
+#define WIN32_LEAN_AND_MEAN
+#include <Windows.h>
+#endif /* defined(OMR_OS_WINDOWS) */
+
+#include <new>
+#include "control/Options.hpp"
+#include "control/Options_inlines.hpp"
+#include "env/CompilerEnv.hpp"
+#include "env/PersistentAllocator.hpp"
+#include "env/RawAllocator.hpp"
+#include "env/VerboseLog.hpp"
+#include "infra/Assert.hpp"
+#include "infra/CriticalSection.hpp"
+#include "infra/Monitor.hpp"
+
+namespace
+{
+
+// Compilation threads with higher IDs do not cache segments
+const int32_t MAX_CACHED_COMPILATION_THREADS = 64;
+
+TR::Monitor *segmentCacheMonitor = NULL;
+TR::SegmentCache *compilationThreadCaches[MAX_CACHED_COMPILATION_THREADS];
+
+void *
+mapSegment(size_t size)
+   {
+#if (defined(LINUX) && !defined(OMRZTPF)) || defined(__APPLE__) || defined(_AIX)
+   void *area = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_ANONYMOUS | MAP_PRIVATE, -1, 0);
+   if (area == MAP_FAILED) throw std::bad_alloc();
+#elif defined(OMR_OS_WINDOWS)
+   void *area = VirtualAlloc(NULL, size, MEM_COMMIT | MEM_RESERVE, PAGE_READWRITE);
+   if (!area) throw std::bad_alloc();
+#else
+   void *area = TR::RawAllocator().allocate(size);
+#endif /* (defined(LINUX) && !defined(OMRZTPF)) || defined(__APPLE__) || defined(_AIX) */
+   return area;
+   }
+
+void
+unmapSegment(void *area, size_t size) throw()
+   {
+#if (defined(LINUX) && !defined(OMRZTPF)) || defined(__APPLE__) || defined(_AIX)
+   munmap(area, size);
+#elif defined(OMR_OS_WINDOWS)
+   VirtualFree(area, 0, MEM_RELEASE);
+#else
+   TR::RawAllocator().deallocate(area, size);
+#endif /* (defined(LINUX) && !defined(OMRZTPF)) || defined(__APPLE__) || defined(_AIX) */
+   }
+
+// Let the system reclaim the pages of an idle segment without unmapping it.
+// The contents of the pages are undefined when the segment is reused.
+//
+void
+adviseIdleSegment(void *area, size_t size) throw()
+   {
+#if (defined(LINUX) && !defined(OMRZTPF)) || defined(__APPLE__) || defined(_AIX)
+#if defined(MADV_FREE)
+   // Kernels older than MADV_FREE reject it
+   if (madvise(area, size, MADV_FREE) == 0)
+      return;
+#endif /* defined(MADV_FREE) */
+#if defined(MADV_DONTNEED)
+   madvise(area, size, MADV_DONTNEED);
+#endif /* defined(MADV_DONTNEED) */
+#elif defined(OMR_OS_WINDOWS)
+   VirtualAlloc(area, size, MEM_RESET, PAGE_READWRITE);
+#endif /* (defined(LINUX) && !defined(OMRZTPF)) || defined(__APPLE__) || defined(_AIX) */
+   }
+
+double
+percentage(uint64_t part, uint64_t whole)
+   {
+   return whole != 0 ? 100.0 * part / whole : 0.0;
+   }
+
+}
+
+const size_t TR::SegmentCache::MIN_SEGMENT_SIZE;
+const size_t TR::SegmentCache::MAX_SEGMENT_SIZE;
+const int32_t TR::SegmentCache::NUM_SIZE_CLASSES;
+const int32_t TR::SegmentCache::MAX_IDLE_SEGMENTS;
+const size_t TR::SegmentCache::DEFAULT_RETAINED_BYTES;
+
+TR::SegmentCache::SegmentCache(size_t retainedBytesLimit) :
+   _retainedBytesLimit(retainedBytesLimit),
+   _bytesInUse(0),
+   _peakBytesInUse(0),
+   _recentPeakBytesInUse(0)
+   {
+   for (int32_t i = 0; i < NUM_SIZE_CLASSES; i++)
+      _numIdleSegments[i] = 0;
+   _statistics._requests = 0;
+   _statistics._hits = 0;
+   _statistics._systemAllocations = 0;
+   _statistics._systemReleases = 0;
+   _statistics._retainedBytes = 0;
+   _statistics._residentBytes = 0;
+   _statistics._maxRetainedBytes = 0;
+   }
+
+TR::SegmentCache::~SegmentCache() throw()
+   {
+   for (int32_t i = 0; i < NUM_SIZE_CLASSES; i++)
+      while (_numIdleSegments[i] > 0)
+         releaseIdleSegment(i);
+   }
+
+size_t
+TR::SegmentCache::segmentSize(size_t requiredSize)
+   {
+   if (requiredSize > MAX_SEGMENT_SIZE)
+      return ((requiredSize + (MIN_SEGMENT_SIZE - 1)) / MIN_SEGMENT_SIZE) * MIN_SEGMENT_SIZE;
+   size_t size = MIN_SEGMENT_SIZE;
+   while (size < requiredSize)
+      size <<= 1;
+   return size;
+   }
+
+int32_t
+TR::SegmentCache::sizeClass(size_t size)
+   {
+   size_t classSize = MIN_SEGMENT_SIZE;
+   for (int32_t i = 0; i < NUM_SIZE_CLASSES; i++, classSize <<= 1)
+      if (size == classSize)
+         return i;
+   return -1;
+   }
+
+void *
+TR::SegmentCache::allocate(size_t size)
+   {
+   void *area;
+   int32_t index = sizeClass(size);
+   if (index >= 0 && _numIdleSegments[index] > 0)
+      {
+      IdleSegment &segment = _idleSegments[index][--_numIdleSegments[index]];
+      area = segment._area;
+      _statistics._retainedBytes -= size;
+      if (segment._resident)
+         _statistics._residentBytes -= size;
+      _statistics._hits++;
+      }
+   else
+      {
+      area = mapSegment(size);
+      _statistics._systemAllocations++;
+      }
+
+   _statistics._requests++;
+   _bytesInUse += size;
+   if (_bytesInUse > _peakBytesInUse)
+      _peakBytesInUse = _bytesInUse;
+   return area;
+   }
+
+void
+TR::SegmentCache::deallocate(void *area, size_t size) throw()
+   {
+   TR_ASSERT(_bytesInUse >= size, "Segment was not allocated from this cache");
+   _bytesInUse -= size;
+
+   int32_t index = sizeClass(size);
+   if (index < 0
+       || _numIdleSegments[index] == MAX_IDLE_SEGMENTS
+       || _statistics._retainedBytes + size > _retainedBytesLimit)
+      {
+      unmapSegment(area, size);
+      _statistics._systemReleases++;
+      return;
+      }
+
+   IdleSegment &segment = _idleSegments[index][_numIdleSegments[index]++];
+   segment._area = area;
+   segment._resident = true;
+   _statistics._retainedBytes += size;
+   _statistics._residentBytes += size;
+   if (_statistics._retainedBytes > _statistics._maxRetainedBytes)
+      _statistics._maxRetainedBytes = _statistics._retainedBytes;
+   }
+
+void
+TR::SegmentCache::releaseIdleSegment(int32_t index) throw()
+   {
+   size_t size = MIN_SEGMENT_SIZE << index;
+   IdleSegment &segment = _idleSegments[index][--_numIdleSegments[index]];
+   unmapSegment(segment._area, size);
+   _statistics._retainedBytes -= size;
+   if (segment._resident)
+      _statistics._residentBytes -= size;
+   _statistics._systemReleases++;
+   }
+
+void
+TR::SegmentCache::compilationEnded() throw()
+   {
+   // A single large compilation should not pin its memory for good, so the
+   // high water mark decays by a quarter with every compilation that stays
+   // below it
+   //
+   size_t decayedPeak = _recentPeakBytesInUse - _recentPeakBytesInUse / 4;
+   _recentPeakBytesInUse = _peakBytesInUse > decayedPeak ? _peakBytesInUse : decayedPeak;
+   _peakBytesInUse = _bytesInUse;
+
+   size_t retainedBytesTarget = _recentPeakBytesInUse < _retainedBytesLimit ? _recentPeakBytesInUse : _retainedBytesLimit;
+   for (int32_t i = NUM_SIZE_CLASSES - 1; i >= 0 && _statistics._retainedBytes > retainedBytesTarget; i--)
+      while (_numIdleSegments[i] > 0 && _statistics._retainedBytes > retainedBytesTarget)
+         releaseIdleSegment(i);
+
+   for (int32_t i = 0; i < NUM_SIZE_CLASSES; i++)
+      {
+      size_t size = MIN_SEGMENT_SIZE << i;
+      for (int32_t j = 0; j < _numIdleSegments[i]; j++)
+         {
+         IdleSegment &segment = _idleSegments[i][j];
+         if (segment._resident)
+            {
+            adviseIdleSegment(segment._area, size);
+            segment._resident = false;
+            _statistics._residentBytes -= size;
+            }
+         }
+      }
+   }
+
+TR::SegmentCache *
+TR::SegmentCache::forCompilationThread(int32_t compilationThreadID)
+   {
+   if (segmentCacheMonitor == NULL
+       || compilationThreadID < 0
+       || compilationThreadID >= MAX_CACHED_COMPILATION_THREADS)
+      return NULL;
+
+   // Only the compilation thread itself creates or uses its cache
+   //
+   TR::SegmentCache *cache = compilationThreadCaches[compilationThreadID];
+   if (cache == NULL)
+      {
+      OMR::CriticalSection creatingCache(segmentCacheMonitor);
+      void *storage = TR::Compiler->persistentAllocator().allocate(sizeof(TR::SegmentCache), std::nothrow);
+      if (storage == NULL)
+         return NULL;
+      cache = new (storage) TR::SegmentCache(DEFAULT_RETAINED_BYTES);
+      compilationThreadCaches[compilationThreadID] = cache;
+      }
+   return cache;
+   }
+
+void
+TR::SegmentCache::initialize()
+   {
+   if (segmentCacheMonitor != NULL || TR::Options::getCmdLineOptions()->getOption(TR_DisableSegmentCache))
+      return;
+
+   for (int32_t i = 0; i < MAX_CACHED_COMPILATION_THREADS; i++)
+      compilationThreadCaches[i] = NULL;
+   segmentCacheMonitor = TR::Monitor::create("SegmentCacheMonitor");
+   }
+
+void
+TR::SegmentCache::shutdown()
+   {
+   if (segmentCacheMonitor == NULL)
+      return;
+
+   bool verbose = TR::Options::getCmdLineOptions()->getVerboseOption(TR_VerboseJitMemory);
+   Statistics totals = { 0, 0, 0, 0, 0, 0, 0 };
+   for (int32_t i = 0; i < MAX_CACHED_COMPILATION_THREADS; i++)
+      {
+      TR::SegmentCache *cache = compilationThreadCaches[i];
+      if (cache == NULL)
+         continue;
+
+      const Statistics &statistics = cache->statistics();
+      if (verbose)
+         TR_VerboseLog::writeLineLocked(TR_Vlog_MEMORY,
+            "Segment cache of compilation thread %d: %llu requests, %.1f%% hits, %llu KB retained, %llu KB resident, %llu KB max retained",
+            i,
+            (unsigned long long)statistics._requests,
+            percentage(statistics._hits, statistics._requests),
+            (unsigned long long)(statistics._retainedBytes >> 10),
+            (unsigned long long)(statistics._residentBytes >> 10),
+            (unsigned long long)(statistics._maxRetainedBytes >> 10));
+
+      totals._requests += statistics._requests;
+      totals._hits += statistics._hits;
+      totals._systemAllocations += statistics._systemAllocations;
+      totals._systemReleases += statistics._systemReleases;
+      totals._retainedBytes += statistics._retainedBytes;
+      totals._residentBytes += statistics._residentBytes;
+
+      cache->~SegmentCache();
+      TR::Compiler->persistentAllocator().deallocate(cache);
+      compilationThreadCaches[i] = NULL;
+      }
+
+   if (verbose)
+      TR_VerboseLog::writeLineLocked(TR_Vlog_MEMORY,
+         "Segment caches: %llu requests, %.1f%% hits, %llu segments mapped, %llu unmapped, %llu KB retained, %llu KB resident",
+         (unsigned long long)totals._requests,
+         percentage(totals._hits, totals._requests),
+         (unsigned long long)totals._systemAllocations,
+         (unsigned long long)totals._systemReleases,
+         (unsigned long long)(totals._retainedBytes >> 10),
+         (unsigned long long)(totals._residentBytes >> 10));
+
+   TR::Monitor::destroy(segmentCacheMonitor);
+   segmentCacheMonitor = NULL;
+   }
@@ -0,0 +1,155 @@
+/*******************************************************************************
+ * Copyright (c) 2020, 2020 IBM Corp. and others
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at https://www.eclipse.org/legal/epl-2.0/
+ * or the Apache License, Version 2.0 which accompanies this distribution and
+ * is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following
+ * Secondary Licenses when the conditions for such availability set
+ * forth in the Eclipse Public License, v. 2.0 are satisfied: GNU
+ * General Public License, version 2 with the GNU Classpath
+ * Exception [1] and GNU General Public License, version 2 with the
+ * OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] http://openjdk.java.net/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
+ *******************************************************************************/
+
+#ifndef OMR_SEGMENT_CACHE_HPP
+#define OMR_SEGMENT_CACHE_HPP
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace TR {
+
+/**
+ * @class
+ * @brief The SegmentCache class keeps the memory segments released at the end
+ * of a compilation so that the next compilation on the same thread can reuse
+ * them instead of mapping new memory, and unmapping it again when it ends.
+ *
+ * Segments are cached by size class: the classes are the powers of two from
+ * MIN_SEGMENT_SIZE to MAX_SEGMENT_SIZE, and larger segments are mapped and
+ * unmapped directly. Each class holds at most MAX_IDLE_SEGMENTS idle segments,
+ * and the cache as a whole holds at most the retention limit given when it
+ * is created.
+ *
+ * When a compilation ends, the idle segments above the largest amount of
+ * memory used by a recent compilation are unmapped, largest first, and the
+ * pages of the remaining idle segments are handed back to the operating system
+ * with MADV_FREE (or MEM_RESET on Windows). The segments stay mapped, so
+ * reusing one costs at most a page fault per page and no system call, and the
+ * memory is only reclaimed if the system needs it.
+ *
+ * A cache is not thread safe. Every compilation thread has its own cache,
+ * found with forCompilationThread(), which is created the first time the
+ * thread asks for it unless caching is disabled by the disableSegmentCache
+ * option. The statistics of the caches are written to the verbose log at
+ * shutdown when the jitMemory verbose option is set.
+ */
+class SegmentCache
+   {
+public:
+
+   static const size_t MIN_SEGMENT_SIZE = 1 << 16;
+   static const size_t MAX_SEGMENT_SIZE = 1 << 23;
+   static const int32_t NUM_SIZE_CLASSES = 8;
+   static const int32_t MAX_IDLE_SEGMENTS = 16;
+
+   /// The retention limit of the caches of compilation threads
+   static const size_t DEFAULT_RETAINED_BYTES = 64 << 20;
+
+   struct Statistics
+      {
+      uint64_t _requests;
+      uint64_t _hits;
+      uint64_t _systemAllocations;
+      uint64_t _systemReleases;
+      size_t _retainedBytes;       // idle segments held by the cache
+      size_t _residentBytes;       // idle segments whose pages have not been handed back
+      size_t _maxRetainedBytes;
+      };
+
+   explicit SegmentCache(size_t retainedBytesLimit);
+
+   /**
+    * @brief Unmap every idle segment.
+    */
+   ~SegmentCache() throw();
+
+   /**
+    * @return the size of the segment allocated for a request of at least
+    * requiredSize bytes
+    */
+   static size_t segmentSize(size_t requiredSize);
+
+   /**
+    * @brief Allocate a segment of a size returned by segmentSize(), reusing an
+    * idle segment of that size if there is one.
+    * @throws std::bad_alloc if the memory cannot be mapped
+    */
+   void *allocate(size_t size);
+
+   /**
+    * @brief Return a segment obtained from allocate() to the cache, or to the
+    * system if the cache of its size is full.
+    */
+   void deallocate(void *area, size_t size) throw();
+
+   /**
+    * @brief Trim the idle segments to the recent high water mark and hand the
+    * pages of the others back to the system.
+    */
+   void compilationEnded() throw();
+
+   const Statistics &statistics() const { return _statistics; }
+
+   /**
+    * @return the cache of a compilation thread, or NULL if segments are not
+    * cached
+    */
+   static SegmentCache *forCompilationThread(int32_t compilationThreadID);
+
+   /**
+    * @brief Prepare to create the caches of compilation threads, unless caching
+    * is disabled on the command line.
+    */
+   static void initialize();
+
+   /**
+    * @brief Report the statistics of the caches of compilation threads and
+    * destroy them.
+    */
+   static void shutdown();
+
+private:
+
+   struct IdleSegment
+      {
+      void *_area;
+      bool _resident;
+      };
+
+   static int32_t sizeClass(size_t size);
+   void releaseIdleSegment(int32_t sizeClass) throw();
+
+   size_t _retainedBytesLimit;
+   size_t _bytesInUse;
+   size_t _peakBytesInUse;        // during the current compilation
+   size_t _recentPeakBytesInUse;  // decays with every compilation
+   int32_t _numIdleSegments[NUM_SIZE_CLASSES];
+   IdleSegment _idleSegments[NUM_SIZE_CLASSES][MAX_IDLE_SEGMENTS];
+   Statistics _statistics;
+   };
+
+}
+
+#endif
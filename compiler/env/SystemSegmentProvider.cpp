@@ -21,10 +21,12 @@
 
 #include "env/SystemSegmentProvider.hpp"
 #include "env/MemorySegment.hpp"
+#include "env/SegmentCache.hpp"
 
-OMR::SystemSegmentProvider::SystemSegmentProvider(size_t segmentSize, TR::RawAllocator rawAllocator) :
+OMR::SystemSegmentProvider::SystemSegmentProvider(size_t segmentSize, TR::RawAllocator rawAllocator, TR::SegmentCache *segmentCache) :
    TR::SegmentAllocator(segmentSize),
    _rawAllocator(rawAllocator),
+   _segmentCache(segmentCache),
    _currentBytesAllocated(0),
    _highWaterMark(0),
    _segments(std::less< TR::MemorySegment >(), SegmentSetAllocator(rawAllocator))
@@ -33,13 +35,17 @@ OMR::SystemSegmentProvider::SystemSegmentProvider(size_t segmentSize, TR::RawAll
 
 OMR::SystemSegmentProvider::~SystemSegmentProvider() throw()
    {
+   if (_segmentCache)
+      _segmentCache->compilationEnded();
    }
 
 TR::MemorySegment &
 OMR::SystemSegmentProvider::request(size_t requiredSize)
    {
    size_t adjustedSize = ( ( requiredSize + (defaultSegmentSize() - 1) ) / defaultSegmentSize() ) * defaultSegmentSize();
-   void *newSegmentArea = _rawAllocator.allocate(adjustedSize);
+   if (_segmentCache)
+      adjustedSize = TR::SegmentCache::segmentSize(adjustedSize);
+   void *newSegmentArea = _segmentCache ? _segmentCache->allocate(adjustedSize) : _rawAllocator.allocate(adjustedSize);
    try
       {
       auto result = _segments.insert( TR::MemorySegment(newSegmentArea, adjustedSize) );
@@ -51,7 +57,10 @@ OMR::SystemSegmentProvider::request(size_t requiredSize)
       }
    catch (...)
       {
-      _rawAllocator.deallocate(newSegmentArea);
+      if (_segmentCache)
+         _segmentCache->deallocate(newSegmentArea, adjustedSize);
+      else
+         _rawAllocator.deallocate(newSegmentArea);
       throw;
       }
    }
@@ -60,7 +69,10 @@ void
 OMR::SystemSegmentProvider::release(TR::MemorySegment &segment) throw()
    {
    auto it = _segments.find(segment);
-   _rawAllocator.deallocate(segment.base());
+   if (_segmentCache)
+      _segmentCache->deallocate(segment.base(), segment.size());
+   else
+      _rawAllocator.deallocate(segment.base());
    _currentBytesAllocated -= segment.size();
    TR_ASSERT(it != _segments.end(), "Segment lookup should never fail");
    _segments.erase(it);
@@ -37,12 +37,20 @@ namespace TR { using OMR::SystemSegmentProvider; }
 #include "env/SegmentAllocator.hpp"
 #include "env/RawAllocator.hpp"
 
+namespace TR { class SegmentCache; }
+
 namespace OMR {
 
+/**
+ * @class
+ * @brief Provides segments allocated from the raw allocator or, when a
+ * TR::SegmentCache is given, from the cache, which reuses the segments of
+ * previous compilations on the same thread.
+ */
 class SystemSegmentProvider : public TR::SegmentAllocator
    {
 public:
-   SystemSegmentProvider(size_t segmentSize, TR::RawAllocator rawAllocator);
+   SystemSegmentProvider(size_t segmentSize, TR::RawAllocator rawAllocator, TR::SegmentCache *segmentCache = NULL);
    ~SystemSegmentProvider() throw();
    virtual TR::MemorySegment &request(size_t requiredSize);
    virtual void release(TR::MemorySegment &segment) throw();
@@ -54,6 +62,7 @@ public:
 
 private:
    TR::RawAllocator _rawAllocator;
+   TR::SegmentCache *_segmentCache;
    size_t _currentBytesAllocated;
    size_t _highWaterMark;
    typedef TR::typed_allocator<
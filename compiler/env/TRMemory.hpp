@@ -76,6 +76,7 @@
 #include "cs2/hashtab.h"
 #include "cs2/llistof.h"
 #include "env/jittypes.h"
+#include "AtomicSupport.hpp"
 
 #include "env/TypedAllocator.hpp"
 
@@ -481,7 +482,7 @@ public:
 
    void * allocatePersistentMemory(size_t const size, ObjectType const ot = UnknownType) throw()
       {
-      _totalPersistentAllocations[ot] += size;
+      VM_AtomicSupport::add(&_totalPersistentAllocations[ot], size);
       void * persistentMemory = _persistentAllocator.get().allocate(size, std::nothrow);
       return persistentMemory;
       }
@@ -506,7 +507,7 @@ public:
 
    TR::PersistentInfo _persistentInfo;
    TR::reference_wrapper<TR::PersistentAllocator> _persistentAllocator;
-   size_t _totalPersistentAllocations[TR_MemoryBase::NumObjectTypes];
+   volatile uintptr_t _totalPersistentAllocations[TR_MemoryBase::NumObjectTypes];
    };
 
 extern TR_PersistentMemory * trPersistentMemory;
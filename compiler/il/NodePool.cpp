@@ -22,7 +22,10 @@
 #include "il/NodePool.hpp"
 
 #include <stddef.h>
+#include <stdint.h>
 #include "compile/Compilation.hpp"
+#include "control/Options.hpp"
+#include "control/Options_inlines.hpp"
 #include "il/ILOps.hpp"
 #include "il/Node.hpp"
 #include "il/Node_inlines.hpp"
@@ -33,7 +36,10 @@
 TR::NodePool::NodePool(TR::Compilation * comp, const TR::Allocator &allocator) :
    _comp(comp),
    _disableGC(true),
+   _useArena(!comp->getOption(TR_DisableNodeArena)),
    _globalIndex(0),
+   _nextNode(NULL),
+   _chunkEnd(NULL),
    _nodeRegion(comp->trMemory()->heapMemoryRegion())
    {
    }
@@ -42,12 +48,34 @@ void
 TR::NodePool::cleanUp()
    {
    TR::Region::reset(_nodeRegion, _comp->trMemory()->heapMemoryRegion());
+   _nextNode = NULL;
+   _chunkEnd = NULL;
+   }
+
+void
+TR::NodePool::allocateChunk()
+   {
+   size_t chunkSize = NODES_PER_CHUNK * sizeof(TR::Node);
+   uintptr_t chunk = reinterpret_cast<uintptr_t>(_nodeRegion.allocate(chunkSize + CACHE_LINE_SIZE - 1));
+   chunk = (chunk + CACHE_LINE_SIZE - 1) & ~(uintptr_t)(CACHE_LINE_SIZE - 1);
+   _nextNode = reinterpret_cast<TR::Node *>(chunk);
+   _chunkEnd = _nextNode + NODES_PER_CHUNK;
    }
 
 TR::Node *
 TR::NodePool::allocate()
    {
-   TR::Node *newNode = static_cast<TR::Node*>(_nodeRegion.allocate(sizeof(TR::Node)));//_pool.ElementAt(poolIndex);
+   TR::Node *newNode;
+   if (_useArena)
+      {
+      if (_nextNode == _chunkEnd)
+         allocateChunk();
+      newNode = _nextNode++;
+      }
+   else
+      {
+      newNode = static_cast<TR::Node*>(_nodeRegion.allocate(sizeof(TR::Node)));
+      }
    memset(newNode, 0, sizeof(TR::Node));
    newNode->_globalIndex = ++_globalIndex;
    TR_ASSERT(_globalIndex < MAX_NODE_COUNT, "Reached TR::Node allocation limit");
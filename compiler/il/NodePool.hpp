@@ -32,10 +32,22 @@ template <class T> class TR_Array;
 
 namespace TR {
 
+/**
+ * Allocates the nodes of a compilation.
+ *
+ * Nodes are carved out of chunks of NODES_PER_CHUNK nodes that are aligned to
+ * CACHE_LINE_SIZE, so that nodes created one after the other, as the nodes of
+ * a tree usually are, are next to each other in memory and a node is never
+ * split across two cache lines when it fits in one.  The disableNodeArena
+ * option allocates every node on its own from the node region instead.
+ */
 class NodePool
    {
    public:
 
+   static const size_t CACHE_LINE_SIZE = 64;
+   static const int32_t NODES_PER_CHUNK = 64;
+
    TR_ALLOC(TR_Memory::Compilation)
    NodePool(TR::Compilation * comp, const TR::Allocator &allocator);
 
@@ -51,10 +63,17 @@ class NodePool
    void cleanUp();
 
    private:
+   void allocateChunk();
+
    TR::Compilation *     _comp;
    bool                  _disableGC;
+   bool                  _useArena;
    ncount_t              _globalIndex;
 
+   // Unused nodes of the current chunk
+   TR::Node *            _nextNode;
+   TR::Node *            _chunkEnd;
+
    TR::Region            _nodeRegion;
    };
 
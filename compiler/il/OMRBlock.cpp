@@ -2555,6 +2555,19 @@ OMR::Block::isSuperCold()
  * Flag functions end
  */
 
+bool
+OMR::Block::isRare(TR::Compilation *comp)
+   {
+   TR::CFG *cfg = comp->getFlowGraph();
+   if (!cfg)
+      return false;
+
+   // Only trust the frequencies if they distinguish hot from cold blocks at all
+   int32_t lowFrequency = cfg->getLowFrequency();
+   return cfg->getMaxFrequency() > (lowFrequency << 2) &&
+          self()->getFrequency() <= lowFrequency;
+   }
+
 TR::Block *
 TR_BlockCloner::cloneBlocks(TR::Block * from, TR::Block * lastBlock)
    {
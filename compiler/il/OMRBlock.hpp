@@ -392,6 +392,12 @@ class OMR_EXTENSIBLE Block : public TR::CFGNode
    void setIsSuperCold(bool v = true);
    bool isSuperCold();
 
+   /**
+    * @brief Whether the block frequencies of the method show this block to be
+    *        rarely executed, whether or not it has been marked cold
+    */
+   bool isRare(TR::Compilation *comp);
+
    void setDoNotProfile()                             { _flags.set(_doNotProfile); }
    bool doNotProfile()                                { return _flags.testAny(_doNotProfile); }
 
@@ -8004,7 +8004,7 @@
    /* .properties4          = */ 0,
    /* .dataType             = */ TR::NoType,
    /* .typeProperties       = */ ILTypeProp::Size_16 | ILTypeProp::Vector | ILTypeProp::HasNoDataType,
-   /* .childProperties      = */ TWO_SAME_CHILD(ILChildProp::UnspecifiedChildType),
+   /* .childProperties      = */ THREE_CHILD(ILChildProp::UnspecifiedChildType, TR::Int32, ILChildProp::UnspecifiedChildType),
    /* .swapChildrenOpCode   = */ TR::BadILOp,
    /* .reverseBranchOpCode  = */ TR::BadILOp,
    /* .booleanCompareOpCode = */ TR::BadILOp,
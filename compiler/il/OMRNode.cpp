@@ -5224,6 +5224,8 @@ OMR::Node::computeDataType()
             _unionPropertyA._dataType = self()->getFirstChild()->getDataType().getVectorElementType().getDataType();
          else if (_opCode.getOpCodeValue() == TR::vsplats)
             _unionPropertyA._dataType = self()->getFirstChild()->getDataType().scalarToVector().getDataType();
+         else if (_opCode.getOpCodeValue() == TR::vl2vd)
+            _unionPropertyA._dataType = TR::VectorDouble;
          else
             _unionPropertyA._dataType = self()->getFirstChild()->getDataType().getDataType();
 
@@ -5232,6 +5234,10 @@ OMR::Node::computeDataType()
 
       if (_opCode.getOpCodeValue() == TR::getvelem)
          return _unionPropertyA._dataType = self()->getFirstChild()->getDataType().vectorToScalar().getDataType();
+
+      // vselect <mask> <a> <b> has the type of the selected values
+      if (_opCode.getOpCodeValue() == TR::vselect)
+         return _unionPropertyA._dataType = self()->getSecondChild()->getDataType().getDataType();
       }
    TR_ASSERT(false, "Unsupported typeless opcode in node %p\n", self());
    return TR::NoType;
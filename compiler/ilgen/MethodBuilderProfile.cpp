@@ -0,0 +1,52 @@
+/*******************************************************************************
+ * Copyright (c) 2020, 2020 IBM Corp. and others
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at https://www.eclipse.org/legal/epl-2.0/
+ * or the Apache License, Version 2.0 which accompanies this distribution and
+ * is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following
+ * Secondary Licenses when the conditions for such availability set
+ * forth in the Eclipse Public License, v. 2.0 are satisfied: GNU
+ * General Public License, version 2 with the GNU Classpath
+ * Exception [1] and GNU General Public License, version 2 with the
+ * OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] http://openjdk.java.net/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
+ *******************************************************************************/
+
+#include "ilgen/MethodBuilderProfile.hpp"
+
+#include <string.h>
+
+TR::MethodBuilderProfile::MethodBuilderProfile(TR::PersistentAllocator &allocator) :
+   _allocator(allocator),
+   _counters(NULL),
+   _numBlocks(0),
+   _timesApplied(0)
+   {
+   }
+
+TR::MethodBuilderProfile::~MethodBuilderProfile()
+   {
+   if (_counters != NULL)
+      _allocator.deallocate(_counters);
+   }
+
+bool
+TR::MethodBuilderProfile::allocateCounters(int32_t numBlocks)
+   {
+   if (_counters != NULL)
+      return numBlocks == _numBlocks;
+
+   size_t size = 2 * (numBlocks > 0 ? numBlocks : 1) * sizeof(int64_t);
+   _counters = static_cast<int64_t *>(_allocator.allocate(size));
+   memset(_counters, 0, size);
+   _numBlocks = numBlocks;
+   return true;
+   }
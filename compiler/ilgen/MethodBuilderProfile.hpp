@@ -0,0 +1,80 @@
+/*******************************************************************************
+ * Copyright (c) 2020, 2020 IBM Corp. and others
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at https://www.eclipse.org/legal/epl-2.0/
+ * or the Apache License, Version 2.0 which accompanies this distribution and
+ * is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following
+ * Secondary Licenses when the conditions for such availability set
+ * forth in the Eclipse Public License, v. 2.0 are satisfied: GNU
+ * General Public License, version 2 with the GNU Classpath
+ * Exception [1] and GNU General Public License, version 2 with the
+ * OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] http://openjdk.java.net/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
+ *******************************************************************************/
+
+#ifndef TR_METHODBUILDERPROFILE_INCL
+#define TR_METHODBUILDERPROFILE_INCL
+
+#include <stdint.h>
+#include "env/PersistentAllocator.hpp"
+
+namespace TR
+{
+
+/**
+ * @brief Block and branch counts gathered by first tier code of a MethodBuilder.
+ *
+ * Blocks are numbered in the order the MethodBuilder creates them while it
+ * generates IL, which is the same for every compilation of the method.  The
+ * first tier code counts how many times each block runs and how many times the
+ * branch ending it is taken; a later compilation turns the counts into block
+ * and edge frequencies.
+ *
+ * The counters are incremented without synchronization, so counts from code
+ * running on several threads at once are approximate.
+ */
+class MethodBuilderProfile
+   {
+public:
+   MethodBuilderProfile(TR::PersistentAllocator &allocator);
+   ~MethodBuilderProfile();
+
+   /**
+    * @brief Allocate zeroed counters for the given number of blocks.
+    * @return false if counters were already allocated for a different number of blocks
+    */
+   bool allocateCounters(int32_t numBlocks);
+
+   int32_t getNumBlocks()                  { return _numBlocks; }
+   bool hasCounts()                        { return _counters != NULL; }
+
+   /// the address of the counter incremented whenever block i runs
+   int64_t *getBlockCounter(int32_t i)     { return &_counters[2 * i]; }
+   /// the address of the counter incremented whenever the branch ending block i is taken
+   int64_t *getTakenCounter(int32_t i)     { return &_counters[2 * i + 1]; }
+
+   int64_t getBlockCount(int32_t i)        { return *getBlockCounter(i); }
+   int64_t getTakenCount(int32_t i)        { return *getTakenCounter(i); }
+
+   /// note that a compilation used the counts to set frequencies
+   void recordUse()                        { _timesApplied++; }
+   int32_t getTimesApplied()               { return _timesApplied; }
+
+private:
+   TR::PersistentAllocator &_allocator;
+   int64_t *_counters;
+   int32_t _numBlocks;
+   int32_t _timesApplied;
+   };
+
+} // namespace TR
+
+#endif // !defined(TR_METHODBUILDERPROFILE_INCL)
@@ -28,6 +28,7 @@
 #include "codegen/CodeGenerator.hpp"
 #include "compile/Compilation.hpp"
 #include "compile/Method.hpp"
+#include "compile/ResolvedMethod.hpp"
 #include "compile/SymbolReferenceTable.hpp"
 #include "control/Recompilation.hpp"
 #include "env/CompilerEnv.hpp"
@@ -38,6 +39,7 @@
 #include "il/ILOps.hpp"
 #include "il/Node.hpp"
 #include "il/Node_inlines.hpp"
+#include "il/ResolvedMethodSymbol.hpp"
 #include "il/TreeTop.hpp"
 #include "il/TreeTop_inlines.hpp"
 #include "ilgen/IlGeneratorMethodDetails_inlines.hpp"
@@ -499,6 +501,8 @@ OMR::IlBuilder::emptyBlock()
    {
    TR::Block *empty = TR::Block::createEmptyBlock(NULL, _comp);
    cfg()->addNode(empty);
+   if (_methodBuilder != NULL)
+      _methodBuilder->addProfiledBlock(empty);
    return empty;
    }
 
@@ -2108,6 +2112,11 @@ OMR::IlBuilder::genCall(TR::SymbolReference *methodSymRef, int32_t numArgs, TR::
    TR::DataType returnType = methodSymRef->getSymbol()->castToMethodSymbol()->getMethod()->returnType();
    TR::Node *callNode = TR::Node::createWithSymRef(isDirectCall? TR::ILOpCode::getDirectCall(returnType): TR::ILOpCode::getIndirectCall(returnType), numArgs, methodSymRef);
 
+   // calls to allocators give escape analysis something to do
+   TR::ResolvedMethodSymbol *callee = methodSymRef->getSymbol()->getResolvedMethodSymbol();
+   if (isDirectCall && callee && static_cast<TR::ResolvedMethod *>(callee->getResolvedMethod())->getAllocationSizeParameter() >= 0)
+      methodSymbol()->setHasNews(true);
+
    // TODO: should really verify argument types here
    int32_t childIndex = 0;
    for (int32_t a=0;a < numArgs;a++)
@@ -2794,6 +2803,7 @@ OMR::IlBuilder::ForLoop(bool countsUp,
    loopBody->AppendBuilder(*loopCode);
    TR::IlBuilder *loopContinue = OrphanBuilder();
    loopBody->AppendBuilder(loopContinue);
+   _methodBuilder->emitRecompilationCounter(loopContinue);
 
    if (breakBuilder)
       {
@@ -2857,6 +2867,7 @@ OMR::IlBuilder::DoWhileLoop(const char *whileCondition, TR::IlBuilder **body, TR
       loopContinue = OrphanBuilder();
 
    AppendBuilder(loopContinue);
+   _methodBuilder->emitRecompilationCounter(loopContinue);
    loopContinue->IfCmpNotEqualZero(body,
    loopContinue->   Load(whileCondition));
 
@@ -2893,6 +2904,7 @@ OMR::IlBuilder::WhileDoLoop(const char *whileCondition, TR::IlBuilder **body, TR
       }
 
    AppendBuilder(loopContinue);
+   _methodBuilder->emitRecompilationCounter(loopContinue);
    loopContinue->IfCmpEqualZero(&done,
    loopContinue->   Load(whileCondition));
 
@@ -19,6 +19,7 @@
  * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
  *******************************************************************************/
 
+#include <algorithm>
 #include <iostream>
 #include <fstream>
 
@@ -47,6 +48,7 @@
 #include "ilgen/IlInjector.hpp"
 #include "ilgen/IlBuilder.hpp"
 #include "ilgen/MethodBuilder.hpp"
+#include "ilgen/MethodBuilderProfile.hpp"
 #include "ilgen/BytecodeBuilder.hpp"
 #include "ilgen/TypeDictionary.hpp"
 #include "ilgen/VirtualMachineState.hpp"
@@ -123,7 +125,18 @@ OMR::MethodBuilder::MethodBuilder(TR::TypeDictionary *types, TR::VirtualMachineS
    _inlineSiteIndex(-1),
    _nextInlineSiteIndex(0),
    _returnBuilder(NULL),
-   _returnSymbolName(NULL)
+   _returnSymbolName(NULL),
+   _persistedEntryPoint(NULL),
+   _recompilationCounter(NULL),
+   _counterExpiredFunction(NULL),
+   _counterExpiredArgument(NULL),
+   _entryPatchSite(NULL),
+   _profile(NULL),
+   _emittingRecompilationCounter(false),
+   _profiledBlocks(NULL),
+   _profiledBlockTails(NULL),
+   _numProfiledBlocks(0),
+   _maxProfiledBlocks(0)
    {
    _definingLine[0] = '\0';
    }
@@ -155,7 +168,18 @@ OMR::MethodBuilder::MethodBuilder(TR::MethodBuilder *callerMB, TR::VirtualMachin
    _inlineSiteIndex(callerMB->getNextInlineSiteIndex()),
    _nextInlineSiteIndex(0),
    _returnBuilder(NULL),
-   _returnSymbolName(NULL)
+   _returnSymbolName(NULL),
+   _persistedEntryPoint(NULL),
+   _recompilationCounter(NULL),
+   _counterExpiredFunction(NULL),
+   _counterExpiredArgument(NULL),
+   _entryPatchSite(NULL),
+   _profile(NULL),
+   _emittingRecompilationCounter(false),
+   _profiledBlocks(NULL),
+   _profiledBlockTails(NULL),
+   _numProfiledBlocks(0),
+   _maxProfiledBlocks(0)
    {
    _definingLine[0] = '\0';
    initialize(callerMB->_details, callerMB->_methodSymbol, callerMB->_fe, callerMB->_symRefTab);
@@ -210,6 +234,34 @@ OMR::MethodBuilder::callerMethodBuilder()
    return _returnBuilder->_methodBuilder;
    }
 
+bool
+OMR::MethodBuilder::injectIL()
+   {
+   if (!TR::IlBuilder::injectIL())
+      return false;
+
+   if (_persistedCodeLoader != NULL)
+      {
+      _persistedEntryPoint = _persistedCodeLoader(static_cast<TR::MethodBuilder *>(this));
+      if (_persistedEntryPoint != NULL)
+         {
+         TraceIL("MethodBuilder[ %p ]::using persisted code at %p instead of compiling\n", this, _persistedEntryPoint);
+         return false;
+         }
+      }
+
+   if (_profile != NULL)
+      {
+      // first tier code gathers the profile, later code uses it
+      if (_recompilationCounter != NULL)
+         instrumentBlocks();
+      else
+         applyProfile();
+      }
+
+   return true;
+   }
+
 void
 OMR::MethodBuilder::setupForBuildIL()
    {
@@ -229,6 +281,240 @@ OMR::MethodBuilder::setupForBuildIL()
 
    // set up initial CFG
    cfg()->addEdge(_entryBlock, _currentBlock);
+
+   // count this invocation
+   emitRecompilationCounter(static_cast<TR::IlBuilder *>(this));
+   }
+
+void
+OMR::MethodBuilder::setRecompilationCounter(int32_t *counter, const char *expiredFunction, void *expiredArgument)
+   {
+   _recompilationCounter = counter;
+   _counterExpiredFunction = expiredFunction;
+   _counterExpiredArgument = expiredArgument;
+   }
+
+void
+OMR::MethodBuilder::emitRecompilationCounter(TR::IlBuilder *builder)
+   {
+   TR::MethodBuilder *caller = callerMethodBuilder();
+   if (caller != NULL)
+      {
+      caller->emitRecompilationCounter(builder);
+      return;
+      }
+
+   if (_recompilationCounter == NULL)
+      return;
+
+   TraceIL("MethodBuilder[ %p ]::emitRecompilationCounter in builder %p\n", this, builder);
+
+   // the blocks created for the counter are not profiled: the code that follows it in the
+   // counted block now ends the block the counter leaves current, so that block is profiled
+   // in place of the counted one
+   TR::Block *counted = builder->_currentBlock;
+   _emittingRecompilationCounter = true;
+
+   TR::IlValue *counterAddress = builder->ConstAddress(_recompilationCounter);
+   TR::IlValue *count = builder->Sub(
+                        builder->   LoadAt(typeDictionary()->PointerTo(Int32),
+                                           counterAddress),
+                        builder->   ConstInt32(1));
+   builder->StoreAt(counterAddress, count);
+
+   // the counter is decremented without synchronization: a lost update only delays the call
+   TR::IlBuilder *expired = NULL;
+   builder->IfThen(&expired,
+   builder->   EqualTo(count,
+   builder->      ConstInt32(0)));
+   expired->Call(_counterExpiredFunction, 1,
+   expired->   ConstAddress(_counterExpiredArgument));
+
+   _emittingRecompilationCounter = false;
+   for (int32_t slot = 0; slot < _numProfiledBlocks; slot++)
+      {
+      if (counted != NULL && _profiledBlockTails[slot] == counted)
+         _profiledBlockTails[slot] = builder->_currentBlock;
+      }
+   }
+
+void
+OMR::MethodBuilder::addProfiledBlock(TR::Block *block)
+   {
+   TR::MethodBuilder *caller = callerMethodBuilder();
+   if (caller != NULL)
+      {
+      caller->addProfiledBlock(block);
+      return;
+      }
+
+   if (_profile == NULL || _emittingRecompilationCounter)
+      return;
+
+   if (_numProfiledBlocks == _maxProfiledBlocks)
+      {
+      int32_t newMax = _maxProfiledBlocks > 0 ? 2 * _maxProfiledBlocks : 64;
+      TR::Block **newBlocks = (TR::Block **) comp()->trMemory()->allocateHeapMemory(newMax * sizeof(TR::Block *));
+      TR::Block **newTails = (TR::Block **) comp()->trMemory()->allocateHeapMemory(newMax * sizeof(TR::Block *));
+      for (int32_t slot = 0; slot < _numProfiledBlocks; slot++)
+         {
+         newBlocks[slot] = _profiledBlocks[slot];
+         newTails[slot] = _profiledBlockTails[slot];
+         }
+      _profiledBlocks = newBlocks;
+      _profiledBlockTails = newTails;
+      _maxProfiledBlocks = newMax;
+      }
+
+   _profiledBlocks[_numProfiledBlocks] = block;
+   _profiledBlockTails[_numProfiledBlocks] = block;
+   _numProfiledBlocks++;
+   }
+
+TR::TreeTop *
+OMR::MethodBuilder::profiledBranch(int32_t slot)
+   {
+   TR::Block *tail = _profiledBlockTails[slot];
+   if (tail->nodeIsRemoved() || tail->getEntry() == NULL)
+      return NULL;
+
+   TR::TreeTop *last = tail->getLastRealTreeTop();
+   TR::Node *node = last->getNode();
+   if (!node->getOpCode().isIf() || node->getOpCode().convertIfCmpToCmp() == TR::BadILOp)
+      return NULL;
+   return last;
+   }
+
+// Adds increment to the 64-bit counter at the given address
+static TR::Node *
+incrementCounter(TR::SymbolReference *counterSymRef, int64_t *counter, TR::Node *increment)
+   {
+   TR::Node *address = TR::Node::aconst(increment, (uintptr_t)counter);
+   TR::Node *count = TR::Node::createWithSymRef(TR::lloadi, 1, 1, address, counterSymRef);
+   return TR::Node::createWithSymRef(TR::lstorei, 2, 2,
+                                     address,
+                                     TR::Node::create(TR::ladd, 2, count, increment),
+                                     counterSymRef);
+   }
+
+void
+OMR::MethodBuilder::instrumentBlocks()
+   {
+   if (!_profile->allocateCounters(_numProfiledBlocks))
+      {
+      TraceIL("MethodBuilder[ %p ]::profile has %d blocks but method has %d, not profiling\n", this, _profile->getNumBlocks(), _numProfiledBlocks);
+      return;
+      }
+
+   TraceIL("MethodBuilder[ %p ]::instrumentBlocks profiling %d blocks\n", this, _numProfiledBlocks);
+
+   TR::SymbolReference *counterSymRef = symRefTab()->findOrCreateArrayShadowSymbolRef(TR::Int64);
+   for (int32_t slot = 0; slot < _numProfiledBlocks; slot++)
+      {
+      TR::Block *block = _profiledBlocks[slot];
+      if (block->nodeIsRemoved() || block->getEntry() == NULL)
+         continue;
+
+      TR::TreeTop *entry = block->getEntry();
+      TR::Node *blockCount = incrementCounter(counterSymRef,
+                                              _profile->getBlockCounter(slot),
+                                              TR::Node::lconst(entry->getNode(), 1));
+      entry->insertAfter(TR::TreeTop::create(comp(), blockCount));
+
+      // the branch is taken as often as its condition, evaluated once for both, is true
+      TR::TreeTop *branch = profiledBranch(slot);
+      if (branch == NULL)
+         continue;
+
+      TR::Node *ifNode = branch->getNode();
+      TR::Node *condition = TR::Node::create(ifNode->getOpCode().convertIfCmpToCmp(), 2,
+                                             ifNode->getFirstChild(),
+                                             ifNode->getSecondChild());
+      TR::Node *takenCount = incrementCounter(counterSymRef,
+                                              _profile->getTakenCounter(slot),
+                                              TR::Node::create(TR::iu2l, 1, condition));
+      branch->insertBefore(TR::TreeTop::create(comp(), takenCount));
+      }
+   }
+
+void
+OMR::MethodBuilder::applyProfile()
+   {
+   if (!_profile->hasCounts() || _profile->getNumBlocks() != _numProfiledBlocks)
+      {
+      TraceIL("MethodBuilder[ %p ]::profile does not match the %d blocks of the method, not used\n", this, _numProfiledBlocks);
+      return;
+      }
+
+   int64_t maxCount = 0;
+   for (int32_t slot = 0; slot < _numProfiledBlocks; slot++)
+      {
+      if (_profile->getBlockCount(slot) > maxCount)
+         maxCount = _profile->getBlockCount(slot);
+      }
+   if (maxCount == 0)
+      return;
+
+   // blocks that ran get frequencies above those of cold blocks, scaled to the hottest block
+   const int32_t minFrequency = MAX_COLD_BLOCK_COUNT + 1;
+   const double scale = (double)(MAX_BLOCK_COUNT - minFrequency) / (double)maxCount;
+
+   for (int32_t slot = 0; slot < _numProfiledBlocks; slot++)
+      {
+      TR::Block *block = _profiledBlocks[slot];
+      if (block->nodeIsRemoved())
+         continue;
+
+      int64_t count = _profile->getBlockCount(slot);
+      if (count == 0)
+         {
+         block->setFrequency(0);
+         block->setIsCold();
+         }
+      else
+         {
+         block->setFrequency(minFrequency + (int32_t)(count * scale));
+         }
+      }
+
+   TR::CFG *cfg = comp()->getFlowGraph();
+   TR::Block *firstBlock = _profiledBlocks[0];
+   cfg->getStart()->setFrequency(firstBlock->getFrequency());
+   cfg->getEnd()->setFrequency(firstBlock->getFrequency());
+   for (auto e = cfg->getStart()->getSuccessors().begin(); e != cfg->getStart()->getSuccessors().end(); ++e)
+      (*e)->setFrequency(firstBlock->getFrequency());
+
+   for (int32_t slot = 0; slot < _numProfiledBlocks; slot++)
+      {
+      TR::Block *block = _profiledBlocks[slot];
+      if (block->nodeIsRemoved())
+         continue;
+
+      int32_t frequency = block->getFrequency();
+      TR::TreeTop *branch = profiledBranch(slot);
+      if (branch != NULL && frequency > 0 && block->getSuccessors().size() == 2)
+         {
+         int64_t count = _profile->getBlockCount(slot);
+         int64_t taken = std::min(_profile->getTakenCount(slot), count);
+         cfg->setEdgeFrequenciesOnNode(block,
+                                       (int32_t)(taken * scale),
+                                       (int32_t)((count - taken) * scale),
+                                       comp());
+         continue;
+         }
+
+      // other edges are as frequent as the less frequent of the blocks they join
+      for (auto e = block->getSuccessors().begin(); e != block->getSuccessors().end(); ++e)
+         {
+         int32_t toFrequency = (*e)->getTo()->getFrequency();
+         (*e)->setFrequency(toFrequency >= 0 ? std::min(frequency, toFrequency) : frequency);
+         }
+      }
+
+   cfg->setMaxFrequency(MAX_BLOCK_COUNT);
+   _profile->recordUse();
+
+   TraceIL("MethodBuilder[ %p ]::applyProfile set frequencies of %d blocks, hottest ran %lld times\n", this, _numProfiledBlocks, (long long)maxCount);
    }
 
 uint32_t
@@ -584,6 +870,19 @@ OMR::MethodBuilder::DefineFunction(const char* const name,
    _functions.insert(std::make_pair(name, method));
    }
 
+void
+OMR::MethodBuilder::DefineAllocator(const char *name, int32_t sizeParameter)
+   {
+   TR::ResolvedMethod *method = lookupFunction(name);
+   if (method == NULL && RequestFunction(name))
+      method = lookupFunction(name);
+   TR_ASSERT_FATAL(method, "Allocator '%s' must be defined with DefineFunction", name);
+   TR_ASSERT_FATAL(sizeParameter >= 0 && sizeParameter < method->getNumArgs(), "Allocator '%s' has no parameter %d", name, sizeParameter);
+   TR_ASSERT_FATAL(method->returnType() == TR::Address, "Allocator '%s' must return an address", name);
+
+   method->setAllocationSizeParameter(sizeParameter);
+   }
+
 const char *
 OMR::MethodBuilder::getSymbolName(int32_t slot)
    {
@@ -703,12 +1002,56 @@ OMR::MethodBuilder::Compile(void **entry)
    TR::ResolvedMethod resolvedMethod(static_cast<TR::MethodBuilder *>(this));
    TR::IlGeneratorMethodDetails details(&resolvedMethod);
 
+   resetForCompilation();
+
+   // code that counts towards its recompilation is only a first tier
+   TR_Hotness hotness = _recompilationCounter != NULL ? cold : warm;
+
    int32_t rc=0;
-   *entry = (void *) compileMethodFromDetails(NULL, details, warm, rc);
+   *entry = (void *) compileMethodFromDetails(NULL, details, hotness, rc);
+   if (_persistedEntryPoint != NULL)
+      {
+      // the compilation was abandoned in favour of persisted code
+      *entry = _persistedEntryPoint;
+      rc = COMPILATION_SUCCEEDED;
+      }
    typeDictionary()->NotifyCompilationDone();
    return rc;
    }
 
+void
+OMR::MethodBuilder::resetForCompilation()
+   {
+   // symbol references, blocks and worklists belong to the compilation that created them
+   _symbols.clear();
+   _countBlocksWorklist = NULL;
+   _connectTreesWorklist = NULL;
+   _allBytecodeBuilders = NULL;
+   _bytecodeWorklist = NULL;
+   _bytecodeHasBeenInWorklist = NULL;
+   _nextValueID = 0;
+   _nextInlineSiteIndex = 0;
+
+   _currentBlock = NULL;
+   _currentBlockNumber = -1;
+   _numBlocks = 0;
+   _blocks = NULL;
+   _blocksAllocatedUpFront = false;
+
+   _count = -1;
+   _connectedTrees = false;
+   _comesBack = true;
+
+   _persistedEntryPoint = NULL;
+   _entryPatchSite = NULL;
+
+   _emittingRecompilationCounter = false;
+   _profiledBlocks = NULL;
+   _profiledBlockTails = NULL;
+   _numProfiledBlocks = 0;
+   _maxProfiledBlocks = 0;
+   }
+
 void *
 OMR::MethodBuilder::client()
    {
@@ -719,3 +1062,4 @@ OMR::MethodBuilder::client()
 
 ClientAllocator OMR::MethodBuilder::_clientAllocator = NULL;
 ClientAllocator OMR::MethodBuilder::_getImpl = NULL;
+OMR::MethodBuilder::PersistedCodeLoader OMR::MethodBuilder::_persistedCodeLoader = NULL;
@@ -33,7 +33,9 @@
 #define MAX_LINE_NUM_LEN 7
 
 class TR_BitVector;
+namespace TR { class Block; }
 namespace TR { class BytecodeBuilder; }
+namespace TR { class MethodBuilderProfile; }
 namespace TR { class ResolvedMethod; }
 namespace TR { class SymbolReference; }
 namespace TR { class VirtualMachineState; }
@@ -54,10 +56,18 @@ class MethodBuilder : public TR::IlBuilder
    public:
    TR_ALLOC(TR_Memory::IlGenerator)
 
+   /**
+    * @brief callback that can supply previously persisted code for a MethodBuilder
+    * Called once the IL of the method has been generated, while it is being compiled.
+    * @returns the entry point of the persisted code, or NULL if the method has to be compiled
+    */
+   typedef void * (*PersistedCodeLoader)(TR::MethodBuilder *methodBuilder);
+
    MethodBuilder(TR::TypeDictionary *types, TR::VirtualMachineState *vmState = NULL);
    MethodBuilder(TR::MethodBuilder *callerMB, TR::VirtualMachineState *vmState = NULL);
    virtual ~MethodBuilder();
 
+   virtual bool injectIL();
    virtual void setupForBuildIL();
 
    /**
@@ -136,8 +146,64 @@ class MethodBuilder : public TR::IlBuilder
                        int32_t          numParms,
                        TR::IlType     ** parmTypes);
 
+   /**
+    * @brief declare that a defined function allocates objects
+    * @param name the name of the function, which must return a new, zero-initialized object whose
+    *        size in bytes is given by one of its arguments, keep no reference to it and have no other
+    *        side effect
+    * @param sizeParameter the index of the parameter giving the size of the object
+    * Objects allocated by calls to the function with a constant size that do not escape the
+    * compiled method are allocated on the stack or have their fields replaced by locals.
+    */
+   void DefineAllocator(const char *name, int32_t sizeParameter);
+
+   /**
+    * @brief compile this method, generating its IL afresh
+    * A MethodBuilder can be compiled more than once; only what was defined before the first
+    * compilation (parameters, locals, memory, functions) carries over to the next one.
+    */
    int32_t Compile(void **entry);
 
+   /**
+    * @brief count invocations and loop iterations in the code subsequently compiled for this method
+    * @param counter the counter the compiled code decrements, or NULL to stop counting
+    * @param expiredFunction a defined function taking one Address parameter, called whenever the counter reaches zero
+    * @param expiredArgument the argument passed to expiredFunction
+    * Code compiled with a counter is a cheap first tier: it is compiled at a lower optimization
+    * level and its entry can be patched to jump to a recompiled version of the method.
+    */
+   void setRecompilationCounter(int32_t *counter, const char *expiredFunction, void *expiredArgument);
+   bool hasRecompilationCounter()                            { return _recompilationCounter != NULL; }
+
+   /**
+    * @brief append code that decrements the recompilation counter, if any, to the given builder
+    * Inlined methods count against the method they are inlined into.
+    */
+   void emitRecompilationCounter(TR::IlBuilder *builder);
+
+   /**
+    * @brief profile the blocks and branches of the code subsequently compiled for this method
+    * @param profile the profile to count into or to use, or NULL to stop profiling
+    * Code compiled with a recompilation counter counts how often each of its blocks runs and how
+    * often each of its branches is taken into the profile; code compiled without one sets its
+    * block and edge frequencies from the counts, so that blocks that never ran are treated as cold.
+    */
+   void setProfile(TR::MethodBuilderProfile *profile)      { _profile = profile; }
+   TR::MethodBuilderProfile *getProfile()                  { return _profile; }
+
+   /**
+    * @brief number a block created while generating the IL of this method for profiling
+    * Blocks of inlined methods are numbered in the method they are inlined into.
+    */
+   void addProfiledBlock(TR::Block *block);
+
+   /**
+    * @brief the location in the most recently compiled code that can be patched to jump to
+    *        another entry point, or NULL if that code has none
+    */
+   void *getEntryPatchSite()                                 { return _entryPatchSite; }
+   void setEntryPatchSite(void *patchSite)                   { _entryPatchSite = patchSite; }
+
    /**
     * @brief will be called if a Call is issued to a function that has not yet been defined, provides a
     *        mechanism for MethodBuilder subclasses to provide method lookup on demand rather than all up
@@ -266,6 +332,14 @@ class MethodBuilder : public TR::IlBuilder
       _clientAllocator = allocator;
       }
 
+   /**
+    * @brief Set the function consulted for persisted code before a MethodBuilder is compiled, or NULL for none
+    */
+   static void setPersistedCodeLoader(PersistedCodeLoader loader)
+      {
+      _persistedCodeLoader = loader;
+      }
+
    /**
     * @brief Set the Get Impl function
     *
@@ -288,6 +362,26 @@ class MethodBuilder : public TR::IlBuilder
     */
    const char * adjustNameForInlinedSite(const char *name);
 
+   /*
+    * @brief forget the state left behind by a previous compilation of this method
+    */
+   void resetForCompilation();
+
+   /*
+    * @brief count block executions and taken branches into the profile
+    */
+   void instrumentBlocks();
+
+   /*
+    * @brief set block and edge frequencies from the counts in the profile
+    */
+   void applyProfile();
+
+   /*
+    * @brief the last tree of the code generated for a profiled block, if it is a conditional branch
+    */
+   TR::TreeTop *profiledBranch(int32_t slot);
+
    private:
    // We have MemoryManager as the first member of TypeDictionary, so that
    // it is the last one to get destroyed and all objects allocated using
@@ -371,9 +465,27 @@ class MethodBuilder : public TR::IlBuilder
    TR::IlBuilder             * _returnBuilder;
    const char                * _returnSymbolName;
 
+   // entry point of persisted code used instead of compiling this method
+   void                      * _persistedEntryPoint;
+
+   int32_t                   * _recompilationCounter;
+   const char                * _counterExpiredFunction;
+   void                      * _counterExpiredArgument;
+   void                      * _entryPatchSite;
+
+   TR::MethodBuilderProfile  * _profile;
+   bool                        _emittingRecompilationCounter;
+
+   // profiled blocks by number, and the blocks that hold the code ending each of them
+   TR::Block                ** _profiledBlocks;
+   TR::Block                ** _profiledBlockTails;
+   int32_t                     _numProfiledBlocks;
+   int32_t                     _maxProfiledBlocks;
+
 private:
    static ClientAllocator      _clientAllocator;
    static ImplGetter _getImpl;
+   static PersistedCodeLoader  _persistedCodeLoader;
    };
 
 } // namespace OMR
@@ -123,6 +123,79 @@ bool TR_BitVector::hasMoreThanOneElement()
    return (count > 1);
    }
 
+bool TR_BitVector::transfer(TR_BitVector& in, TR_BitVector *gen, TR_BitVector *kill)
+   {
+   if (gen && gen->_lastChunkWithNonZero < 0)
+      gen = NULL;
+   if (kill && kill->_lastChunkWithNonZero < 0)
+      kill = NULL;
+
+   // Grow this vector if the result may not fit
+   int32_t resultChunks = in._numChunks;
+   if (gen && gen->_numChunks > resultChunks)
+      resultChunks = gen->_numChunks;
+   if (_numChunks < resultChunks)
+      setChunkSize(resultChunks);
+
+   // The chunks that may be non-zero before or after the transfer
+   int32_t low = _numChunks;
+   int32_t high = -1;
+   if (_lastChunkWithNonZero >= 0)
+      {
+      low = _firstChunkWithNonZero;
+      high = _lastChunkWithNonZero;
+      }
+   if (in._lastChunkWithNonZero >= 0)
+      {
+      if (in._firstChunkWithNonZero < low)
+         low = in._firstChunkWithNonZero;
+      if (in._lastChunkWithNonZero > high)
+         high = in._lastChunkWithNonZero;
+      }
+   if (gen)
+      {
+      if (gen->_firstChunkWithNonZero < low)
+         low = gen->_firstChunkWithNonZero;
+      if (gen->_lastChunkWithNonZero > high)
+         high = gen->_lastChunkWithNonZero;
+      }
+   if (high < low)
+      return false; // all empty
+
+   bool changed;
+   if (in._numChunks > high &&
+       (!gen || gen->_numChunks > high) &&
+       (!kill || kill->_numChunks > high))
+      {
+      changed = TR::BitVectorOperations::transferWords(_chunks + low, in._chunks + low,
+                                                       gen ? gen->_chunks + low : NULL,
+                                                       kill ? kill->_chunks + low : NULL,
+                                                       high - low + 1);
+      }
+   else
+      {
+      // Vectors of different sizes: chunks past the end of a vector are zero
+      chunk_t difference = 0;
+      for (int32_t i = low; i <= high; i++)
+         {
+         chunk_t chunk = i < in._numChunks ? in._chunks[i] : 0;
+         if (kill && i < kill->_numChunks)
+            chunk &= ~kill->_chunks[i];
+         if (gen && i < gen->_numChunks)
+            chunk |= gen->_chunks[i];
+         difference |= chunk ^ _chunks[i];
+         _chunks[i] = chunk;
+         }
+      changed = difference != 0;
+      }
+
+   resetLowAndHighChunks(low, high);
+#if BV_SANITY_CHECK
+   sanityCheck("transfer");
+#endif
+   return changed;
+   }
+
 void TR_BitVector::setChunkSize(int32_t chunkSize)
    {
    if (chunkSize == _numChunks)
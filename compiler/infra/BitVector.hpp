@@ -28,6 +28,7 @@
 #include "env/TRMemory.hpp"
 #include "env/defines.h"
 #include "infra/Assert.hpp"
+#include "infra/BitVectorOperations.hpp"
 
 class TR_BitVector;
 class TR_BitVectorCursor;
@@ -123,6 +124,14 @@ class TR_SingleBitContainer
    void operator&=(TR_SingleBitContainer &other) { _value = _value && other._value; }
    void operator-=(TR_SingleBitContainer &other) { if (other._value) { _value = false; } }
    void operator=(TR_SingleBitContainer &other) { _value = other._value; }
+   bool assignAndCheckForChange(TR_SingleBitContainer &other) { bool changed = _value != other._value; _value = other._value; return changed; }
+   bool transfer(TR_SingleBitContainer &in, TR_SingleBitContainer *gen, TR_SingleBitContainer *kill)
+      {
+      bool value = (in._value && !(kill && kill->_value)) || (gen && gen->_value);
+      bool changed = _value != value;
+      _value = value;
+      return changed;
+      }
 
    void setAll(int64_t n) { TR_ASSERT(n < 2, "SingleBitContainers only contain one bit\n"); if (n > 0) { _value = true; } }
    void setAll(int64_t m, int64_t n) { if (m == 0 && n == 1) { _value = true; } }
@@ -432,8 +441,7 @@ class TR_BitVector
          int32_t low = v2._firstChunkWithNonZero;
          for (i = _firstChunkWithNonZero; i < low; i++)
             _chunks[i] = 0;
-         for (i = low ; i <= high; i++)
-            _chunks[i] = v2._chunks[i];
+         TR::BitVectorOperations::copyWords(_chunks + low, v2._chunks + low, high - low + 1);
          for (i = high+1; i <= _lastChunkWithNonZero; i++)
             _chunks[i] = 0;
          _firstChunkWithNonZero = low;
@@ -458,8 +466,8 @@ class TR_BitVector
          setChunkSize(v2Used);
 
       // OR in all of the words from the 2nd vector
-      for (int32_t i = v2._firstChunkWithNonZero; i <= v2._lastChunkWithNonZero; i++)
-         _chunks[i] |= v2._chunks[i];
+      int32_t low = v2._firstChunkWithNonZero;
+      TR::BitVectorOperations::orWords(_chunks + low, _chunks + low, v2._chunks + low, v2._lastChunkWithNonZero - low + 1);
       if (_firstChunkWithNonZero > v2._firstChunkWithNonZero)
          _firstChunkWithNonZero = v2._firstChunkWithNonZero;
       if (_lastChunkWithNonZero < v2._lastChunkWithNonZero)
@@ -514,8 +522,7 @@ class TR_BitVector
          }
 
       // AND in all of the words from the 2nd vector
-      for (i = low; i <= high; i++)
-         _chunks[i] &= v2._chunks[i];
+      TR::BitVectorOperations::andWords(_chunks + low, _chunks + low, v2._chunks + low, high - low + 1);
 
       // Reset first and last chunks with non-zero
       resetLowAndHighChunks(low, high);
@@ -540,10 +547,7 @@ class TR_BitVector
          low = _firstChunkWithNonZero;
       if (high > _lastChunkWithNonZero)
          high = _lastChunkWithNonZero;
-      for (int32_t i = low; i<= high; i++)
-         if (_chunks[i] & v2._chunks[i])
-            return true;
-      return false;
+      return TR::BitVectorOperations::intersectWords(_chunks + low, v2._chunks + low, high - low + 1);
       }
 
    // Perform a bitwise negation (AND-NOT) between this vector and a second vector
@@ -563,8 +567,7 @@ class TR_BitVector
          low = _firstChunkWithNonZero;
       if (high > _lastChunkWithNonZero)
          high = _lastChunkWithNonZero;
-      for (int32_t i = low; i<= high; i++)
-         _chunks[i] &= ~v2._chunks[i];
+      TR::BitVectorOperations::andNotWords(_chunks + low, _chunks + low, v2._chunks + low, high - low + 1);
 
       // Reset first and last chunks with non-zero
       resetLowAndHighChunks(_firstChunkWithNonZero, _lastChunkWithNonZero);
@@ -604,14 +607,36 @@ class TR_BitVector
          return false;
       if (_lastChunkWithNonZero != v2._lastChunkWithNonZero)
          return false;
-      for (int32_t i = _firstChunkWithNonZero; i <= _lastChunkWithNonZero; i++)
-         if (_chunks[i] != v2._chunks[i])
-            return false;
-      return true;
+      return TR::BitVectorOperations::equalWords(_chunks + _firstChunkWithNonZero, v2._chunks + _firstChunkWithNonZero,
+                                                 _lastChunkWithNonZero - _firstChunkWithNonZero + 1);
       }
 
    bool operator!= (TR_BitVector& v2){ return !operator==(v2); }
 
+   // Copy a second vector into this one and determine whether this vector
+   // changed, in one pass over the vectors when they span the same chunks.
+   //
+   bool assignAndCheckForChange(TR_BitVector& v2)
+      {
+      if (_firstChunkWithNonZero != v2._firstChunkWithNonZero ||
+          _lastChunkWithNonZero != v2._lastChunkWithNonZero ||
+          _lastChunkWithNonZero < 0)
+         {
+         bool changed = !(*this == v2);
+         *this = v2;
+         return changed;
+         }
+      int32_t low = _firstChunkWithNonZero;
+      return TR::BitVectorOperations::copyWords(_chunks + low, v2._chunks + low, _lastChunkWithNonZero - low + 1);
+      }
+
+   // Set this vector to gen | (in & ~kill), the transfer function of a block
+   // in a gen/kill dataflow analysis, in one pass over the vectors. gen and
+   // kill may be NULL for empty sets and in may be this vector. Returns true
+   // if this vector changed.
+   //
+   bool transfer(TR_BitVector& in, TR_BitVector *gen, TR_BitVector *kill);
+
 
    // Set the first n elements of the set
    //
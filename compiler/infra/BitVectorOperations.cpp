@@ -0,0 +1,336 @@
+/*******************************************************************************
+ * Copyright (c) 2020, 2020 IBM Corp. and others
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at https://www.eclipse.org/legal/epl-2.0/
+ * or the Apache License, Version 2.0 which accompanies this distribution and
+ * is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following
+ * Secondary Licenses when the conditions for such availability set
+ * forth in the Eclipse Public License, v. 2.0 are satisfied: GNU
+ * General Public License, version 2 with the GNU Classpath
+ * Exception [1] and GNU General Public License, version 2 with the
+ * OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] http://openjdk.java.net/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
+ *******************************************************************************/
+
+#include "infra/BitVectorOperations.hpp"
+
+#include <stddef.h>
+#include "env/defines.h"
+
+// The AVX2 loops are compiled with a function level target attribute, so that
+// the rest of the compiler does not have to be built for AVX2, and are only
+// called after checking that the host supports AVX2.
+//
+#if defined(TR_HOST_X86) && defined(TR_HOST_64BIT) && defined(__GNUC__)
+#define BITVECTOR_USE_AVX2 1
+#include <immintrin.h>
+#define AVX2_FUNCTION __attribute__((target("avx2")))
+#endif
+
+typedef TR::BitVectorOperations::Word Word;
+
+static bool
+hostSupportsVectorInstructions()
+   {
+#if defined(BITVECTOR_USE_AVX2)
+   __builtin_cpu_init();
+   return __builtin_cpu_supports("avx2") != 0;
+#else
+   return false;
+#endif
+   }
+
+static bool vectorInstructionsSupported = hostSupportsVectorInstructions();
+static bool useVectorInstructions = vectorInstructionsSupported;
+
+bool
+TR::BitVectorOperations::vectorInstructionsEnabled()
+   {
+   return useVectorInstructions;
+   }
+
+bool
+TR::BitVectorOperations::enableVectorInstructions(bool enable)
+   {
+   bool previous = useVectorInstructions;
+   useVectorInstructions = enable && vectorInstructionsSupported;
+   return previous;
+   }
+
+#if defined(BITVECTOR_USE_AVX2)
+
+static const int32_t wordsPerVector = sizeof(__m256i) / sizeof(Word);
+
+static inline __m256i AVX2_FUNCTION
+loadVector(const Word *words, int32_t i)
+   {
+   return _mm256_loadu_si256((const __m256i *)(words + i));
+   }
+
+static inline void AVX2_FUNCTION
+storeVector(Word *words, int32_t i, __m256i value)
+   {
+   _mm256_storeu_si256((__m256i *)(words + i), value);
+   }
+
+// Each loop processes the words that fill whole vectors and returns the
+// number of words processed; the caller finishes the remaining words with
+// the scalar loop.
+//
+static int32_t AVX2_FUNCTION
+orVectors(Word *result, const Word *a, const Word *b, int32_t count, bool *changed)
+   {
+   __m256i difference = _mm256_setzero_si256();
+   int32_t i = 0;
+   for (; i + wordsPerVector <= count; i += wordsPerVector)
+      {
+      __m256i value = _mm256_or_si256(loadVector(a, i), loadVector(b, i));
+      difference = _mm256_or_si256(difference, _mm256_xor_si256(value, loadVector(a, i)));
+      storeVector(result, i, value);
+      }
+   *changed = !_mm256_testz_si256(difference, difference);
+   return i;
+   }
+
+static int32_t AVX2_FUNCTION
+andVectors(Word *result, const Word *a, const Word *b, int32_t count, bool *changed)
+   {
+   __m256i difference = _mm256_setzero_si256();
+   int32_t i = 0;
+   for (; i + wordsPerVector <= count; i += wordsPerVector)
+      {
+      __m256i value = _mm256_and_si256(loadVector(a, i), loadVector(b, i));
+      difference = _mm256_or_si256(difference, _mm256_xor_si256(value, loadVector(a, i)));
+      storeVector(result, i, value);
+      }
+   *changed = !_mm256_testz_si256(difference, difference);
+   return i;
+   }
+
+static int32_t AVX2_FUNCTION
+andNotVectors(Word *result, const Word *a, const Word *b, int32_t count, bool *changed)
+   {
+   __m256i difference = _mm256_setzero_si256();
+   int32_t i = 0;
+   for (; i + wordsPerVector <= count; i += wordsPerVector)
+      {
+      __m256i value = _mm256_andnot_si256(loadVector(b, i), loadVector(a, i));
+      difference = _mm256_or_si256(difference, _mm256_xor_si256(value, loadVector(a, i)));
+      storeVector(result, i, value);
+      }
+   *changed = !_mm256_testz_si256(difference, difference);
+   return i;
+   }
+
+static int32_t AVX2_FUNCTION
+transferVectors(Word *result, const Word *in, const Word *gen, const Word *kill, int32_t count, bool *changed)
+   {
+   __m256i difference = _mm256_setzero_si256();
+   int32_t i = 0;
+   for (; i + wordsPerVector <= count; i += wordsPerVector)
+      {
+      __m256i value = loadVector(in, i);
+      if (kill)
+         value = _mm256_andnot_si256(loadVector(kill, i), value);
+      if (gen)
+         value = _mm256_or_si256(value, loadVector(gen, i));
+      difference = _mm256_or_si256(difference, _mm256_xor_si256(value, loadVector(result, i)));
+      storeVector(result, i, value);
+      }
+   *changed = !_mm256_testz_si256(difference, difference);
+   return i;
+   }
+
+static int32_t AVX2_FUNCTION
+copyVectors(Word *result, const Word *a, int32_t count, bool *changed)
+   {
+   __m256i difference = _mm256_setzero_si256();
+   int32_t i = 0;
+   for (; i + wordsPerVector <= count; i += wordsPerVector)
+      {
+      __m256i value = loadVector(a, i);
+      difference = _mm256_or_si256(difference, _mm256_xor_si256(value, loadVector(result, i)));
+      storeVector(result, i, value);
+      }
+   *changed = !_mm256_testz_si256(difference, difference);
+   return i;
+   }
+
+static int32_t AVX2_FUNCTION
+equalVectors(const Word *a, const Word *b, int32_t count, bool *equal)
+   {
+   int32_t i = 0;
+   for (; i + wordsPerVector <= count; i += wordsPerVector)
+      {
+      __m256i difference = _mm256_xor_si256(loadVector(a, i), loadVector(b, i));
+      if (!_mm256_testz_si256(difference, difference))
+         {
+         *equal = false;
+         return i;
+         }
+      }
+   *equal = true;
+   return i;
+   }
+
+static int32_t AVX2_FUNCTION
+intersectVectors(const Word *a, const Word *b, int32_t count, bool *intersect)
+   {
+   int32_t i = 0;
+   for (; i + wordsPerVector <= count; i += wordsPerVector)
+      {
+      if (!_mm256_testz_si256(loadVector(a, i), loadVector(b, i)))
+         {
+         *intersect = true;
+         return i;
+         }
+      }
+   *intersect = false;
+   return i;
+   }
+
+#endif
+
+bool
+TR::BitVectorOperations::orWordsLong(Word *result, const Word *a, const Word *b, int32_t count)
+   {
+   bool changed = false;
+   int32_t done = 0;
+#if defined(BITVECTOR_USE_AVX2)
+   if (useVectorInstructions)
+      done = orVectors(result, a, b, count, &changed);
+#endif
+   Word difference = 0;
+   for (int32_t i = done; i < count; i++)
+      {
+      Word word = a[i] | b[i];
+      difference |= word ^ a[i];
+      result[i] = word;
+      }
+   return changed || difference != 0;
+   }
+
+bool
+TR::BitVectorOperations::andWordsLong(Word *result, const Word *a, const Word *b, int32_t count)
+   {
+   bool changed = false;
+   int32_t done = 0;
+#if defined(BITVECTOR_USE_AVX2)
+   if (useVectorInstructions)
+      done = andVectors(result, a, b, count, &changed);
+#endif
+   Word difference = 0;
+   for (int32_t i = done; i < count; i++)
+      {
+      Word word = a[i] & b[i];
+      difference |= word ^ a[i];
+      result[i] = word;
+      }
+   return changed || difference != 0;
+   }
+
+bool
+TR::BitVectorOperations::andNotWordsLong(Word *result, const Word *a, const Word *b, int32_t count)
+   {
+   bool changed = false;
+   int32_t done = 0;
+#if defined(BITVECTOR_USE_AVX2)
+   if (useVectorInstructions)
+      done = andNotVectors(result, a, b, count, &changed);
+#endif
+   Word difference = 0;
+   for (int32_t i = done; i < count; i++)
+      {
+      Word word = a[i] & ~b[i];
+      difference |= word ^ a[i];
+      result[i] = word;
+      }
+   return changed || difference != 0;
+   }
+
+bool
+TR::BitVectorOperations::transferWordsLong(Word *result, const Word *in, const Word *gen, const Word *kill, int32_t count)
+   {
+   bool changed = false;
+   int32_t done = 0;
+#if defined(BITVECTOR_USE_AVX2)
+   if (useVectorInstructions)
+      done = transferVectors(result, in, gen, kill, count, &changed);
+#endif
+   Word difference = 0;
+   for (int32_t i = done; i < count; i++)
+      {
+      Word word = in[i];
+      if (kill)
+         word &= ~kill[i];
+      if (gen)
+         word |= gen[i];
+      difference |= word ^ result[i];
+      result[i] = word;
+      }
+   return changed || difference != 0;
+   }
+
+bool
+TR::BitVectorOperations::copyWordsLong(Word *result, const Word *a, int32_t count)
+   {
+   bool changed = false;
+   int32_t done = 0;
+#if defined(BITVECTOR_USE_AVX2)
+   if (useVectorInstructions)
+      done = copyVectors(result, a, count, &changed);
+#endif
+   Word difference = 0;
+   for (int32_t i = done; i < count; i++)
+      {
+      difference |= a[i] ^ result[i];
+      result[i] = a[i];
+      }
+   return changed || difference != 0;
+   }
+
+bool
+TR::BitVectorOperations::equalWordsLong(const Word *a, const Word *b, int32_t count)
+   {
+   int32_t done = 0;
+#if defined(BITVECTOR_USE_AVX2)
+   if (useVectorInstructions)
+      {
+      bool equal;
+      done = equalVectors(a, b, count, &equal);
+      if (!equal)
+         return false;
+      }
+#endif
+   for (int32_t i = done; i < count; i++)
+      if (a[i] != b[i])
+         return false;
+   return true;
+   }
+
+bool
+TR::BitVectorOperations::intersectWordsLong(const Word *a, const Word *b, int32_t count)
+   {
+   int32_t done = 0;
+#if defined(BITVECTOR_USE_AVX2)
+   if (useVectorInstructions)
+      {
+      bool intersect;
+      done = intersectVectors(a, b, count, &intersect);
+      if (intersect)
+         return true;
+      }
+#endif
+   for (int32_t i = done; i < count; i++)
+      if (a[i] & b[i])
+         return true;
+   return false;
+   }
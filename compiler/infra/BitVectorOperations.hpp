@@ -0,0 +1,203 @@
+/*******************************************************************************
+ * Copyright (c) 2020, 2020 IBM Corp. and others
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at https://www.eclipse.org/legal/epl-2.0/
+ * or the Apache License, Version 2.0 which accompanies this distribution and
+ * is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following
+ * Secondary Licenses when the conditions for such availability set
+ * forth in the Eclipse Public License, v. 2.0 are satisfied: GNU
+ * General Public License, version 2 with the GNU Classpath
+ * Exception [1] and GNU General Public License, version 2 with the
+ * OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] http://openjdk.java.net/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
+ *******************************************************************************/
+
+#ifndef BITVECTOROPERATIONS_INCL
+#define BITVECTOROPERATIONS_INCL
+
+#include <stdint.h>
+
+namespace TR {
+
+/**
+ * @class
+ * @brief Bulk operations on the arrays of words backing TR_BitVector and
+ * CS2::ABitVector.
+ *
+ * Every operation works on count words starting at the given addresses.
+ * Arrays shorter than VECTOR_THRESHOLD words are processed inline one word at a
+ * time; longer arrays are processed by an out of line loop that uses 256-bit
+ * AVX2 instructions when the host supports them, and falls back to the word at
+ * a time loop on other hosts.
+ *
+ * The operations that produce a result report whether it changed, so that a
+ * dataflow solver can find out whether a set changed in the same pass that
+ * computes it. The result array may be the same as any of the inputs.
+ */
+class BitVectorOperations
+   {
+public:
+
+#if defined(BITVECTOR_64BIT)
+   typedef uint64_t Word;
+#else
+   typedef uint32_t Word;
+#endif
+
+   /// Arrays at least this long are processed by the out of line loops
+   static const int32_t VECTOR_THRESHOLD = 8;
+
+   /**
+    * @brief result = a | b
+    * @return true if result differs from a
+    */
+   static bool orWords(Word *result, const Word *a, const Word *b, int32_t count)
+      {
+      if (count >= VECTOR_THRESHOLD)
+         return orWordsLong(result, a, b, count);
+      Word changed = 0;
+      for (int32_t i = 0; i < count; i++)
+         {
+         Word word = a[i] | b[i];
+         changed |= word ^ a[i];
+         result[i] = word;
+         }
+      return changed != 0;
+      }
+
+   /**
+    * @brief result = a & b
+    * @return true if result differs from a
+    */
+   static bool andWords(Word *result, const Word *a, const Word *b, int32_t count)
+      {
+      if (count >= VECTOR_THRESHOLD)
+         return andWordsLong(result, a, b, count);
+      Word changed = 0;
+      for (int32_t i = 0; i < count; i++)
+         {
+         Word word = a[i] & b[i];
+         changed |= word ^ a[i];
+         result[i] = word;
+         }
+      return changed != 0;
+      }
+
+   /**
+    * @brief result = a & ~b
+    * @return true if result differs from a
+    */
+   static bool andNotWords(Word *result, const Word *a, const Word *b, int32_t count)
+      {
+      if (count >= VECTOR_THRESHOLD)
+         return andNotWordsLong(result, a, b, count);
+      Word changed = 0;
+      for (int32_t i = 0; i < count; i++)
+         {
+         Word word = a[i] & ~b[i];
+         changed |= word ^ a[i];
+         result[i] = word;
+         }
+      return changed != 0;
+      }
+
+   /**
+    * @brief result = gen | (in & ~kill), the transfer function of a block in
+    * a gen/kill dataflow analysis. gen and kill may be NULL for empty sets.
+    * @return true if result changed
+    */
+   static bool transferWords(Word *result, const Word *in, const Word *gen, const Word *kill, int32_t count)
+      {
+      if (count >= VECTOR_THRESHOLD)
+         return transferWordsLong(result, in, gen, kill, count);
+      Word changed = 0;
+      for (int32_t i = 0; i < count; i++)
+         {
+         Word word = in[i];
+         if (kill)
+            word &= ~kill[i];
+         if (gen)
+            word |= gen[i];
+         changed |= word ^ result[i];
+         result[i] = word;
+         }
+      return changed != 0;
+      }
+
+   /**
+    * @brief result = a
+    * @return true if result changed
+    */
+   static bool copyWords(Word *result, const Word *a, int32_t count)
+      {
+      if (count >= VECTOR_THRESHOLD)
+         return copyWordsLong(result, a, count);
+      Word changed = 0;
+      for (int32_t i = 0; i < count; i++)
+         {
+         changed |= a[i] ^ result[i];
+         result[i] = a[i];
+         }
+      return changed != 0;
+      }
+
+   /**
+    * @return true if a and b have the same words
+    */
+   static bool equalWords(const Word *a, const Word *b, int32_t count)
+      {
+      if (count >= VECTOR_THRESHOLD)
+         return equalWordsLong(a, b, count);
+      for (int32_t i = 0; i < count; i++)
+         if (a[i] != b[i])
+            return false;
+      return true;
+      }
+
+   /**
+    * @return true if a and b have a bit set in common
+    */
+   static bool intersectWords(const Word *a, const Word *b, int32_t count)
+      {
+      if (count >= VECTOR_THRESHOLD)
+         return intersectWordsLong(a, b, count);
+      for (int32_t i = 0; i < count; i++)
+         if (a[i] & b[i])
+            return true;
+      return false;
+      }
+
+   /**
+    * @brief Whether the out of line loops use vector instructions.
+    */
+   static bool vectorInstructionsEnabled();
+
+   /**
+    * @brief Allow or prevent the use of vector instructions, for testing and
+    * for measuring the scalar loops on hosts that support them. Vector
+    * instructions are never used on hosts that do not support them.
+    * @return the previous setting
+    */
+   static bool enableVectorInstructions(bool enable);
+
+private:
+   static bool orWordsLong(Word *result, const Word *a, const Word *b, int32_t count);
+   static bool andWordsLong(Word *result, const Word *a, const Word *b, int32_t count);
+   static bool andNotWordsLong(Word *result, const Word *a, const Word *b, int32_t count);
+   static bool transferWordsLong(Word *result, const Word *in, const Word *gen, const Word *kill, int32_t count);
+   static bool copyWordsLong(Word *result, const Word *a, int32_t count);
+   static bool equalWordsLong(const Word *a, const Word *b, int32_t count);
+   static bool intersectWordsLong(const Word *a, const Word *b, int32_t count);
+   };
+
+}
+
+#endif
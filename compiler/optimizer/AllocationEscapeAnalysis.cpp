@@ -0,0 +1,628 @@
+/*******************************************************************************
+ * Copyright (c) 2020, 2020 IBM Corp. and others
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at https://www.eclipse.org/legal/epl-2.0/
+ * or the Apache License, Version 2.0 which accompanies this distribution and
+ * is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following
+ * Secondary Licenses when the conditions for such availability set
+ * forth in the Eclipse Public License, v. 2.0 are satisfied: GNU
+ * General Public License, version 2 with the GNU Classpath
+ * Exception [1] and GNU General Public License, version 2 with the
+ * OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] http://openjdk.java.net/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
+ *******************************************************************************/
+
+#include "optimizer/AllocationEscapeAnalysis.hpp"
+
+#include <algorithm>
+#include <stdint.h>
+#include "compile/Compilation.hpp"
+#include "compile/SymbolReferenceTable.hpp"
+#include "env/CompilerEnv.hpp"
+#include "env/FrontEnd.hpp"
+#include "env/StackMemoryRegion.hpp"
+#include "env/TRMemory.hpp"
+#include "il/Block.hpp"
+#include "il/DataTypes.hpp"
+#include "il/ILOpCodes.hpp"
+#include "il/ILOps.hpp"
+#include "il/Node.hpp"
+#include "il/Node_inlines.hpp"
+#include "il/ResolvedMethodSymbol.hpp"
+#include "il/Symbol.hpp"
+#include "il/SymbolReference.hpp"
+#include "il/TreeTop.hpp"
+#include "il/TreeTop_inlines.hpp"
+#include "infra/vector.hpp"
+#include "optimizer/Optimization_inlines.hpp"
+#include "optimizer/Optimizer.hpp"
+
+TR_AllocationEscapeAnalysis::TR_AllocationEscapeAnalysis(TR::OptimizationManager *manager)
+   : TR::Optimization(manager)
+   {}
+
+int32_t
+TR_AllocationEscapeAnalysis::perform()
+   {
+   TR::StackMemoryRegion stackMemoryRegion(*trMemory());
+   TR::Region &region = comp()->trMemory()->currentStackRegion();
+
+   _candidates = new (trStackMemory()) TR::vector<Candidate, TR::Region&>(region);
+   _accesses = new (trStackMemory()) TR::vector<Access, TR::Region&>(region);
+   _holderStores = new (trStackMemory()) TR::vector<HolderStore, TR::Region&>(region);
+   _candidateOfAllocation = new (trStackMemory()) NodeMap(std::less<TR::Node *>(), NodeMapAllocator(region));
+   _derivedAddressOfNode = new (trStackMemory()) NodeMap(std::less<TR::Node *>(), NodeMapAllocator(region));
+   _derivedAddresses = new (trStackMemory()) TR::vector<DerivedAddress, TR::Region&>(region);
+   _holders = new (trStackMemory()) SymbolMap(std::less<TR::Symbol *>(), SymbolMapAllocator(region));
+
+   findCandidates();
+   if (_candidates->empty())
+      return 0;
+
+   findHolders();
+   findUses();
+   for (int32_t c = 0; c < (int32_t)_candidates->size(); c++)
+      if (!(*_candidates)[c]._escapes)
+         checkAllocationBlock(c);
+
+   // The accesses of each candidate, in order of offset
+   TR::vector<int32_t, TR::Region&> accesses(region);
+   int32_t numTransformations = 0;
+   for (int32_t c = 0; c < (int32_t)_candidates->size(); c++)
+      {
+      Candidate &candidate = (*_candidates)[c];
+      if (candidate._escapes)
+         continue;
+
+      accesses.clear();
+      for (int32_t a = 0; a < (int32_t)_accesses->size(); a++)
+         if ((*_accesses)[a]._candidate == c)
+            accesses.push_back(a);
+      std::stable_sort(accesses.begin(), accesses.end(), AccessOffsetLess(*_accesses));
+
+      if (fieldsCanBeReplaced(c, accesses))
+         {
+         if (!performTransformation(comp(), "%sReplacing the fields of the %d byte object allocated by [%p] with locals\n",
+                                    optDetailString(), candidate._size, candidate._allocation))
+            continue;
+         replaceFields(c, accesses);
+         }
+      else if (candidate._storesAddress)
+         {
+         if (trace())
+            traceMsg(comp(), "Object allocated by [%p] does not escape but an address is stored into it\n", candidate._allocation);
+         continue;
+         }
+      else
+         {
+         if (!performTransformation(comp(), "%sAllocating the %d byte object allocated by [%p] on the stack\n",
+                                    optDetailString(), candidate._size, candidate._allocation))
+            continue;
+         allocateOnStack(c, accesses);
+         }
+      numTransformations++;
+      }
+
+   if (numTransformations > 0)
+      {
+      optimizer()->setUseDefInfo(NULL);
+      optimizer()->setValueNumberInfo(NULL);
+      optimizer()->setAliasSetsAreValid(false);
+      requestOpt(OMR::localCSE);
+      requestOpt(OMR::deadTreesElimination);
+      }
+
+   return numTransformations;
+   }
+
+const char *
+TR_AllocationEscapeAnalysis::optDetailString() const throw()
+   {
+   return "O^O ALLOCATION ESCAPE ANALYSIS: ";
+   }
+
+/*
+ * The value stored by a tree that is a direct store, or anchored by a tree
+ * that is a treetop, or NULL
+ */
+TR::Node *
+TR_AllocationEscapeAnalysis::storedAllocation(TR::Node *node)
+   {
+   if (node->getOpCodeValue() == TR::treetop || node->getOpCode().isStoreDirect())
+      return node->getFirstChild();
+   return NULL;
+   }
+
+void
+TR_AllocationEscapeAnalysis::findCandidates()
+   {
+   vcount_t visitCount = comp()->incVisitCount();
+   TR::vector<TR::Node *, TR::Region&> stack(comp()->trMemory()->currentStackRegion());
+   TR::Block *block = NULL;
+
+   for (TR::TreeTop *tt = comp()->getStartTree(); tt; tt = tt->getNextTreeTop())
+      {
+      TR::Node *node = tt->getNode();
+      if (node->getOpCodeValue() == TR::BBStart)
+         block = node->getBlock();
+
+      // An allocation is evaluated by the first tree that refers to it, which
+      // must anchor it or store it to a local
+      //
+      TR::Node *allocation = storedAllocation(node);
+      int32_t size = 0;
+      if (allocation &&
+          allocation->getVisitCount() != visitCount &&
+          allocation->getOpCode().isCall() &&
+          fe()->isObjectAllocation(comp(), allocation, size) &&
+          size <= MAX_OBJECT_SIZE)
+         {
+         Candidate candidate = { allocation, tt, block, size, false, false, false };
+         (*_candidateOfAllocation)[allocation] = (int32_t)_candidates->size();
+         _candidates->push_back(candidate);
+         if (trace())
+            traceMsg(comp(), "Candidate allocation [%p] of %d bytes in block_%d\n", allocation, size, block->getNumber());
+         }
+
+      stack.push_back(node);
+      while (!stack.empty())
+         {
+         TR::Node *n = stack.back();
+         stack.pop_back();
+         if (n->getVisitCount() == visitCount)
+            continue;
+         n->setVisitCount(visitCount);
+         for (int32_t i = 0; i < n->getNumChildren(); i++)
+            stack.push_back(n->getChild(i));
+         }
+      }
+   }
+
+/*
+ * A local holds the address of a candidate if every store to it stores that
+ * address, in the block that allocates the object, and its address is never
+ * taken.
+ */
+void
+TR_AllocationEscapeAnalysis::findHolders()
+   {
+   vcount_t visitCount = comp()->incVisitCount();
+   TR::vector<TR::Node *, TR::Region&> stack(comp()->trMemory()->currentStackRegion());
+   TR::Block *block = NULL;
+
+   for (TR::TreeTop *tt = comp()->getStartTree(); tt; tt = tt->getNextTreeTop())
+      {
+      TR::Node *node = tt->getNode();
+      if (node->getOpCodeValue() == TR::BBStart)
+         block = node->getBlock();
+
+      stack.push_back(node);
+      while (!stack.empty())
+         {
+         TR::Node *n = stack.back();
+         stack.pop_back();
+         if (n->getVisitCount() == visitCount)
+            continue;
+         n->setVisitCount(visitCount);
+         for (int32_t i = 0; i < n->getNumChildren(); i++)
+            stack.push_back(n->getChild(i));
+
+         bool isStore = n->getOpCode().isStoreDirect();
+         if (!(isStore || n->getOpCodeValue() == TR::loadaddr) ||
+             !n->getSymbol()->isAuto())
+            continue;
+
+         TR::Symbol *local = n->getSymbol();
+         int32_t holds = AnyValue;
+         if (isStore && n == node)
+            {
+            NodeMap::iterator candidate = _candidateOfAllocation->find(n->getFirstChild());
+            if (candidate != _candidateOfAllocation->end() && (*_candidates)[candidate->second]._block == block)
+               holds = candidate->second;
+            }
+
+         SymbolMap::iterator previous = _holders->find(local);
+         if (previous == _holders->end())
+            (*_holders)[local] = holds;
+         else if (previous->second != holds)
+            previous->second = AnyValue;
+
+         if (holds >= 0)
+            {
+            HolderStore store = { holds, tt };
+            _holderStores->push_back(store);
+            }
+         }
+      }
+   }
+
+/*
+ * The candidate whose address, plus baseOffset, node computes, or NoCandidate
+ */
+int32_t
+TR_AllocationEscapeAnalysis::referenceOf(TR::Node *node, int32_t &baseOffset, bool &isDerived)
+   {
+   baseOffset = 0;
+   isDerived = false;
+
+   NodeMap::iterator allocation = _candidateOfAllocation->find(node);
+   if (allocation != _candidateOfAllocation->end())
+      return allocation->second;
+
+   if (node->getOpCode().isLoadVarDirect() && node->getSymbol()->isAuto())
+      {
+      SymbolMap::iterator holder = _holders->find(node->getSymbol());
+      if (holder != _holders->end() && holder->second >= 0)
+         return holder->second;
+      }
+
+   NodeMap::iterator derived = _derivedAddressOfNode->find(node);
+   if (derived != _derivedAddressOfNode->end())
+      {
+      DerivedAddress &address = (*_derivedAddresses)[derived->second];
+      baseOffset = address._offset;
+      isDerived = true;
+      return address._candidate;
+      }
+
+   return NoCandidate;
+   }
+
+bool
+TR_AllocationEscapeAnalysis::isHolderLoad(TR::Node *node, int32_t candidate)
+   {
+   if (!node->getOpCode().isLoadVarDirect() || !node->getSymbol()->isAuto())
+      return false;
+   SymbolMap::iterator holder = _holders->find(node->getSymbol());
+   return holder != _holders->end() && holder->second == candidate;
+   }
+
+void
+TR_AllocationEscapeAnalysis::escapes(int32_t candidate, TR::Node *use, const char *reason)
+   {
+   if ((*_candidates)[candidate]._escapes)
+      return;
+   (*_candidates)[candidate]._escapes = true;
+   if (trace())
+      traceMsg(comp(), "Object allocated by [%p] escapes at [%p]: %s\n", (*_candidates)[candidate]._allocation, use, reason);
+   }
+
+void
+TR_AllocationEscapeAnalysis::findUses()
+   {
+   TR::vector<TR::Node *, TR::Region&> stack(comp()->trMemory()->currentStackRegion());
+
+   // Address arithmetic on a candidate that adds a constant is followed to
+   // the accesses that use it
+   //
+   vcount_t visitCount = comp()->incVisitCount();
+   for (TR::TreeTop *tt = comp()->getStartTree(); tt; tt = tt->getNextTreeTop())
+      {
+      stack.push_back(tt->getNode());
+      while (!stack.empty())
+         {
+         TR::Node *node = stack.back();
+         stack.pop_back();
+         if (node->getVisitCount() == visitCount)
+            continue;
+         node->setVisitCount(visitCount);
+         for (int32_t i = 0; i < node->getNumChildren(); i++)
+            stack.push_back(node->getChild(i));
+
+         if (!node->getOpCode().isAdd() || node->getDataType() != TR::Address ||
+             !node->getSecondChild()->getOpCode().isLoadConst())
+            continue;
+
+         int32_t baseOffset;
+         bool isDerived;
+         int32_t candidate = referenceOf(node->getFirstChild(), baseOffset, isDerived);
+         int64_t offset = node->getSecondChild()->get64bitIntegralValue();
+         if (candidate < 0 || isDerived || offset < 0 || offset >= (*_candidates)[candidate]._size)
+            continue;
+
+         DerivedAddress address = { candidate, (int32_t)offset };
+         (*_derivedAddressOfNode)[node] = (int32_t)_derivedAddresses->size();
+         _derivedAddresses->push_back(address);
+         }
+      }
+
+   visitCount = comp()->incVisitCount();
+   for (TR::TreeTop *tt = comp()->getStartTree(); tt; tt = tt->getNextTreeTop())
+      {
+      stack.push_back(tt->getNode());
+      while (!stack.empty())
+         {
+         TR::Node *node = stack.back();
+         stack.pop_back();
+         if (node->getVisitCount() == visitCount)
+            continue;
+         node->setVisitCount(visitCount);
+
+         for (int32_t i = 0; i < node->getNumChildren(); i++)
+            {
+            TR::Node *child = node->getChild(i);
+            stack.push_back(child);
+
+            int32_t baseOffset;
+            bool isDerived;
+            int32_t candidate = referenceOf(child, baseOffset, isDerived);
+            if (candidate >= 0 && !(*_candidates)[candidate]._escapes)
+               classifyUse(node, i, candidate, baseOffset, isDerived);
+            }
+         }
+      }
+   }
+
+void
+TR_AllocationEscapeAnalysis::classifyUse(TR::Node *parent, int32_t childIndex, int32_t candidate, int32_t baseOffset, bool isDerived)
+   {
+   Candidate &object = (*_candidates)[candidate];
+   TR::ILOpCode &op = parent->getOpCode();
+   TR::Node *child = parent->getChild(childIndex);
+
+   if (parent->getOpCodeValue() == TR::treetop)
+      return;
+
+   if (!isDerived && op.isStoreDirect() && child == object._allocation && parent->getSymbol()->isAuto())
+      {
+      SymbolMap::iterator holder = _holders->find(parent->getSymbol());
+      if (holder != _holders->end() && holder->second == candidate)
+         return;
+      }
+
+   if (!isDerived && childIndex == 0 && _derivedAddressOfNode->find(parent) != _derivedAddressOfNode->end())
+      return;
+
+   if (childIndex == 0 && (op.isLoadIndirect() || op.isStoreIndirect()))
+      {
+      TR::DataType type = parent->getDataType();
+      if (type.isVector() || type.isAggregate() || type == TR::NoType)
+         {
+         escapes(candidate, parent, "unsupported access type");
+         return;
+         }
+
+      int64_t offset = (int64_t)baseOffset + parent->getSymbolReference()->getOffset();
+      if (offset < 0 || offset + TR::DataType::getSize(type) > object._size)
+         {
+         escapes(candidate, parent, "access outside the object");
+         return;
+         }
+
+      if (op.isStoreIndirect() && parent->getSecondChild()->getDataType() == TR::Address)
+         object._storesAddress = true;
+
+      Access access = { candidate, parent, baseOffset, (int32_t)offset };
+      _accesses->push_back(access);
+      return;
+      }
+
+   if (!isDerived && op.isBooleanCompare() && op.isCompareForEquality() && child->getDataType() == TR::Address)
+      {
+      object._compared = true;
+      return;
+      }
+
+   escapes(candidate, parent, "address used");
+   }
+
+/*
+ * The locals that hold the address of a candidate must be assigned after it is
+ * allocated before they are used again, so that the object they referred to
+ * before is dead once the allocation is evaluated again.
+ */
+void
+TR_AllocationEscapeAnalysis::checkAllocationBlock(int32_t candidate)
+   {
+   Candidate &object = (*_candidates)[candidate];
+   TR::vector<TR::Node *, TR::Region&> stack(comp()->trMemory()->currentStackRegion());
+   TR::vector<TR::Symbol *, TR::Region&> assigned(comp()->trMemory()->currentStackRegion());
+   TR::vector<TR::Node *, TR::Region&> loadedBefore(comp()->trMemory()->currentStackRegion());
+   vcount_t visitCount = comp()->incVisitCount();
+   bool allocated = false;
+
+   for (TR::TreeTop *tt = object._block->getEntry(); tt != object._block->getExit(); tt = tt->getNextTreeTop())
+      {
+      if (tt == object._treeTop)
+         allocated = true;
+
+      stack.push_back(tt->getNode());
+      while (!stack.empty())
+         {
+         TR::Node *node = stack.back();
+         stack.pop_back();
+
+         if (isHolderLoad(node, candidate))
+            {
+            if (node->getVisitCount() != visitCount)
+               {
+               if (!allocated)
+                  loadedBefore.push_back(node);
+               else if (std::find(assigned.begin(), assigned.end(), node->getSymbol()) == assigned.end())
+                  {
+                  escapes(candidate, node, "local used before it is assigned the new object");
+                  return;
+                  }
+               }
+            else if (allocated && std::find(loadedBefore.begin(), loadedBefore.end(), node) != loadedBefore.end())
+               {
+               escapes(candidate, node, "previous object used after the allocation");
+               return;
+               }
+            }
+
+         if (node->getVisitCount() == visitCount)
+            continue;
+         node->setVisitCount(visitCount);
+         for (int32_t i = 0; i < node->getNumChildren(); i++)
+            stack.push_back(node->getChild(i));
+         }
+
+      TR::Node *node = tt->getNode();
+      if (node->getOpCode().isStoreDirect() && node->getFirstChild() == object._allocation)
+         assigned.push_back(node->getSymbol());
+      }
+   }
+
+/*
+ * Each field becomes a local if the accesses at an offset all have the same
+ * type and no two fields overlap
+ */
+bool
+TR_AllocationEscapeAnalysis::fieldsCanBeReplaced(int32_t candidate, TR::vector<int32_t, TR::Region&> &accesses)
+   {
+   if ((*_candidates)[candidate]._compared)
+      return false;
+
+   for (size_t i = 1; i < accesses.size(); i++)
+      {
+      Access &previous = (*_accesses)[accesses[i - 1]];
+      Access &access = (*_accesses)[accesses[i]];
+      TR::DataType previousType = previous._node->getDataType();
+      if (access._offset == previous._offset)
+         {
+         if (access._node->getDataType() != previousType)
+            return false;
+         }
+      else if (access._offset < previous._offset + (int32_t)TR::DataType::getSize(previousType))
+         {
+         return false;
+         }
+      }
+   return true;
+   }
+
+void
+TR_AllocationEscapeAnalysis::replaceFields(int32_t candidate, TR::vector<int32_t, TR::Region&> &accesses)
+   {
+   Candidate &object = (*_candidates)[candidate];
+   TR::SymbolReference *field = NULL;
+   int32_t fieldOffset = 0;
+
+   for (size_t i = 0; i < accesses.size(); i++)
+      {
+      Access &access = (*_accesses)[accesses[i]];
+      TR::Node *node = access._node;
+      TR::DataType type = node->getDataType();
+
+      if (field == NULL || access._offset != fieldOffset)
+         {
+         field = comp()->getSymRefTab()->createTemporary(comp()->getMethodSymbol(), type);
+         fieldOffset = access._offset;
+         TR::Node *clear = TR::Node::createStore(field, TR::Node::createConstZeroValue(object._allocation, type));
+         object._treeTop->insertBefore(TR::TreeTop::create(comp(), clear));
+         if (trace())
+            traceMsg(comp(), "Field at offset %d replaced by #%d\n", fieldOffset, field->getReferenceNumber());
+         }
+
+      if (node->getOpCode().isLoadIndirect())
+         {
+         node->removeAllChildren();
+         TR::Node::recreateWithSymRef(node, comp()->il.opCodeForDirectLoad(type), field);
+         }
+      else
+         {
+         TR::Node *value = node->getSecondChild();
+         value->incReferenceCount();
+         node->removeAllChildren();
+         TR::Node::recreateWithSymRef(node, comp()->il.opCodeForDirectStore(type), field);
+         node->setNumChildren(1);
+         node->setChild(0, value);
+         }
+      }
+
+   removeAllocation(candidate, NULL);
+   }
+
+void
+TR_AllocationEscapeAnalysis::allocateOnStack(int32_t candidate, TR::vector<int32_t, TR::Region&> &accesses)
+   {
+   Candidate &object = (*_candidates)[candidate];
+   int32_t size = (object._size + 7) & ~7;
+   TR::SymbolReference *stackObject = comp()->getSymRefTab()->createLocalPrimArray(size, comp()->getMethodSymbol(),
+                                                                                  8 /*FIXME: JVM-specific - byte*/);
+   stackObject->setStackAllocatedArrayAccess();
+
+   // Clear every field that is accessed, once per shape of access
+   //
+   for (size_t i = 0; i < accesses.size(); i++)
+      {
+      Access &access = (*_accesses)[accesses[i]];
+      bool cleared = false;
+      for (size_t j = 0; j < i && !cleared; j++)
+         {
+         Access &other = (*_accesses)[accesses[j]];
+         cleared = other._offset == access._offset &&
+                   other._baseOffset == access._baseOffset &&
+                   other._node->getSymbolReference() == access._node->getSymbolReference() &&
+                   other._node->getDataType() == access._node->getDataType();
+         }
+      if (cleared)
+         continue;
+
+      TR::Node *base = TR::Node::createWithSymRef(object._allocation, TR::loadaddr, 0, stackObject);
+      if (access._baseOffset != 0)
+         {
+         if (TR::Compiler->target.is64Bit())
+            base = TR::Node::create(TR::aladd, 2, base, TR::Node::lconst(object._allocation, access._baseOffset));
+         else
+            base = TR::Node::create(TR::aiadd, 2, base, TR::Node::iconst(object._allocation, access._baseOffset));
+         }
+
+      TR::DataType type = access._node->getDataType();
+      TR::Node *clear = TR::Node::createWithSymRef(comp()->il.opCodeForIndirectStore(type), 2, 2,
+                                                   base, TR::Node::createConstZeroValue(object._allocation, type),
+                                                   access._node->getSymbolReference());
+      object._treeTop->insertBefore(TR::TreeTop::create(comp(), clear));
+      }
+
+   removeAllocation(candidate, stackObject);
+   }
+
+/*
+ * Replace the allocation by the address of stackObject, or remove it along
+ * with the stores of its address if its fields were replaced.  The arguments
+ * of the allocation are still evaluated where it was.
+ */
+void
+TR_AllocationEscapeAnalysis::removeAllocation(int32_t candidate, TR::SymbolReference *stackObject)
+   {
+   Candidate &object = (*_candidates)[candidate];
+   TR::Node *allocation = object._allocation;
+
+   for (int32_t i = 0; i < allocation->getNumChildren(); i++)
+      object._treeTop->insertBefore(TR::TreeTop::create(comp(), TR::Node::create(TR::treetop, 1, allocation->getChild(i))));
+   allocation->removeAllChildren();
+
+   if (stackObject)
+      {
+      TR::Node::recreateWithSymRef(allocation, TR::loadaddr, stackObject);
+      return;
+      }
+
+   TR::Node::recreate(allocation, TR::aconst);
+   allocation->setAddress(0);
+
+   bool allocationTreeRemoved = false;
+   for (size_t i = 0; i < _holderStores->size(); i++)
+      {
+      HolderStore &store = (*_holderStores)[i];
+      if (store._candidate != candidate || (*_holders)[store._treeTop->getNode()->getSymbol()] != candidate)
+         continue;
+      if (store._treeTop == object._treeTop)
+         allocationTreeRemoved = true;
+      store._treeTop->unlink(true);
+      }
+
+   TR::Node *node = object._treeTop->getNode();
+   if (!allocationTreeRemoved && node->getOpCodeValue() == TR::treetop && allocation->getReferenceCount() == 1)
+      object._treeTop->unlink(true);
+   }
@@ -0,0 +1,158 @@
+/*******************************************************************************
+ * Copyright (c) 2020, 2020 IBM Corp. and others
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at https://www.eclipse.org/legal/epl-2.0/
+ * or the Apache License, Version 2.0 which accompanies this distribution and
+ * is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following
+ * Secondary Licenses when the conditions for such availability set
+ * forth in the Eclipse Public License, v. 2.0 are satisfied: GNU
+ * General Public License, version 2 with the GNU Classpath
+ * Exception [1] and GNU General Public License, version 2 with the
+ * OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] http://openjdk.java.net/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
+ *******************************************************************************/
+
+#ifndef ALLOCATIONESCAPEANALYSIS_INCL
+#define ALLOCATIONESCAPEANALYSIS_INCL
+
+#include <stdint.h>
+#include <map>
+#include "env/TRMemory.hpp"
+#include "infra/vector.hpp"
+#include "optimizer/Optimization.hpp"
+#include "optimizer/OptimizationManager.hpp"
+
+namespace TR { class Block; }
+namespace TR { class Node; }
+namespace TR { class Symbol; }
+namespace TR { class SymbolReference; }
+namespace TR { class TreeTop; }
+
+/**
+ * Escape analysis of the objects allocated by the method, for front ends with
+ * no object model of their own in the optimizer.
+ *
+ * The front end recognizes the nodes that allocate objects through
+ * TR_FrontEnd::isObjectAllocation.  An object does not escape if its address
+ * is only used to load and store its fields, compared, or stored to locals
+ * that hold nothing else and are assigned in the block that allocates it.
+ * Every field access must be at a constant offset within the object.
+ *
+ * An object that does not escape has its fields replaced by locals if its
+ * address is never compared and its fields do not partially overlap.  Other
+ * objects that do not escape are allocated on the stack, as long as no address
+ * is stored into them: the stack is not described to a garbage collector, so
+ * it must not hold the only reference to a heap object.  In both cases the
+ * allocation is removed, and the fields that are used are cleared where the
+ * object was allocated.
+ *
+ * Only one object allocated by a given node is live at a time, because the
+ * locals that hold its address are assigned right after it is allocated, so
+ * an object allocated in a loop reuses the same stack slot or locals on every
+ * iteration.
+ */
+class TR_AllocationEscapeAnalysis : public TR::Optimization
+   {
+   public:
+   TR_AllocationEscapeAnalysis(TR::OptimizationManager *manager);
+   static TR::Optimization *create(TR::OptimizationManager *manager)
+      {
+      return new (manager->allocator()) TR_AllocationEscapeAnalysis(manager);
+      }
+
+   virtual int32_t perform();
+   virtual const char * optDetailString() const throw();
+
+   /// Larger objects are left on the heap
+   static const int32_t MAX_OBJECT_SIZE = 256;
+
+   private:
+
+   struct Candidate
+      {
+      TR::Node *_allocation;
+      TR::TreeTop *_treeTop;     // where the allocation is evaluated
+      TR::Block *_block;
+      int32_t _size;
+      bool _escapes;
+      bool _compared;            // its address must stay distinct from other objects'
+      bool _storesAddress;
+      };
+
+   /// A load or store of part of a candidate object
+   struct Access
+      {
+      int32_t _candidate;
+      TR::Node *_node;           // the indirect load or store
+      int32_t _baseOffset;       // added to the object's address by the node's base
+      int32_t _offset;           // of the access from the start of the object
+      };
+
+   /// Orders the indices of accesses by offset
+   struct AccessOffsetLess
+      {
+      AccessOffsetLess(TR::vector<Access, TR::Region&> &accesses) : _accesses(accesses) {}
+      bool operator()(int32_t a, int32_t b) const { return _accesses[a]._offset < _accesses[b]._offset; }
+      TR::vector<Access, TR::Region&> &_accesses;
+      };
+
+   /// The address of a candidate object plus a constant
+   struct DerivedAddress
+      {
+      int32_t _candidate;
+      int32_t _offset;
+      };
+
+   /// A store of a candidate's address to a local
+   struct HolderStore
+      {
+      int32_t _candidate;
+      TR::TreeTop *_treeTop;
+      };
+
+   // The candidate whose address a local holds, or one of these
+   enum
+      {
+      NoCandidate = -1,
+      AnyValue = -2
+      };
+
+   typedef TR::typed_allocator<std::pair<TR::Node * const, int32_t>, TR::Region&> NodeMapAllocator;
+   typedef std::map<TR::Node *, int32_t, std::less<TR::Node *>, NodeMapAllocator> NodeMap;
+   typedef TR::typed_allocator<std::pair<TR::Symbol * const, int32_t>, TR::Region&> SymbolMapAllocator;
+   typedef std::map<TR::Symbol *, int32_t, std::less<TR::Symbol *>, SymbolMapAllocator> SymbolMap;
+
+   void findCandidates();
+   void findHolders();
+   void findUses();
+   void checkAllocationBlock(int32_t candidate);
+
+   int32_t referenceOf(TR::Node *node, int32_t &baseOffset, bool &isDerived);
+   void classifyUse(TR::Node *parent, int32_t childIndex, int32_t candidate, int32_t baseOffset, bool isDerived);
+   void escapes(int32_t candidate, TR::Node *use, const char *reason);
+   bool isHolderLoad(TR::Node *node, int32_t candidate);
+   TR::Node *storedAllocation(TR::Node *node);
+
+   bool fieldsCanBeReplaced(int32_t candidate, TR::vector<int32_t, TR::Region&> &accesses);
+   void replaceFields(int32_t candidate, TR::vector<int32_t, TR::Region&> &accesses);
+   void allocateOnStack(int32_t candidate, TR::vector<int32_t, TR::Region&> &accesses);
+   void removeAllocation(int32_t candidate, TR::SymbolReference *stackObject);
+
+   TR::vector<Candidate, TR::Region&> *_candidates;
+   TR::vector<Access, TR::Region&> *_accesses;
+   TR::vector<HolderStore, TR::Region&> *_holderStores;
+   NodeMap *_candidateOfAllocation;
+   NodeMap *_derivedAddressOfNode;
+   TR::vector<DerivedAddress, TR::Region&> *_derivedAddresses;
+   SymbolMap *_holders;               // the candidate whose address a local holds
+   };
+
+#endif
@@ -21,6 +21,7 @@
 
 #include <stddef.h>
 #include <stdint.h>
+#include <string.h>
 #include "compile/Compilation.hpp"
 #include "env/TRMemory.hpp"
 #include "il/Block.hpp"
@@ -28,6 +29,7 @@
 #include "il/TreeTop.hpp"
 #include "il/TreeTop_inlines.hpp"
 #include "infra/Assert.hpp"
+#include "infra/Cfg.hpp"
 #include "infra/Link.hpp"
 #include "infra/List.hpp"
 #include "infra/CfgEdge.hpp"
@@ -49,6 +51,9 @@ template<class Container>void TR_BackwardDFSetAnalysis<Container *>::initializeD
    {
    this->initializeBasicDFSetAnalysis();
 
+   if (this->_solveOnCFG)
+      return;
+
    _currentOutSetInfo = (Container **)this->trMemory()->allocateStackMemory(this->_numberOfNodes*sizeof(Container *));
    _originalOutSetInfo = (Container **)this->trMemory()->allocateStackMemory(this->_numberOfNodes*sizeof(Container *));
 
@@ -1453,8 +1458,7 @@ template<class Container>bool TR_BackwardDFSetAnalysis<Container *>::analyzeBloc
       {
       if (this->_regularGenSetInfo)
          {
-         if (this->_regularKillSetInfo[blockNum])
-            *this->_regularInfo -= *this->_regularKillSetInfo[blockNum];
+         this->_regularInfo->transfer(*this->_regularInfo, this->_regularGenSetInfo[blockNum], this->_regularKillSetInfo[blockNum]);
 
          if (traceBBVA())
             {
@@ -1463,20 +1467,7 @@ template<class Container>bool TR_BackwardDFSetAnalysis<Container *>::analyzeBloc
             dumpOptDetails(this->comp(), "\n");
             }
 
-         if (this->_regularGenSetInfo[blockNum])
-            *this->_regularInfo |= *this->_regularGenSetInfo[blockNum];
-
-         if (traceBBVA())
-            {
-            dumpOptDetails(this->comp(), "Normal info for %d : ", blockNum);
-            this->_regularInfo->print(this->comp());
-            dumpOptDetails(this->comp(), "\n");
-            }
-
-         if (this->_exceptionKillSetInfo[blockNum])
-            *this->_exceptionInfo -= *this->_exceptionKillSetInfo[blockNum];
-         if (this->_exceptionGenSetInfo[blockNum])
-            *this->_exceptionInfo |= *this->_exceptionGenSetInfo[blockNum];
+         this->_exceptionInfo->transfer(*this->_exceptionInfo, this->_exceptionGenSetInfo[blockNum], this->_exceptionKillSetInfo[blockNum]);
          compose(this->_regularInfo, this->_exceptionInfo);
 
          if (traceBBVA())
@@ -1492,17 +1483,17 @@ template<class Container>bool TR_BackwardDFSetAnalysis<Container *>::analyzeBloc
          analysisInfo->_containsExceptionTreeTop = this->_containsExceptionTreeTop;
          }
 
-      if (checkForChange && !(*analysisInfo->_inSetInfo == *this->_regularInfo))
+      bool inSetChanged = analysisInfo->_inSetInfo->assignAndCheckForChange(*this->_regularInfo);
+      if (checkForChange && inSetChanged)
          changed = true;
 
       if (this->supportsGenAndKillSets() &&
           canGenAndKillForStructure(blockStructure))
          {
-         if (!(*this->_regularInfo == *analysisInfo->_inSetInfo))
+         if (inSetChanged)
             TR_ASSERT(0, "This should not happen for a block\n");
          }
 
-      *analysisInfo->_inSetInfo = *this->_regularInfo;
       if (!this->_blockAnalysisInfo[blockStructure->getNumber()])
          this->allocateBlockInfoContainer(&this->_blockAnalysisInfo[blockStructure->getNumber()], this->_regularInfo);
       this->copyFromInto(this->_regularInfo, this->_blockAnalysisInfo[blockStructure->getNumber()]);
@@ -1531,6 +1522,105 @@ template<class Container>bool TR_BackwardDFSetAnalysis<Container *>::analyzeBloc
 
 
 
+template<class Container>void TR_BackwardDFSetAnalysis<Container *>::solveOnCFG()
+   {
+   TR::Region &stackRegion = this->trMemory()->currentStackRegion();
+   int32_t numberOfNodes = this->_numberOfNodes;
+   TR::CFGNode **order = (TR::CFGNode **)this->trMemory()->allocateStackMemory(numberOfNodes*sizeof(TR::CFGNode *));
+   int32_t *orderIndex = (int32_t *)this->trMemory()->allocateStackMemory(numberOfNodes*sizeof(int32_t));
+   int32_t numberOfBlocks = this->computeReversePostOrder(order, orderIndex);
+
+   // In sets start at the identity of the meet, so that successors not yet
+   // analyzed do not contribute to the out set of a block
+   //
+   int32_t arraySize = numberOfNodes*sizeof(Container *);
+   Container **inSetInfo = (Container **)this->trMemory()->allocateStackMemory(arraySize);
+   memset(inSetInfo, 0, arraySize);
+   for (int32_t i = 0; i < numberOfBlocks; i++)
+      {
+      int32_t blockNum = order[i]->getNumber();
+      this->allocateContainer(&inSetInfo[blockNum]);
+      initializeInfo(inSetInfo[blockNum]);
+      }
+
+   // Visit the blocks that are pending in post-order until none is left. A
+   // block is pending until it has been analyzed once and again whenever the
+   // in set of one of its successors changes, so each pass only visits the
+   // blocks reached by a change.
+   //
+   TR_BitVector pending(numberOfBlocks, stackRegion);
+   pending.setAll(numberOfBlocks);
+   int32_t numPasses = 0;
+   int32_t numVisits = 0;
+
+   while (!pending.isEmpty())
+      {
+      numPasses++;
+      for (int32_t i = numberOfBlocks-1; i >= 0; i--)
+         {
+         if (!pending.isSet(i))
+            continue;
+
+         pending.reset(i);
+         numVisits++;
+         TR::Block *block = order[i]->asBlock();
+         int32_t blockNum = block->getNumber();
+
+         // The in set of the entry block is not part of the solution
+         //
+         if (blockNum == 0)
+            continue;
+
+         if (block == this->_cfg->getEnd())
+            {
+            this->_regularInfo->empty();
+            this->_exceptionInfo->empty();
+            }
+         else
+            {
+            initializeInfo(this->_regularInfo);
+            initializeInfo(this->_exceptionInfo);
+            for (auto succ = block->getSuccessors().begin(); succ != block->getSuccessors().end(); ++succ)
+               compose(this->_regularInfo, inSetInfo[(*succ)->getTo()->getNumber()]);
+            for (auto succ = block->getExceptionSuccessors().begin(); succ != block->getExceptionSuccessors().end(); ++succ)
+               compose(this->_exceptionInfo, inSetInfo[(*succ)->getTo()->getNumber()]);
+            }
+
+         this->_regularInfo->transfer(*this->_regularInfo, this->_regularGenSetInfo[blockNum], this->_regularKillSetInfo[blockNum]);
+         this->_exceptionInfo->transfer(*this->_exceptionInfo, this->_exceptionGenSetInfo[blockNum], this->_exceptionKillSetInfo[blockNum]);
+         compose(this->_regularInfo, this->_exceptionInfo);
+
+         if (inSetInfo[blockNum]->assignAndCheckForChange(*this->_regularInfo))
+            {
+            TR_PredecessorIterator predecessors(block);
+            for (auto pred = predecessors.getFirst(); pred; pred = predecessors.getNext())
+               pending.set(orderIndex[pred->getFrom()->getNumber()]);
+            }
+
+         if (traceBBVA())
+            {
+            traceMsg(this->comp(), "\nIn Set Info for block_%d is : \n", blockNum);
+            inSetInfo[blockNum]->print(this->comp());
+            traceMsg(this->comp(), "\n");
+            }
+         }
+      }
+
+   for (int32_t i = 0; i < numberOfBlocks; i++)
+      {
+      int32_t blockNum = order[i]->getNumber();
+      if (blockNum == 0)
+         continue;
+      if (!this->_blockAnalysisInfo[blockNum])
+         this->allocateBlockInfoContainer(&this->_blockAnalysisInfo[blockNum], inSetInfo[blockNum]);
+      this->copyFromInto(inSetInfo[blockNum], this->_blockAnalysisInfo[blockNum]);
+      }
+
+   if (traceBBVA())
+      traceMsg(this->comp(), "\nSolved on the CFG in %d passes visiting %d blocks out of %d\n", numPasses, numVisits, numberOfBlocks);
+   }
+
+
 template<class Container>void TR_BackwardDFSetAnalysis<Container *>::analyzeNode(TR::Node *node, vcount_t visitCount, TR_BlockStructure *blockStructure, Container *_analysisInfo)
    {
    }
@@ -79,6 +79,16 @@ performAnalysis(TR_Structure *rootStructure,
                 bool checkForChanges)
    {
    LexicalTimer tlex("basicDFSetAnalysis_pA", comp()->phaseTimer());
+   _solveOnCFG = canSolveOnCFG(rootStructure);
+   if (_solveOnCFG)
+      {
+      initializeDFSetAnalysis();
+      if (!postInitializationProcessing())
+         return false;
+      solveOnCFG();
+      return true;
+      }
+
    // Table of bit vectors to be used during the analysis.
    rootStructure->resetAnalysisInfo();
    rootStructure->resetAnalyzedStatus();
@@ -89,6 +99,93 @@ performAnalysis(TR_Structure *rootStructure,
    return true;
    }
 
+template<class Container>
+bool
+TR_BasicDFSetAnalysis<Container *>::
+canSolveOnCFG(TR_Structure *rootStructure)
+   {
+   // Without gen and kill sets the transfer function of a block is found by
+   // walking its trees, which needs its block structure
+   //
+   if (!supportsGenAndKillSets())
+      return false;
+
+   if (rootStructure == NULL)
+      return true;
+
+   if (comp()->getOption(TR_DisableCFGDataFlowSolver))
+      return false;
+
+   if (comp()->getOption(TR_EnableCFGDataFlowSolver))
+      return true;
+
+   // Improper regions are iterated as a whole until nothing in them changes
+   //
+   return rootStructure->markStructuresWithImproperRegions();
+   }
+
+template<class Container>
+int32_t
+TR_BasicDFSetAnalysis<Container *>::
+computeReversePostOrder(TR::CFGNode **order, int32_t *orderIndex)
+   {
+   TR::Region &stackRegion = trMemory()->currentStackRegion();
+   TR_BitVector visited(_numberOfNodes, stackRegion);
+   TR::CFGNode **postOrder = (TR::CFGNode **)trMemory()->allocateStackMemory(_numberOfNodes*sizeof(TR::CFGNode *));
+   TR::CFGNode **stackNodes = (TR::CFGNode **)trMemory()->allocateStackMemory(_numberOfNodes*sizeof(TR::CFGNode *));
+   TR_SuccessorIterator **stack = (TR_SuccessorIterator **)trMemory()->allocateStackMemory(_numberOfNodes*sizeof(TR_SuccessorIterator *));
+
+   // Depth first search from the start, with an explicit stack of successor
+   // iterators so that deep CFGs do not overflow the native stack
+   //
+   TR::CFGNode *start = _cfg->getStart();
+   int32_t depth = 0;
+   int32_t numberOfPostOrder = 0;
+   visited.set(start->getNumber());
+   stackNodes[depth] = start;
+   stack[depth++] = new (stackRegion) TR_SuccessorIterator(start);
+
+   while (depth > 0)
+      {
+      TR_SuccessorIterator *successors = stack[depth-1];
+      TR::CFGEdge *edge = successors->getCurrent();
+      if (edge)
+         {
+         successors->getNext();
+         TR::CFGNode *succ = edge->getTo();
+         if (!visited.isSet(succ->getNumber()))
+            {
+            visited.set(succ->getNumber());
+            stackNodes[depth] = succ;
+            stack[depth++] = new (stackRegion) TR_SuccessorIterator(succ);
+            }
+         }
+      else
+         postOrder[numberOfPostOrder++] = stackNodes[--depth];
+      }
+
+   for (int32_t i = 0; i < _numberOfNodes; i++)
+      orderIndex[i] = -1;
+
+   int32_t numberOfBlocks = 0;
+   for (int32_t i = numberOfPostOrder-1; i >= 0; i--)
+      {
+      orderIndex[postOrder[i]->getNumber()] = numberOfBlocks;
+      order[numberOfBlocks++] = postOrder[i];
+      }
+
+   for (TR::CFGNode *node = _cfg->getFirstNode(); node; node = node->getNext())
+      {
+      if (!visited.isSet(node->getNumber()))
+         {
+         orderIndex[node->getNumber()] = numberOfBlocks;
+         order[numberOfBlocks++] = node;
+         }
+      }
+
+   return numberOfBlocks;
+   }
+
 template<class Container>
 void
 TR_BasicDFSetAnalysis<Container *>::
@@ -151,15 +248,22 @@ template<class Container>void TR_BasicDFSetAnalysis<Container *>::initializeBasi
    if (_blockAnalysisInfo == NULL)
       initializeBlockInfo();
 
-   _hasImproperRegion = _cfg->getStructure()->markStructuresWithImproperRegions();
-
-   if (comp()->getMethodSymbol()->mayHaveNestedLoops() &&
-       !comp()->getOption(TR_DisableNewBVA))
+   if (_solveOnCFG)
       {
-      _hasImproperRegion = false; // Probably use a run time option here to enable old flow analysis behav
+      _hasImproperRegion = true; // No gen and kill sets for structures
       }
    else
-      _hasImproperRegion = true;
+      {
+      _hasImproperRegion = _cfg->getStructure()->markStructuresWithImproperRegions();
+
+      if (comp()->getMethodSymbol()->mayHaveNestedLoops() &&
+          !comp()->getOption(TR_DisableNewBVA))
+         {
+         _hasImproperRegion = false; // Probably use a run time option here to enable old flow analysis behav
+         }
+      else
+         _hasImproperRegion = true;
+      }
 
    if (comp()->getVisitCount() > HIGH_VISIT_COUNT)
       {
@@ -202,7 +306,8 @@ template<class Container>void TR_BasicDFSetAnalysis<Container *>::initializeBasi
       _exceptionKillSetInfo = NULL;
       }
 
-  _cfg->getStructure()->resetAnalyzedStatus();
+  if (!_solveOnCFG)
+     _cfg->getStructure()->resetAnalyzedStatus();
 
   if (comp()->getVisitCount() > HIGH_VISIT_COUNT)
       {
@@ -1451,22 +1556,16 @@ template<class Container>bool TR_ForwardDFSetAnalysis<Container *>::analyzeBlock
    else
       {
       int32_t blockNum = blockStructure->getNumber();
-      this->copyFromInto(_currentInSetInfo, this->_regularInfo);
-      this->copyFromInto(_currentInSetInfo, this->_exceptionInfo);
       if (this->_regularGenSetInfo)
          {
-         if (this->_regularKillSetInfo[blockNum])
-            *this->_regularInfo -= *this->_regularKillSetInfo[blockNum];
-         if (this->_regularGenSetInfo[blockNum])
-            *this->_regularInfo |= *this->_regularGenSetInfo[blockNum];
-         if (this->_exceptionKillSetInfo[blockNum])
-            *this->_exceptionInfo -= *this->_exceptionKillSetInfo[blockNum];
-         if (this->_exceptionGenSetInfo[blockNum])
-            *this->_exceptionInfo |= *this->_exceptionGenSetInfo[blockNum];
+         this->transferInto(_currentInSetInfo, this->_regularGenSetInfo[blockNum], this->_regularKillSetInfo[blockNum], this->_regularInfo);
+         this->transferInto(_currentInSetInfo, this->_exceptionGenSetInfo[blockNum], this->_exceptionKillSetInfo[blockNum], this->_exceptionInfo);
          this->copyFromInto(analysisInfo->_inSetInfo, this->_blockAnalysisInfo[blockStructure->getNumber()]);
          }
       else
          {
+         this->copyFromInto(_currentInSetInfo, this->_regularInfo);
+         this->copyFromInto(_currentInSetInfo, this->_exceptionInfo);
          analyzeTreeTopsInBlockStructure(blockStructure);
          }
       }
@@ -1480,17 +1579,16 @@ template<class Container>bool TR_ForwardDFSetAnalysis<Container *>::analyzeBlock
       Container* outSetInfo = analysisInfo->getContainer(analysisInfo->_outSetInfo, succ->getTo()->getNumber());
       Container* _info = normalSucc ? this->_regularInfo : this->_exceptionInfo;
 
-      if (checkForChange && !changed && !(*_info == *outSetInfo))
+      bool outSetChanged = outSetInfo->assignAndCheckForChange(*_info);
+      if (checkForChange && outSetChanged)
          changed = true;
 
       if (this->supportsGenAndKillSets() &&
           canGenAndKillForStructure(blockStructure))
          {
-         if (!(*_info == *outSetInfo))
+         if (outSetChanged)
             TR_ASSERT(0, "This should not happen for a block\n");
          }
-
-      *outSetInfo = *_info;
       }
 
   if (this->traceBVA())
@@ -1517,7 +1615,115 @@ template<class Container>bool TR_ForwardDFSetAnalysis<Container *>::analyzeBlock
 
 template<class Container>void TR_ForwardDFSetAnalysis<Container *>::analyzeBlockZeroStructure(TR_BlockStructure *blockStructure)
    {
-   analyzeTreeTopsInBlockStructure(blockStructure);
+   // There is no block structure when solving on the CFG; the entry block
+   // has no trees, so its out sets are its in set
+   //
+   if (blockStructure)
+      analyzeTreeTopsInBlockStructure(blockStructure);
+   }
+
+
+template<class Container>void TR_ForwardDFSetAnalysis<Container *>::solveOnCFG()
+   {
+   TR::Region &stackRegion = this->trMemory()->currentStackRegion();
+   int32_t numberOfNodes = this->_numberOfNodes;
+   TR::CFGNode **order = (TR::CFGNode **)this->trMemory()->allocateStackMemory(numberOfNodes*sizeof(TR::CFGNode *));
+   int32_t *orderIndex = (int32_t *)this->trMemory()->allocateStackMemory(numberOfNodes*sizeof(int32_t));
+   int32_t numberOfBlocks = this->computeReversePostOrder(order, orderIndex);
+
+   // Out sets start at the identity of the meet, so that predecessors not yet
+   // analyzed do not contribute to the in set of a block
+   //
+   int32_t arraySize = numberOfNodes*sizeof(Container *);
+   Container **regularOutSetInfo = (Container **)this->trMemory()->allocateStackMemory(arraySize);
+   Container **exceptionOutSetInfo = (Container **)this->trMemory()->allocateStackMemory(arraySize);
+   memset(regularOutSetInfo, 0, arraySize);
+   memset(exceptionOutSetInfo, 0, arraySize);
+   for (int32_t i = 0; i < numberOfBlocks; i++)
+      {
+      int32_t blockNum = order[i]->getNumber();
+      this->allocateContainer(&regularOutSetInfo[blockNum]);
+      this->allocateContainer(&exceptionOutSetInfo[blockNum]);
+      initializeInfo(regularOutSetInfo[blockNum]);
+      initializeInfo(exceptionOutSetInfo[blockNum]);
+      }
+
+   // Visit the blocks that are pending in reverse post-order until none is
+   // left. A block is pending until it has been analyzed once and again
+   // whenever the out set of one of its predecessors changes, so each pass
+   // only visits the blocks reached by a change.
+   //
+   TR_BitVector pending(numberOfBlocks, stackRegion);
+   pending.setAll(numberOfBlocks);
+   int32_t numPasses = 0;
+   int32_t numVisits = 0;
+
+   while (!pending.isEmpty())
+      {
+      numPasses++;
+      for (int32_t i = 0; i < numberOfBlocks; i++)
+         {
+         if (!pending.isSet(i))
+            continue;
+
+         pending.reset(i);
+         numVisits++;
+         TR::Block *block = order[i]->asBlock();
+         int32_t blockNum = block->getNumber();
+
+         if (blockNum == 0)
+            _currentInSetInfo->empty();
+         else
+            {
+            initializeInfo(_currentInSetInfo);
+            for (auto pred = block->getPredecessors().begin(); pred != block->getPredecessors().end(); ++pred)
+               compose(_currentInSetInfo, regularOutSetInfo[(*pred)->getFrom()->getNumber()]);
+            for (auto pred = block->getExceptionPredecessors().begin(); pred != block->getExceptionPredecessors().end(); ++pred)
+               compose(_currentInSetInfo, exceptionOutSetInfo[(*pred)->getFrom()->getNumber()]);
+            }
+
+         if (!this->_blockAnalysisInfo[blockNum])
+            this->allocateBlockInfoContainer(&this->_blockAnalysisInfo[blockNum], _currentInSetInfo);
+         this->copyFromInto(_currentInSetInfo, this->_blockAnalysisInfo[blockNum]);
+
+         if (blockNum == 0)
+            {
+            this->copyFromInto(_currentInSetInfo, this->_regularInfo);
+            this->copyFromInto(_currentInSetInfo, this->_exceptionInfo);
+            analyzeBlockZeroStructure(NULL);
+            }
+         else
+            {
+            this->transferInto(_currentInSetInfo, this->_regularGenSetInfo[blockNum], this->_regularKillSetInfo[blockNum], this->_regularInfo);
+            this->transferInto(_currentInSetInfo, this->_exceptionGenSetInfo[blockNum], this->_exceptionKillSetInfo[blockNum], this->_exceptionInfo);
+            }
+
+         bool regularChanged = regularOutSetInfo[blockNum]->assignAndCheckForChange(*this->_regularInfo);
+         bool exceptionChanged = exceptionOutSetInfo[blockNum]->assignAndCheckForChange(*this->_exceptionInfo);
+         if (regularChanged)
+            {
+            for (auto succ = block->getSuccessors().begin(); succ != block->getSuccessors().end(); ++succ)
+               pending.set(orderIndex[(*succ)->getTo()->getNumber()]);
+            }
+         if (exceptionChanged)
+            {
+            for (auto succ = block->getExceptionSuccessors().begin(); succ != block->getExceptionSuccessors().end(); ++succ)
+               pending.set(orderIndex[(*succ)->getTo()->getNumber()]);
+            }
+
+         if (this->traceBVA())
+            {
+            traceMsg(this->comp(), "\nIn Set Info for block_%d is : \n", blockNum);
+            this->_blockAnalysisInfo[blockNum]->print(this->comp());
+            traceMsg(this->comp(), "\nOut Set Info for block_%d is : \n", blockNum);
+            regularOutSetInfo[blockNum]->print(this->comp());
+            traceMsg(this->comp(), "\n");
+            }
+         }
+      }
+
+   if (this->traceBVA())
+      traceMsg(this->comp(), "\nSolved on the CFG in %d passes visiting %d blocks out of %d\n", numPasses, numVisits, numberOfBlocks);
    }
 
 
@@ -210,6 +210,20 @@ class TR_DataFlowAnalysis
          to->empty();
       }
 
+   // Set to to gen | (in & ~kill) in one pass; any of the sets may be NULL
+   //
+   template<class Container>static void transferInto(Container *in, Container *gen, Container *kill, Container *to)
+      {
+      if (in)
+         to->transfer(*in, gen, kill);
+      else
+         {
+         to->empty();
+         if (gen)
+            *to |= *gen;
+         }
+      }
+
    TR_ScratchList<TR_StructureSubGraphNode> _analysisQueue;
    TR_ScratchList<uint8_t> _changedSetsQueue;
    bool _analysisInterrupted;
@@ -248,6 +262,7 @@ template<class Container>class TR_BasicDFSetAnalysis<Container *> :
       _exceptionKillSetInfo = 0;
       _blockAnalysisInfo    = 0;
       _hasImproperRegion    = false;
+      _solveOnCFG           = false;
       _nodesInCycle         = NULL;
       }
 
@@ -283,6 +298,20 @@ template<class Container>class TR_BasicDFSetAnalysis<Container *> :
 
    virtual void initializeDFSetAnalysis() = 0;
 
+   // Analyses with gen and kill sets can be solved by a worklist over the
+   // blocks of the CFG instead of over the structure. This is done when there
+   // is no structure, when the structure has improper regions, or when asked
+   // for by option.
+   //
+   bool canSolveOnCFG(TR_Structure *rootStructure);
+   virtual void solveOnCFG() = 0;
+
+   // Fill order with the blocks of the CFG in reverse post-order, followed by
+   // any blocks not reachable from the start, and orderIndex with the position
+   // of each block number in order. Returns the number of blocks.
+   //
+   int32_t computeReversePostOrder(TR::CFGNode **order, int32_t *orderIndex);
+
    class TR_ContainerNodeNumberPair : public TR_Link<TR_ContainerNodeNumberPair>
       {
       public:
@@ -356,6 +385,7 @@ template<class Container>class TR_BasicDFSetAnalysis<Container *> :
    int32_t _maxReferenceNumber;
    TR::Node **_supportedNodesAsArray;
    bool _hasImproperRegion;
+   bool _solveOnCFG;
    };
 
 
@@ -398,6 +428,7 @@ template<class Container>class TR_ForwardDFSetAnalysis<Container *> :
    virtual void analyzeNode(TR::Node *, vcount_t, TR_BlockStructure *, Container *);
 
    bool analyzeNodeIfPredecessorsAnalyzed(TR_RegionStructure *, TR_BitVector &);
+   virtual void solveOnCFG();
 
    virtual void initializeGenAndKillSetInfo(TR_RegionStructure *, TR_BitVector &);
    virtual void initializeGenAndKillSetInfoForRegion(TR_RegionStructure *);
@@ -540,6 +571,7 @@ template<class Container>class TR_BackwardDFSetAnalysis<Container *> :
    virtual void analyzeNode(TR::Node *, vcount_t, TR_BlockStructure *, Container *);
 
    bool analyzeNodeIfSuccessorsAnalyzed(TR_RegionStructure *, TR_BitVector &, TR_BitVector &);
+   virtual void solveOnCFG();
 
    virtual void initializeGenAndKillSetInfo(TR_RegionStructure *, TR_BitVector &, TR_BitVector &, bool);
    virtual void initializeGenAndKillSetInfoForRegion(TR_RegionStructure *);
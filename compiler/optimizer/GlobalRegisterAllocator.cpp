@@ -333,6 +333,17 @@ TR_GlobalRegisterAllocator::walkTreesAndCollectSymbolDataTypes()
       }
    }
 
+bool
+TR_GlobalRegisterAllocator::shouldPerform()
+   {
+   // The code generator allocates registers by linear scan instead
+   //
+   if (comp()->cg()->getUseLinearScanRegisterAllocation())
+      return false;
+
+   return true;
+   }
+
 int32_t
 TR_GlobalRegisterAllocator::perform()
    {
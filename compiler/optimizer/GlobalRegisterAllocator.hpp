@@ -142,6 +142,7 @@ public:
       return new (manager->allocator()) TR_GlobalRegisterAllocator(manager);
       }
 
+   virtual bool shouldPerform();
    virtual int32_t perform();
    virtual const char * optDetailString() const throw();
 
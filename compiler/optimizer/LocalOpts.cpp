@@ -8116,15 +8116,7 @@ TR_ColdBlockOutlining::perform()
 
 static bool coldBlock(TR::Block *block, TR::Compilation *comp)
    {
-   int32_t lowCFGFrequency = comp->getFlowGraph()->getLowFrequency();
-   bool    retValue        = false;
-
-
-
-      retValue = (block->isCold() || (comp->getFlowGraph() &&
-                              (comp->getFlowGraph()->getMaxFrequency()>(lowCFGFrequency<<2)) &&
-                               block->getFrequency()<=lowCFGFrequency));
-   return retValue;
+   return block->isCold() || block->isRare(comp);
    }
 
 
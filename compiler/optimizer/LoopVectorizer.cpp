@@ -0,0 +1,634 @@
+/*******************************************************************************
+ * Copyright (c) 2020, 2020 IBM Corp. and others
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at https://www.eclipse.org/legal/epl-2.0/
+ * or the Apache License, Version 2.0 which accompanies this distribution and
+ * is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following
+ * Secondary Licenses when the conditions for such availability set
+ * forth in the Eclipse Public License, v. 2.0 are satisfied: GNU
+ * General Public License, version 2 with the GNU Classpath
+ * Exception [1] and GNU General Public License, version 2 with the
+ * OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] http://openjdk.java.net/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
+ *******************************************************************************/
+
+#include "optimizer/LoopVectorizer.hpp"
+
+#include <stdint.h>
+#include "codegen/CodeGenerator.hpp"
+#include "compile/Compilation.hpp"
+#include "compile/SymbolReferenceTable.hpp"
+#include "env/CompilerEnv.hpp"
+#include "env/TRMemory.hpp"
+#include "il/Block.hpp"
+#include "il/DataTypes.hpp"
+#include "il/ILOpCodes.hpp"
+#include "il/ILOps.hpp"
+#include "il/Node.hpp"
+#include "il/Node_inlines.hpp"
+#include "il/Symbol.hpp"
+#include "il/SymbolReference.hpp"
+#include "il/TreeTop.hpp"
+#include "il/TreeTop_inlines.hpp"
+#include "infra/Cfg.hpp"
+#include "infra/CfgEdge.hpp"
+#include "infra/List.hpp"
+#include "optimizer/InductionVariable.hpp"
+#include "optimizer/Optimization_inlines.hpp"
+#include "optimizer/Optimizer.hpp"
+#include "optimizer/Structure.hpp"
+
+#define OPT_DETAILS "O^O LOOP VECTORIZER: "
+
+/**
+ * All IL vector types are 128 bits wide
+ */
+#define VECTOR_LENGTH_IN_BYTES 16
+
+TR_LoopVectorizer::TR_LoopVectorizer(TR::OptimizationManager *manager)
+   : TR::Optimization(manager)
+   {}
+
+bool
+TR_LoopVectorizer::shouldPerform()
+   {
+   if (!cg()->getSupportsAutoSIMD())
+      {
+      if (trace())
+         traceMsg(comp(), "Code generator does not support vector IL -- returning from loop vectorization.\n");
+      return false;
+      }
+
+   // The array address arithmetic recognized below is the 64-bit aladd form
+   //
+   if (!comp()->target().is64Bit())
+      return false;
+
+   if (!comp()->mayHaveLoops())
+      return false;
+
+   return true;
+   }
+
+int32_t
+TR_LoopVectorizer::perform()
+   {
+   TR_Structure *rootStructure = comp()->getFlowGraph()->getStructure();
+   if (rootStructure == NULL)
+      return 0;
+
+   TR::StackMemoryRegion stackMemoryRegion(*trMemory());
+
+   TR_ScratchList<LoopInfo> candidates(trMemory());
+   collectCandidateLoops(rootStructure, candidates);
+   if (candidates.isEmpty())
+      return 0;
+
+   bool transformed = false;
+   ListIterator<LoopInfo> it(&candidates);
+   for (LoopInfo *info = it.getFirst(); info; info = it.getNext())
+      {
+      if (!performTransformation(comp(), "%sVectorizing loop %d with %d x %s elements per iteration\n",
+            OPT_DETAILS, info->_loop->getNumber(), info->_vectorLength, info->_elementType.toString()))
+         continue;
+
+      if (!transformed)
+         {
+         comp()->getFlowGraph()->setStructure(NULL);
+         transformed = true;
+         }
+
+      vectorizeLoop(info);
+      }
+
+   if (transformed)
+      {
+      optimizer()->setUseDefInfo(NULL);
+      optimizer()->setValueNumberInfo(NULL);
+      optimizer()->setAliasSetsAreValid(false);
+
+      // Canonicalize the new vector and scalar loops for the loop optimizations that follow
+      //
+      requestOpt(OMR::loopCanonicalization);
+      requestOpt(OMR::inductionVariableAnalysis);
+      }
+
+   return 1;
+   }
+
+void
+TR_LoopVectorizer::collectCandidateLoops(TR_Structure *str, List<LoopInfo> &candidates)
+   {
+   TR_RegionStructure *region = str->asRegion();
+   if (region == NULL)
+      return;
+
+   TR_RegionStructure::Cursor it(*region);
+   for (TR_StructureSubGraphNode *node = it.getCurrent(); node; node = it.getNext())
+      collectCandidateLoops(node->getStructure(), candidates);
+
+   if (!region->isNaturalLoop())
+      return;
+
+   LoopInfo *info = analyzeLoop(region);
+   if (info != NULL)
+      candidates.add(info);
+   }
+
+TR_LoopVectorizer::LoopInfo *
+TR_LoopVectorizer::analyzeLoop(TR_RegionStructure *loop)
+   {
+   TR_ScratchList<TR::Block> blocksInLoop(trMemory());
+   loop->getBlocks(&blocksInLoop);
+   if (blocksInLoop.getSize() != 1)
+      {
+      if (trace())
+         traceMsg(comp(), "Reject loop %d ==> body is not a single block\n", loop->getNumber());
+      return NULL;
+      }
+
+   TR_PrimaryInductionVariable *piv = loop->getPrimaryInductionVariable();
+   if (piv == NULL || piv->getDeltaOnBackEdge() != 1 || piv->getSymRef()->getSymbol()->getDataType() != TR::Int32)
+      {
+      if (trace())
+         traceMsg(comp(), "Reject loop %d ==> no Int32 primary induction variable with unit stride\n", loop->getNumber());
+      return NULL;
+      }
+
+   TR::Block *header = loop->getEntryBlock();
+   if (header->hasExceptionPredecessors() || header->hasExceptionSuccessors())
+      {
+      if (trace())
+         traceMsg(comp(), "Reject loop %d ==> exception edges\n", loop->getNumber());
+      return NULL;
+      }
+
+   TR::Block *preHeader = NULL;
+   for (auto e = header->getPredecessors().begin(); e != header->getPredecessors().end(); ++e)
+      {
+      TR::Block *from = toBlock((*e)->getFrom());
+      if (from == header)
+         continue;
+      if (preHeader != NULL)
+         return NULL;
+      preHeader = from;
+      }
+
+   if (preHeader == NULL ||
+       preHeader->getEntry() == NULL ||
+       !preHeader->getStructureOf() ||
+       !preHeader->getStructureOf()->isLoopInvariantBlock() ||
+       preHeader->getNextBlock() != header ||
+       preHeader->getLastRealTreeTop()->getNode()->getOpCode().isBranch())
+      {
+      if (trace())
+         traceMsg(comp(), "Reject loop %d ==> no pre-header falling through to the loop\n", loop->getNumber());
+      return NULL;
+      }
+
+   // The loop must end in a bottom test of the incremented induction variable
+   //
+   TR::TreeTop *branchTree = header->getLastRealTreeTop();
+   TR::Node *branch = branchTree->getNode();
+   TR::Block *exit = header->getNextBlock();
+   if (branch->getOpCodeValue() != TR::ificmplt ||
+       branch->getBranchDestination() != header->getEntry() ||
+       exit == NULL)
+      {
+      if (trace())
+         traceMsg(comp(), "Reject loop %d ==> loop test is not i < n branching back to the header\n", loop->getNumber());
+      return NULL;
+      }
+
+   LoopInfo *info = (LoopInfo *) trMemory()->allocateStackMemory(sizeof(LoopInfo));
+   info->_loop = loop;
+   info->_preHeader = preHeader;
+   info->_header = header;
+   info->_exit = exit;
+   info->_ivSymRef = piv->getSymRef();
+   info->_ivStoreTree = branchTree->getPrevTreeTop();
+   info->_bound = branch->getSecondChild();
+   info->_elementType = TR::NoType;
+   info->_vectorLength = 0;
+   info->_numArrayBases = 0;
+
+   TR::Node *ivStore = info->_ivStoreTree->getNode();
+   if (ivStore->getOpCodeValue() != TR::istore ||
+       ivStore->getSymbolReference() != info->_ivSymRef ||
+       !isIncrementOfInductionVariable(info, ivStore->getFirstChild()))
+      {
+      if (trace())
+         traceMsg(comp(), "Reject loop %d ==> induction variable is not incremented just before the loop test\n", loop->getNumber());
+      return NULL;
+      }
+
+   TR::Node *tested = branch->getFirstChild();
+   bool testsIncrementedValue = tested == ivStore->getFirstChild() ||
+                                (tested->getOpCodeValue() == TR::iload && tested->getSymbolReference() == info->_ivSymRef);
+   if (!testsIncrementedValue || !isLoopInvariant(info, info->_bound))
+      {
+      if (trace())
+         traceMsg(comp(), "Reject loop %d ==> loop test does not compare the induction variable to an invariant\n", loop->getNumber());
+      return NULL;
+      }
+
+   // Every array store in the loop must have the same element type; it sets the vector length
+   //
+   for (TR::TreeTop *tt = header->getFirstRealTreeTop(); tt != info->_ivStoreTree; tt = tt->getNextTreeTop())
+      {
+      TR::Node *node = tt->getNode();
+      if (node->getOpCode().isStoreIndirect() && node->getSymbol()->isArrayShadowSymbol())
+         {
+         info->_elementType = node->getDataType();
+         break;
+         }
+      }
+
+   if (info->_elementType == TR::NoType ||
+       info->_elementType.isVector() ||
+       !cg()->getSupportsOpCodeForAutoSIMD(TR::vstorei, info->_elementType) ||
+       !cg()->getSupportsOpCodeForAutoSIMD(TR::vloadi, info->_elementType))
+      {
+      if (trace())
+         traceMsg(comp(), "Reject loop %d ==> no array store of a vectorizable type\n", loop->getNumber());
+      return NULL;
+      }
+
+   info->_vectorLength = VECTOR_LENGTH_IN_BYTES / TR::DataType::getSize(info->_elementType);
+
+   for (TR::TreeTop *tt = header->getFirstRealTreeTop(); tt != info->_ivStoreTree; tt = tt->getNextTreeTop())
+      {
+      TR::Node *node = tt->getNode();
+      bool vectorizable = false;
+
+      if (node->getOpCodeValue() == TR::treetop)
+         {
+         vectorizable = isVectorizableExpression(info, node->getFirstChild());
+         }
+      else if (node->getOpCode().isStoreIndirect() && node->getSymbol()->isArrayShadowSymbol())
+         {
+         vectorizable = node->getDataType() == info->_elementType &&
+                        isUnitStrideArrayAccess(info, node) &&
+                        isVectorizableExpression(info, node->getSecondChild());
+         }
+
+      if (!vectorizable)
+         {
+         if (trace())
+            traceMsg(comp(), "Reject loop %d ==> tree n%dn cannot be vectorized\n", loop->getNumber(), node->getGlobalIndex());
+         return NULL;
+         }
+      }
+
+   if (trace())
+      traceMsg(comp(), "Loop %d is a vectorization candidate: %d x %s, %d array bases\n",
+         loop->getNumber(), info->_vectorLength, info->_elementType.toString(), info->_numArrayBases);
+
+   return info;
+   }
+
+/**
+ * A constant, or a direct load of an auto or parm other than the induction variable.
+ * The body of a candidate loop only stores to array elements and to the induction
+ * variable, so such loads cannot change inside the loop.
+ */
+bool
+TR_LoopVectorizer::isLoopInvariant(LoopInfo *info, TR::Node *node)
+   {
+   if (node->getOpCode().isLoadConst())
+      return true;
+
+   return node->getOpCode().isLoadVarDirect() &&
+          node->getSymbol()->isAutoOrParm() &&
+          node->getSymbolReference() != info->_ivSymRef;
+   }
+
+bool
+TR_LoopVectorizer::isIncrementOfInductionVariable(LoopInfo *info, TR::Node *node)
+   {
+   int32_t increment;
+   if (node->getOpCodeValue() == TR::iadd)
+      increment = 1;
+   else if (node->getOpCodeValue() == TR::isub)
+      increment = -1;
+   else
+      return false;
+
+   TR::Node *ivLoad = node->getFirstChild();
+   TR::Node *constant = node->getSecondChild();
+   return ivLoad->getOpCodeValue() == TR::iload &&
+          ivLoad->getSymbolReference() == info->_ivSymRef &&
+          constant->getOpCodeValue() == TR::iconst &&
+          constant->getInt() == increment;
+   }
+
+/**
+ * Matches an indirect array load or store of `base[i]`, i.e. an address of the form
+ *
+ *    aladd
+ *      base
+ *      lmul
+ *        i2l
+ *          iload i
+ *        lconst elementSize
+ *
+ * where the multiply is omitted for single byte elements.
+ */
+bool
+TR_LoopVectorizer::isUnitStrideArrayAccess(LoopInfo *info, TR::Node *node)
+   {
+   TR::Node *address = node->getFirstChild();
+   if (address->getOpCodeValue() != TR::aladd)
+      return false;
+
+   TR::Node *base = address->getFirstChild();
+   bool isInvariantBase = base->getOpCodeValue() == TR::loadaddr ||
+                          (base->getOpCodeValue() == TR::aload && isLoopInvariant(info, base));
+   if (!isInvariantBase)
+      return false;
+
+   TR::Node *index = address->getSecondChild();
+   int32_t elementSize = TR::DataType::getSize(info->_elementType);
+   if (index->getOpCodeValue() == TR::lmul)
+      {
+      TR::Node *scale = index->getSecondChild();
+      if (scale->getOpCodeValue() != TR::lconst || scale->getLongInt() != elementSize)
+         return false;
+      index = index->getFirstChild();
+      }
+   else if (elementSize != 1)
+      {
+      return false;
+      }
+
+   if (index->getOpCodeValue() != TR::i2l)
+      return false;
+
+   TR::Node *ivLoad = index->getFirstChild();
+   if (ivLoad->getOpCodeValue() != TR::iload || ivLoad->getSymbolReference() != info->_ivSymRef)
+      return false;
+
+   return recordArrayBase(info, base, node->getOpCode().isStore());
+   }
+
+bool
+TR_LoopVectorizer::isVectorizableExpression(LoopInfo *info, TR::Node *node)
+   {
+   if (node->getDataType() != info->_elementType)
+      return false;
+
+   if (node->getOpCode().isLoadIndirect())
+      return node->getSymbol()->isArrayShadowSymbol() && isUnitStrideArrayAccess(info, node);
+
+   if (isLoopInvariant(info, node))
+      return cg()->getSupportsOpCodeForAutoSIMD(TR::vsplats, info->_elementType);
+
+   TR::ILOpCodes vectorOp = TR::ILOpCode::convertScalarToVector(node->getOpCodeValue());
+   switch (vectorOp)
+      {
+      case TR::vadd:
+      case TR::vsub:
+      case TR::vmul:
+      case TR::vdiv:
+      case TR::vneg:
+      case TR::vand:
+      case TR::vor:
+      case TR::vxor:
+         break;
+      default:
+         return false;
+      }
+
+   if (!cg()->getSupportsOpCodeForAutoSIMD(vectorOp, info->_elementType))
+      return false;
+
+   for (int32_t i = 0; i < node->getNumChildren(); i++)
+      {
+      if (!isVectorizableExpression(info, node->getChild(i)))
+         return false;
+      }
+
+   return true;
+   }
+
+bool
+TR_LoopVectorizer::recordArrayBase(LoopInfo *info, TR::Node *base, bool isStored)
+   {
+   for (int32_t i = 0; i < info->_numArrayBases; i++)
+      {
+      ArrayBase &arrayBase = info->_arrayBases[i];
+      if (arrayBase._base->getOpCodeValue() == base->getOpCodeValue() &&
+          arrayBase._base->getSymbolReference() == base->getSymbolReference())
+         {
+         arrayBase._isStored |= isStored;
+         return true;
+         }
+      }
+
+   if (info->_numArrayBases == maxArrayBases)
+      return false;
+
+   info->_arrayBases[info->_numArrayBases]._base = base;
+   info->_arrayBases[info->_numArrayBases]._isStored = isStored;
+   info->_numArrayBases++;
+   return true;
+   }
+
+/**
+ * Two different array bases need a runtime check if either one is stored to,
+ * unless both are distinct local arrays, which never overlap.
+ */
+bool
+TR_LoopVectorizer::needsOverlapCheck(ArrayBase &first, ArrayBase &second)
+   {
+   if (!first._isStored && !second._isStored)
+      return false;
+
+   return first._base->getOpCodeValue() != TR::loadaddr ||
+          second._base->getOpCodeValue() != TR::loadaddr;
+   }
+
+TR::Block *
+TR_LoopVectorizer::createBlockAfter(TR::Block *prevBlock, int32_t frequency)
+   {
+   TR::Block *block = TR::Block::createEmptyBlock(prevBlock->getEntry()->getNode(), comp(), frequency, prevBlock);
+   comp()->getFlowGraph()->addNode(block);
+
+   TR::TreeTop *nextTree = prevBlock->getExit()->getNextTreeTop();
+   prevBlock->getExit()->join(block->getEntry());
+   block->getExit()->join(nextTree);
+   return block;
+   }
+
+/**
+ * Create a fresh `base + i * elementSize` address for a vector access.  The induction
+ * variable is reloaded so that the address tracks the vector loop's own updates.
+ */
+TR::Node *
+TR_LoopVectorizer::createVectorAddress(LoopInfo *info, TR::Node *address)
+   {
+   TR::Node *base = address->getFirstChild()->duplicateTree();
+   TR::Node *index = TR::Node::create(address, TR::i2l, 1, TR::Node::createLoad(address, info->_ivSymRef));
+
+   int32_t elementSize = TR::DataType::getSize(info->_elementType);
+   if (elementSize > 1)
+      index = TR::Node::create(address, TR::lmul, 2, index, TR::Node::lconst(address, elementSize));
+
+   return TR::Node::create(address, TR::aladd, 2, base, index);
+   }
+
+TR::Node *
+TR_LoopVectorizer::createVectorExpression(LoopInfo *info, TR::Node *node, VectorNodeMap &vectorNodes)
+   {
+   VectorNodeMap::iterator existing = vectorNodes.find(node);
+   if (existing != vectorNodes.end())
+      return existing->second;
+
+   TR::DataType vectorType = info->_elementType.scalarToVector();
+   TR::Node *vectorNode = NULL;
+
+   if (node->getOpCode().isLoadIndirect())
+      {
+      TR::Node *address = createVectorAddress(info, node->getFirstChild());
+      TR::SymbolReference *symRef = comp()->getSymRefTab()->findOrCreateArrayShadowSymbolRef(vectorType, address);
+      vectorNode = TR::Node::createWithSymRef(TR::vloadi, 1, 1, address, symRef);
+      }
+   else if (isLoopInvariant(info, node))
+      {
+      vectorNode = TR::Node::create(node, TR::vsplats, 1, node->duplicateTree());
+      }
+   else
+      {
+      TR::ILOpCodes vectorOp = TR::ILOpCode::convertScalarToVector(node->getOpCodeValue());
+      TR::Node *firstChild = createVectorExpression(info, node->getFirstChild(), vectorNodes);
+      if (node->getNumChildren() == 1)
+         vectorNode = TR::Node::create(node, vectorOp, 1, firstChild);
+      else
+         vectorNode = TR::Node::create(node, vectorOp, 2, firstChild,
+                                       createVectorExpression(info, node->getSecondChild(), vectorNodes));
+      }
+
+   vectorNodes[node] = vectorNode;
+   return vectorNode;
+   }
+
+void
+TR_LoopVectorizer::vectorizeLoop(LoopInfo *info)
+   {
+   TR::CFG *cfg = comp()->getFlowGraph();
+   TR::Block *preHeader = info->_preHeader;
+   TR::Block *header = info->_header;
+   TR::Node *bcNode = header->getLastRealTreeTop()->getNode();
+   int32_t preHeaderFrequency = preHeader->getFrequency();
+   int32_t vectorLength = info->_vectorLength;
+
+   // Lay the new blocks out between the pre-header and the scalar loop
+   //
+   TR::Block *scalarPreHeader = createBlockAfter(preHeader, preHeaderFrequency);
+   TR::Block *lastBlock = preHeader;
+
+   // Enough iterations remain for at least one vector iteration: n - i >= VL
+   //
+   TR::Block *tripCountGuard = createBlockAfter(lastBlock, preHeaderFrequency);
+   TR::Node *remaining = TR::Node::create(bcNode, TR::lsub, 2,
+                                          TR::Node::create(bcNode, TR::i2l, 1, info->_bound->duplicateTree()),
+                                          TR::Node::create(bcNode, TR::i2l, 1, TR::Node::createLoad(bcNode, info->_ivSymRef)));
+   tripCountGuard->append(TR::TreeTop::create(comp(),
+      TR::Node::createif(TR::iflcmplt, remaining, TR::Node::lconst(bcNode, vectorLength), scalarPreHeader->getEntry())));
+   cfg->addEdge(preHeader, tripCountGuard);
+   cfg->addEdge(tripCountGuard, scalarPreHeader);
+   lastBlock = tripCountGuard;
+
+   // Arrays that are written must not overlap any other array accessed in the loop by
+   // less than a vector: 0 < |a - b| < VL * elementSize
+   //
+   int32_t vectorBytes = vectorLength * TR::DataType::getSize(info->_elementType);
+   for (int32_t i = 0; i < info->_numArrayBases; i++)
+      {
+      for (int32_t j = i + 1; j < info->_numArrayBases; j++)
+         {
+         if (!needsOverlapCheck(info->_arrayBases[i], info->_arrayBases[j]))
+            continue;
+
+         TR::Block *overlapGuard = createBlockAfter(lastBlock, preHeaderFrequency);
+         TR::Node *distance = TR::Node::create(bcNode, TR::lsub, 2,
+                                               TR::Node::create(bcNode, TR::a2l, 1, info->_arrayBases[i]._base->duplicateTree()),
+                                               TR::Node::create(bcNode, TR::a2l, 1, info->_arrayBases[j]._base->duplicateTree()));
+         TR::Node *distanceLessOne = TR::Node::create(bcNode, TR::lsub, 2,
+                                                      TR::Node::create(bcNode, TR::labs, 1, distance),
+                                                      TR::Node::lconst(bcNode, 1));
+         overlapGuard->append(TR::TreeTop::create(comp(),
+            TR::Node::createif(TR::iflucmplt, distanceLessOne, TR::Node::lconst(bcNode, vectorBytes - 1), scalarPreHeader->getEntry())));
+         cfg->addEdge(lastBlock, overlapGuard);
+         cfg->addEdge(overlapGuard, scalarPreHeader);
+         lastBlock = overlapGuard;
+         }
+      }
+
+   // The vector loop body: the array trees of the scalar body rewritten as vector IL
+   //
+   TR::Block *vectorBody = createBlockAfter(lastBlock, header->getFrequency());
+   cfg->addEdge(lastBlock, vectorBody);
+
+   VectorNodeMap vectorNodes(std::less<TR::Node *>(), trMemory()->currentStackRegion());
+   TR::DataType vectorType = info->_elementType.scalarToVector();
+   for (TR::TreeTop *tt = header->getFirstRealTreeTop(); tt != info->_ivStoreTree; tt = tt->getNextTreeTop())
+      {
+      TR::Node *node = tt->getNode();
+      TR::Node *vectorTree;
+      if (node->getOpCodeValue() == TR::treetop)
+         {
+         vectorTree = TR::Node::create(node, TR::treetop, 1, createVectorExpression(info, node->getFirstChild(), vectorNodes));
+         }
+      else
+         {
+         TR::Node *address = createVectorAddress(info, node->getFirstChild());
+         TR::Node *value = createVectorExpression(info, node->getSecondChild(), vectorNodes);
+         TR::SymbolReference *symRef = comp()->getSymRefTab()->findOrCreateArrayShadowSymbolRef(vectorType, address);
+         vectorTree = TR::Node::createWithSymRef(TR::vstorei, 2, 2, address, value, symRef);
+         }
+      vectorBody->append(TR::TreeTop::create(comp(), vectorTree));
+      }
+
+   // i = i + VL; if (i + VL <= n) goto vectorBody
+   //
+   TR::Node *increment = TR::Node::create(bcNode, TR::iadd, 2,
+                                          TR::Node::createLoad(bcNode, info->_ivSymRef),
+                                          TR::Node::iconst(bcNode, vectorLength));
+   vectorBody->append(TR::TreeTop::create(comp(), TR::Node::createStore(bcNode, info->_ivSymRef, increment)));
+   TR::Node *nextEnd = TR::Node::create(bcNode, TR::ladd, 2,
+                                        TR::Node::create(bcNode, TR::i2l, 1, TR::Node::createLoad(bcNode, info->_ivSymRef)),
+                                        TR::Node::lconst(bcNode, vectorLength));
+   vectorBody->append(TR::TreeTop::create(comp(),
+      TR::Node::createif(TR::iflcmple, nextEnd, TR::Node::create(bcNode, TR::i2l, 1, info->_bound->duplicateTree()), vectorBody->getEntry())));
+   cfg->addEdge(vectorBody, vectorBody);
+
+   // Skip the scalar epilogue if the vector loop covered every iteration
+   //
+   TR::Block *vectorExit = createBlockAfter(vectorBody, preHeaderFrequency);
+   vectorExit->append(TR::TreeTop::create(comp(),
+      TR::Node::createif(TR::ificmpge, TR::Node::createLoad(bcNode, info->_ivSymRef), info->_bound->duplicateTree(), info->_exit->getEntry())));
+   cfg->addEdge(vectorBody, vectorExit);
+   cfg->addEdge(vectorExit, info->_exit);
+   cfg->addEdge(vectorExit, scalarPreHeader);
+
+   cfg->addEdge(scalarPreHeader, header);
+   cfg->removeEdge(preHeader, header);
+
+   if (trace())
+      comp()->dumpMethodTrees("Trees after vectorizing loop");
+   }
+
+const char *
+TR_LoopVectorizer::optDetailString() const throw()
+   {
+   return "O^O LOOP VECTORIZER: ";
+   }
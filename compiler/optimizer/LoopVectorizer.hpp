@@ -0,0 +1,133 @@
+/*******************************************************************************
+ * Copyright (c) 2020, 2020 IBM Corp. and others
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at https://www.eclipse.org/legal/epl-2.0/
+ * or the Apache License, Version 2.0 which accompanies this distribution and
+ * is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following
+ * Secondary Licenses when the conditions for such availability set
+ * forth in the Eclipse Public License, v. 2.0 are satisfied: GNU
+ * General Public License, version 2 with the GNU Classpath
+ * Exception [1] and GNU General Public License, version 2 with the
+ * OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] http://openjdk.java.net/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
+ *******************************************************************************/
+
+#ifndef LOOPVECTORIZER_INCL
+#define LOOPVECTORIZER_INCL
+
+#include <map>
+#include <stdint.h>
+#include "env/TRMemory.hpp"
+#include "il/DataTypes.hpp"
+#include "infra/List.hpp"
+#include "optimizer/Optimization.hpp"
+#include "optimizer/OptimizationManager.hpp"
+
+class TR_RegionStructure;
+class TR_Structure;
+namespace TR { class Block; }
+namespace TR { class Node; }
+namespace TR { class SymbolReference; }
+namespace TR { class TreeTop; }
+
+/**
+ * Loop auto-vectorization.
+ *
+ * Rewrites canonicalized innermost counted loops whose body is a single block of
+ * unit stride array stores into a loop that processes a full vector register of
+ * elements per iteration.  The original scalar loop is kept as the epilogue for
+ * the remaining iterations and as the fallback taken when the arrays accessed in
+ * the loop overlap in a way that would make the vector loop observable.
+ *
+ * The loops handled have the form
+ *
+ *    preHeader:
+ *    header:      a[i] = f(b[i], c[i], invariant) ...
+ *                 i = i + 1
+ *                 if (i < n) goto header
+ *    exit:
+ *
+ * and are transformed into
+ *
+ *    preHeader:
+ *    guards:      if (n - i < VL) goto scalarPreHeader
+ *                 if (0 < |a - b| < VL * elementSize) goto scalarPreHeader ...
+ *    vectorBody:  a[i:VL] = f(b[i:VL], c[i:VL], splat(invariant)) ...
+ *                 i = i + VL
+ *                 if (i + VL <= n) goto vectorBody
+ *    vectorExit:  if (i >= n) goto exit
+ *    scalarPreHeader:
+ *    header:      original scalar loop
+ *    exit:
+ */
+class TR_LoopVectorizer : public TR::Optimization
+   {
+   public:
+   TR_LoopVectorizer(TR::OptimizationManager *manager);
+   static TR::Optimization *create(TR::OptimizationManager *manager)
+      {
+      return new (manager->allocator()) TR_LoopVectorizer(manager);
+      }
+
+   virtual bool shouldPerform();
+   virtual int32_t perform();
+   virtual const char * optDetailString() const throw();
+
+   private:
+
+   enum
+      {
+      maxArrayBases = 8
+      };
+
+   /**
+    * A loop invariant array base address accessed in the loop body
+    */
+   struct ArrayBase
+      {
+      TR::Node *_base;
+      bool _isStored;
+      };
+
+   struct LoopInfo
+      {
+      TR_RegionStructure *_loop;
+      TR::Block *_preHeader;
+      TR::Block *_header;
+      TR::Block *_exit;
+      TR::TreeTop *_ivStoreTree;
+      TR::SymbolReference *_ivSymRef;
+      TR::Node *_bound;
+      TR::DataType _elementType;
+      int32_t _vectorLength;
+      int32_t _numArrayBases;
+      ArrayBase _arrayBases[maxArrayBases];
+      };
+
+   typedef TR::typed_allocator<std::pair<TR::Node * const, TR::Node *>, TR::Region &> VectorNodeMapAllocator;
+   typedef std::map<TR::Node *, TR::Node *, std::less<TR::Node *>, VectorNodeMapAllocator> VectorNodeMap;
+
+   void collectCandidateLoops(TR_Structure *str, List<LoopInfo> &candidates);
+   LoopInfo *analyzeLoop(TR_RegionStructure *loop);
+   bool isLoopInvariant(LoopInfo *info, TR::Node *node);
+   bool isIncrementOfInductionVariable(LoopInfo *info, TR::Node *node);
+   bool isUnitStrideArrayAccess(LoopInfo *info, TR::Node *node);
+   bool isVectorizableExpression(LoopInfo *info, TR::Node *node);
+   bool recordArrayBase(LoopInfo *info, TR::Node *base, bool isStored);
+   bool needsOverlapCheck(ArrayBase &first, ArrayBase &second);
+
+   void vectorizeLoop(LoopInfo *info);
+   TR::Block *createBlockAfter(TR::Block *prevBlock, int32_t frequency);
+   TR::Node *createVectorAddress(LoopInfo *info, TR::Node *address);
+   TR::Node *createVectorExpression(LoopInfo *info, TR::Node *node, VectorNodeMap &vectorNodes);
+   };
+
+#endif
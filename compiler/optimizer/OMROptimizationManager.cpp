@@ -145,7 +145,6 @@ OMR::OptimizationManager::OptimizationManager(TR::Optimizer *o, OptimizationFact
          _flags.set(doesNotRequireAliasSets | verifyTrees | supportsIlGenOptLevel);
          break;
       case OMR::compactLocals:
-         _flags.set(requiresStructure);
          break;
       case OMR::coldBlockMarker:
          _flags.set(doesNotRequireAliasSets | supportsIlGenOptLevel);
@@ -186,6 +185,9 @@ OMR::OptimizationManager::OptimizationManager(TR::Optimizer *o, OptimizationFact
       case OMR::profiledNodeVersioning:
          _flags.set(doesNotRequireAliasSets);
          break;
+      case OMR::loopVectorization:
+         _flags.set(requiresStructure | checkStructure | dumpStructure);
+         break;
       case OMR::stripMining:
          _flags.set(requiresStructure | checkStructure | dumpStructure);
          break;
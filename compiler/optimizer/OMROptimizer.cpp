@@ -89,10 +89,13 @@
 #include "optimizer/LoopCanonicalizer.hpp"
 #include "optimizer/LoopReducer.hpp"
 #include "optimizer/LoopReplicator.hpp"
+#include "optimizer/LoopVectorizer.hpp"
 #include "optimizer/LoopVersioner.hpp"
 #include "optimizer/OrderBlocks.hpp"
 #include "optimizer/RedundantAsyncCheckRemoval.hpp"
 #include "optimizer/Simplifier.hpp"
+#include "optimizer/SparseConditionalConstantPropagation.hpp"
+#include "optimizer/SparseCopyPropagation.hpp"
 #include "optimizer/VirtualGuardCoalescer.hpp"
 #include "optimizer/VirtualGuardHeadMerger.hpp"
 #include "optimizer/Inliner.hpp"
@@ -111,6 +114,7 @@
 #include "optimizer/GlobalRegisterAllocator.hpp"
 #include "optimizer/RecognizedCallTransformer.hpp"
 #include "optimizer/SwitchAnalyzer.hpp"
+#include "env/PhaseProfiler.hpp"
 #include "env/RegionProfiler.hpp"
 
 #if defined (_MSC_VER) && _MSC_VER < 1900
@@ -312,6 +316,8 @@ const OptimizationStrategy partialRedundancyEliminationOpts[] =
    { inductionVariableAnalysis,             IfLoopsAndNotProfiling   },
 #ifdef J9_PROJECT_SPECIFIC
    { SPMDKernelParallelization,          IfLoops },
+#else
+   { loopVectorization,           IfLoopsAndNotProfiling },
 #endif
    { loopStrider,                 IfLoops   },
    { treeSimplification,          IfEnabled },
@@ -810,6 +816,8 @@ OMR::Optimizer::Optimizer(TR::Compilation *comp, TR::ResolvedMethodSymbol *metho
       new (comp->allocator()) TR::OptimizationManager(self(), TR_LoopReducer::create, OMR::loopReduction);
    _opts[OMR::loopReplicator] =
       new (comp->allocator()) TR::OptimizationManager(self(), TR_LoopReplicator::create, OMR::loopReplicator);
+   _opts[OMR::loopVectorization] =
+      new (comp->allocator()) TR::OptimizationManager(self(), TR_LoopVectorizer::create, OMR::loopVectorization);
    _opts[OMR::profiledNodeVersioning] =
       new (comp->allocator()) TR::OptimizationManager(self(), TR_ProfiledNodeVersioning::create, OMR::profiledNodeVersioning);
    _opts[OMR::redundantAsyncCheckRemoval] =
@@ -818,6 +826,10 @@ OMR::Optimizer::Optimizer(TR::Compilation *comp, TR::ResolvedMethodSymbol *metho
       new (comp->allocator()) TR::OptimizationManager(self(), TR_EliminateRedundantGotos::create, OMR::redundantGotoElimination);
    _opts[OMR::rematerialization] =
       new (comp->allocator()) TR::OptimizationManager(self(), TR_Rematerialization::create, OMR::rematerialization);
+   _opts[OMR::sparseConditionalConstantPropagation] =
+      new (comp->allocator()) TR::OptimizationManager(self(), TR_SparseConditionalConstantPropagation::create, OMR::sparseConditionalConstantPropagation);
+   _opts[OMR::sparseCopyPropagation] =
+      new (comp->allocator()) TR::OptimizationManager(self(), TR_SparseCopyPropagation::create, OMR::sparseCopyPropagation);
    _opts[OMR::treesCleansing] =
       new (comp->allocator()) TR::OptimizationManager(self(), TR_CleanseTrees::create, OMR::treesCleansing);
    _opts[OMR::treeSimplification] =
@@ -1245,6 +1257,11 @@ static bool hasMoreThanOneBlock( TR::Compilation *comp)
    return (comp->getStartBlock() && comp->getStartBlock()->getNextBlock());
    }
 
+static bool isLargeMethod(TR::Compilation *comp)
+   {
+   return comp->getNodeCount() > LARGE_METHOD_NODE_COUNT;
+   }
+
 static void breakForTesting(int index)
    {
    static char *optimizerBreakLocationStr = feGetEnv("TR_optimizerBreakLocation");
@@ -1269,6 +1286,7 @@ int32_t OMR::Optimizer::performOptimization(const OptimizationStrategy *optimiza
    TR::OptimizationManager *manager = getOptimization(optNum);
    TR_ASSERT(manager != NULL, "Optimization manager should have been initialized for %s.",
       getOptimizationName(optNum));
+   TR::PhaseProfiler pp(comp(), comp()->trMemory()->heapMemoryRegion(), "opt", getOptimizationName(optNum));
 
    comp()->reportAnalysisPhase(BEFORE_OPTIMIZATION);
    breakForTesting(1010);
@@ -1301,6 +1319,16 @@ int32_t OMR::Optimizer::performOptimization(const OptimizationStrategy *optimiza
             doThisOptimization = true;
          break;
 
+      case IfMoreThanOneBlockAndNotLargeMethod:
+         if (hasMoreThanOneBlock(comp()) && !isLargeMethod(comp()))
+            doThisOptimization = true;
+         break;
+
+      case IfNotLargeMethod:
+         if (!isLargeMethod(comp()))
+            doThisOptimization = true;
+         break;
+
       case IfLoopsMarkLastRun:
          if (comp()->mayHaveLoops())
             doThisOptimization = true;
@@ -1661,6 +1689,7 @@ int32_t OMR::Optimizer::performOptimization(const OptimizationStrategy *optimiza
 
    if (!doThisOptimization)
       {
+      pp.discard();
       if (!manager->requested() &&
           !manager->getRequestedBlocks()->isEmpty())
         {
@@ -1675,15 +1704,14 @@ int32_t OMR::Optimizer::performOptimization(const OptimizationStrategy *optimiza
       bool needTreeDump = false;
       bool needStructureDump = false;
 
-      if (!isEnabled(optNum))
-         return 0;
-
       TR::SimpleRegex * regex = comp()->getOptions()->getDisabledOpts();
-      if (regex && TR::SimpleRegex::match(regex, optIndex))
-         return 0;
-
-      if (regex && TR::SimpleRegex::match(regex, manager->name()))
+      if (!isEnabled(optNum) ||
+          (regex && TR::SimpleRegex::match(regex, optIndex)) ||
+          (regex && TR::SimpleRegex::match(regex, manager->name())))
+         {
+         pp.discard();
          return 0;
+         }
 
       // actually doing optimization
       regex = comp()->getOptions()->getBreakOnOpts();
@@ -88,6 +88,11 @@ namespace OMR
 #define HIGH_LOOP_COUNT 65
 #define VERY_HOT_HIGH_LOOP_COUNT 95
 
+// Methods with more nodes than this are optimized with the sparse analyses
+// in place of the bit vector based ones
+//
+#define LARGE_METHOD_NODE_COUNT 20000
+
 // Optimization Options
 //
 enum
@@ -118,6 +123,8 @@ enum
    IfOneBlock,
    IfEnabledAndMoreThanOneBlock,
    IfEnabledAndMoreThanOneBlockMarkLastRun,
+   IfMoreThanOneBlockAndNotLargeMethod,
+   IfNotLargeMethod,
    IfAOTAndEnabled,
    IfMethodHandleInvokes, // JSR292: Extra analysis required to optimize MethodHandle.invoke
    IfNotQuickStart,
@@ -624,10 +624,8 @@ int32_t TR_OSRDefAnalysis::perform()
          optimizer()->getMethodSymbol()->signature(comp()->trMemory()));
       }
 
-   TR_Structure* rootStructure = TR_RegionAnalysis::getRegions(comp(), optimizer()->getMethodSymbol());
-   optimizer()->getMethodSymbol()->getFlowGraph()->setStructure(rootStructure);
-   TR_ASSERT(rootStructure, "Structure is NULL");
-
+   // Reaching definitions are solved on the CFG when there is no structure
+   //
    if (trace())
       {
       traceMsg(comp(), "Starting OSR reaching definitions analysis\n");
@@ -1291,10 +1289,6 @@ void TR_OSRLiveRangeAnalysis::buildDeadSlotsInfo(TR::Node *node, TR_BitVector *l
 
 int32_t TR_OSRLiveRangeAnalysis::fullAnalysis(bool includeParms, bool containsPendingPushes)
    {
-   TR_Structure* rootStructure = TR_RegionAnalysis::getRegions(comp(), optimizer()->getMethodSymbol());
-   optimizer()->getMethodSymbol()->getFlowGraph()->setStructure(rootStructure);
-   TR_ASSERT(rootStructure, "Structure is NULL");
-
    if (comp()->getOption(TR_TraceOSR))
       {
       traceMsg(comp(), "Starting full OSRLiveRangeAnalysis\n");
@@ -1304,11 +1298,11 @@ int32_t TR_OSRLiveRangeAnalysis::fullAnalysis(bool includeParms, bool containsPe
    {
    TR::StackMemoryRegion stackMemoryRegion(*trMemory());
 
-   // Perform liveness analysis
+   // Perform liveness analysis, solved on the CFG without structure
    //
    bool ignoreOSRuses = true;
    bool includeParms = true;
-   TR_Liveness liveLocals(comp(), optimizer(), comp()->getFlowGraph()->getStructure(), ignoreOSRuses, NULL, false, includeParms);
+   TR_Liveness liveLocals(comp(), optimizer(), NULL, ignoreOSRuses, NULL, false, includeParms);
    _liveVars = new (trStackMemory()) TR_BitVector(liveLocals.getNumberOfBits(), trMemory(), stackAlloc);
 
    //set the structure to NULL so that the inliner (which is applied very soon after) doesn't need
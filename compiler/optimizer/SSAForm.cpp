@@ -0,0 +1,605 @@
+/*******************************************************************************
+ * Copyright (c) 2020, 2020 IBM Corp. and others
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at https://www.eclipse.org/legal/epl-2.0/
+ * or the Apache License, Version 2.0 which accompanies this distribution and
+ * is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following
+ * Secondary Licenses when the conditions for such availability set
+ * forth in the Eclipse Public License, v. 2.0 are satisfied: GNU
+ * General Public License, version 2 with the GNU Classpath
+ * Exception [1] and GNU General Public License, version 2 with the
+ * OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] http://openjdk.java.net/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
+ *******************************************************************************/
+
+#include "optimizer/SSAForm.hpp"
+
+#include <map>
+#include <stdint.h>
+#include "compile/Compilation.hpp"
+#include "compile/SymbolReferenceTable.hpp"
+#include "env/CompilerEnv.hpp"
+#include "env/TRMemory.hpp"
+#include "il/Block.hpp"
+#include "il/DataTypes.hpp"
+#include "il/ILOps.hpp"
+#include "il/Node.hpp"
+#include "il/Node_inlines.hpp"
+#include "il/NodePool.hpp"
+#include "il/Symbol.hpp"
+#include "il/SymbolReference.hpp"
+#include "il/TreeTop.hpp"
+#include "il/TreeTop_inlines.hpp"
+#include "infra/Cfg.hpp"
+#include "infra/CfgEdge.hpp"
+#include "optimizer/Dominators.hpp"
+#include "ras/Debug.hpp"
+
+// States of a symbol reference in _localOfSymRef before locals are numbered
+//
+#define SYMREF_NOT_SEEN      -1
+#define SYMREF_DISQUALIFIED  -2
+#define SYMREF_CANDIDATE     -3
+
+TR_SSAForm::TR_SSAForm(TR::Compilation *comp, bool trace)
+   : _comp(comp),
+     _region(comp->trMemory()->currentStackRegion()),
+     _trace(trace),
+     _localOfSymRef(comp->getSymRefTab()->getNumSymRefs(), SYMREF_NOT_SEEN, _region),
+     _symRefOfSymbol(std::less<TR::Symbol *>(), _region),
+     _localSymRefs(_region),
+     _isGlobal(comp->getSymRefTab()->getNumSymRefs(), _region),
+     _lastDefBlock(comp->getSymRefTab()->getNumSymRefs(), -1, _region),
+     _defBlocks(comp->getSymRefTab()->getNumSymRefs(), -1, _region),
+     _nextDefBlock(_region),
+     _defBlockNumbers(_region),
+     _numBlocks(comp->getFlowGraph()->getNextNodeNumber()),
+     _blocks(_numBlocks, static_cast<TR::Block *>(NULL), _region),
+     _reachable(_numBlocks, _region),
+     _firstPredecessor(_numBlocks + 1, 0, _region),
+     _predecessors(_region),
+     _frontierStart(_numBlocks + 1, 0, _region),
+     _frontier(_region),
+     _defs(_region),
+     _phiOperands(_region),
+     _firstPhiOfBlock(_numBlocks, -1, _region),
+     _defForNode(comp->getNodePool().getLastGlobalIndex() + 1, -1, _region),
+     _copyForNode(comp->getNodePool().getLastGlobalIndex() + 1, -1, _region),
+     _currentDef(_region),
+     _renameLog(_region)
+   {}
+
+int32_t
+TR_SSAForm::getLocal(TR::Node *node)
+   {
+   if (!node->getOpCode().isLoadVarDirect() && !node->getOpCode().isStoreDirect())
+      return -1;
+   int32_t symRefNumber = node->getSymbolReference()->getReferenceNumber();
+   if (symRefNumber >= (int32_t)_localOfSymRef.size())
+      return -1;
+   return _localOfSymRef[symRefNumber];
+   }
+
+int32_t
+TR_SSAForm::getDefForNode(TR::Node *node)
+   {
+   if (node->getGlobalIndex() >= _defForNode.size())
+      return -1;
+   return _defForNode[node->getGlobalIndex()];
+   }
+
+int32_t
+TR_SSAForm::getCopyForLoad(TR::Node *load)
+   {
+   if (load->getGlobalIndex() >= _copyForNode.size())
+      return -1;
+   return _copyForNode[load->getGlobalIndex()];
+   }
+
+int32_t
+TR_SSAForm::getNumPredecessors(TR::Block *block)
+   {
+   int32_t number = block->getNumber();
+   return _firstPredecessor[number + 1] - _firstPredecessor[number];
+   }
+
+TR::Block *
+TR_SSAForm::getPredecessor(TR::Block *block, int32_t index)
+   {
+   return _predecessors[_firstPredecessor[block->getNumber()] + index];
+   }
+
+int32_t
+TR_SSAForm::getPredecessorIndex(TR::Block *block, TR::Block *pred)
+   {
+   int32_t first = _firstPredecessor[block->getNumber()];
+   int32_t last = _firstPredecessor[block->getNumber() + 1];
+   for (int32_t i = first; i < last; i++)
+      {
+      if (_predecessors[i] == pred)
+         return i - first;
+      }
+   return -1;
+   }
+
+int32_t
+TR_SSAForm::getEdgeIndex(TR::Block *block, int32_t index)
+   {
+   return _firstPredecessor[block->getNumber()] + index;
+   }
+
+int32_t
+TR_SSAForm::getFirstPhi(TR::Block *block)
+   {
+   return _firstPhiOfBlock[block->getNumber()];
+   }
+
+bool
+TR_SSAForm::isReachable(TR::Block *block)
+   {
+   return _reachable.isSet(block->getNumber());
+   }
+
+bool
+TR_SSAForm::build()
+   {
+   LexicalTimer tlex("SSAForm::build", comp()->phaseTimer());
+
+   collectLocals();
+   if (getNumLocals() == 0)
+      return false;
+
+   TR_Dominators dominators(comp());
+   computePredecessors();
+   computeDominanceFrontiers(dominators);
+   placePhis();
+   rename(dominators);
+
+   if (trace())
+      traceMsg(comp(), "SSA form: %d locals, %d definitions, %d phi operands\n",
+               getNumLocals(), getNumDefs(), (int32_t)_phiOperands.size());
+   return true;
+   }
+
+void
+TR_SSAForm::disqualify(int32_t symRefNumber)
+   {
+   _localOfSymRef[symRefNumber] = SYMREF_DISQUALIFIED;
+   }
+
+/**
+ * Find the autos and parms that can be tracked, the blocks storing them, and
+ * whether they are used in a block other than the one defining them
+ */
+void
+TR_SSAForm::collectLocals()
+   {
+   vcount_t visitCount = comp()->incVisitCount();
+   TR::Block *block = NULL;
+   for (TR::TreeTop *tt = comp()->getStartTree(); tt; tt = tt->getNextTreeTop())
+      {
+      TR::Node *node = tt->getNode();
+      if (node->getOpCodeValue() == TR::BBStart)
+         {
+         block = node->getBlock();
+         continue;
+         }
+      collectLocals(node, block, visitCount);
+      }
+
+   TR::SymbolReferenceTable *symRefTab = comp()->getSymRefTab();
+   for (int32_t i = 0; i < (int32_t)_localOfSymRef.size(); i++)
+      {
+      if (_localOfSymRef[i] == SYMREF_CANDIDATE)
+         {
+         _localOfSymRef[i] = (int32_t)_localSymRefs.size();
+         _localSymRefs.push_back(symRefTab->getSymRef(i));
+         }
+      else
+         {
+         _localOfSymRef[i] = -1;
+         }
+      }
+   }
+
+void
+TR_SSAForm::collectLocals(TR::Node *node, TR::Block *block, vcount_t visitCount)
+   {
+   if (node->getVisitCount() == visitCount)
+      return;
+   node->setVisitCount(visitCount);
+
+   for (int32_t i = 0; i < node->getNumChildren(); i++)
+      collectLocals(node->getChild(i), block, visitCount);
+
+   TR::ILOpCode &opCode = node->getOpCode();
+   if (!opCode.hasSymbolReference() || !node->getSymbolReference())
+      return;
+
+   TR::SymbolReference *symRef = node->getSymbolReference();
+   TR::Symbol *symbol = symRef->getSymbol();
+   if (!symbol || !symbol->isAutoOrParm())
+      return;
+
+   int32_t symRefNumber = symRef->getReferenceNumber();
+   if (_localOfSymRef[symRefNumber] == SYMREF_DISQUALIFIED)
+      return;
+
+   if (_localOfSymRef[symRefNumber] == SYMREF_NOT_SEEN)
+      {
+      _localOfSymRef[symRefNumber] = SYMREF_CANDIDATE;
+
+      // A symbol accessed through more than one symbol reference could be
+      // given different definitions by each of them
+      //
+      SymbolMap::iterator owner = _symRefOfSymbol.find(symbol);
+      if (owner != _symRefOfSymbol.end())
+         {
+         disqualify(owner->second);
+         disqualify(symRefNumber);
+         return;
+         }
+      _symRefOfSymbol.insert(std::make_pair(symbol, symRefNumber));
+
+      TR::DataType type = symbol->getDataType();
+      if (!type.isIntegral() && !type.isAddress() && !type.isFloatingPoint())
+         {
+         disqualify(symRefNumber);
+         return;
+         }
+
+      if (symbol->isAuto() && (symbol->isInternalPointerAuto() || symbol->isPinningArrayPointer()))
+         {
+         disqualify(symRefNumber);
+         return;
+         }
+      }
+
+   if (opCode.isLoadVarDirect())
+      {
+      if (_lastDefBlock[symRefNumber] != block->getNumber())
+         _isGlobal.set(symRefNumber);
+      }
+   else if (opCode.isStoreDirect() && !opCode.isStoreReg())
+      {
+      if (!block->getExceptionSuccessors().empty())
+         {
+         disqualify(symRefNumber);
+         return;
+         }
+
+      if (_lastDefBlock[symRefNumber] != block->getNumber())
+         {
+         _lastDefBlock[symRefNumber] = block->getNumber();
+         _defBlockNumbers.push_back(block->getNumber());
+         _nextDefBlock.push_back(_defBlocks[symRefNumber]);
+         _defBlocks[symRefNumber] = (int32_t)_defBlockNumbers.size() - 1;
+         }
+
+      // The source of a copy must have phis wherever its definitions merge so
+      // that a later load of the copy can tell whether the source still holds
+      // the copied value
+      //
+      TR::Node *value = node->getFirstChild();
+      if (value->getOpCode().isLoadVarDirect())
+         _isGlobal.set(value->getSymbolReference()->getReferenceNumber());
+      }
+   else
+      {
+      // loadaddr, register loads and stores, or any other use of the symbol
+      //
+      disqualify(symRefNumber);
+      }
+   }
+
+void
+TR_SSAForm::computePredecessors()
+   {
+   TR::CFG *cfg = comp()->getFlowGraph();
+   for (TR::CFGNode *node = cfg->getFirstNode(); node; node = node->getNext())
+      {
+      TR::Block *block = toBlock(node);
+      _blocks[block->getNumber()] = block;
+      _firstPredecessor[block->getNumber() + 1] = (int32_t)(block->getPredecessors().size() + block->getExceptionPredecessors().size());
+      }
+
+   for (int32_t i = 0; i < _numBlocks; i++)
+      _firstPredecessor[i + 1] += _firstPredecessor[i];
+
+   _predecessors.resize(_firstPredecessor[_numBlocks], NULL);
+   for (int32_t i = 0; i < _numBlocks; i++)
+      {
+      TR::Block *block = _blocks[i];
+      if (!block)
+         continue;
+      int32_t next = _firstPredecessor[i];
+      TR_PredecessorIterator preds(block);
+      for (TR::CFGEdge *edge = preds.getFirst(); edge; edge = preds.getNext())
+         _predecessors[next++] = toBlock(edge->getFrom());
+      }
+   }
+
+/**
+ * Dominance frontiers as described by Cooper, Harvey and Kennedy in "A Simple,
+ * Fast Dominance Algorithm": a merge point is in the frontier of every block on
+ * the dominator tree path from each of its predecessors up to, but excluding,
+ * its immediate dominator.
+ */
+void
+TR_SSAForm::computeDominanceFrontiers(TR_Dominators &dominators)
+   {
+   TR::Block *start = toBlock(comp()->getFlowGraph()->getStart());
+   for (int32_t i = 0; i < _numBlocks; i++)
+      {
+      TR::Block *block = _blocks[i];
+      if (block && (block == start || dominators.getDominator(block) != NULL))
+         _reachable.set(i);
+      }
+
+   IndexVector frontierOf(_region);
+   IndexVector frontierBlock(_region);
+   for (int32_t i = 0; i < _numBlocks; i++)
+      {
+      TR::Block *block = _blocks[i];
+      if (!block || !_reachable.isSet(i) || getNumPredecessors(block) < 2)
+         continue;
+
+      TR::Block *idom = dominators.getDominator(block);
+      for (int32_t p = 0; p < getNumPredecessors(block); p++)
+         {
+         TR::Block *runner = getPredecessor(block, p);
+         if (!_reachable.isSet(runner->getNumber()))
+            continue;
+         while (runner && runner != idom)
+            {
+            frontierOf.push_back(runner->getNumber());
+            frontierBlock.push_back(i);
+            runner = dominators.getDominator(runner);
+            }
+         }
+      }
+
+   // Bucket the frontier by block
+   //
+   for (size_t i = 0; i < frontierOf.size(); i++)
+      _frontierStart[frontierOf[i] + 1]++;
+   for (int32_t i = 0; i < _numBlocks; i++)
+      _frontierStart[i + 1] += _frontierStart[i];
+
+   IndexVector next(_frontierStart.begin(), _frontierStart.end() - 1, _region);
+   _frontier.resize(frontierOf.size(), -1);
+   for (size_t i = 0; i < frontierOf.size(); i++)
+      _frontier[next[frontierOf[i]]++] = frontierBlock[i];
+   }
+
+int32_t
+TR_SSAForm::createDef(DefKind kind, int32_t local, TR::Block *block, TR::Node *store)
+   {
+   Def def;
+   def._kind = kind;
+   def._local = local;
+   def._block = block;
+   def._store = store;
+   def._firstOperand = -1;
+   def._nextPhi = -1;
+   def._copyOf = -1;
+   _defs.push_back(def);
+   return (int32_t)_defs.size() - 1;
+   }
+
+/**
+ * Place phis on the iterated dominance frontier of the blocks storing each
+ * local that is used outside the block defining it
+ */
+void
+TR_SSAForm::placePhis()
+   {
+   // The entry definitions are numbered like the locals
+   //
+   for (int32_t local = 0; local < getNumLocals(); local++)
+      createDef(EntryDef, local, NULL, NULL);
+
+   TR::Block *end = toBlock(comp()->getFlowGraph()->getEnd());
+   IndexVector hasPhi(_numBlocks, -1, _region);
+   IndexVector onWorklist(_numBlocks, -1, _region);
+   IndexVector worklist(_region);
+
+   for (int32_t local = 0; local < getNumLocals(); local++)
+      {
+      int32_t symRefNumber = getLocalSymRef(local)->getReferenceNumber();
+      if (!_isGlobal.isSet(symRefNumber))
+         continue;
+
+      for (int32_t d = _defBlocks[symRefNumber]; d >= 0; d = _nextDefBlock[d])
+         {
+         int32_t blockNumber = _defBlockNumbers[d];
+         if (onWorklist[blockNumber] != local)
+            {
+            onWorklist[blockNumber] = local;
+            worklist.push_back(blockNumber);
+            }
+         }
+
+      while (!worklist.empty())
+         {
+         int32_t blockNumber = worklist.back();
+         worklist.pop_back();
+         for (int32_t f = _frontierStart[blockNumber]; f < _frontierStart[blockNumber + 1]; f++)
+            {
+            int32_t frontier = _frontier[f];
+            if (hasPhi[frontier] == local)
+               continue;
+            hasPhi[frontier] = local;
+
+            TR::Block *block = _blocks[frontier];
+            if (block == end)
+               continue;
+
+            int32_t phi = createDef(PhiDef, local, block, NULL);
+            _defs[phi]._firstOperand = (int32_t)_phiOperands.size();
+            _defs[phi]._nextPhi = _firstPhiOfBlock[frontier];
+            _firstPhiOfBlock[frontier] = phi;
+            _phiOperands.resize(_phiOperands.size() + getNumPredecessors(block), -1);
+
+            if (onWorklist[frontier] != local)
+               {
+               onWorklist[frontier] = local;
+               worklist.push_back(frontier);
+               }
+            }
+         }
+      }
+   }
+
+void
+TR_SSAForm::setCurrentDef(int32_t local, int32_t def)
+   {
+   _renameLog.push_back(local);
+   _renameLog.push_back(_currentDef[local]);
+   _currentDef[local] = def;
+   }
+
+void
+TR_SSAForm::renameNode(TR::Node *node, TR::Block *block, vcount_t visitCount)
+   {
+   if (node->getVisitCount() == visitCount)
+      return;
+   node->setVisitCount(visitCount);
+
+   for (int32_t i = 0; i < node->getNumChildren(); i++)
+      renameNode(node->getChild(i), block, visitCount);
+
+   int32_t local = getLocal(node);
+   if (local < 0)
+      return;
+
+   if (node->getOpCode().isLoadVarDirect())
+      {
+      int32_t def = _currentDef[local];
+      _defForNode[node->getGlobalIndex()] = def;
+
+      int32_t copy = _defs[def]._copyOf;
+      if (copy >= 0 && _currentDef[_defs[copy]._local] == copy)
+         _copyForNode[node->getGlobalIndex()] = copy;
+      }
+   else
+      {
+      int32_t def = createDef(StoreDef, local, block, node);
+      _defForNode[node->getGlobalIndex()] = def;
+
+      TR::Node *value = node->getFirstChild();
+      int32_t valueLocal = getLocal(value);
+      if (valueLocal >= 0 && valueLocal != local && value->getOpCode().isLoadVarDirect())
+         {
+         int32_t source = _copyForNode[value->getGlobalIndex()];
+         if (source < 0)
+            source = _defForNode[value->getGlobalIndex()];
+         _defs[def]._copyOf = source;
+         }
+
+      setCurrentDef(local, def);
+      }
+   }
+
+/**
+ * Give every load the definition reaching it by walking the dominator tree
+ * with a stack of current definitions per local, undone when leaving a subtree
+ */
+void
+TR_SSAForm::rename(TR_Dominators &dominators)
+   {
+   TR::Block *start = toBlock(comp()->getFlowGraph()->getStart());
+
+   // Children in the dominator tree
+   //
+   IndexVector firstChild(_numBlocks + 1, 0, _region);
+   for (int32_t i = 0; i < _numBlocks; i++)
+      {
+      if (_reachable.isSet(i) && _blocks[i] != start)
+         firstChild[dominators.getDominator(_blocks[i])->getNumber() + 1]++;
+      }
+   for (int32_t i = 0; i < _numBlocks; i++)
+      firstChild[i + 1] += firstChild[i];
+   IndexVector children(firstChild[_numBlocks], -1, _region);
+   IndexVector next(firstChild.begin(), firstChild.end() - 1, _region);
+   for (int32_t i = 0; i < _numBlocks; i++)
+      {
+      if (_reachable.isSet(i) && _blocks[i] != start)
+         children[next[dominators.getDominator(_blocks[i])->getNumber()]++] = i;
+      }
+
+   _currentDef.resize(getNumLocals(), -1);
+   for (int32_t local = 0; local < getNumLocals(); local++)
+      _currentDef[local] = local;
+
+   vcount_t visitCount = comp()->incVisitCount();
+
+   // Each stack entry is a block, the next of its children to visit, and the
+   // size of the rename log on entry to the block
+   //
+   IndexVector stack(_region);
+   stack.push_back(start->getNumber());
+   stack.push_back(-1);
+   stack.push_back(0);
+
+   while (!stack.empty())
+      {
+      size_t top = stack.size() - 3;
+      int32_t blockNumber = stack[top];
+      TR::Block *block = _blocks[blockNumber];
+
+      if (stack[top + 1] < 0)
+         {
+         stack[top + 1] = firstChild[blockNumber];
+         stack[top + 2] = (int32_t)_renameLog.size();
+
+         for (int32_t phi = _firstPhiOfBlock[blockNumber]; phi >= 0; phi = _defs[phi]._nextPhi)
+            setCurrentDef(_defs[phi]._local, phi);
+
+         if (block->getEntry())
+            {
+            for (TR::TreeTop *tt = block->getEntry()->getNextTreeTop(); tt != block->getExit(); tt = tt->getNextTreeTop())
+               renameNode(tt->getNode(), block, visitCount);
+            }
+
+         TR_SuccessorIterator succs(block);
+         for (TR::CFGEdge *edge = succs.getFirst(); edge; edge = succs.getNext())
+            {
+            TR::Block *succ = toBlock(edge->getTo());
+            int32_t index = getPredecessorIndex(succ, block);
+            for (int32_t phi = _firstPhiOfBlock[succ->getNumber()]; phi >= 0; phi = _defs[phi]._nextPhi)
+               _phiOperands[_defs[phi]._firstOperand + index] = _currentDef[_defs[phi]._local];
+            }
+         }
+
+      if (stack[top + 1] < firstChild[blockNumber + 1])
+         {
+         int32_t child = children[stack[top + 1]++];
+         stack.push_back(child);
+         stack.push_back(-1);
+         stack.push_back(0);
+         continue;
+         }
+
+      // Leaving the block: restore the definitions current on entry
+      //
+      int32_t logSize = stack[top + 2];
+      while ((int32_t)_renameLog.size() > logSize)
+         {
+         int32_t previous = _renameLog.back();
+         _renameLog.pop_back();
+         int32_t local = _renameLog.back();
+         _renameLog.pop_back();
+         _currentDef[local] = previous;
+         }
+      stack.resize(top);
+      }
+   }
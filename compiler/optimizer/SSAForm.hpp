@@ -0,0 +1,196 @@
+/*******************************************************************************
+ * Copyright (c) 2020, 2020 IBM Corp. and others
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at https://www.eclipse.org/legal/epl-2.0/
+ * or the Apache License, Version 2.0 which accompanies this distribution and
+ * is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following
+ * Secondary Licenses when the conditions for such availability set
+ * forth in the Eclipse Public License, v. 2.0 are satisfied: GNU
+ * General Public License, version 2 with the GNU Classpath
+ * Exception [1] and GNU General Public License, version 2 with the
+ * OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] http://openjdk.java.net/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
+ *******************************************************************************/
+
+#ifndef SSAFORM_INCL
+#define SSAFORM_INCL
+
+#include <map>
+#include <stdint.h>
+#include "env/TRMemory.hpp"
+#include "env/TypedAllocator.hpp"
+#include "il/Node.hpp"
+#include "infra/BitVector.hpp"
+#include "infra/vector.hpp"
+
+class TR_Dominators;
+namespace TR { class Block; }
+namespace TR { class Compilation; }
+namespace TR { class Symbol; }
+namespace TR { class SymbolReference; }
+
+/**
+ * Static single assignment form of the method's local variables.
+ *
+ * The trees are not rewritten: the SSA form is an overlay that maps every load
+ * of a tracked local to the single definition reaching it.  A definition is
+ * either the value the local has on method entry, a direct store, or a phi
+ * placed at a merge point.  Phis are not materialized in the trees; each phi
+ * records the definition flowing in along every predecessor edge of its block.
+ *
+ * Only autos and parms that cannot be modified through anything but a direct
+ * store are tracked: their address is never taken, they are accessed through a
+ * single symbol reference, and they are not stored in a block that can throw
+ * into a handler, so a catch block sees the same definition on entry no matter
+ * where in the try block the exception was raised.
+ *
+ * Construction uses the dominance frontiers of the dominator tree computed by
+ * TR_Dominators (Cooper, Harvey and Kennedy) and places phis for locals that
+ * are live across blocks only (semi-pruned SSA), so its cost is close to
+ * linear in the size of the method instead of proportional to the number of
+ * locals times the number of blocks.
+ */
+class TR_SSAForm
+   {
+   public:
+
+   enum DefKind
+      {
+      EntryDef,
+      StoreDef,
+      PhiDef
+      };
+
+   struct Def
+      {
+      DefKind _kind;
+      int32_t _local;
+      TR::Block *_block;       // block of the store or phi, NULL for an entry definition
+      TR::Node *_store;        // the store node of a StoreDef
+      int32_t _firstOperand;   // index of the first phi operand of a PhiDef
+      int32_t _nextPhi;        // next phi in the same block
+      int32_t _copyOf;         // definition of another local holding the same value, or -1
+      };
+
+   TR_SSAForm(TR::Compilation *comp, bool trace);
+
+   /**
+    * Build the SSA form of the current method.
+    *
+    * \return false if the method has no local that can be tracked
+    */
+   bool build();
+
+   TR::Compilation *comp() { return _comp; }
+   bool trace() { return _trace; }
+
+   int32_t getNumLocals() { return (int32_t)_localSymRefs.size(); }
+   TR::SymbolReference *getLocalSymRef(int32_t local) { return _localSymRefs[local]; }
+
+   /**
+    * \return the tracked local accessed by a direct load or store, or -1
+    */
+   int32_t getLocal(TR::Node *node);
+
+   int32_t getNumDefs() { return (int32_t)_defs.size(); }
+   Def &getDef(int32_t def) { return _defs[def]; }
+
+   /**
+    * \return the definition reaching a load of a tracked local, the definition
+    *         created by a store of a tracked local, or -1 for any other node or
+    *         for nodes in blocks not reachable from the method entry
+    */
+   int32_t getDefForNode(TR::Node *node);
+
+   /**
+    * \return a definition of another local whose value is the value of the
+    *         given load and that still reaches the load, or -1.  A load with
+    *         such a definition can be changed to load the other local instead.
+    */
+   int32_t getCopyForLoad(TR::Node *load);
+
+   /**
+    * Predecessors of a block, in phi operand order; normal and exception
+    * predecessors are included.
+    */
+   int32_t getNumPredecessors(TR::Block *block);
+   TR::Block *getPredecessor(TR::Block *block, int32_t index);
+   int32_t getPredecessorIndex(TR::Block *block, TR::Block *pred);
+
+   /**
+    * \return the index in a flat array of all CFG edges of the edge from the
+    *         index'th predecessor of a block
+    */
+   int32_t getEdgeIndex(TR::Block *block, int32_t index);
+   int32_t getNumEdges() { return (int32_t)_predecessors.size(); }
+
+   int32_t getFirstPhi(TR::Block *block);
+   int32_t getPhiOperand(int32_t phi, int32_t index) { return _phiOperands[_defs[phi]._firstOperand + index]; }
+
+   bool isReachable(TR::Block *block);
+
+   private:
+
+   typedef TR::vector<int32_t, TR::Region&> IndexVector;
+   typedef TR::typed_allocator<std::pair<TR::Symbol * const, int32_t>, TR::Region &> SymbolMapAllocator;
+   typedef std::map<TR::Symbol *, int32_t, std::less<TR::Symbol *>, SymbolMapAllocator> SymbolMap;
+
+   void collectLocals();
+   void collectLocals(TR::Node *node, TR::Block *block, vcount_t visitCount);
+   void disqualify(int32_t symRefNumber);
+   void computePredecessors();
+   void computeDominanceFrontiers(TR_Dominators &dominators);
+   void placePhis();
+   void rename(TR_Dominators &dominators);
+   void renameNode(TR::Node *node, TR::Block *block, vcount_t visitCount);
+   void setCurrentDef(int32_t local, int32_t def);
+   int32_t createDef(DefKind kind, int32_t local, TR::Block *block, TR::Node *store);
+
+   TR::Compilation *_comp;
+   TR::Region &_region;
+   bool _trace;
+
+   // Locals
+   //
+   IndexVector _localOfSymRef;       // by symbol reference number; -1 if not tracked
+   SymbolMap _symRefOfSymbol;
+   TR::vector<TR::SymbolReference *, TR::Region&> _localSymRefs;
+   TR_BitVector _isGlobal;           // by symbol reference number
+   IndexVector _lastDefBlock;        // by symbol reference number, while collecting
+   IndexVector _defBlocks;           // by symbol reference number, heads of lists linked through _nextDefBlock
+   IndexVector _nextDefBlock;
+   IndexVector _defBlockNumbers;
+
+   // CFG
+   //
+   int32_t _numBlocks;
+   TR::vector<TR::Block *, TR::Region&> _blocks;
+   TR_BitVector _reachable;
+   IndexVector _firstPredecessor;    // by block number; predecessors are _predecessors[first .. first of next block)
+   TR::vector<TR::Block *, TR::Region&> _predecessors;
+   IndexVector _frontierStart;
+   IndexVector _frontier;
+
+   // Definitions
+   //
+   TR::vector<Def, TR::Region&> _defs;
+   IndexVector _phiOperands;
+   IndexVector _firstPhiOfBlock;
+   IndexVector _defForNode;          // by node global index
+   IndexVector _copyForNode;         // by node global index
+
+   // Renaming state
+   //
+   IndexVector _currentDef;
+   IndexVector _renameLog;           // pairs of local and previous definition
+   };
+
+#endif
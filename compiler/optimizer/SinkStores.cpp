@@ -296,6 +296,8 @@ TR_SinkStores::TR_SinkStores(TR::OptimizationManager *manager)
    {
    _tempSymMap = new (trHeapMemory()) TR_HashTab(comp()->trMemory(), stackAlloc, 4);
 
+   _underCommonedNode = false;
+
    // tuning parameters
    _sinkAllStores = false;
    _printSinkStoreStats = false;
@@ -1801,12 +1803,11 @@ bool TR_SinkStores::treeIsSinkableStore(TR::Node *node, bool sinkIndirectLoads,
       }
 
    int32_t numChildren = node->getNumChildren();
-   static bool underCommonedNode;
 
    /* initialization upon first entry */
    if (depth == 0)
       {
-      underCommonedNode = false;
+      _underCommonedNode = false;
       }
 
    if (numChildren == 0)
@@ -1905,7 +1906,7 @@ bool TR_SinkStores::treeIsSinkableStore(TR::Node *node, bool sinkIndirectLoads,
 
    if (!comp()->cg()->getSupportsJavaFloatSemantics() &&
        node->getOpCode().isFloatingPoint() &&
-       (underCommonedNode || node->getReferenceCount() > 1))
+       (_underCommonedNode || node->getReferenceCount() > 1))
       {
       if (trace())
          traceMsg(comp(), "         fp store failure\n");
@@ -1915,7 +1916,7 @@ bool TR_SinkStores::treeIsSinkableStore(TR::Node *node, bool sinkIndirectLoads,
    if (numChildren == 0 &&
        node->getOpCode().isLoadVarDirect() &&
        node->getSymbolReference()->getSymbol()->isStatic() &&
-       (underCommonedNode || node->getReferenceCount() > 1))
+       (_underCommonedNode || node->getReferenceCount() > 1))
        {
        if (trace())
          traceMsg(comp(), "         commoned static load store failure: %p\n", node);
@@ -1923,9 +1924,9 @@ bool TR_SinkStores::treeIsSinkableStore(TR::Node *node, bool sinkIndirectLoads,
        }
 
    int32_t currentDepth = ++depth;
-   bool    previouslyCommoned = underCommonedNode;
+   bool    previouslyCommoned = _underCommonedNode;
    if (node->getReferenceCount() > 1)
-      underCommonedNode = true;
+      _underCommonedNode = true;
    for (int32_t c=0;c < numChildren;c++)
       {
       int32_t childDepth = currentDepth;
@@ -1935,7 +1936,7 @@ bool TR_SinkStores::treeIsSinkableStore(TR::Node *node, bool sinkIndirectLoads,
       if (childDepth > depth)
          depth = childDepth;
       }
-   underCommonedNode = previouslyCommoned;
+   _underCommonedNode = previouslyCommoned;
    return true;
    }
 
@@ -447,6 +447,9 @@ class TR_SinkStores : public TR::Optimization
    int32_t                         _firstSinkOptTransformationIndex;
    int32_t                         _lastSinkOptTransformationIndex;
 
+   // set by treeIsSinkableStore while it walks below a commoned node
+   bool                            _underCommonedNode;
+
    enum
       {
       UsesDataFlowAnalysis                     = 0x0001,
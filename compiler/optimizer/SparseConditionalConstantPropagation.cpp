@@ -0,0 +1,683 @@
+/*******************************************************************************
+ * Copyright (c) 2020, 2020 IBM Corp. and others
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at https://www.eclipse.org/legal/epl-2.0/
+ * or the Apache License, Version 2.0 which accompanies this distribution and
+ * is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following
+ * Secondary Licenses when the conditions for such availability set
+ * forth in the Eclipse Public License, v. 2.0 are satisfied: GNU
+ * General Public License, version 2 with the GNU Classpath
+ * Exception [1] and GNU General Public License, version 2 with the
+ * OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] http://openjdk.java.net/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
+ *******************************************************************************/
+
+#include "optimizer/SparseConditionalConstantPropagation.hpp"
+
+#include <limits.h>
+#include <stdint.h>
+#include "compile/Compilation.hpp"
+#include "env/StackMemoryRegion.hpp"
+#include "env/TRMemory.hpp"
+#include "il/Block.hpp"
+#include "il/DataTypes.hpp"
+#include "il/ILOpCodes.hpp"
+#include "il/ILOps.hpp"
+#include "il/Node.hpp"
+#include "il/Node_inlines.hpp"
+#include "il/NodePool.hpp"
+#include "il/Symbol.hpp"
+#include "il/SymbolReference.hpp"
+#include "il/TreeTop.hpp"
+#include "il/TreeTop_inlines.hpp"
+#include "infra/BitVector.hpp"
+#include "infra/Cfg.hpp"
+#include "infra/CfgEdge.hpp"
+#include "optimizer/Optimization_inlines.hpp"
+#include "optimizer/Optimizer.hpp"
+#include "optimizer/SSAForm.hpp"
+
+static bool
+isIntegralType(TR::DataType type)
+   {
+   return type.isInt8() || type.isInt16() || type.isInt32() || type.isInt64();
+   }
+
+/**
+ * Sign extend a value to 64 bits from the width of the given type
+ */
+static int64_t
+normalize(int64_t value, TR::DataType type)
+   {
+   if (type.isInt8())
+      return (int8_t)value;
+   if (type.isInt16())
+      return (int16_t)value;
+   if (type.isInt32())
+      return (int32_t)value;
+   return value;
+   }
+
+/**
+ * Zero extend a value to 64 bits from the width of the given type
+ */
+static uint64_t
+zeroExtend(int64_t value, TR::DataType type)
+   {
+   if (type.isInt8())
+      return (uint8_t)value;
+   if (type.isInt16())
+      return (uint16_t)value;
+   if (type.isInt32())
+      return (uint32_t)value;
+   return (uint64_t)value;
+   }
+
+TR_SparseConditionalConstantPropagation::TR_SparseConditionalConstantPropagation(TR::OptimizationManager *manager)
+   : TR::Optimization(manager),
+     _ssa(NULL),
+     _values(NULL),
+     _uses(NULL),
+     _firstUse(NULL),
+     _executableBlocks(NULL),
+     _executableEdges(NULL),
+     _blockWorklist(NULL),
+     _defWorklist(NULL),
+     _nodeValues(NULL),
+     _nodeValueStamps(NULL),
+     _evaluationStamp(0)
+   {}
+
+int32_t
+TR_SparseConditionalConstantPropagation::perform()
+   {
+   TR::StackMemoryRegion stackMemoryRegion(*trMemory());
+   TR::Region &region = comp()->trMemory()->currentStackRegion();
+
+   TR_SSAForm ssa(comp(), trace());
+   if (!ssa.build())
+      return 0;
+   _ssa = &ssa;
+
+   int32_t numDefs = ssa.getNumDefs();
+   LatticeValue top = { Top, 0 };
+   LatticeValue bottom = { Bottom, 0 };
+   _values = new (trStackMemory()) TR::vector<LatticeValue, TR::Region&>(numDefs, top, region);
+   for (int32_t def = 0; def < numDefs; def++)
+      {
+      TR_SSAForm::Def &d = ssa.getDef(def);
+      if (d._kind == TR_SSAForm::EntryDef ||
+          !isIntegralType(ssa.getLocalSymRef(d._local)->getSymbol()->getDataType()))
+         (*_values)[def] = bottom;
+      }
+
+   _uses = new (trStackMemory()) TR::vector<Use, TR::Region&>(region);
+   _firstUse = new (trStackMemory()) IndexVector(numDefs, -1, region);
+   _executableBlocks = new (trStackMemory()) TR_BitVector(comp()->getFlowGraph()->getNextNodeNumber(), trMemory(), stackAlloc);
+   _executableEdges = new (trStackMemory()) TR_BitVector(ssa.getNumEdges(), trMemory(), stackAlloc);
+   _blockWorklist = new (trStackMemory()) IndexVector(region);
+   _defWorklist = new (trStackMemory()) IndexVector(region);
+
+   size_t numNodes = comp()->getNodePool().getLastGlobalIndex() + 1;
+   _nodeValues = new (trStackMemory()) TR::vector<LatticeValue, TR::Region&>(numNodes, top, region);
+   _nodeValueStamps = new (trStackMemory()) IndexVector(numNodes, 0, region);
+   _evaluationStamp = 0;
+
+   collectUses();
+   propagate();
+   int32_t numTransformations = transform();
+
+   if (numTransformations > 0)
+      {
+      optimizer()->setUseDefInfo(NULL);
+      optimizer()->setValueNumberInfo(NULL);
+      requestOpt(OMR::treeSimplification);
+      }
+
+   _ssa = NULL;
+   return numTransformations;
+   }
+
+void
+TR_SparseConditionalConstantPropagation::addUse(int32_t def, TR::Node *node, TR::Block *block, int32_t phi)
+   {
+   Use use;
+   use._node = node;
+   use._block = block;
+   use._phi = phi;
+   use._next = (*_firstUse)[def];
+   _uses->push_back(use);
+   (*_firstUse)[def] = (int32_t)_uses->size() - 1;
+   }
+
+/**
+ * Record the store or branch as a use of every definition reaching a load in
+ * its subtree.  The stamp makes sure a load commoned within the subtree is
+ * recorded once.
+ */
+void
+TR_SparseConditionalConstantPropagation::collectUses(TR::Node *node, TR::Node *user, TR::Block *block, int32_t stamp)
+   {
+   if ((*_nodeValueStamps)[node->getGlobalIndex()] == stamp)
+      return;
+   (*_nodeValueStamps)[node->getGlobalIndex()] = stamp;
+
+   if (node->getOpCode().isLoadVarDirect())
+      {
+      int32_t def = _ssa->getDefForNode(node);
+      if (def >= 0)
+         addUse(def, user, block, -1);
+      return;
+      }
+
+   for (int32_t i = 0; i < node->getNumChildren(); i++)
+      collectUses(node->getChild(i), user, block, stamp);
+   }
+
+void
+TR_SparseConditionalConstantPropagation::collectUses()
+   {
+   TR_BitVector evaluatedStores(_ssa->getNumDefs(), trMemory(), stackAlloc);
+   int32_t stamp = 0;
+   TR::Block *block = NULL;
+   for (TR::TreeTop *tt = comp()->getStartTree(); tt; tt = tt->getNextTreeTop())
+      {
+      TR::Node *node = tt->getNode();
+      if (node->getOpCodeValue() == TR::BBStart)
+         {
+         block = node->getBlock();
+         continue;
+         }
+      if (!_ssa->isReachable(block))
+         continue;
+
+      if (node->getOpCode().isStoreDirect() && _ssa->getLocal(node) >= 0)
+         {
+         evaluatedStores.set(_ssa->getDefForNode(node));
+         collectUses(node->getFirstChild(), node, block, ++stamp);
+         }
+      else if (node->getOpCode().isIf())
+         {
+         ++stamp;
+         for (int32_t i = 0; i < node->getNumChildren(); i++)
+            collectUses(node->getChild(i), node, block, stamp);
+         }
+      }
+
+   for (int32_t def = 0; def < _ssa->getNumDefs(); def++)
+      {
+      TR_SSAForm::Def &d = _ssa->getDef(def);
+
+      // A store that is not the root of its tree is not evaluated
+      //
+      if (d._kind == TR_SSAForm::StoreDef && !evaluatedStores.isSet(def))
+         {
+         LatticeValue bottom = { Bottom, 0 };
+         (*_values)[def] = bottom;
+         }
+
+      if (d._kind != TR_SSAForm::PhiDef)
+         continue;
+      for (int32_t i = 0; i < _ssa->getNumPredecessors(d._block); i++)
+         {
+         int32_t operand = _ssa->getPhiOperand(def, i);
+         if (operand >= 0)
+            addUse(operand, NULL, d._block, def);
+         }
+      }
+
+   // The node stamps are shared with evaluation, which continues numbering
+   // after the last stamp used here
+   //
+   _evaluationStamp = stamp;
+   }
+
+TR_SparseConditionalConstantPropagation::LatticeValue
+TR_SparseConditionalConstantPropagation::meet(LatticeValue first, LatticeValue second)
+   {
+   if (first._state == Top)
+      return second;
+   if (second._state == Top)
+      return first;
+   if (first._state == Bottom || second._state == Bottom || first._value != second._value)
+      {
+      LatticeValue bottom = { Bottom, 0 };
+      return bottom;
+      }
+   return first;
+   }
+
+void
+TR_SparseConditionalConstantPropagation::lowerValue(int32_t def, LatticeValue value)
+   {
+   LatticeValue &current = (*_values)[def];
+   LatticeValue lowered = meet(current, value);
+   if (lowered._state == current._state && lowered._value == current._value)
+      return;
+
+   if (trace())
+      {
+      if (lowered._state == Constant)
+         traceMsg(comp(), "   definition %d of #%d is constant %lld\n", def,
+                  _ssa->getLocalSymRef(_ssa->getDef(def)._local)->getReferenceNumber(), lowered._value);
+      else
+         traceMsg(comp(), "   definition %d of #%d is not constant\n", def,
+                  _ssa->getLocalSymRef(_ssa->getDef(def)._local)->getReferenceNumber());
+      }
+
+   current = lowered;
+   _defWorklist->push_back(def);
+   }
+
+/**
+ * Solve the lattice values of all definitions and the executable CFG edges
+ * together, starting with only the method entry executable
+ */
+void
+TR_SparseConditionalConstantPropagation::propagate()
+   {
+   TR::Block *start = toBlock(comp()->getFlowGraph()->getStart());
+   _executableBlocks->set(start->getNumber());
+   _blockWorklist->push_back(start->getNumber());
+
+   TR::CFG *cfg = comp()->getFlowGraph();
+   TR::vector<TR::Block *, TR::Region&> blocks(cfg->getNextNodeNumber(), static_cast<TR::Block *>(NULL), comp()->trMemory()->currentStackRegion());
+   for (TR::CFGNode *node = cfg->getFirstNode(); node; node = node->getNext())
+      blocks[node->getNumber()] = toBlock(node);
+
+   while (!_blockWorklist->empty() || !_defWorklist->empty())
+      {
+      if (!_blockWorklist->empty())
+         {
+         int32_t blockNumber = _blockWorklist->back();
+         _blockWorklist->pop_back();
+         visitBlock(blocks[blockNumber]);
+         continue;
+         }
+
+      int32_t def = _defWorklist->back();
+      _defWorklist->pop_back();
+      for (int32_t u = (*_firstUse)[def]; u >= 0; u = (*_uses)[u]._next)
+         {
+         Use &use = (*_uses)[u];
+         if (!_executableBlocks->isSet(use._block->getNumber()))
+            continue;
+         if (use._phi >= 0)
+            visitPhi(use._phi);
+         else
+            visitUser(use._node, use._block);
+         }
+      }
+   }
+
+void
+TR_SparseConditionalConstantPropagation::visitBlock(TR::Block *block)
+   {
+   for (int32_t phi = _ssa->getFirstPhi(block); phi >= 0; phi = _ssa->getDef(phi)._nextPhi)
+      visitPhi(phi);
+
+   if (!block->getEntry())
+      {
+      markSuccessorsExecutable(block, NULL);
+      return;
+      }
+
+   for (TR::TreeTop *tt = block->getEntry()->getNextTreeTop(); tt != block->getExit(); tt = tt->getNextTreeTop())
+      {
+      TR::Node *node = tt->getNode();
+      if (node->getOpCode().isStoreDirect() && _ssa->getLocal(node) >= 0)
+         visitUser(node, block);
+      }
+
+   TR::Node *last = block->getLastRealTreeTop()->getNode();
+   if (last->getOpCode().isIf())
+      visitBranch(last, block);
+   else
+      markSuccessorsExecutable(block, NULL);
+   }
+
+void
+TR_SparseConditionalConstantPropagation::visitPhi(int32_t phi)
+   {
+   TR::Block *block = _ssa->getDef(phi)._block;
+   LatticeValue value = { Top, 0 };
+   for (int32_t i = 0; i < _ssa->getNumPredecessors(block); i++)
+      {
+      if (!_executableEdges->isSet(_ssa->getEdgeIndex(block, i)))
+         continue;
+      int32_t operand = _ssa->getPhiOperand(phi, i);
+      if (operand < 0)
+         {
+         LatticeValue bottom = { Bottom, 0 };
+         value = bottom;
+         break;
+         }
+      value = meet(value, (*_values)[operand]);
+      }
+   lowerValue(phi, value);
+   }
+
+void
+TR_SparseConditionalConstantPropagation::visitUser(TR::Node *node, TR::Block *block)
+   {
+   if (node->getOpCode().isIf())
+      {
+      visitBranch(node, block);
+      return;
+      }
+
+   ++_evaluationStamp;
+   lowerValue(_ssa->getDefForNode(node), evaluate(node->getFirstChild()));
+   }
+
+void
+TR_SparseConditionalConstantPropagation::visitBranch(TR::Node *node, TR::Block *block)
+   {
+   ++_evaluationStamp;
+   LatticeValue condition = evaluate(node);
+   if (condition._state == Bottom)
+      {
+      markSuccessorsExecutable(block, NULL);
+      return;
+      }
+
+   TR::Block *target = NULL;
+   if (condition._state == Constant)
+      {
+      if (condition._value)
+         target = node->getBranchDestination()->getNode()->getBlock();
+      else if (block->getExit()->getNextTreeTop())
+         target = block->getExit()->getNextTreeTop()->getNode()->getBlock();
+      else
+         target = NULL;
+
+      markSuccessorsExecutable(block, target);
+      return;
+      }
+
+   // With the condition still unknown, only the exception successors are
+   // executable; the target is chosen once the condition becomes known
+   //
+   TR::CFGEdgeList &exceptionSuccessors = block->getExceptionSuccessors();
+   for (auto edge = exceptionSuccessors.begin(); edge != exceptionSuccessors.end(); ++edge)
+      markEdgeExecutable(block, toBlock((*edge)->getTo()));
+   }
+
+/**
+ * Mark the edges to the successors of a block executable; when a block is
+ * given, of the normal successors only the edge to that block is marked
+ */
+void
+TR_SparseConditionalConstantPropagation::markSuccessorsExecutable(TR::Block *block, TR::Block *onlyTo)
+   {
+   if (onlyTo)
+      {
+      bool found = false;
+      TR::CFGEdgeList &successors = block->getSuccessors();
+      for (auto edge = successors.begin(); edge != successors.end(); ++edge)
+         {
+         if ((*edge)->getTo() == onlyTo)
+            found = true;
+         }
+      if (!found)
+         onlyTo = NULL;
+      }
+
+   TR::CFGEdgeList &successors = block->getSuccessors();
+   for (auto edge = successors.begin(); edge != successors.end(); ++edge)
+      {
+      if (!onlyTo || (*edge)->getTo() == onlyTo)
+         markEdgeExecutable(block, toBlock((*edge)->getTo()));
+      }
+
+   TR::CFGEdgeList &exceptionSuccessors = block->getExceptionSuccessors();
+   for (auto edge = exceptionSuccessors.begin(); edge != exceptionSuccessors.end(); ++edge)
+      markEdgeExecutable(block, toBlock((*edge)->getTo()));
+   }
+
+void
+TR_SparseConditionalConstantPropagation::markEdgeExecutable(TR::Block *from, TR::Block *to)
+   {
+   int32_t index = _ssa->getPredecessorIndex(to, from);
+   if (index < 0)
+      return;
+   int32_t edge = _ssa->getEdgeIndex(to, index);
+   if (_executableEdges->isSet(edge))
+      return;
+   _executableEdges->set(edge);
+
+   if (!_executableBlocks->isSet(to->getNumber()))
+      {
+      _executableBlocks->set(to->getNumber());
+      _blockWorklist->push_back(to->getNumber());
+      }
+   else
+      {
+      for (int32_t phi = _ssa->getFirstPhi(to); phi >= 0; phi = _ssa->getDef(phi)._nextPhi)
+         visitPhi(phi);
+      }
+   }
+
+bool
+TR_SparseConditionalConstantPropagation::isTrackedType(TR::Node *node)
+   {
+   return isIntegralType(node->getDataType());
+   }
+
+TR_SparseConditionalConstantPropagation::LatticeValue
+TR_SparseConditionalConstantPropagation::constant(TR::Node *node, int64_t value)
+   {
+   LatticeValue result = { Constant, normalize(value, node->getDataType()) };
+   return result;
+   }
+
+TR_SparseConditionalConstantPropagation::LatticeValue
+TR_SparseConditionalConstantPropagation::evaluate(TR::Node *node)
+   {
+   ncount_t index = node->getGlobalIndex();
+   if ((*_nodeValueStamps)[index] == _evaluationStamp)
+      return (*_nodeValues)[index];
+
+   LatticeValue value = evaluateUncached(node);
+   (*_nodeValueStamps)[index] = _evaluationStamp;
+   (*_nodeValues)[index] = value;
+   return value;
+   }
+
+TR_SparseConditionalConstantPropagation::LatticeValue
+TR_SparseConditionalConstantPropagation::evaluateUncached(TR::Node *node)
+   {
+   LatticeValue top = { Top, 0 };
+   LatticeValue bottom = { Bottom, 0 };
+   TR::ILOpCode &opCode = node->getOpCode();
+
+   if (opCode.isBooleanCompare())
+      {
+      if (opCode.isCompBranchOnly() || opCode.isOverflowCompare() || node->getNumChildren() < 2 ||
+          !isTrackedType(node->getFirstChild()) || !isTrackedType(node->getSecondChild()))
+         return bottom;
+      if (!opCode.isIf() && !isTrackedType(node))
+         return bottom;
+
+      LatticeValue first = evaluate(node->getFirstChild());
+      LatticeValue second = evaluate(node->getSecondChild());
+      if (first._state == Bottom || second._state == Bottom)
+         return bottom;
+      if (first._state == Top || second._state == Top)
+         return top;
+
+      bool less, greater;
+      if (opCode.isUnsignedCompare())
+         {
+         uint64_t a = zeroExtend(first._value, node->getFirstChild()->getDataType());
+         uint64_t b = zeroExtend(second._value, node->getSecondChild()->getDataType());
+         less = a < b;
+         greater = a > b;
+         }
+      else
+         {
+         less = first._value < second._value;
+         greater = first._value > second._value;
+         }
+
+      bool result = (less && opCode.isCompareTrueIfLess()) ||
+                    (greater && opCode.isCompareTrueIfGreater()) ||
+                    (!less && !greater && opCode.isCompareTrueIfEqual());
+      LatticeValue value = { Constant, result ? 1 : 0 };
+      return value;
+      }
+
+   if (!isTrackedType(node))
+      return bottom;
+
+   if (opCode.isLoadConst())
+      return constant(node, node->get64bitIntegralValue());
+
+   if (opCode.isLoadVarDirect())
+      {
+      int32_t def = _ssa->getDefForNode(node);
+      return def >= 0 ? (*_values)[def] : bottom;
+      }
+
+   if (node->getNumChildren() < 1 || node->getNumChildren() > 2)
+      return bottom;
+   for (int32_t i = 0; i < node->getNumChildren(); i++)
+      {
+      if (!isTrackedType(node->getChild(i)))
+         return bottom;
+      }
+
+   LatticeValue first = evaluate(node->getFirstChild());
+   LatticeValue second = node->getNumChildren() > 1 ? evaluate(node->getSecondChild()) : first;
+   if (first._state == Bottom || second._state == Bottom)
+      return bottom;
+   if (first._state == Top || second._state == Top)
+      return top;
+
+   TR::DataType type = node->getDataType();
+   TR::DataType sourceType = node->getFirstChild()->getDataType();
+   int64_t a = first._value;
+   int64_t b = second._value;
+   int32_t shiftMask = type.isInt64() ? 63 : 31;
+   int64_t minValue = type.isInt64() ? (int64_t)((uint64_t)1 << 63) : (int64_t)INT_MIN;
+
+   switch (node->getOpCodeValue())
+      {
+      case TR::badd: case TR::sadd: case TR::iadd: case TR::ladd:
+         return constant(node, (int64_t)((uint64_t)a + (uint64_t)b));
+      case TR::bsub: case TR::ssub: case TR::isub: case TR::lsub:
+         return constant(node, (int64_t)((uint64_t)a - (uint64_t)b));
+      case TR::bmul: case TR::smul: case TR::imul: case TR::lmul:
+         return constant(node, (int64_t)((uint64_t)a * (uint64_t)b));
+      case TR::idiv: case TR::ldiv:
+         if (b == 0 || (b == -1 && a == minValue))
+            return bottom;
+         return constant(node, a / b);
+      case TR::irem: case TR::lrem:
+         if (b == 0 || (b == -1 && a == minValue))
+            return bottom;
+         return constant(node, a % b);
+      case TR::band: case TR::sand: case TR::iand: case TR::land:
+         return constant(node, a & b);
+      case TR::bor: case TR::sor: case TR::ior: case TR::lor:
+         return constant(node, a | b);
+      case TR::bxor: case TR::sxor: case TR::ixor: case TR::lxor:
+         return constant(node, a ^ b);
+      case TR::bneg: case TR::sneg: case TR::ineg: case TR::lneg:
+         return constant(node, (int64_t)(0 - (uint64_t)a));
+      case TR::bshl: case TR::sshl: case TR::ishl: case TR::lshl:
+         return constant(node, (int64_t)((uint64_t)a << (b & shiftMask)));
+      case TR::bshr: case TR::sshr: case TR::ishr: case TR::lshr:
+         return constant(node, a >> (b & shiftMask));
+      case TR::bushr: case TR::sushr: case TR::iushr: case TR::lushr:
+         return constant(node, (int64_t)(zeroExtend(a, type) >> (b & shiftMask)));
+
+      // Sign extending and truncating conversions
+      //
+      case TR::b2s: case TR::b2i: case TR::b2l:
+      case TR::s2b: case TR::s2i: case TR::s2l:
+      case TR::i2b: case TR::i2s: case TR::i2l:
+      case TR::l2b: case TR::l2s: case TR::l2i:
+         return constant(node, a);
+
+      // Zero extending conversions
+      //
+      case TR::bu2s: case TR::bu2i: case TR::bu2l:
+      case TR::su2i: case TR::su2l:
+      case TR::iu2l:
+         return constant(node, (int64_t)zeroExtend(a, sourceType));
+
+      default:
+         return bottom;
+      }
+   }
+
+/**
+ * Replace the loads of locals found to be constant in executable code
+ */
+int32_t
+TR_SparseConditionalConstantPropagation::transform()
+   {
+   int32_t numTransformations = 0;
+   vcount_t visitCount = comp()->incVisitCount();
+   TR::Block *block = NULL;
+   TR::vector<TR::Node *, TR::Region&> stack(comp()->trMemory()->currentStackRegion());
+
+   for (TR::TreeTop *tt = comp()->getStartTree(); tt; tt = tt->getNextTreeTop())
+      {
+      TR::Node *node = tt->getNode();
+      if (node->getOpCodeValue() == TR::BBStart)
+         {
+         block = node->getBlock();
+         continue;
+         }
+      if (!_executableBlocks->isSet(block->getNumber()))
+         continue;
+
+      stack.push_back(node);
+      while (!stack.empty())
+         {
+         TR::Node *current = stack.back();
+         stack.pop_back();
+         if (current->getVisitCount() == visitCount)
+            continue;
+         current->setVisitCount(visitCount);
+
+         if (!current->getOpCode().isLoadVarDirect())
+            {
+            for (int32_t i = 0; i < current->getNumChildren(); i++)
+               stack.push_back(current->getChild(i));
+            continue;
+            }
+
+         int32_t def = _ssa->getDefForNode(current);
+         if (def < 0 || (*_values)[def]._state != Constant || !isTrackedType(current))
+            continue;
+
+         int64_t value = (*_values)[def]._value;
+         if (!performTransformation(comp(), "%sReplacing load [%p] of #%d with constant %lld\n", optDetailString(),
+                                    current, current->getSymbolReference()->getReferenceNumber(), value))
+            continue;
+
+         prepareToReplaceNode(current, TR::ILOpCode::constOpCode(current->getDataType()));
+         current->set64bitIntegralValue(value);
+         numTransformations++;
+         }
+      }
+
+   return numTransformations;
+   }
+
+const char *
+TR_SparseConditionalConstantPropagation::optDetailString() const throw()
+   {
+   return "O^O SPARSE CONDITIONAL CONSTANT PROPAGATION: ";
+   }
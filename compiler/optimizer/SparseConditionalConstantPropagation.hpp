@@ -0,0 +1,132 @@
+/*******************************************************************************
+ * Copyright (c) 2020, 2020 IBM Corp. and others
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at https://www.eclipse.org/legal/epl-2.0/
+ * or the Apache License, Version 2.0 which accompanies this distribution and
+ * is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following
+ * Secondary Licenses when the conditions for such availability set
+ * forth in the Eclipse Public License, v. 2.0 are satisfied: GNU
+ * General Public License, version 2 with the GNU Classpath
+ * Exception [1] and GNU General Public License, version 2 with the
+ * OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] http://openjdk.java.net/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
+ *******************************************************************************/
+
+#ifndef SCCP_INCL
+#define SCCP_INCL
+
+#include <stdint.h>
+#include "env/TRMemory.hpp"
+#include "infra/vector.hpp"
+#include "optimizer/Optimization.hpp"
+#include "optimizer/OptimizationManager.hpp"
+
+class TR_BitVector;
+class TR_SSAForm;
+namespace TR { class Block; }
+namespace TR { class Node; }
+
+/**
+ * Sparse conditional constant propagation (Wegman and Zadeck).
+ *
+ * Propagates integral constants through the SSA form of the method's locals
+ * (TR_SSAForm), evaluating only the stores and conditional branches that use
+ * a definition whose value changed, and only along CFG edges found to be
+ * executable.  A local is constant at a merge point if it has the same value
+ * on every executable incoming edge, so constants are found through branches
+ * whose outcome is itself constant and through loops that never change them.
+ *
+ * Loads of locals found to be constant are replaced by constants; folding the
+ * branches that become constant and removing the dead paths is left to the
+ * simplifier.  The work done is proportional to the number of definitions and
+ * uses rather than to the number of locals times the number of blocks, which
+ * makes this usable on methods too large for the bit vector based analyses.
+ */
+class TR_SparseConditionalConstantPropagation : public TR::Optimization
+   {
+   public:
+   TR_SparseConditionalConstantPropagation(TR::OptimizationManager *manager);
+   static TR::Optimization *create(TR::OptimizationManager *manager)
+      {
+      return new (manager->allocator()) TR_SparseConditionalConstantPropagation(manager);
+      }
+
+   virtual int32_t perform();
+   virtual const char * optDetailString() const throw();
+
+   private:
+
+   enum LatticeState
+      {
+      Top,        // no executable definition seen yet
+      Constant,
+      Bottom      // not a constant
+      };
+
+   struct LatticeValue
+      {
+      LatticeState _state;
+      int64_t _value;
+      };
+
+   /**
+    * A store or conditional branch evaluated again when the value of one of
+    * the definitions it uses changes, or a phi using the definition
+    */
+   struct Use
+      {
+      TR::Node *_node;
+      TR::Block *_block;
+      int32_t _phi;
+      int32_t _next;
+      };
+
+   typedef TR::vector<int32_t, TR::Region&> IndexVector;
+
+   void collectUses();
+   void collectUses(TR::Node *node, TR::Node *user, TR::Block *block, int32_t stamp);
+   void addUse(int32_t def, TR::Node *node, TR::Block *block, int32_t phi);
+
+   void propagate();
+   void visitBlock(TR::Block *block);
+   void visitPhi(int32_t phi);
+   void visitUser(TR::Node *node, TR::Block *block);
+   void visitBranch(TR::Node *node, TR::Block *block);
+   void markSuccessorsExecutable(TR::Block *block, TR::Block *onlyTo);
+   void markEdgeExecutable(TR::Block *from, TR::Block *to);
+   void lowerValue(int32_t def, LatticeValue value);
+
+   LatticeValue evaluate(TR::Node *node);
+   LatticeValue evaluateUncached(TR::Node *node);
+   bool isTrackedType(TR::Node *node);
+   LatticeValue constant(TR::Node *node, int64_t value);
+   static LatticeValue meet(LatticeValue first, LatticeValue second);
+
+   int32_t transform();
+
+   TR_SSAForm *_ssa;
+   TR::vector<LatticeValue, TR::Region&> *_values;   // by definition
+   TR::vector<Use, TR::Region&> *_uses;
+   IndexVector *_firstUse;                            // by definition
+   TR_BitVector *_executableBlocks;
+   TR_BitVector *_executableEdges;
+   IndexVector *_blockWorklist;
+   IndexVector *_defWorklist;
+
+   // Memoized values of the nodes of the tree being evaluated, so that a
+   // commoned subtree is evaluated once per evaluation
+   //
+   TR::vector<LatticeValue, TR::Region&> *_nodeValues;
+   IndexVector *_nodeValueStamps;
+   int32_t _evaluationStamp;
+   };
+
+#endif
@@ -0,0 +1,103 @@
+/*******************************************************************************
+ * Copyright (c) 2020, 2020 IBM Corp. and others
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at https://www.eclipse.org/legal/epl-2.0/
+ * or the Apache License, Version 2.0 which accompanies this distribution and
+ * is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following
+ * Secondary Licenses when the conditions for such availability set
+ * forth in the Eclipse Public License, v. 2.0 are satisfied: GNU
+ * General Public License, version 2 with the GNU Classpath
+ * Exception [1] and GNU General Public License, version 2 with the
+ * OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] http://openjdk.java.net/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
+ *******************************************************************************/
+
+#include "optimizer/SparseCopyPropagation.hpp"
+
+#include <stdint.h>
+#include "compile/Compilation.hpp"
+#include "env/StackMemoryRegion.hpp"
+#include "env/TRMemory.hpp"
+#include "il/Block.hpp"
+#include "il/Node.hpp"
+#include "il/Node_inlines.hpp"
+#include "il/SymbolReference.hpp"
+#include "il/TreeTop.hpp"
+#include "il/TreeTop_inlines.hpp"
+#include "infra/vector.hpp"
+#include "optimizer/Optimization_inlines.hpp"
+#include "optimizer/Optimizer.hpp"
+#include "optimizer/SSAForm.hpp"
+
+TR_SparseCopyPropagation::TR_SparseCopyPropagation(TR::OptimizationManager *manager)
+   : TR::Optimization(manager)
+   {}
+
+int32_t
+TR_SparseCopyPropagation::perform()
+   {
+   TR::StackMemoryRegion stackMemoryRegion(*trMemory());
+
+   TR_SSAForm ssa(comp(), trace());
+   if (!ssa.build())
+      return 0;
+
+   int32_t numTransformations = 0;
+   vcount_t visitCount = comp()->incVisitCount();
+   TR::vector<TR::Node *, TR::Region&> stack(comp()->trMemory()->currentStackRegion());
+
+   for (TR::TreeTop *tt = comp()->getStartTree(); tt; tt = tt->getNextTreeTop())
+      {
+      stack.push_back(tt->getNode());
+      while (!stack.empty())
+         {
+         TR::Node *node = stack.back();
+         stack.pop_back();
+         if (node->getVisitCount() == visitCount)
+            continue;
+         node->setVisitCount(visitCount);
+
+         if (!node->getOpCode().isLoadVarDirect())
+            {
+            for (int32_t i = 0; i < node->getNumChildren(); i++)
+               stack.push_back(node->getChild(i));
+            continue;
+            }
+
+         int32_t copy = ssa.getCopyForLoad(node);
+         if (copy < 0)
+            continue;
+
+         TR::SymbolReference *source = ssa.getLocalSymRef(ssa.getDef(copy)._local);
+         if (!performTransformation(comp(), "%sReplacing load [%p] of #%d with a load of #%d\n", optDetailString(),
+                                    node, node->getSymbolReference()->getReferenceNumber(), source->getReferenceNumber()))
+            continue;
+
+         node->setSymbolReference(source);
+         numTransformations++;
+         }
+      }
+
+   if (numTransformations > 0)
+      {
+      optimizer()->setUseDefInfo(NULL);
+      optimizer()->setValueNumberInfo(NULL);
+      requestOpt(OMR::globalDeadStoreElimination);
+      }
+
+   return numTransformations;
+   }
+
+const char *
+TR_SparseCopyPropagation::optDetailString() const throw()
+   {
+   return "O^O SPARSE COPY PROPAGATION: ";
+   }
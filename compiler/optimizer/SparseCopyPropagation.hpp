@@ -0,0 +1,53 @@
+/*******************************************************************************
+ * Copyright (c) 2020, 2020 IBM Corp. and others
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at https://www.eclipse.org/legal/epl-2.0/
+ * or the Apache License, Version 2.0 which accompanies this distribution and
+ * is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following
+ * Secondary Licenses when the conditions for such availability set
+ * forth in the Eclipse Public License, v. 2.0 are satisfied: GNU
+ * General Public License, version 2 with the GNU Classpath
+ * Exception [1] and GNU General Public License, version 2 with the
+ * OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] http://openjdk.java.net/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
+ *******************************************************************************/
+
+#ifndef SPARSECOPYPROP_INCL
+#define SPARSECOPYPROP_INCL
+
+#include <stdint.h>
+#include "optimizer/Optimization.hpp"
+#include "optimizer/OptimizationManager.hpp"
+
+/**
+ * Sparse copy propagation.
+ *
+ * Uses the SSA form of the method's locals (TR_SSAForm) to find loads of a
+ * local whose only reaching definition is a copy of another local, x = y,
+ * where the definition of y that was copied still reaches the load.  Such a
+ * load is changed to load y directly, leaving the copy to dead store
+ * elimination.  Unlike TR_CopyPropagation no use/def bit vectors are built,
+ * so the cost is linear in the size of the method.
+ */
+class TR_SparseCopyPropagation : public TR::Optimization
+   {
+   public:
+   TR_SparseCopyPropagation(TR::OptimizationManager *manager);
+   static TR::Optimization *create(TR::OptimizationManager *manager)
+      {
+      return new (manager->allocator()) TR_SparseCopyPropagation(manager);
+      }
+
+   virtual int32_t perform();
+   virtual const char * optDetailString() const throw();
+   };
+
+#endif
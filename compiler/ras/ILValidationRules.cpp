@@ -428,6 +428,18 @@ void TR::ValidateChildCount::validate(TR::Node *node)
  * A majority of these  expectations are defined in
  * `compiler/il/ILOpCodeProperties.hpp`.
  */
+/**
+ * The data type produced by a child node. Vector reductions have no fixed opcode
+ * type; their type is the element type of their vector operand.
+ */
+static TR::DataTypes
+getChildDataType(TR::Node *child)
+   {
+   if (child->getOpCode().isVectorReduction())
+      return child->getDataType().getDataType();
+   return child->getOpCode().getDataType().getDataType();
+   }
+
 TR::ValidateChildTypes::ValidateChildTypes(TR::Compilation *comp)
    : TR::NodeValidationRule(comp, OMR::validateChildTypes)
    {
@@ -447,7 +459,7 @@ void TR::ValidateChildTypes::validate(TR::Node *node)
          if (childOpcode.getOpCodeValue() != TR::GlRegDeps)
             {
             const auto expChildType = opcode.expectedChildType(i);
-            const auto actChildType = childOpcode.getDataType().getDataType();
+            const auto actChildType = getChildDataType(node->getChild(i));
             const auto expChildTypeName = (expChildType >= TR::NumTypes) ?
                                            "UnspecifiedChildType" :
                                            TR::DataType::getName(expChildType);
@@ -485,8 +497,7 @@ void TR::Validate_ireturnReturnType::validate(TR::Node *node)
       const auto childCount = node->getNumChildren();
       for (auto i = 0; i < childCount; ++i)
          {
-         auto childOpcode = node->getChild(i)->getOpCode();
-         const auto actChildType = childOpcode.getDataType().getDataType();
+         const auto actChildType = getChildDataType(node->getChild(i));
          const auto childTypeName = TR::DataType::getName(actChildType);
          TR::checkILCondition(node, (actChildType == TR::Int32 ||
                                      actChildType == TR::Int16 ||
@@ -30,10 +30,13 @@
 
 #include <stddef.h>
 #include <stdint.h>
+#include <set>
+#include <utility>
 #if defined(CODECACHE_DEBUG)
 #include <stdio.h>
 #endif /* CODECACHE_DEBUG */
 
+#include "env/RawAllocator.hpp"
 #include "runtime/MethodExceptionData.hpp"
 
 /*
@@ -164,6 +167,35 @@ struct CodeCacheFreeCacheBlock
    };
 #define MIN_SIZE_BLOCK (sizeof(CodeCacheFreeCacheBlock) > 96 ? sizeof(CodeCacheFreeCacheBlock) : 96)
 
+/**
+ * @brief Index over the free blocks of a code cache.
+ *
+ * The free blocks themselves live in the code cache and stay linked in
+ * address order through their _next field. The index keeps them ordered by
+ * address, to find the neighbours a new free block coalesces with, and by
+ * size separately for the warm and cold regions, to find the best fit for
+ * an allocation. Every lookup is logarithmic in the number of free blocks.
+ */
+struct CodeCacheFreeBlockIndex
+   {
+   typedef TR::typed_allocator<CodeCacheFreeCacheBlock *, TR::RawAllocator> AddressAllocator;
+   typedef std::set<CodeCacheFreeCacheBlock *, std::less<CodeCacheFreeCacheBlock *>, AddressAllocator> AddressIndex;
+
+   typedef std::pair<size_t, CodeCacheFreeCacheBlock *> SizeKey;
+   typedef TR::typed_allocator<SizeKey, TR::RawAllocator> SizeAllocator;
+   typedef std::set<SizeKey, std::less<SizeKey>, SizeAllocator> SizeIndex;
+
+   CodeCacheFreeBlockIndex(TR::RawAllocator rawAllocator) :
+      _byAddress(std::less<CodeCacheFreeCacheBlock *>(), AddressAllocator(rawAllocator)),
+      _warmBySize(std::less<SizeKey>(), SizeAllocator(rawAllocator)),
+      _coldBySize(std::less<SizeKey>(), SizeAllocator(rawAllocator))
+      {}
+
+   AddressIndex _byAddress;
+   SizeIndex _warmBySize;
+   SizeIndex _coldBySize;
+   };
+
 
 struct FaintCacheBlock
    {
@@ -0,0 +1,351 @@
+/*******************************************************************************
+ * Copyright (c) 2020, 2020 IBM Corp. and others
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at https://www.eclipse.org/legal/epl-2.0/
+ * or the Apache License, Version 2.0 which accompanies this distribution and
+ * is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following
+ * Secondary Licenses when the conditions for such availability set
+ * forth in the Eclipse Public License, v. 2.0 are satisfied: GNU
+ * General Public License, version 2 with the GNU Classpath
+ * Exception [1] and GNU General Public License, version 2 with the
+ * OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] http://openjdk.java.net/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
+ *******************************************************************************/
+
+#ifndef TR_CODERANGEINDEX_INCL
+#define TR_CODERANGEINDEX_INCL
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include "env/RawAllocator.hpp"
+#include "infra/Assert.hpp"
+#include "infra/vector.hpp"
+#include "AtomicSupport.hpp"
+
+namespace TR
+{
+
+/**
+ * @brief A sorted index of disjoint address ranges [start, end) that can be
+ *        searched without taking a lock.
+ *
+ * Lookups are meant for stack walkers, exception handlers, profilers and
+ * signal handlers that must map a PC to the code cache or method body that
+ * contains it. They neither allocate nor block; they binary search an
+ * immutable snapshot of the index.
+ *
+ * The snapshot is a sorted array of leaves, each of which is a sorted array
+ * of at most LeafCapacity ranges. An update copies the one leaf it changes
+ * and the array of leaf pointers, then publishes the new snapshot with a
+ * single store. Unchanged leaves are shared between snapshots, so an update
+ * costs O(n / LeafCapacity + LeafCapacity) while a lookup is O(log n).
+ *
+ * Replaced leaves and snapshots are retired and freed by the next update
+ * that finds no lookup in progress. Updates must be serialized by the
+ * caller; lookups may run concurrently with them and with each other.
+ */
+template <typename T>
+class CodeRangeIndex
+   {
+   public:
+
+   static const size_t LeafCapacity = 64;
+
+   CodeRangeIndex(TR::RawAllocator rawAllocator) :
+      _rawAllocator(rawAllocator),
+      _snapshot(NULL),
+      _activeLookups(0),
+      _retired(TR::vector<void *, TR::RawAllocator>::allocator_type(rawAllocator))
+      {}
+
+   ~CodeRangeIndex()
+      {
+      Snapshot *snapshot = const_cast<Snapshot *>(_snapshot);
+      if (snapshot)
+         {
+         for (size_t i = 0; i < snapshot->_numLeaves; i++)
+            _rawAllocator.deallocate(snapshot->_leaves[i]);
+         _rawAllocator.deallocate(snapshot);
+         }
+      freeRetired();
+      }
+
+   /**
+    * @brief Finds the value whose range contains the given address
+    *
+    * Safe to call from any thread, including from a signal handler, while
+    * another thread updates the index.
+    *
+    * @param[in] address : the address to look up
+    * @return the value of the range containing address, or NULL
+    */
+   T *find(uintptr_t address)
+      {
+      VM_AtomicSupport::add(&_activeLookups, 1);
+      T *value = NULL;
+      Snapshot *snapshot = const_cast<Snapshot *>(_snapshot);
+      if (snapshot)
+         {
+         size_t leafIndex = findLeaf(snapshot, address);
+         Leaf *leaf = snapshot->_leaves[leafIndex];
+         size_t entryIndex = findEntry(leaf, address);
+         if (entryIndex < leaf->_count &&
+             leaf->_entries[entryIndex]._start <= address &&
+             address < leaf->_entries[entryIndex]._end)
+            value = leaf->_entries[entryIndex]._value;
+         }
+      VM_AtomicSupport::subtract(&_activeLookups, 1);
+      return value;
+      }
+
+   /**
+    * @brief Adds the range [start, end) mapping to value
+    *
+    * The range must not overlap a range already in the index.
+    * Must not run concurrently with another update.
+    *
+    * @return true on success; false if memory could not be allocated
+    */
+   bool insert(uintptr_t start, uintptr_t end, T *value)
+      {
+      TR_ASSERT(start < end, "Empty range [%p, %p)", (void *)start, (void *)end);
+      Snapshot *oldSnapshot = const_cast<Snapshot *>(_snapshot);
+
+      Entry entry = { start, end, value };
+      if (!oldSnapshot)
+         {
+         Snapshot *newSnapshot = allocateSnapshot(1);
+         Leaf *leaf = allocateLeaf();
+         if (!newSnapshot || !leaf)
+            {
+            _rawAllocator.deallocate(newSnapshot);
+            _rawAllocator.deallocate(leaf);
+            return false;
+            }
+         leaf->_count = 1;
+         leaf->_entries[0] = entry;
+         newSnapshot->_leaves[0] = leaf;
+         newSnapshot->_numEntries = 1;
+         publish(newSnapshot, NULL, NULL);
+         return true;
+         }
+
+      size_t leafIndex = findLeaf(oldSnapshot, start);
+      Leaf *oldLeaf = oldSnapshot->_leaves[leafIndex];
+      size_t position = findEntry(oldLeaf, start);
+      if (position < oldLeaf->_count && oldLeaf->_entries[position]._start <= start)
+         position++; // insert after the last range starting at or below start
+
+      TR_ASSERT(position == 0 || oldLeaf->_entries[position - 1]._end <= start, "Range [%p, %p) overlaps an existing range", (void *)start, (void *)end);
+      TR_ASSERT(position == oldLeaf->_count || end <= oldLeaf->_entries[position]._start, "Range [%p, %p) overlaps an existing range", (void *)start, (void *)end);
+
+      // Build the new contents of the leaf, then split it if it is too big
+      Entry entries[LeafCapacity + 1];
+      memcpy(entries, oldLeaf->_entries, position * sizeof(Entry));
+      entries[position] = entry;
+      memcpy(entries + position + 1, oldLeaf->_entries + position, (oldLeaf->_count - position) * sizeof(Entry));
+      size_t count = oldLeaf->_count + 1;
+
+      size_t numNewLeaves = (count > LeafCapacity) ? 2 : 1;
+      Snapshot *newSnapshot = allocateSnapshot(oldSnapshot->_numLeaves + numNewLeaves - 1);
+      Leaf *newLeaves[2] = { allocateLeaf(), (numNewLeaves == 2) ? allocateLeaf() : NULL };
+      if (!newSnapshot || !newLeaves[0] || (numNewLeaves == 2 && !newLeaves[1]))
+         {
+         _rawAllocator.deallocate(newSnapshot);
+         _rawAllocator.deallocate(newLeaves[0]);
+         _rawAllocator.deallocate(newLeaves[1]);
+         return false;
+         }
+
+      size_t firstCount = count / numNewLeaves;
+      newLeaves[0]->_count = firstCount;
+      memcpy(newLeaves[0]->_entries, entries, firstCount * sizeof(Entry));
+      if (numNewLeaves == 2)
+         {
+         newLeaves[1]->_count = count - firstCount;
+         memcpy(newLeaves[1]->_entries, entries + firstCount, (count - firstCount) * sizeof(Entry));
+         }
+
+      replaceLeaf(oldSnapshot, newSnapshot, leafIndex, newLeaves, numNewLeaves);
+      newSnapshot->_numEntries = oldSnapshot->_numEntries + 1;
+      publish(newSnapshot, oldSnapshot, oldLeaf);
+      return true;
+      }
+
+   /**
+    * @brief Removes the range starting at start
+    *
+    * Must not run concurrently with another update.
+    *
+    * @return true if a range was removed; false if there is no range
+    *         starting at start or memory could not be allocated
+    */
+   bool remove(uintptr_t start)
+      {
+      Snapshot *oldSnapshot = const_cast<Snapshot *>(_snapshot);
+      if (!oldSnapshot)
+         return false;
+
+      size_t leafIndex = findLeaf(oldSnapshot, start);
+      Leaf *oldLeaf = oldSnapshot->_leaves[leafIndex];
+      size_t position = findEntry(oldLeaf, start);
+      if (position == oldLeaf->_count || oldLeaf->_entries[position]._start != start)
+         return false;
+
+      size_t numNewLeaves = (oldLeaf->_count > 1) ? 1 : 0;
+      Snapshot *newSnapshot = NULL;
+      if (oldSnapshot->_numLeaves + numNewLeaves > 1)
+         {
+         newSnapshot = allocateSnapshot(oldSnapshot->_numLeaves + numNewLeaves - 1);
+         if (!newSnapshot)
+            return false;
+         }
+
+      Leaf *newLeaves[1] = { NULL };
+      if (numNewLeaves)
+         {
+         newLeaves[0] = allocateLeaf();
+         if (!newLeaves[0])
+            {
+            _rawAllocator.deallocate(newSnapshot);
+            return false;
+            }
+         newLeaves[0]->_count = oldLeaf->_count - 1;
+         memcpy(newLeaves[0]->_entries, oldLeaf->_entries, position * sizeof(Entry));
+         memcpy(newLeaves[0]->_entries + position, oldLeaf->_entries + position + 1, (oldLeaf->_count - position - 1) * sizeof(Entry));
+         }
+
+      if (newSnapshot)
+         {
+         replaceLeaf(oldSnapshot, newSnapshot, leafIndex, newLeaves, numNewLeaves);
+         newSnapshot->_numEntries = oldSnapshot->_numEntries - 1;
+         }
+      publish(newSnapshot, oldSnapshot, oldLeaf);
+      return true;
+      }
+
+   /**
+    * @brief Returns the number of ranges in the index
+    */
+   size_t size() { return _snapshot ? _snapshot->_numEntries : 0; }
+
+   private:
+
+   struct Entry
+      {
+      uintptr_t _start;
+      uintptr_t _end;
+      T *_value;
+      };
+
+   struct Leaf
+      {
+      size_t _count;
+      Entry _entries[LeafCapacity];
+      };
+
+   struct Snapshot
+      {
+      size_t _numEntries;
+      size_t _numLeaves;
+      Leaf *_leaves[1];
+      };
+
+   // Index of the last leaf whose first range starts at or below address,
+   // or 0 if there is none
+   static size_t findLeaf(Snapshot *snapshot, uintptr_t address)
+      {
+      size_t low = 0, high = snapshot->_numLeaves;
+      while (high - low > 1)
+         {
+         size_t middle = low + (high - low) / 2;
+         if (snapshot->_leaves[middle]->_entries[0]._start <= address)
+            low = middle;
+         else
+            high = middle;
+         }
+      return low;
+      }
+
+   // Index of the last range in the leaf that starts at or below address,
+   // or 0 if there is none
+   static size_t findEntry(Leaf *leaf, uintptr_t address)
+      {
+      size_t low = 0, high = leaf->_count;
+      while (high - low > 1)
+         {
+         size_t middle = low + (high - low) / 2;
+         if (leaf->_entries[middle]._start <= address)
+            low = middle;
+         else
+            high = middle;
+         }
+      return low;
+      }
+
+   Leaf *allocateLeaf()
+      {
+      return static_cast<Leaf *>(_rawAllocator.allocate(sizeof(Leaf), std::nothrow));
+      }
+
+   Snapshot *allocateSnapshot(size_t numLeaves)
+      {
+      Snapshot *snapshot = static_cast<Snapshot *>(_rawAllocator.allocate(sizeof(Snapshot) + (numLeaves - 1) * sizeof(Leaf *), std::nothrow));
+      if (snapshot)
+         snapshot->_numLeaves = numLeaves;
+      return snapshot;
+      }
+
+   static void replaceLeaf(Snapshot *oldSnapshot, Snapshot *newSnapshot, size_t leafIndex, Leaf **newLeaves, size_t numNewLeaves)
+      {
+      memcpy(newSnapshot->_leaves, oldSnapshot->_leaves, leafIndex * sizeof(Leaf *));
+      memcpy(newSnapshot->_leaves + leafIndex, newLeaves, numNewLeaves * sizeof(Leaf *));
+      memcpy(newSnapshot->_leaves + leafIndex + numNewLeaves,
+             oldSnapshot->_leaves + leafIndex + 1,
+             (oldSnapshot->_numLeaves - leafIndex - 1) * sizeof(Leaf *));
+      }
+
+   // Makes newSnapshot visible to lookups and retires the snapshot and leaf
+   // it replaces. Everything retired so far is freed if no lookup is in
+   // progress: a lookup that starts after the store below can only see the
+   // new snapshot.
+   void publish(Snapshot *newSnapshot, Snapshot *oldSnapshot, Leaf *oldLeaf)
+      {
+      VM_AtomicSupport::writeBarrier();
+      _snapshot = newSnapshot;
+      VM_AtomicSupport::readWriteBarrier();
+
+      if (oldSnapshot)
+         _retired.push_back(oldSnapshot);
+      if (oldLeaf)
+         _retired.push_back(oldLeaf);
+
+      if (_activeLookups == 0)
+         freeRetired();
+      }
+
+   void freeRetired()
+      {
+      for (size_t i = 0; i < _retired.size(); i++)
+         _rawAllocator.deallocate(_retired[i]);
+      _retired.clear();
+      }
+
+   TR::RawAllocator _rawAllocator;
+   Snapshot * volatile _snapshot;
+   volatile uintptr_t _activeLookups;
+   TR::vector<void *, TR::RawAllocator> _retired;
+   };
+
+}
+
+#endif
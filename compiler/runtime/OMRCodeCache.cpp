@@ -110,6 +110,13 @@ OMR::CodeCache::self()
 void
 OMR::CodeCache::destroy(TR::CodeCacheManager *manager)
    {
+   if (_freeBlockIndex)
+      {
+      _freeBlockIndex->~CodeCacheFreeBlockIndex();
+      manager->freeMemory(_freeBlockIndex);
+      _freeBlockIndex = NULL;
+      }
+
    while (_hashEntrySlab)
       {
       CodeCacheHashEntrySlab *slab = _hashEntrySlab;
@@ -289,6 +296,14 @@ OMR::CodeCache::initialize(TR::CodeCacheManager *manager,
       return false;
       }
 
+   void *freeBlockIndexMemory = manager->getMemory(sizeof(CodeCacheFreeBlockIndex));
+   if (!freeBlockIndexMemory)
+      {
+      _hashEntrySlab->free(manager);
+      return false;
+      }
+   _freeBlockIndex = new (freeBlockIndexMemory) CodeCacheFreeBlockIndex(TR::RawAllocator());
+
    _hashEntryFreeList = NULL;
    _freeBlockList     = NULL;
    _flags = 0;
@@ -968,98 +983,68 @@ OMR::CodeCache::addFreeBlock2WithCallSite(uint8_t *start,
       ((CodeCacheMethodHeader*)start)->_eyeCatcher[0] = 0;
 
    //fprintf(stderr, "--ccr-- newFreeBlock size %d at %p\n", size, start);
+   // Find the free blocks on either side of the new one
+   CodeCacheFreeBlockIndex::AddressIndex &byAddress = _freeBlockIndex->_byAddress;
+   CodeCacheFreeBlockIndex::AddressIndex::iterator after = byAddress.lower_bound((CodeCacheFreeCacheBlock *) start);
+   CodeCacheFreeCacheBlock *next = (after != byAddress.end()) ? *after : NULL;
+   CodeCacheFreeCacheBlock *prev = (after != byAddress.begin()) ? *(--after) : NULL;
+
+   // we should not merge warm blocks with cold blocks
+   bool mergeWithPrev = prev &&
+                        start - ((uint8_t *)prev + prev->_size) < sizeof(CodeCacheFreeCacheBlock) &&
+                        !((uint8_t *)prev < _warmCodeAlloc && start >= _coldCodeAlloc);
+   bool mergeWithNext = next &&
+                        (uint8_t *)next - end < sizeof(CodeCacheFreeCacheBlock) &&
+                        !(start < _warmCodeAlloc && (uint8_t *)next >= _coldCodeAlloc);
+
+   TR_ASSERT(!next || end <= (uint8_t *)next, "assertion failure"); // check for no overlap of blocks
+
    CodeCacheFreeCacheBlock *mergedBlock = NULL;
    CodeCacheFreeCacheBlock *link = NULL;
-   if (_freeBlockList)
+   if (mergeWithPrev && mergeWithNext)
       {
-      CodeCacheFreeCacheBlock *curr;
-      // find the insertion point
-      for (curr = _freeBlockList; curr->_next && (uint8_t *)(curr->_next) < start; curr = curr->_next)
-         {}
-
-      if (start < (uint8_t *)curr && (uint8_t *)curr - end < sizeof(CodeCacheFreeCacheBlock))
-         {
-         // merge with the curr block ahead, which is also the first block
-         TR_ASSERT(end <= (uint8_t *)curr, "assertion failure"); // check for no overlap of blocks
-         // we should not merge warm block with cold blocks
-         if (!(start < _warmCodeAlloc && (uint8_t *)curr >= _coldCodeAlloc))
-            {
-            // which is also the first block
-            link = (CodeCacheFreeCacheBlock *) start;
-            mergedBlock = curr;
-            //fprintf(stderr, "--ccr-- merging new free block of the size %d with a block of the size %d at %p\n", size, curr->size, link);
-            link->_size = (uint8_t *)curr + curr->_size - start;
-            link->_next = curr->_next;
-            _freeBlockList = link;
-            //fprintf(stderr, "--ccr-- new merged free block's size is %d\n", link->size);
-            }
-         }
-      else if (curr->_next && ((uint8_t *)curr->_next - end < sizeof(CodeCacheFreeCacheBlock)) &&
-         !(start < _warmCodeAlloc && (uint8_t *)curr->_next >= _coldCodeAlloc))
-         {
-         // merge with the next block, but don't merge warm blocks with cold blocks
-         if ((start - ((uint8_t *)curr + curr->_size) < sizeof(CodeCacheFreeCacheBlock)) &&
-             !((uint8_t *)curr < _warmCodeAlloc && start >= _coldCodeAlloc))
-            {
-            // merge with the previous and the next blocks
-            mergedBlock = curr;
-            //fprintf(stderr, "--ccr-- merging new free block of the size %d with blocks of the size %d and %d at %p\n", size, curr->_size, curr->_next->_size, curr);
-            curr->_size = (uint8_t *)curr->_next + curr->_next->_size - (uint8_t *)curr;
-            curr->_next = curr->_next->_next;
-            //fprintf(stderr, "--ccr-- new merged free block's size is %d\n", curr->_size);
-            link = curr;
+      // merge with the previous and the next blocks
+      mergedBlock = prev;
+      self()->unindexFreeBlock(next);
+      prev->_next = next->_next;
+      self()->resizeFreeBlock(prev, (uint8_t *)next + next->_size - (uint8_t *)prev);
+      link = prev;
 #ifdef DEBUG
-            start = (uint8_t *)curr;
+      start = (uint8_t *)prev;
 #endif
-            }
-         else
-            {
-            mergedBlock = curr->_next;
-            link = (CodeCacheFreeCacheBlock *) start;
-            //fprintf(stderr, "--ccr-- merging new free block of the size %d with a block of the size %d at %p\n", size, curr->next->size, link);
-            link->_size = (uint8_t *)curr->_next + curr->_next->_size - start;
-            link->_next = curr->_next->_next;
-            curr->_next = link;
-            //fprintf(stderr, "--ccr-- new merged free block's size is %d\n", link->_size);
-            }
-         }
-      else if ((uint8_t *)curr < start && start - ((uint8_t *)curr + curr->_size) < sizeof(CodeCacheFreeCacheBlock))
-         {
-         // merge with the previous block
-         if (!((uint8_t *)curr < _warmCodeAlloc && start >= _coldCodeAlloc))
-            {
-            mergedBlock = curr;
-            curr->_size = start + size - (uint8_t *)curr;
-            //fprintf(stderr, "--ccr-- new merged free block's size is %d\n", curr->_size);
-            link = curr;
+      }
+   else if (mergeWithPrev)
+      {
+      mergedBlock = prev;
+      self()->resizeFreeBlock(prev, end - (uint8_t *)prev);
+      link = prev;
 #ifdef DEBUG
-            start = (uint8_t *)curr;
+      start = (uint8_t *)prev;
 #endif
-            }
-         }
-      if (!link) // no merging happened
-         {
-         link = (CodeCacheFreeCacheBlock *) start;
-         link->_size = size;
-         if (start < (uint8_t *)curr)
-            {
-            link->_next = _freeBlockList;
-            _freeBlockList = link;
-            }
-         else
-            {
-            link->_next = curr->_next;
-            curr->_next = link;
-            }
-         }
       }
-   else // This is the first block in the list
+   else if (mergeWithNext)
+      {
+      // the new block takes the place of the next block
+      mergedBlock = next;
+      self()->unindexFreeBlock(next);
+      link = (CodeCacheFreeCacheBlock *) start;
+      link->_size = (uint8_t *)next + next->_size - start;
+      link->_next = next->_next;
+      }
+   else // no merging happened
+      {
+      link = (CodeCacheFreeCacheBlock *) start;
+      link->_size = size;
+      link->_next = next;
+      }
+
+   if (link != prev)
       {
-      _freeBlockList = (CodeCacheFreeCacheBlock *) start;
-      _freeBlockList->_size = size;
-      _freeBlockList->_next = NULL;
-      //updateMaxSizeOfFreeBlocks(_freeBlockList, _freeBlockList->_size);
-      link = _freeBlockList;
+      if (prev)
+         prev->_next = link;
+      else
+         _freeBlockList = link;
+      self()->indexFreeBlock(link);
       }
 
    self()->updateMaxSizeOfFreeBlocks(link, link->_size);
@@ -1112,69 +1097,14 @@ OMR::CodeCache::updateMaxSizeOfFreeBlocks(CodeCacheFreeCacheBlock *blockPtr, siz
 uint8_t *
 OMR::CodeCache::findFreeBlock(size_t size, bool isCold, bool isMethodHeaderNeeded)
    {
-   CodeCacheFreeCacheBlock *currLink;
-   CodeCacheFreeCacheBlock *prevLink;
-   CodeCacheFreeCacheBlock *bestFitLink = NULL, *bestFitLinkPrev = NULL;
-   CodeCacheFreeCacheBlock *biggestLink = NULL;
-   CodeCacheFreeCacheBlock *secondBiggestLink = NULL;
-
    TR_ASSERT(_freeBlockList, "Because we first checked that a freeBlockExists, freeBlockList cannot be null");
 
-   // Find the smallest free link to fit the requested blockSize
-   for (currLink = _freeBlockList, prevLink = NULL; currLink; prevLink = currLink, currLink = currLink->_next)
-      {
-      if (isCold)
-         {
-         if ((void*)currLink < (void*)_coldCodeAlloc)
-            continue;
-         }
-      else
-         {
-         if ((void*)currLink >= (void*)_warmCodeAlloc)
-            continue;
-         // curLink is warm code
-         }
-
-      //fprintf(stderr, "cache %p findFreeBlock bs=%u\n", this, currLink->size);
-      if (!biggestLink)
-         {
-         biggestLink = currLink;
-         }
-      else
-         {
-         if (currLink->_size >= biggestLink->_size) // >= is important; do not use > only as secondBiggestLink may be wrong
-            {
-            secondBiggestLink = biggestLink;
-            biggestLink = currLink;
-            }
-         else
-            {
-            if (secondBiggestLink)
-               {
-               if (currLink->_size >= secondBiggestLink->_size)
-                  secondBiggestLink = currLink;
-               }
-            else
-               {
-               secondBiggestLink = currLink;
-               }
-            }
-         }
-
-      if (currLink->_size >= size)
-         {
-         if (!bestFitLink)
-            {
-            bestFitLink = currLink;
-            bestFitLinkPrev = prevLink;
-            }
-         else if (bestFitLink->_size > currLink->_size)
-            {
-            bestFitLink = currLink;
-            bestFitLinkPrev = prevLink;
-            }
-         }
-      } // end for
+   // Find the smallest free link to fit the requested blockSize; among links
+   // of the same size the one with the lowest address is chosen
+   CodeCacheFreeBlockIndex::SizeIndex &bySize = isCold ? _freeBlockIndex->_coldBySize : _freeBlockIndex->_warmBySize;
+   CodeCacheFreeBlockIndex::SizeIndex::iterator bestFit = bySize.lower_bound(CodeCacheFreeBlockIndex::SizeKey(size, NULL));
+   CodeCacheFreeCacheBlock *bestFitLink = (bestFit != bySize.end()) ? bestFit->second : NULL;
+   CodeCacheFreeCacheBlock *biggestLink = !bySize.empty() ? bySize.rbegin()->second : NULL;
 
    // safety net
    TR_ASSERT(biggestLink, "There must be a biggestLink");
@@ -1197,13 +1127,11 @@ OMR::CodeCache::findFreeBlock(size_t size, bool isCold, bool isMethodHeaderNeede
       {
       // Fix the linked list by removing the allocated block AND if there is any unused
       // space left in the currLink chunk, reclaim it and put back on the freeList
-      CodeCacheFreeCacheBlock *leftBlock = self()->removeFreeBlock(size, bestFitLinkPrev, bestFitLink);
+      CodeCacheFreeCacheBlock *leftBlock = self()->removeFreeBlock(size, self()->previousFreeBlock(bestFitLink), bestFitLink);
 
       if (bestFitLink == biggestLink)  // Size of biggest might have changed
          {
-         uint64_t leftBlockSize     = leftBlock ? leftBlock->_size : 0;
-         uint64_t secondBiggestSize = secondBiggestLink ? secondBiggestLink->_size : 0;
-         uint64_t biggestSize       = leftBlockSize > secondBiggestSize ? leftBlockSize : secondBiggestSize;
+         uint64_t biggestSize = !bySize.empty() ? bySize.rbegin()->first : 0;
          if (!isCold)
             {
             _sizeOfLargestFreeWarmBlock = (size_t)biggestSize;
@@ -1246,6 +1174,8 @@ OMR::CodeCache::removeFreeBlock(size_t blockSize,
    {
    CodeCacheFreeCacheBlock *next = curr->_next;
 
+   self()->unindexFreeBlock(curr);
+
    // Is there any left over space in the current link? Save it as a
    // separate link and adjust the sizes of the two split resulting blocks
    if (curr->_size - blockSize >= MIN_SIZE_BLOCK)
@@ -1260,6 +1190,7 @@ OMR::CodeCache::removeFreeBlock(size_t blockSize,
          prev->_next = curr;
       else
          _freeBlockList = curr;
+      self()->indexFreeBlock(curr);
       return curr;
       }
    else // Use the entire block
@@ -1273,6 +1204,52 @@ OMR::CodeCache::removeFreeBlock(size_t blockSize,
    }
 
 
+// Free blocks in the warm region are indexed separately from free blocks in
+// the cold region. A free block never moves between regions: warm blocks
+// stay below _warmCodeAlloc and cold blocks at or above _coldCodeAlloc.
+//
+OMR::CodeCacheFreeBlockIndex::SizeIndex &
+OMR::CodeCache::freeBlocksBySize(CodeCacheFreeCacheBlock *block)
+   {
+   return ((uint8_t *)block < _warmCodeAlloc) ? _freeBlockIndex->_warmBySize : _freeBlockIndex->_coldBySize;
+   }
+
+void
+OMR::CodeCache::indexFreeBlock(CodeCacheFreeCacheBlock *block)
+   {
+   _freeBlockIndex->_byAddress.insert(block);
+   self()->freeBlocksBySize(block).insert(CodeCacheFreeBlockIndex::SizeKey(block->_size, block));
+   }
+
+void
+OMR::CodeCache::unindexFreeBlock(CodeCacheFreeCacheBlock *block)
+   {
+   _freeBlockIndex->_byAddress.erase(block);
+   self()->freeBlocksBySize(block).erase(CodeCacheFreeBlockIndex::SizeKey(block->_size, block));
+   }
+
+void
+OMR::CodeCache::resizeFreeBlock(CodeCacheFreeCacheBlock *block, size_t newSize)
+   {
+   CodeCacheFreeBlockIndex::SizeIndex &bySize = self()->freeBlocksBySize(block);
+   bySize.erase(CodeCacheFreeBlockIndex::SizeKey(block->_size, block));
+   block->_size = newSize;
+   bySize.insert(CodeCacheFreeBlockIndex::SizeKey(block->_size, block));
+   }
+
+// Returns the free block that precedes the given free block in the list of
+// free blocks, or NULL if the given block is the first one
+//
+OMR::CodeCacheFreeCacheBlock *
+OMR::CodeCache::previousFreeBlock(CodeCacheFreeCacheBlock *block)
+   {
+   CodeCacheFreeBlockIndex::AddressIndex &byAddress = _freeBlockIndex->_byAddress;
+   CodeCacheFreeBlockIndex::AddressIndex::iterator blockEntry = byAddress.find(block);
+   TR_ASSERT(blockEntry != byAddress.end(), "Free block %p is missing from the free block index", block);
+   return (blockEntry != byAddress.begin()) ? *(--blockEntry) : NULL;
+   }
+
+
 void
 OMR::CodeCache::dumpCodeCache()
    {
@@ -1307,6 +1284,22 @@ OMR::CodeCache::printOccupancyStats()
             }
          }
       fprintf(stderr, "\n");
+
+      // Fragmentation is the share of the free space in a region that cannot
+      // be handed out as a single block, i.e. 1 - largest / total
+      //
+      CacheCriticalSection freeBlockStats(self());
+      for (int32_t isCold = 0; isCold <= 1; isCold++)
+         {
+         CodeCacheFreeBlockIndex::SizeIndex &bySize = isCold ? _freeBlockIndex->_coldBySize : _freeBlockIndex->_warmBySize;
+         size_t totalFree = 0;
+         for (CodeCacheFreeBlockIndex::SizeIndex::iterator it = bySize.begin(); it != bySize.end(); ++it)
+            totalFree += it->first;
+         size_t largestFree = !bySize.empty() ? bySize.rbegin()->first : 0;
+         size_t fragmentation = totalFree ? 100 - (largestFree * 100) / totalFree : 0;
+         fprintf(stderr, "   %s free blocks = %6" OMR_PRIuSIZE " total = %8" OMR_PRIuSIZE " bytes largest = %8" OMR_PRIuSIZE " bytes fragmentation = %3" OMR_PRIuSIZE "%%\n",
+            isCold ? "cold" : "warm", (size_t)bySize.size(), totalFree, largestFree, fragmentation);
+         }
       }
 
    TR::CodeCacheConfig &config = _manager->codeCacheConfig();
@@ -1352,6 +1345,7 @@ OMR::CodeCache::checkForErrors()
       {
       bool doCrash = false;
       size_t maxFreeWarmSize = 0, maxFreeColdSize = 0;
+      size_t numFreeBlocks = 0;
       // scope for cache walk
          {
          CacheCriticalSection walkFreeList(self());
@@ -1410,6 +1404,14 @@ OMR::CodeCache::checkForErrors()
                      }
                   }
                }
+            // Is the block indexed under its current size?
+            if (!_freeBlockIndex->_byAddress.count(currLink) ||
+                !self()->freeBlocksBySize(currLink).count(CodeCacheFreeBlockIndex::SizeKey(currLink->_size, currLink)))
+               {
+               fprintf(stderr, "checkForErrors cache %p: Error: free block %p of size %u is missing from the free block index\n", this, currLink, (uint32_t)currLink->_size);
+               doCrash = true;
+               }
+            numFreeBlocks++;
             if ((uint8_t*)currLink < _warmCodeAlloc) // warm block
                {
                if (currLink->_size > maxFreeWarmSize)
@@ -1421,6 +1423,12 @@ OMR::CodeCache::checkForErrors()
                   maxFreeColdSize = currLink->_size;
                }
             } // end for
+         if (_freeBlockIndex->_byAddress.size() != numFreeBlocks ||
+             _freeBlockIndex->_warmBySize.size() + _freeBlockIndex->_coldBySize.size() != numFreeBlocks)
+            {
+            fprintf(stderr, "checkForErrors cache %p: Error: free block index has %" OMR_PRIuSIZE " entries but there are %" OMR_PRIuSIZE " free blocks\n", this, (size_t)_freeBlockIndex->_byAddress.size(), numFreeBlocks);
+            doCrash = true;
+            }
          if (_sizeOfLargestFreeWarmBlock != maxFreeWarmSize)
             {
             fprintf(stderr, "checkForErrors cache %p: Error: _sizeOfLargestFreeWarmBlock(%" OMR_PRIuSIZE ") != maxFreeWarmSize(%" OMR_PRIuSIZE ")\n", this, _sizeOfLargestFreeWarmBlock, maxFreeWarmSize);
@@ -1443,14 +1451,8 @@ OMR::CodeCache::checkForErrors()
          while (start < this->_trampolineBase)
             {
             // Is it a free segment?
-            bool freeSeg = false;
-            CodeCacheFreeCacheBlock *currLink = _freeBlockList;
-            for (; currLink; currLink = currLink->_next)
-               if (start == (uint8_t *)currLink)
-                  {
-                  freeSeg = true;
-                  break;
-                  }
+            CodeCacheFreeCacheBlock *currLink = (CodeCacheFreeCacheBlock *)start;
+            bool freeSeg = _freeBlockIndex->_byAddress.count(currLink) != 0;
                if (freeSeg)
                   {
                   prevBlock = start;
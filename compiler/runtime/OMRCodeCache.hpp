@@ -175,6 +175,11 @@ public:
    uint32_t                   tempTrampolinesMax()                  { return _tempTrampolinesMax; }
    bool                       addResolvedMethod(TR_OpaqueMethodBlock *method);
 
+   /**
+    * @brief Prints the occupancy of this code cache to stderr, including the
+    *        number, total and largest size of the free blocks in each region
+    *        and how fragmented that free space is.
+    */
    void                       printOccupancyStats();
    void                       printFreeBlocks();
    void                       checkForErrors();
@@ -227,6 +232,12 @@ private:
                                               CodeCacheFreeCacheBlock *prev,
                                               CodeCacheFreeCacheBlock *curr);
 
+   CodeCacheFreeBlockIndex::SizeIndex &freeBlocksBySize(CodeCacheFreeCacheBlock *block);
+   void                       indexFreeBlock(CodeCacheFreeCacheBlock *block);
+   void                       unindexFreeBlock(CodeCacheFreeCacheBlock *block);
+   void                       resizeFreeBlock(CodeCacheFreeCacheBlock *block, size_t newSize);
+   CodeCacheFreeCacheBlock *  previousFreeBlock(CodeCacheFreeCacheBlock *block);
+
 public:
    bool                       addFreeBlock2WithCallSite(uint8_t *start,
                                                         uint8_t *end,
@@ -299,6 +310,9 @@ public:
    /**
     * @brief Setter for freeBlockList
     *
+    * The free block index is not updated; use addFreeBlock2 to add free
+    * blocks to a code cache that allocates from its free blocks.
+    *
     * @param[in] : The new head of the CodeCacheFreeCacheBlock list
     */
    void setFreeBlockList(CodeCacheFreeCacheBlock *fcb) { _freeBlockList = fcb; }
@@ -416,6 +430,7 @@ public:
    TR::CodeCacheMemorySegment *_segment;
 
    CodeCacheFreeCacheBlock *_freeBlockList;
+   CodeCacheFreeBlockIndex *_freeBlockIndex;
 
    // This is used in an attempt to enforce mutually exclusive ownership.
    // flag accessed under mutex <== This is deceiving! There are two different monitors we may hold (not at the same time!) when we write to this.
@@ -55,6 +55,8 @@ TR::CodeCacheSymbolContainer * OMR::CodeCacheManager::_symbolContainer = NULL;
 
 OMR::CodeCacheManager::CodeCacheManager(TR::RawAllocator rawAllocator) :
    _rawAllocator(rawAllocator),
+   _codeCacheRangeIndex(rawAllocator),
+   _codeCacheRangeIndexIncomplete(false),
    _initialized(false),
    _codeCacheFull(false),
    _currTotalUsedInBytes(0),
@@ -85,6 +87,11 @@ OMR::CodeCacheManager::UsageMonitorCriticalSection::UsageMonitorCriticalSection(
    {
    }
 
+OMR::CodeCacheManager::SymbolMonitorCriticalSection::SymbolMonitorCriticalSection(TR::CodeCacheManager *mgr)
+   : CriticalSection(mgr->_symbolMonitor)
+   {
+   }
+
 TR::CodeCache *
 OMR::CodeCacheManager::initialize(
       bool allocateMonolithicCodeCache,
@@ -150,6 +157,9 @@ OMR::CodeCacheManager::initialize(
    if (!(_usageMonitor = TR::Monitor::create("CodeCacheUsageMonitor")))
       return NULL;
 
+   if (!(_symbolMonitor = TR::Monitor::create("CodeCacheSymbolMonitor")))
+      return NULL;
+
 #if defined(TR_HOST_POWER)
    #define REACHEABLE_RANGE_KB (32*1024)
 #elif defined(TR_HOST_ARM64)
@@ -228,6 +238,10 @@ OMR::CodeCacheManager::destroy()
    while (codeCache != NULL)
       {
       TR::CodeCache *nextCache = codeCache->next();
+         {
+         CacheListCriticalSection updateCacheList(self());
+         _codeCacheRangeIndex.remove(reinterpret_cast<uintptr_t>(codeCache->getCodeBase()));
+         }
       codeCache->destroy(self());
       self()->freeMemory(codeCache);
       codeCache = nextCache;
@@ -283,6 +297,12 @@ OMR::CodeCacheManager::addCodeCache(TR::CodeCache *codeCache)
    FLUSH_MEMORY(true);  // Insure codeCache contents are globally visible before adding it to the list!
    _codeCacheList._head = codeCache;
    _curNumberOfCodeCaches++;
+
+   // helperTop is heapTop, the end of the code cache
+   if (!_codeCacheRangeIndex.insert(reinterpret_cast<uintptr_t>(codeCache->getCodeBase()),
+                                    reinterpret_cast<uintptr_t>(codeCache->getHelperTop()),
+                                    codeCache))
+      _codeCacheRangeIndexIncomplete = true;
    }
 
 
@@ -467,11 +487,12 @@ OMR::CodeCacheManager::performSizeAdjustments(size_t &warmCodeSize,
 TR::CodeCache *
 OMR::CodeCacheManager::findCodeCacheFromPC(void *inCacheAddress)
    {
-   TR::CodeCache *codeCache = self()->getFirstCodeCache();
-   if (!codeCache)
-      return NULL;
+   TR::CodeCache *codeCache = _codeCacheRangeIndex.find(reinterpret_cast<uintptr_t>(inCacheAddress));
+   if (codeCache || !_codeCacheRangeIndexIncomplete)
+      return codeCache;
 
-   /* scan all code caches to see if they encompass inCacheAddress */
+   /* the index is missing a code cache; scan all code caches to see if they encompass inCacheAddress */
+   codeCache = self()->getFirstCodeCache();
    while (codeCache)
       {
       /* helperTop is heapTop */
@@ -876,6 +897,10 @@ OMR::CodeCacheManager::repositoryCodeCacheCreated()
 #endif // HOST_OS == OMR_LINUX
    }
 
+// Symbols and relocations are built outside of the symbol monitor; only the
+// linking into the containers is done while holding it, so compilation
+// threads registering their methods contend for a handful of stores.
+//
 void
 OMR::CodeCacheManager::registerCompiledMethod(const char *sig, uint8_t *startPC, uint32_t codeSize)
    {
@@ -890,6 +915,16 @@ OMR::CodeCacheManager::registerCompiledMethod(const char *sig, uint8_t *startPC,
    newSymbol->_start = startPC;
    newSymbol->_size = codeSize;
    newSymbol->_next = NULL;
+
+   TR::CodeCacheSymbol *newRelocSymbol = NULL;
+   if (_elfRelocatableGenerator){
+      newRelocSymbol = static_cast<TR::CodeCacheSymbol *> (self()->getMemory(sizeof(TR::CodeCacheSymbol)));
+      memcpy(newRelocSymbol, newSymbol, sizeof(TR::CodeCacheSymbol));
+      newRelocSymbol->_next = NULL;
+   }
+
+   SymbolMonitorCriticalSection registerSymbol(self());
+
    if(_symbolContainer->_head){
       _symbolContainer->_tail->_next = newSymbol;
       _symbolContainer->_tail = newSymbol;
@@ -900,10 +935,7 @@ OMR::CodeCacheManager::registerCompiledMethod(const char *sig, uint8_t *startPC,
    _symbolContainer->_numSymbols++;
    _symbolContainer->_totalSymbolNameLength += nameLength;
 
-   if (_elfRelocatableGenerator){
-      TR::CodeCacheSymbol *newRelocSymbol = static_cast<TR::CodeCacheSymbol *> (self()->getMemory(sizeof(TR::CodeCacheSymbol)));
-      memcpy(newRelocSymbol, newSymbol, sizeof(TR::CodeCacheSymbol));
-      newRelocSymbol->_next = NULL;
+   if (newRelocSymbol){
       if(_relocatableSymbolContainer->_head){
             _relocatableSymbolContainer->_tail->_next = newRelocSymbol;
             _relocatableSymbolContainer->_tail = newRelocSymbol;
@@ -921,7 +953,10 @@ void
 OMR::CodeCacheManager::registerStaticRelocation(const TR::StaticRelocation &relocation)
    {
 #if (HOST_OS == OMR_LINUX)
-   if (_elfRelocatableGenerator)
+   // References to the method itself are not expressible as symbol relocations
+   // by the ELF generator, and are left as they were encoded
+   //
+   if (_elfRelocatableGenerator && relocation.symbol() != NULL)
       {
       const char * const symbolName(relocation.symbol());
       uint32_t nameLength = strlen(symbolName) + 1;
@@ -933,6 +968,15 @@ OMR::CodeCacheManager::registerStaticRelocation(const TR::StaticRelocation &relo
       newRelocSymbol->_start = 0;
       newRelocSymbol->_size = 0;
       newRelocSymbol->_next = NULL;
+
+      uint32_t relocationType = _resolver.resolveRelocationType(relocation);
+      TR::CodeCacheRelocationInfo *newRelocation = static_cast<TR::CodeCacheRelocationInfo *> (self()->getMemory(sizeof(TR::CodeCacheRelocationInfo)));
+      newRelocation->_location = relocation.location();
+      newRelocation->_type = relocationType;
+      newRelocation->_next = NULL;
+
+      SymbolMonitorCriticalSection registerRelocation(self());
+
       if(_relocatableSymbolContainer->_head){
             _relocatableSymbolContainer->_tail->_next = newRelocSymbol;
             _relocatableSymbolContainer->_tail = newRelocSymbol;
@@ -943,12 +987,7 @@ OMR::CodeCacheManager::registerStaticRelocation(const TR::StaticRelocation &relo
       _relocatableSymbolContainer->_numSymbols++;
       _relocatableSymbolContainer->_totalSymbolNameLength += nameLength;
 
-      uint32_t symbolNumber = static_cast<uint32_t>(_relocatableSymbolContainer->_numSymbols - 1); //symbol index in the linked list
-      uint32_t relocationType = _resolver.resolveRelocationType(relocation);
-      TR::CodeCacheRelocationInfo *newRelocation = static_cast<TR::CodeCacheRelocationInfo *> (self()->getMemory(sizeof(TR::CodeCacheRelocationInfo)));
-      newRelocation->_location = relocation.location();
-      newRelocation->_type = relocationType;
-      newRelocation->_symbol = symbolNumber; //symbol index along the linked list
+      newRelocation->_symbol = static_cast<uint32_t>(_relocatableSymbolContainer->_numSymbols - 1); //symbol index along the linked list
       if(_relocations->_head){
             _relocations->_tail->_next = newRelocation;
             _relocations->_tail = newRelocation;
@@ -30,6 +30,7 @@
 #include "runtime/MethodExceptionData.hpp"
 #include "runtime/Runtime.hpp"
 #include "runtime/CodeCacheTypes.hpp"
+#include "runtime/CodeRangeIndex.hpp"
 #include "env/RawAllocator.hpp"
 #include "codegen/StaticRelocation.hpp"
 #include "codegen/ELFRelocationResolver.hpp"
@@ -134,6 +135,12 @@ public:
       UsageMonitorCriticalSection(TR::CodeCacheManager *mgr);
       };
 
+   class SymbolMonitorCriticalSection : public CriticalSection
+      {
+      public:
+      SymbolMonitorCriticalSection(TR::CodeCacheManager *mgr);
+      };
+
    TR::CodeCacheConfig & codeCacheConfig() { return _config; }
 
    /**
@@ -200,6 +207,16 @@ public:
       size_t segmentSizeInBytes,
       int32_t reservingCompilationTID);
 
+   /**
+    * @brief Finds the code cache whose memory, from its code base up to and
+    *        including its helper top, contains the given address.
+    *
+    * The lookup takes no lock and may be used from signal handlers.
+    *
+    * @param[in] inCacheAddress : the address to look up
+    *
+    * @return the code cache containing the address; NULL otherwise.
+    */
    TR::CodeCache * findCodeCacheFromPC(void *inCacheAddress);
 
    /**
@@ -291,6 +308,8 @@ protected:
    TR::CodeCacheConfig            _config;
    TR::CodeCache                 *_lastCache;                         /*!< last code cache round robined through */
    CodeCacheList                  _codeCacheList;                     /*!< list of allocated code caches */
+   TR::CodeRangeIndex<TR::CodeCache> _codeCacheRangeIndex;            /*!< address ranges of the code caches, updated under the cache list mutex */
+   bool                           _codeCacheRangeIndexIncomplete;     /*!< a code cache could not be added to _codeCacheRangeIndex */
    int32_t                        _curNumberOfCodeCaches;
 
    // The following 3 fields are for implementation of code cache consolidation
@@ -305,6 +324,8 @@ protected:
    TR::Monitor                   *_usageMonitor;
    size_t                         _currTotalUsedInBytes;
    size_t                         _maxUsedInBytes;
+
+   TR::Monitor                   *_symbolMonitor;                     /*!< guards the symbol and relocation containers */
 #if (HOST_OS == OMR_LINUX)
    public:
    /**
@@ -328,7 +349,7 @@ protected:
 
    // collect information on code cache symbols here, will be post processed into the elf trailer structure
    static TR::CodeCacheSymbolContainer   *_symbolContainer; /**< Symbol container used for tracking CodeCacheSymbols.
-                                                                  Note: This static member is not thread-safe. Synchronization is needed if multiple compilation threads are active */
+                                                                  Guarded by _symbolMonitor when multiple compilation threads are active */
    TR::CodeCacheSymbolContainer          *_relocatableSymbolContainer; /**< Symbol container used for tracking CodeCacheSymbols, for the purpose of writing to relocatable ELF object file */
    TR::CodeCacheRelocationInfoContainer  *_relocations; /**< for tracking relocation info */
    TR::ELFRelocationResolver              _resolver; /**< this translates between a TR::StaticRelocation and the ELF relocation type required for the platform */
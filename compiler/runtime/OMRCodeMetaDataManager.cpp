@@ -44,6 +44,8 @@ TR::CodeMetaDataManager *CodeMetaDataManager::_codeMetaDataManager = NULL;
 
 
 CodeMetaDataManager::CodeMetaDataManager() :
+   _hashTableRangeIndex(TR::RawAllocator()),
+   _hashTableRangeIndexIncomplete(false),
    _cachedPC(0),
    _cachedHashTable(NULL),
    _retrievedMetaDataCache(NULL)
@@ -147,16 +149,17 @@ const TR::MethodMetaDataPOD *
 CodeMetaDataManager::findMetaDataForPC(uintptr_t pc)
    {
    TR_ASSERT(pc != 0, "attempting to query existing MetaData for a NULL PC");
-   self()->updateCache(pc);
-   if (!_retrievedMetaDataCache)
+   if (_hashTableRangeIndexIncomplete)
       {
-      if (_cachedHashTable)
-         {
+      // The index could not grow; fall back to the locked AVL search
+      self()->updateCache(pc);
+      if (!_retrievedMetaDataCache && _cachedHashTable)
          _retrievedMetaDataCache = self()->findMetaDataInHash(_cachedHashTable, pc);
-         }
+      return _retrievedMetaDataCache;
       }
 
-   return _retrievedMetaDataCache;
+   TR::MetaDataHashTable *table = _hashTableRangeIndex.find(pc);
+   return table ? self()->findMetaDataInHash(table, pc) : NULL;
    }
 
 
@@ -205,8 +208,9 @@ CodeMetaDataManager::updateCache(uintptr_t currentPC)
       {
       _retrievedMetaDataCache = NULL;
       _cachedPC = currentPC;
-      _cachedHashTable =
-         static_cast<TR::MetaDataHashTable *>(static_cast<void *>(avl_search(_metaDataAVL, currentPC) ) );
+      _cachedHashTable = _hashTableRangeIndexIncomplete ?
+         static_cast<TR::MetaDataHashTable *>(static_cast<void *>(avl_search(_metaDataAVL, currentPC) ) ) :
+         _hashTableRangeIndex.find(currentPC);
 
       TR_ASSERT(_cachedHashTable, "Either we lost a code cache or we attempted to find a hash table for a non-code cache startPC: Searched for %p", currentPC);
       }
@@ -596,6 +600,8 @@ CodeMetaDataManager::addCodeCache(
 
    if (newTable)
       {
+      if (!_hashTableRangeIndex.insert(newTable->start, newTable->end, newTable))
+         _hashTableRangeIndexIncomplete = true;
       avl_insert(_metaDataAVL, (J9AVLTreeNode *) newTable);
       }
 
@@ -40,6 +40,7 @@ namespace OMR { typedef OMR::MetaDataHashTable MetaDataHashTableConnector; }
 #include <stdint.h>
 #include "env/TRMemory.hpp"
 #include "infra/Annotations.hpp"
+#include "runtime/CodeRangeIndex.hpp"
 #include "j9nongenerated.h"
 
 namespace TR { class CodeCache; }
@@ -122,9 +123,13 @@ class OMR_EXTENSIBLE CodeMetaDataManager
    /**
     * @brief Attempts to find a registered metadata for a given metadata's startPC.
     * 
-    * Note: findMetaDataForPC does not locally acquire the JIT metadata monitor.
-    * Users must first manually acquire the monitor or go through another function
-    * that does.
+    * findMetaDataForPC takes no lock and keeps no state, so it may be called
+    * from stack walkers, profilers and signal handlers while another thread
+    * inserts or removes metadata. The code cache hash table is found through
+    * a lock-free range index and the hash table buckets are published with a
+    * write barrier by the inserting thread. If the index could not be
+    * extended the lookup falls back to the AVL tree, which requires the
+    * JIT metadata monitor.
     *
     * @param pc The PC for which we require the JIT metadata .
     * @return If an metadata for a given startPC is successfully found, returns
@@ -238,6 +243,10 @@ class OMR_EXTENSIBLE CodeMetaDataManager
 
    J9AVLTree *_metaDataAVL;
 
+   // Address ranges of the code cache hash tables; searched without a lock
+   TR::CodeRangeIndex<TR::MetaDataHashTable> _hashTableRangeIndex;
+   bool _hashTableRangeIndexIncomplete;
+
    private:
 
    mutable uintptr_t _cachedPC;
@@ -813,7 +813,7 @@ TR::Register *TR::AMD64SystemLinkage::buildDirectDispatch(
          methodSymRef,
          cg());
 
-      if (comp()->getOption(TR_EmitRelocatableELFFile))
+      if (cg()->needStaticRelocations())
          {
          LoadRegisterInstruction->setReloKind(TR_NativeMethodAbsolute);
          }
@@ -483,8 +483,8 @@
    TR::TreeEvaluator::unImpOpEvaluator,                                // TR::vdlog
    TR::TreeEvaluator::unImpOpEvaluator,                                // TR::vinc
    TR::TreeEvaluator::unImpOpEvaluator,                                // TR::vdec
-   TR::TreeEvaluator::unImpOpEvaluator,                                // TR::vneg
-   TR::TreeEvaluator::unImpOpEvaluator,                                // TR::vcom
+   TR::TreeEvaluator::SIMDnegEvaluator,                                // TR::vneg
+   TR::TreeEvaluator::SIMDcomEvaluator,                                // TR::vcom
    TR::TreeEvaluator::FloatingPointAndVectorBinaryArithmeticEvaluator, // TR::vadd
    TR::TreeEvaluator::FloatingPointAndVectorBinaryArithmeticEvaluator, // TR::vsub
    TR::TreeEvaluator::FloatingPointAndVectorBinaryArithmeticEvaluator, // TR::vmul
@@ -493,33 +493,33 @@
    TR::TreeEvaluator::FloatingPointAndVectorBinaryArithmeticEvaluator, // TR::vand
    TR::TreeEvaluator::FloatingPointAndVectorBinaryArithmeticEvaluator, // TR::vor
    TR::TreeEvaluator::FloatingPointAndVectorBinaryArithmeticEvaluator, // TR::vxor
-   TR::TreeEvaluator::unImpOpEvaluator,                                // TR::vshl
-   TR::TreeEvaluator::unImpOpEvaluator,                                // TR::vushr
-   TR::TreeEvaluator::unImpOpEvaluator,                                // TR::vshr
-   TR::TreeEvaluator::unImpOpEvaluator,                                // TR::vcmpeq
-   TR::TreeEvaluator::unImpOpEvaluator,                                // TR::vcmpne
-   TR::TreeEvaluator::unImpOpEvaluator,                                // TR::vcmplt
-   TR::TreeEvaluator::unImpOpEvaluator,                                // TR::vucmplt
-   TR::TreeEvaluator::unImpOpEvaluator,                                // TR::vcmpgt
-   TR::TreeEvaluator::unImpOpEvaluator,                                // TR::vucmpgt
-   TR::TreeEvaluator::unImpOpEvaluator,                                // TR::vcmple
-   TR::TreeEvaluator::unImpOpEvaluator,                                // TR::vucmple
-   TR::TreeEvaluator::unImpOpEvaluator,                                // TR::vcmpge
-   TR::TreeEvaluator::unImpOpEvaluator,                                // TR::vucmpge
+   TR::TreeEvaluator::SIMDshiftEvaluator,                              // TR::vshl
+   TR::TreeEvaluator::SIMDshiftEvaluator,                              // TR::vushr
+   TR::TreeEvaluator::SIMDshiftEvaluator,                              // TR::vshr
+   TR::TreeEvaluator::SIMDcompareEvaluator,                            // TR::vcmpeq
+   TR::TreeEvaluator::SIMDcompareEvaluator,                            // TR::vcmpne
+   TR::TreeEvaluator::SIMDcompareEvaluator,                            // TR::vcmplt
+   TR::TreeEvaluator::SIMDcompareEvaluator,                            // TR::vucmplt
+   TR::TreeEvaluator::SIMDcompareEvaluator,                            // TR::vcmpgt
+   TR::TreeEvaluator::SIMDcompareEvaluator,                            // TR::vucmpgt
+   TR::TreeEvaluator::SIMDcompareEvaluator,                            // TR::vcmple
+   TR::TreeEvaluator::SIMDcompareEvaluator,                            // TR::vucmple
+   TR::TreeEvaluator::SIMDcompareEvaluator,                            // TR::vcmpge
+   TR::TreeEvaluator::SIMDcompareEvaluator,                            // TR::vucmpge
    TR::TreeEvaluator::SIMDloadEvaluator,                               // TR::vload
    TR::TreeEvaluator::SIMDloadEvaluator,                               // TR::vloadi
    TR::TreeEvaluator::SIMDstoreEvaluator,                              // TR::vstore
    TR::TreeEvaluator::SIMDstoreEvaluator,                              // TR::vstorei
-   TR::TreeEvaluator::unImpOpEvaluator,                                // TR::vrand
+   TR::TreeEvaluator::SIMDrandEvaluator,                               // TR::vrand
    TR::TreeEvaluator::unImpOpEvaluator,                                // TR::vreturn
    TR::TreeEvaluator::unImpOpEvaluator,                                // TR::vcall
    TR::TreeEvaluator::unImpOpEvaluator,                                // TR::vcalli
-   TR::TreeEvaluator::unImpOpEvaluator,                                // TR::vselect
-   TR::TreeEvaluator::unImpOpEvaluator,                                // TR::v2v
-   TR::TreeEvaluator::unImpOpEvaluator,                                // TR::vl2vd
+   TR::TreeEvaluator::SIMDselectEvaluator,                             // TR::vselect
+   TR::TreeEvaluator::SIMDv2vEvaluator,                                // TR::v2v
+   TR::TreeEvaluator::SIMDl2vdEvaluator,                               // TR::vl2vd
    TR::TreeEvaluator::unImpOpEvaluator,                                // TR::vconst
    TR::TreeEvaluator::SIMDgetvelemEvaluator,                           // TR::getvelem
-   TR::TreeEvaluator::unImpOpEvaluator,                                // TR::vsetelem
+   TR::TreeEvaluator::SIMDsetelemEvaluator,                            // TR::vsetelem
    TR::TreeEvaluator::SIMDRegLoadEvaluator,                            // TR::vbRegLoad
    TR::TreeEvaluator::SIMDRegLoadEvaluator,                            // TR::vsRegLoad
    TR::TreeEvaluator::SIMDRegLoadEvaluator,                            // TR::viRegLoad
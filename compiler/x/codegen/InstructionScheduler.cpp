@@ -0,0 +1,780 @@
+/*******************************************************************************
+ * Copyright (c) 2020, 2020 IBM Corp. and others
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at https://www.eclipse.org/legal/epl-2.0/
+ * or the Apache License, Version 2.0 which accompanies this distribution and
+ * is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following
+ * Secondary Licenses when the conditions for such availability set
+ * forth in the Eclipse Public License, v. 2.0 are satisfied: GNU
+ * General Public License, version 2 with the GNU Classpath
+ * Exception [1] and GNU General Public License, version 2 with the
+ * OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] http://openjdk.java.net/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
+ *******************************************************************************/
+
+#include "x/codegen/InstructionScheduler.hpp"
+
+#include <algorithm>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include "codegen/CodeGenerator.hpp"
+#include "codegen/Instruction.hpp"
+#include "codegen/Machine.hpp"
+#include "codegen/MemoryReference.hpp"
+#include "codegen/RealRegister.hpp"
+#include "codegen/Register.hpp"
+#include "compile/Compilation.hpp"
+#include "control/Options.hpp"
+#include "control/Options_inlines.hpp"
+#include "il/Block.hpp"
+#include "il/ILOpCodes.hpp"
+#include "il/Node.hpp"
+#include "il/Node_inlines.hpp"
+#include "il/SymbolReference.hpp"
+#include "infra/Assert.hpp"
+#include "ras/Debug.hpp"
+#include "x/codegen/X86Instruction.hpp"
+#include "x/codegen/X86Ops.hpp"
+
+#define OPT_DETAILS "O^O INSTRUCTION SCHEDULING: "
+
+enum
+   {
+   IntelSkylakeModel,
+   IntelHaswellModel,
+   IntelSandyBridgeModel,
+   IntelCoreModel,
+   AMDFamily15hModel,
+   AMDOpteronModel
+   };
+
+static const TR_X86SchedulingModel schedulingModels[] =
+   {
+   //                           mov  alu imul fmov fadd fmul fdiv  load issue loads stores
+   { "Intel Skylake",         {   1,   1,   3,   1,   4,   4,  13 },   5,    4,    2,    1 },
+   { "Intel Haswell",         {   1,   1,   3,   1,   3,   5,  14 },   4,    4,    2,    1 },
+   { "Intel Sandy Bridge",    {   1,   1,   3,   1,   3,   5,  14 },   4,    4,    2,    1 },
+   { "Intel Core",            {   1,   1,   3,   1,   3,   5,  21 },   3,    4,    1,    1 },
+   { "AMD Family 15h",        {   1,   1,   4,   2,   5,   5,  27 },   4,    4,    2,    1 },
+   { "AMD Opteron",           {   1,   1,   3,   2,   4,   4,  20 },   3,    3,    2,    1 },
+   };
+
+const TR_X86SchedulingModel &
+TR_X86SchedulingModel::forProcessor(TR_X86ProcessorInfo &processorInfo)
+   {
+   if (processorInfo.isIntelHaswell() || processorInfo.isIntelBroadwell())
+      return schedulingModels[IntelHaswellModel];
+   if (processorInfo.isIntelSandyBridge() || processorInfo.isIntelIvyBridge() || processorInfo.isIntelWestmere())
+      return schedulingModels[IntelSandyBridgeModel];
+   if (processorInfo.isIntelOldMachine())
+      return schedulingModels[IntelCoreModel];
+   if (processorInfo.isAMD15h())
+      return schedulingModels[AMDFamily15hModel];
+   if (processorInfo.isAMDOpteron() || processorInfo.isAMDAthlonDuron())
+      return schedulingModels[AMDOpteronModel];
+   return schedulingModels[IntelSkylakeModel];
+   }
+
+// The scheduling class of every opcode, found from its mnemonic, or -1 for
+// opcodes the scheduler does not move.
+//
+class InstructionClassTable
+   {
+   public:
+
+   InstructionClassTable()
+      {
+      static const char *mnemonics[] =
+         {
+#define INSTRUCTION(name, mnemonic, binary, property0, property1) #mnemonic
+#include "codegen/X86Ops.ins"
+#undef INSTRUCTION
+         };
+      static const struct
+         {
+         const char *_mnemonic;
+         TR_X86SchedulingModel::InstructionClass _class;
+         } classes[] =
+         {
+         { "mov",    TR_X86SchedulingModel::IntegerMove },
+         { "movzx",  TR_X86SchedulingModel::IntegerMove },
+         { "movsx",  TR_X86SchedulingModel::IntegerMove },
+         { "movsxd", TR_X86SchedulingModel::IntegerMove },
+         { "lea",    TR_X86SchedulingModel::IntegerMove },
+         { "add",    TR_X86SchedulingModel::IntegerArithmetic },
+         { "sub",    TR_X86SchedulingModel::IntegerArithmetic },
+         { "and",    TR_X86SchedulingModel::IntegerArithmetic },
+         { "or",     TR_X86SchedulingModel::IntegerArithmetic },
+         { "xor",    TR_X86SchedulingModel::IntegerArithmetic },
+         { "cmp",    TR_X86SchedulingModel::IntegerArithmetic },
+         { "test",   TR_X86SchedulingModel::IntegerArithmetic },
+         { "neg",    TR_X86SchedulingModel::IntegerArithmetic },
+         { "shl",    TR_X86SchedulingModel::IntegerArithmetic },
+         { "shr",    TR_X86SchedulingModel::IntegerArithmetic },
+         { "sar",    TR_X86SchedulingModel::IntegerArithmetic },
+         { "imul",   TR_X86SchedulingModel::IntegerMultiply },
+         { "movss",  TR_X86SchedulingModel::FloatMove },
+         { "movsd",  TR_X86SchedulingModel::FloatMove },
+         { "movaps", TR_X86SchedulingModel::FloatMove },
+         { "movapd", TR_X86SchedulingModel::FloatMove },
+         { "movups", TR_X86SchedulingModel::FloatMove },
+         { "movupd", TR_X86SchedulingModel::FloatMove },
+         { "movdqa", TR_X86SchedulingModel::FloatMove },
+         { "movdqu", TR_X86SchedulingModel::FloatMove },
+         { "movd",   TR_X86SchedulingModel::FloatMove },
+         { "movq",   TR_X86SchedulingModel::FloatMove },
+         { "xorps",  TR_X86SchedulingModel::FloatMove },
+         { "xorpd",  TR_X86SchedulingModel::FloatMove },
+         { "andps",  TR_X86SchedulingModel::FloatMove },
+         { "andpd",  TR_X86SchedulingModel::FloatMove },
+         { "orps",   TR_X86SchedulingModel::FloatMove },
+         { "orpd",   TR_X86SchedulingModel::FloatMove },
+         { "addss",  TR_X86SchedulingModel::FloatAdd },
+         { "addsd",  TR_X86SchedulingModel::FloatAdd },
+         { "subss",  TR_X86SchedulingModel::FloatAdd },
+         { "subsd",  TR_X86SchedulingModel::FloatAdd },
+         { "mulss",  TR_X86SchedulingModel::FloatMultiply },
+         { "mulsd",  TR_X86SchedulingModel::FloatMultiply },
+         { "divss",  TR_X86SchedulingModel::FloatDivide },
+         { "divsd",  TR_X86SchedulingModel::FloatDivide },
+         { "sqrtss", TR_X86SchedulingModel::FloatDivide },
+         { "sqrtsd", TR_X86SchedulingModel::FloatDivide },
+         };
+
+      _numOpCodes = sizeof(mnemonics) / sizeof(mnemonics[0]);
+      TR_ASSERT(_numOpCodes <= MAX_OPCODES, "More x86 opcodes than the scheduling class table can hold");
+      for (int32_t op = 0; op < _numOpCodes; op++)
+         {
+         _class[op] = -1;
+         for (size_t c = 0; c < sizeof(classes) / sizeof(classes[0]); c++)
+            {
+            if (strcmp(mnemonics[op], classes[c]._mnemonic) == 0)
+               {
+               _class[op] = classes[c]._class;
+               break;
+               }
+            }
+         }
+      }
+
+   int32_t getClass(TR_X86OpCodes op) { return (int32_t)op < _numOpCodes ? _class[op] : -1; }
+
+   private:
+
+   static const int32_t MAX_OPCODES = 2048;
+
+   int32_t _numOpCodes;
+   int8_t _class[MAX_OPCODES];
+   };
+
+static int32_t
+instructionClassOf(TR_X86OpCodes op)
+   {
+   static InstructionClassTable table;
+   return table.getClass(op);
+   }
+
+// The number of bytes a memory operand of the opcode may access
+//
+static int32_t
+accessSize(TR_X86OpCode &op)
+   {
+   if (op.hasXMMSource() || op.hasXMMTarget())
+      return 16;
+   if (op.hasLongSource() || op.hasLongTarget())
+      return 8;
+   if (op.hasIntSource() || op.hasIntTarget())
+      return 4;
+   if (op.hasShortSource() || op.hasShortTarget())
+      return 2;
+   if (op.hasByteSource() || op.hasByteTarget())
+      return 1;
+   return 16;
+   }
+
+TR_X86InstructionScheduler::TR_X86InstructionScheduler(TR::CodeGenerator *cg, bool afterRegisterAssignment)
+   : _cg(cg),
+     _comp(cg->comp()),
+     _model(TR_X86SchedulingModel::forProcessor(cg->getX86ProcessorInfo())),
+     _stackPointer(cg->machine()->getRealRegister(TR::RealRegister::esp)),
+     _afterRegisterAssignment(afterRegisterAssignment),
+     _trace(cg->comp()->getOption(TR_TraceCG)),
+     _nodes(getTypedAllocator<Node>(cg->comp()->allocator())),
+     _edges(getTypedAllocator<Edge>(cg->comp()->allocator()))
+   {
+   }
+
+bool
+TR_X86InstructionScheduler::blockMayBeScheduled(TR::Instruction *fence)
+   {
+   TR::Node *node = fence->getNode();
+   if (node == NULL || node->getOpCodeValue() != TR::BBStart)
+      return false;
+
+   // An instruction that can raise an exception must not move past a store
+   // that the handler can observe
+   //
+   return !node->getBlock()->hasExceptionSuccessors();
+   }
+
+bool
+TR_X86InstructionScheduler::classify(TR::Instruction *instr, Node &node)
+   {
+   TR_X86OpCodes opCodeValue = instr->getOpCodeValue();
+   int32_t instructionClass = instructionClassOf(opCodeValue);
+   if (instructionClass < 0)
+      return false;
+
+   TR_X86OpCode &op = instr->getOpCode();
+   if (op.getTestedEFlags() ||
+       op.targetRegIsImplicit() ||
+       op.sourceRegIsImplicit() ||
+       op.needsLockPrefix() ||
+       op.needsRepPrefix() ||
+       op.isPseudoOp() ||
+       instr->getDependencyConditions() ||
+       instr->needsGCMap())
+      return false;
+
+   TR::Register *target = NULL;
+   TR::Register *source = NULL;
+   TR::MemoryReference *memRef = NULL;
+   bool memoryIsTarget = false;
+
+   switch (instr->getKind())
+      {
+      case TR::Instruction::IsRegReg:
+      case TR::Instruction::IsRegRegImm:
+         target = instr->getTargetRegister();
+         source = instr->getSourceRegister();
+         break;
+      case TR::Instruction::IsRegImm:
+      case TR::Instruction::IsRegImm64:
+         target = instr->getTargetRegister();
+         break;
+      case TR::Instruction::IsRegMem:
+      case TR::Instruction::IsRegMemImm:
+         target = instr->getTargetRegister();
+         memRef = instr->getMemoryReference();
+         break;
+      case TR::Instruction::IsMemReg:
+         source = instr->getSourceRegister();
+         memRef = instr->getMemoryReference();
+         memoryIsTarget = true;
+         break;
+      case TR::Instruction::IsMemImm:
+         memRef = instr->getMemoryReference();
+         memoryIsTarget = true;
+         break;
+      case TR::Instruction::IsReg:
+      case TR::Instruction::IsMem:
+         // Only the single operand forms that read and write their operand,
+         // such as neg; shifts by an implicit count are left alone
+         //
+         if (!op.modifiesTarget() || !op.usesTarget() || op.isShiftOp())
+            return false;
+         target = instr->getTargetRegister();
+         memRef = instr->getMemoryReference();
+         memoryIsTarget = true;
+         break;
+      default:
+         return false;
+      }
+
+   // A shift by zero leaves the flags alone
+   //
+   if (op.isShiftOp())
+      {
+      if (instr->getKind() != TR::Instruction::IsRegImm && instr->getKind() != TR::Instruction::IsMemImm)
+         return false;
+      int32_t count = instr->getKind() == TR::Instruction::IsRegImm ?
+         static_cast<TR::X86RegImmInstruction *>(instr)->getSourceImmediate() :
+         static_cast<TR::X86MemImmInstruction *>(instr)->getSourceImmediate();
+      if ((count & 0x1f) == 0)
+         return false;
+      }
+
+   node._instruction = instr;
+   node._numReads = 0;
+   node._numWrites = 0;
+   node._properties = 0;
+
+   if (target)
+      {
+      if (op.usesTarget() ||
+          (instr->getKind() == TR::Instruction::IsRegReg && (opCodeValue == MOVSSRegReg || opCodeValue == MOVSDRegReg)))
+         node._reads[node._numReads++] = target;
+      if (op.modifiesTarget())
+         node._writes[node._numWrites++] = target;
+      }
+
+   if (source)
+      {
+      node._reads[node._numReads++] = source;
+      if (op.modifiesSource())
+         node._writes[node._numWrites++] = source;
+      }
+
+   if (memRef)
+      {
+      TR::SymbolReference &symRef = memRef->getSymbolReference();
+      if (memRef->getLabel() ||
+          memRef->hasUnresolvedDataSnippet() ||
+          memRef->hasUnresolvedVirtualCallSnippet() ||
+          (symRef.getSymbol() && symRef.isUnresolved()))
+         return false;
+
+      if (memRef->getBaseRegister())
+         node._reads[node._numReads++] = memRef->getBaseRegister();
+      if (memRef->getIndexRegister())
+         node._reads[node._numReads++] = memRef->getIndexRegister();
+
+      if (opCodeValue == LEA2RegMem || opCodeValue == LEA4RegMem || opCodeValue == LEA8RegMem)
+         {
+         // Address computation only
+         }
+      else if (memoryIsTarget)
+         {
+         if (op.modifiesTarget())
+            node._properties |= WritesMemory;
+         if (op.usesTarget() || !op.modifiesTarget())
+            node._properties |= ReadsMemory;
+         }
+      else
+         {
+         node._properties |= ReadsMemory;
+         }
+
+      if (memRef->getDataSnippet())
+         {
+         if (node._properties & WritesMemory)
+            return false;
+         node._properties |= ConstantMemory;
+         }
+      }
+
+   // The stack pointer is also changed by pushes, pops and calls, which are
+   // barriers, and the offsets of the memory references that use it depend
+   // on the order of its updates
+   //
+   for (int32_t i = 0; i < node._numWrites; i++)
+      {
+      if (node._writes[i] == _stackPointer)
+         return false;
+      }
+
+   uint8_t flags = op.getModifiedEFlags();
+   if (flags == (IA32EFlags_OF | IA32EFlags_SF | IA32EFlags_ZF | IA32EFlags_PF | IA32EFlags_CF))
+      node._properties |= WritesAllFlags;
+   else if (flags)
+      node._properties |= WritesSomeFlags;
+
+   node._latency = _model._latency[instructionClass];
+   if (node._properties & ReadsMemory)
+      node._latency += _model._loadLatency;
+
+   return true;
+   }
+
+bool
+TR_X86InstructionScheduler::reads(Node &node, TR::Register *reg)
+   {
+   for (int32_t i = 0; i < node._numReads; i++)
+      if (node._reads[i] == reg)
+         return true;
+   return false;
+   }
+
+bool
+TR_X86InstructionScheduler::writes(Node &node, TR::Register *reg)
+   {
+   for (int32_t i = 0; i < node._numWrites; i++)
+      if (node._writes[i] == reg)
+         return true;
+   return false;
+   }
+
+// Whether reg is written by any of the nodes [from, to)
+//
+bool
+TR_X86InstructionScheduler::writtenBetween(TR::Register *reg, int32_t from, int32_t to)
+   {
+   for (int32_t i = from; i < to; i++)
+      if (writes(_nodes[i], reg))
+         return true;
+   return false;
+   }
+
+// Whether the memory accessed by node a may overlap the memory accessed by a
+// later node b
+//
+bool
+TR_X86InstructionScheduler::mayOverlap(int32_t a, int32_t b)
+   {
+   TR::MemoryReference *first = _nodes[a]._instruction->getMemoryReference();
+   TR::MemoryReference *second = _nodes[b]._instruction->getMemoryReference();
+   TR::Register *base = first->getBaseRegister();
+   TR::Register *index = first->getIndexRegister();
+
+   if (base != second->getBaseRegister() ||
+       index != second->getIndexRegister() ||
+       (index && first->getStride() != second->getStride()))
+      return true;
+
+   // Before the stack is mapped only the offsets within the same symbol can
+   // be compared
+   //
+   if (!_afterRegisterAssignment &&
+       first->getSymbolReference().getSymbol() != second->getSymbolReference().getSymbol())
+      return true;
+
+   if ((base && writtenBetween(base, a, b)) ||
+       (index && writtenBetween(index, a, b)))
+      return true;
+
+   intptr_t firstStart = first->getDisplacement();
+   intptr_t secondStart = second->getDisplacement();
+   return firstStart < secondStart + accessSize(_nodes[b]._instruction->getOpCode()) &&
+          secondStart < firstStart + accessSize(_nodes[a]._instruction->getOpCode());
+   }
+
+void
+TR_X86InstructionScheduler::addEdge(int32_t from, int32_t to, int32_t latency)
+   {
+   Edge edge;
+   edge._to = to;
+   edge._latency = latency;
+   edge._next = _nodes[from]._firstSuccessor;
+   _nodes[from]._firstSuccessor = (int32_t)_edges.size();
+   _edges.push_back(edge);
+   _nodes[to]._unscheduledPredecessors++;
+   }
+
+void
+TR_X86InstructionScheduler::buildDependences()
+   {
+   int32_t numNodes = (int32_t)_nodes.size();
+   _edges.clear();
+   for (int32_t n = 0; n < numNodes; n++)
+      {
+      _nodes[n]._firstSuccessor = -1;
+      _nodes[n]._unscheduledPredecessors = 0;
+      }
+
+   for (int32_t n = 1; n < numNodes; n++)
+      {
+      Node &later = _nodes[n];
+      for (int32_t m = 0; m < n; m++)
+         {
+         Node &earlier = _nodes[m];
+
+         for (int32_t i = 0; i < later._numReads; i++)
+            {
+            if (writes(earlier, later._reads[i]))
+               addEdge(m, n, earlier._latency);
+            }
+         for (int32_t i = 0; i < later._numWrites; i++)
+            {
+            if (writes(earlier, later._writes[i]))
+               addEdge(m, n, 1);
+            if (reads(earlier, later._writes[i]))
+               addEdge(m, n, 0);
+            }
+
+         uint8_t earlierAccess = earlier._properties & (ReadsMemory | WritesMemory);
+         uint8_t laterAccess = later._properties & (ReadsMemory | WritesMemory);
+         if (earlierAccess && laterAccess &&
+             ((earlierAccess | laterAccess) & WritesMemory) &&
+             !((earlier._properties | later._properties) & ConstantMemory) &&
+             mayOverlap(m, n))
+            {
+            if (!(earlierAccess & WritesMemory))
+               addEdge(m, n, 0);
+            else if (laterAccess & ReadsMemory)
+               addEdge(m, n, _model._loadLatency);
+            else
+               addEdge(m, n, 1);
+            }
+         }
+      }
+
+   // The flags of the last flag writer must survive to the end of the region.
+   // Writers of all of the flags can be reordered among themselves as long as
+   // the last one stays last; a writer of only some of them keeps its place
+   // relative to all other writers.
+   //
+   int32_t partialWriter = -1;
+   int32_t lastWriter = -1;
+   for (int32_t n = 0; n <= numNodes; n++)
+      {
+      bool endOfRegion = n == numNodes;
+      uint8_t properties = endOfRegion ? 0 : _nodes[n]._properties;
+      if (!endOfRegion && !(properties & (WritesAllFlags | WritesSomeFlags)))
+         continue;
+
+      if (!endOfRegion && (properties & WritesAllFlags))
+         {
+         if (partialWriter >= 0)
+            addEdge(partialWriter, n, 0);
+         lastWriter = n;
+         continue;
+         }
+
+      if (lastWriter > partialWriter)
+         {
+         for (int32_t m = partialWriter + 1; m < lastWriter; m++)
+            {
+            if (_nodes[m]._properties & WritesAllFlags)
+               addEdge(m, lastWriter, 0);
+            }
+         }
+
+      if (!endOfRegion)
+         {
+         if (lastWriter >= 0)
+            addEdge(lastWriter, n, 0);
+         partialWriter = lastWriter = n;
+         }
+      }
+
+   for (int32_t n = numNodes - 1; n >= 0; n--)
+      {
+      Node &node = _nodes[n];
+      node._height = node._latency;
+      for (int32_t e = node._firstSuccessor; e >= 0; e = _edges[e]._next)
+         node._height = std::max(node._height, _edges[e]._latency + _nodes[_edges[e]._to]._height);
+      }
+   }
+
+// Issue the nodes cycle by cycle, choosing among the nodes whose operands are
+// available the one with the longest path to the end of the region.
+//
+void
+TR_X86InstructionScheduler::listSchedule(TR::vector<int32_t> &order)
+   {
+   int32_t numNodes = (int32_t)_nodes.size();
+   for (int32_t n = 0; n < numNodes; n++)
+      _nodes[n]._earliest = 0;
+
+   int32_t cycle = 0;
+   while ((int32_t)order.size() < numNodes)
+      {
+      int32_t issued = 0;
+      int32_t loads = 0;
+      int32_t stores = 0;
+      while (issued < _model._issueWidth)
+         {
+         int32_t best = -1;
+         for (int32_t n = 0; n < numNodes; n++)
+            {
+            Node &node = _nodes[n];
+            if (node._unscheduledPredecessors != 0 || node._earliest > cycle)
+               continue;
+            if (((node._properties & ReadsMemory) && loads == _model._loadPorts) ||
+                ((node._properties & WritesMemory) && stores == _model._storePorts))
+               continue;
+            if (best < 0 || node._height > _nodes[best]._height)
+               best = n;
+            }
+         if (best < 0)
+            break;
+
+         Node &node = _nodes[best];
+         node._unscheduledPredecessors = -1;
+         order.push_back(best);
+         issued++;
+         if (node._properties & ReadsMemory)
+            loads++;
+         if (node._properties & WritesMemory)
+            stores++;
+         for (int32_t e = node._firstSuccessor; e >= 0; e = _edges[e]._next)
+            {
+            Node &successor = _nodes[_edges[e]._to];
+            successor._unscheduledPredecessors--;
+            successor._earliest = std::max(successor._earliest, cycle + _edges[e]._latency);
+            }
+         }
+      cycle++;
+      }
+   }
+
+// The number of cycles an in order processor with the resources of the model
+// would need to issue the nodes in the given order and complete them.
+//
+int32_t
+TR_X86InstructionScheduler::estimateCycles(TR::vector<int32_t> &order)
+   {
+   int32_t numNodes = (int32_t)_nodes.size();
+   for (int32_t n = 0; n < numNodes; n++)
+      _nodes[n]._earliest = 0;
+
+   int32_t cycle = 0;
+   int32_t issued = 0;
+   int32_t loads = 0;
+   int32_t stores = 0;
+   int32_t finish = 0;
+   for (size_t i = 0; i < order.size(); i++)
+      {
+      Node &node = _nodes[order[i]];
+      bool isLoad = (node._properties & ReadsMemory) != 0;
+      bool isStore = (node._properties & WritesMemory) != 0;
+      if (node._earliest > cycle ||
+          issued == _model._issueWidth ||
+          (isLoad && loads == _model._loadPorts) ||
+          (isStore && stores == _model._storePorts))
+         {
+         cycle = std::max(cycle + 1, node._earliest);
+         issued = loads = stores = 0;
+         }
+
+      issued++;
+      if (isLoad)
+         loads++;
+      if (isStore)
+         stores++;
+      finish = std::max(finish, cycle + node._latency);
+      for (int32_t e = node._firstSuccessor; e >= 0; e = _edges[e]._next)
+         {
+         Node &successor = _nodes[_edges[e]._to];
+         successor._earliest = std::max(successor._earliest, cycle + _edges[e]._latency);
+         }
+      }
+
+   return finish;
+   }
+
+bool
+TR_X86InstructionScheduler::scheduleRegion()
+   {
+   int32_t numNodes = (int32_t)_nodes.size();
+   TR::Instruction *cursor = _nodes[0]._instruction->getPrev();
+   if (numNodes < 2 || cursor == NULL)
+      return false;
+
+   buildDependences();
+
+   TR::vector<int32_t> original(getTypedAllocator<int32_t>(comp()->allocator()));
+   TR::vector<int32_t> order(getTypedAllocator<int32_t>(comp()->allocator()));
+   for (int32_t n = 0; n < numNodes; n++)
+      original.push_back(n);
+   listSchedule(order);
+
+   int32_t originalCycles = estimateCycles(original);
+   int32_t scheduledCycles = estimateCycles(order);
+   if (scheduledCycles >= originalCycles)
+      return false;
+
+   if (!performTransformation(comp(), "%sScheduling %d instructions from [%p]: %d -> %d cycles\n", OPT_DETAILS,
+         numNodes, _nodes[0]._instruction, originalCycles, scheduledCycles))
+      return false;
+
+   TR::vector<uint32_t> indices(getTypedAllocator<uint32_t>(comp()->allocator()));
+   for (int32_t n = 0; n < numNodes; n++)
+      indices.push_back(_nodes[n]._instruction->getIndex());
+   std::sort(indices.begin(), indices.end());
+
+   for (int32_t i = 0; i < numNodes; i++)
+      {
+      TR::Instruction *instr = _nodes[order[i]]._instruction;
+      if (cursor->getNext() != instr)
+         instr->move(cursor);
+      instr->setIndex(indices[i]);
+      cursor = instr;
+      }
+
+   // Before register assignment the live ranges must still start and end at
+   // the first and last instructions that reference each register
+   //
+   if (!_afterRegisterAssignment)
+      {
+      for (int32_t n = 0; n < numNodes; n++)
+         {
+         Node &node = _nodes[n];
+         TR::Register *registers[MAX_READS + MAX_WRITES];
+         int32_t numRegisters = 0;
+         for (int32_t i = 0; i < node._numReads; i++)
+            registers[numRegisters++] = node._reads[i];
+         for (int32_t i = 0; i < node._numWrites; i++)
+            registers[numRegisters++] = node._writes[i];
+
+         for (int32_t i = 0; i < numRegisters; i++)
+            {
+            TR::Register *reg = registers[i];
+            TR::Instruction *start = reg->getStartOfRange();
+            TR::Instruction *end = reg->getEndOfRange();
+            if (start && isInRegion(start) && start->getIndex() > node._instruction->getIndex())
+               reg->setStartOfRange(node._instruction);
+            if (end && isInRegion(end) && end->getIndex() < node._instruction->getIndex())
+               reg->setEndOfRange(node._instruction);
+            }
+         }
+      }
+
+   if (_trace)
+      {
+      traceMsg(comp(), "Scheduled %d instructions: %d -> %d cycles\n", numNodes, originalCycles, scheduledCycles);
+      for (int32_t i = 0; i < numNodes; i++)
+         {
+         Node &node = _nodes[order[i]];
+         traceMsg(comp(), "\t[%p] was %d, height %d\n", node._instruction, order[i], node._height);
+         }
+      }
+
+   return true;
+   }
+
+bool
+TR_X86InstructionScheduler::isInRegion(TR::Instruction *instr)
+   {
+   for (size_t n = 0; n < _nodes.size(); n++)
+      if (_nodes[n]._instruction == instr)
+         return true;
+   return false;
+   }
+
+int32_t
+TR_X86InstructionScheduler::perform()
+   {
+   if (_trace)
+      traceMsg(comp(), "\n<instructionScheduling after=\"%s\" model=\"%s\">\n",
+         _afterRegisterAssignment ? "registerAssignment" : "instructionSelection", _model._name);
+
+   int32_t regionsScheduled = 0;
+   bool inSchedulableBlock = false;
+   TR::Instruction *instr = cg()->getFirstInstruction();
+   while (instr)
+      {
+      TR::Instruction *next = instr->getNext();
+
+      if (instr->getKind() == TR::Instruction::IsFence)
+         inSchedulableBlock = blockMayBeScheduled(instr);
+
+      Node node;
+      bool schedulable = inSchedulableBlock && classify(instr, node);
+      if (schedulable)
+         _nodes.push_back(node);
+
+      if (!schedulable || (int32_t)_nodes.size() == MAX_REGION_SIZE || next == NULL)
+         {
+         if (!_nodes.empty() && scheduleRegion())
+            regionsScheduled++;
+         _nodes.clear();
+         }
+
+      instr = next;
+      }
+
+   if (_trace)
+      traceMsg(comp(), "</instructionScheduling regions=\"%d\">\n", regionsScheduled);
+
+   return regionsScheduled;
+   }
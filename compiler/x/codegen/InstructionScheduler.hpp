@@ -0,0 +1,183 @@
+/*******************************************************************************
+ * Copyright (c) 2020, 2020 IBM Corp. and others
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at https://www.eclipse.org/legal/epl-2.0/
+ * or the Apache License, Version 2.0 which accompanies this distribution and
+ * is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following
+ * Secondary Licenses when the conditions for such availability set
+ * forth in the Eclipse Public License, v. 2.0 are satisfied: GNU
+ * General Public License, version 2 with the GNU Classpath
+ * Exception [1] and GNU General Public License, version 2 with the
+ * OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] http://openjdk.java.net/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
+ *******************************************************************************/
+
+#ifndef X86INSTRUCTIONSCHEDULER_INCL
+#define X86INSTRUCTIONSCHEDULER_INCL
+
+#include <stdint.h>
+#include "env/TRMemory.hpp"
+#include "infra/vector.hpp"
+
+namespace TR { class CodeGenerator; }
+namespace TR { class Compilation; }
+namespace TR { class Instruction; }
+namespace TR { class Register; }
+struct TR_X86ProcessorInfo;
+
+/**
+ * @brief Latencies and issue resources of an x86 processor family, as seen
+ *        by the instruction scheduler.
+ *
+ * The numbers are those of the common cases in the processor vendors'
+ * optimization manuals; they only have to rank instructions correctly, not
+ * predict cycle counts.
+ */
+struct TR_X86SchedulingModel
+   {
+   enum InstructionClass
+      {
+      IntegerMove,       // mov, movzx, movsx, lea
+      IntegerArithmetic, // add, sub, and, or, xor, cmp, test, neg, shifts by an immediate
+      IntegerMultiply,   // two and three operand imul
+      FloatMove,         // scalar and packed SSE moves and logical operations
+      FloatAdd,          // addss, addsd, subss, subsd
+      FloatMultiply,     // mulss, mulsd
+      FloatDivide,       // divss, divsd, sqrtss, sqrtsd
+      NumInstructionClasses
+      };
+
+   const char *_name;
+   uint8_t _latency[NumInstructionClasses];
+   uint8_t _loadLatency;   ///< added to the latency of an instruction that reads memory
+   uint8_t _issueWidth;    ///< instructions issued per cycle
+   uint8_t _loadPorts;     ///< memory reads issued per cycle
+   uint8_t _storePorts;    ///< memory writes issued per cycle
+
+   /**
+    * @brief The model of the processor described by processorInfo, or a
+    *        model of a recent Intel processor for processors not known here.
+    */
+   static const TR_X86SchedulingModel &forProcessor(TR_X86ProcessorInfo &processorInfo);
+   };
+
+/**
+ * @brief List scheduling of the instructions between scheduling barriers.
+ *
+ * A region is a run of consecutive instructions the scheduler understands
+ * well enough to reorder: register to register, register to memory and
+ * immediate forms of moves, integer arithmetic, integer multiply and scalar
+ * SSE arithmetic. Any other instruction, as well as labels, fences, branches,
+ * instructions with register dependencies or a GC map, and instructions with
+ * unresolved or label relative memory references, ends the region and stays
+ * where it is. Blocks with exception successors are not scheduled.
+ *
+ * Within a region the dependences are
+ *    - true, anti and output dependences through registers,
+ *    - the order of memory accesses that may overlap; two accesses are only
+ *      independent when they use the same base and index registers, holding
+ *      the same values, and their displacements do not overlap,
+ *    - the order of flag writers needed to leave the flags of the last one
+ *      in place at the end of the region.
+ *
+ * The instructions are then issued cycle by cycle in order of the longest
+ * latency path to the end of the region, subject to the issue width and the
+ * load and store ports of the processor model, and the region is reordered
+ * only if this is estimated to finish in fewer cycles than the original
+ * order.
+ *
+ * The scheduler runs after register assignment and, optionally, before it
+ * when the local register assigner alone is used; before register assignment
+ * it lengthens live ranges, which the assigner pays for with spills.
+ */
+class TR_X86InstructionScheduler
+   {
+   public:
+
+   TR_ALLOC(TR_Memory::CodeGenerator)
+
+   TR_X86InstructionScheduler(TR::CodeGenerator *cg, bool afterRegisterAssignment);
+
+   /**
+    * @brief Schedule every region of the method's instruction stream.
+    * @return the number of regions whose order changed
+    */
+   int32_t perform();
+
+   TR::CodeGenerator *cg() { return _cg; }
+   TR::Compilation *comp() { return _comp; }
+
+   /// Regions longer than this are split
+   static const int32_t MAX_REGION_SIZE = 64;
+
+   private:
+
+   enum
+      {
+      ReadsMemory      = 0x01,
+      WritesMemory     = 0x02,
+      ConstantMemory   = 0x04, // reads a data snippet, which is never written
+      WritesAllFlags   = 0x08,
+      WritesSomeFlags  = 0x10
+      };
+
+   static const int32_t MAX_READS = 4;
+   static const int32_t MAX_WRITES = 2;
+
+   struct Node
+      {
+      TR::Instruction *_instruction;
+      TR::Register *_reads[MAX_READS];
+      TR::Register *_writes[MAX_WRITES];
+      int8_t _numReads;
+      int8_t _numWrites;
+      uint8_t _properties;
+      uint8_t _latency;
+      int32_t _height;        // longest latency path to the end of the region
+      int32_t _earliest;      // earliest cycle all operands are available
+      int32_t _unscheduledPredecessors;
+      int32_t _firstSuccessor;
+      };
+
+   struct Edge
+      {
+      int32_t _to;
+      int32_t _latency;
+      int32_t _next;
+      };
+
+   bool classify(TR::Instruction *instr, Node &node);
+   bool blockMayBeScheduled(TR::Instruction *fence);
+
+   bool scheduleRegion();
+   bool isInRegion(TR::Instruction *instr);
+   void buildDependences();
+   void addEdge(int32_t from, int32_t to, int32_t latency);
+   bool reads(Node &node, TR::Register *reg);
+   bool writes(Node &node, TR::Register *reg);
+   bool writtenBetween(TR::Register *reg, int32_t from, int32_t to);
+   bool mayOverlap(int32_t a, int32_t b);
+
+   void listSchedule(TR::vector<int32_t> &order);
+   int32_t estimateCycles(TR::vector<int32_t> &order);
+
+   TR::CodeGenerator *_cg;
+   TR::Compilation *_comp;
+   const TR_X86SchedulingModel &_model;
+   TR::Register *_stackPointer;
+   bool _afterRegisterAssignment;
+   bool _trace;
+
+   TR::vector<Node> _nodes;
+   TR::vector<Edge> _edges;
+   };
+
+#endif
@@ -0,0 +1,300 @@
+/*******************************************************************************
+ * Copyright (c) 2020, 2020 IBM Corp. and others
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at https://www.eclipse.org/legal/epl-2.0/
+ * or the Apache License, Version 2.0 which accompanies this distribution and
+ * is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following
+ * Secondary Licenses when the conditions for such availability set
+ * forth in the Eclipse Public License, v. 2.0 are satisfied: GNU
+ * General Public License, version 2 with the GNU Classpath
+ * Exception [1] and GNU General Public License, version 2 with the
+ * OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] http://openjdk.java.net/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
+ *******************************************************************************/
+
+#include "x/codegen/LinearScanRegisterAllocator.hpp"
+
+#include <algorithm>
+#include <stddef.h>
+#include <stdint.h>
+#include "codegen/CodeGenerator.hpp"
+#include "codegen/Instruction.hpp"
+#include "codegen/Linkage.hpp"
+#include "codegen/Machine.hpp"
+#include "codegen/RealRegister.hpp"
+#include "codegen/Register.hpp"
+#include "codegen/RegisterConstants.hpp"
+#include "codegen/RegisterDependency.hpp"
+#include "compile/Compilation.hpp"
+#include "control/Options.hpp"
+#include "control/Options_inlines.hpp"
+#include "env/CompilerEnv.hpp"
+#include "infra/Array.hpp"
+#include "ras/Debug.hpp"
+
+TR_X86LinearScanRegisterAllocator::TR_X86LinearScanRegisterAllocator(TR::CodeGenerator *cg)
+   : _cg(cg),
+     _comp(cg->comp()),
+     _intervals(getTypedAllocator<LiveInterval>(cg->comp()->allocator())),
+     _callSites(getTypedAllocator<uint32_t>(cg->comp()->allocator())),
+     _trace(cg->comp()->getDebug() && cg->comp()->getOptions()->getRegisterAssignmentTraceOption(TR_TraceRABasic))
+   {
+   }
+
+static bool
+isAssignableRealRegister(TR::RealRegister::RegNum regNum)
+   {
+   return (regNum >= TR::RealRegister::FirstGPR && regNum <= TR::RealRegister::LastAssignableGPR) ||
+          (regNum >= TR::RealRegister::FirstXMMR && regNum <= TR::RealRegister::LastXMMR);
+   }
+
+// Records the real register of each dependency as the preferred register of
+// its virtual register, unless an earlier dependency already gave it one.
+//
+static void
+precolourFromDependencies(TR_X86RegisterDependencyGroup *group, uint32_t numDependencies, uint32_t kindMask)
+   {
+   if (group == NULL)
+      return;
+
+   for (uint32_t i = 0; i < numDependencies; i++)
+      {
+      TR::RegisterDependency *dep = group->getRegisterDependency(i);
+      TR::Register *virtReg = dep->getRegister();
+
+      if (virtReg == NULL ||
+          !(TO_KIND_MASK(virtReg->getKind()) & kindMask) ||
+          virtReg->getAssignedRegister() != NULL ||
+          virtReg->getAssociation() != TR::RealRegister::NoReg)
+         continue;
+
+      if (isAssignableRealRegister(dep->getRealRegister()))
+         virtReg->setAssociation(dep->getRealRegister());
+      }
+   }
+
+bool
+TR_X86LinearScanRegisterAllocator::crossesCall(uint32_t start, uint32_t end)
+   {
+   TR::vector<uint32_t>::iterator call = std::upper_bound(_callSites.begin(), _callSites.end(), start);
+   return call != _callSites.end() && *call < end;
+   }
+
+void
+TR_X86LinearScanRegisterAllocator::collectIntervals(uint32_t kindMask)
+   {
+   TR_Array<TR::Register *> &registers = cg()->getRegisterArray();
+
+   _intervals.clear();
+   _callSites.clear();
+
+   for (int32_t i = 0; i < registers.size(); i++)
+      {
+      TR::Register *virtReg = registers[i];
+      if (virtReg && (TO_KIND_MASK(virtReg->getKind()) & kindMask) && virtReg->getAssignedRegister() == NULL)
+         virtReg->setAssociation(TR::RealRegister::NoReg);
+      }
+
+   // Find the calls and seed the dependency preferences in one walk of the
+   // instruction stream. The association of each virtual register holds its
+   // dependency preference until the intervals are built.
+   //
+   for (TR::Instruction *cursor = cg()->getFirstInstruction(); cursor; cursor = cursor->getNext())
+      {
+      if (cursor->getOpCode().isCallOp())
+         _callSites.push_back(cursor->getIndex());
+
+      TR::RegisterDependencyConditions *deps = cursor->getDependencyConditions();
+      if (deps)
+         {
+         precolourFromDependencies(deps->getPreConditions(), deps->getAddCursorForPre(), kindMask);
+         precolourFromDependencies(deps->getPostConditions(), deps->getAddCursorForPost(), kindMask);
+         }
+      }
+
+   std::sort(_callSites.begin(), _callSites.end());
+
+   for (int32_t i = 0; i < registers.size(); i++)
+      {
+      TR::Register *virtReg = registers[i];
+      if (virtReg == NULL ||
+          !(TO_KIND_MASK(virtReg->getKind()) & kindMask) ||
+          virtReg->getAssignedRegister() != NULL)
+         continue;
+
+      TR::Instruction *startInstruction = virtReg->getStartOfRange();
+      TR::Instruction *endInstruction = virtReg->getEndOfRange();
+
+      LiveInterval interval;
+      interval._virtual = virtReg;
+      interval._dependencyRegister = (TR::RealRegister::RegNum)virtReg->getAssociation();
+      virtReg->setAssociation(TR::RealRegister::NoReg);
+
+      // Registers only referenced from out of line code have no range in the
+      // main line and are left to the local assigner.
+      //
+      if (startInstruction == NULL || endInstruction == NULL ||
+          startInstruction->getIndex() > endInstruction->getIndex())
+         continue;
+
+      interval._start = startInstruction->getIndex();
+      interval._end = endInstruction->getIndex();
+      interval._crossesCall = crossesCall(interval._start, interval._end);
+
+      // A register defined by a move from a register that dies at the move
+      // can share its real register, which makes the move an identity move.
+      //
+      interval._moveSource = NULL;
+      if (startInstruction->isRegRegMove() && startInstruction->getTargetRegister() == virtReg)
+         {
+         TR::Register *source = startInstruction->getSourceRegister();
+         if (source && source != virtReg &&
+             (TO_KIND_MASK(source->getKind()) & kindMask) &&
+             source->getEndOfRange() == startInstruction)
+            interval._moveSource = source;
+         }
+
+      _intervals.push_back(interval);
+      }
+
+   std::sort(_intervals.begin(), _intervals.end(), ByStart());
+   }
+
+void
+TR_X86LinearScanRegisterAllocator::allocate(uint32_t kindMask, TR::RealRegister::RegNum first, TR::RealRegister::RegNum last)
+   {
+   const TR::X86LinkageProperties &properties = cg()->getProperties();
+   LiveInterval *holder[TR::RealRegister::NumRegisters];
+   bool allocatable[TR::RealRegister::NumRegisters];
+
+   for (int32_t r = first; r <= last; r++)
+      {
+      holder[r] = NULL;
+      allocatable[r] = cg()->machine()->getRealRegister((TR::RealRegister::RegNum)r)->getState() == TR::RealRegister::Free;
+      }
+
+   collectIntervals(kindMask);
+
+   for (TR::vector<LiveInterval>::iterator it = _intervals.begin(); it != _intervals.end(); ++it)
+      {
+      LiveInterval *interval = &(*it);
+      TR::RealRegister::RegNum choice = TR::RealRegister::NoReg;
+
+      // Expire the intervals that end no later than this one starts. An
+      // interval ending at the instruction where this one starts may share
+      // its real register: the instruction reads it before writing the new
+      // value.
+      //
+      for (int32_t r = first; r <= last; r++)
+         {
+         if (holder[r] && holder[r]->_end <= interval->_start)
+            holder[r] = NULL;
+         }
+
+      if (interval->_moveSource)
+         {
+         TR::RealRegister::RegNum source = (TR::RealRegister::RegNum)interval->_moveSource->getAssociation();
+         if (source >= first && source <= last && allocatable[source] && holder[source] == NULL)
+            choice = source;
+         }
+
+      if (choice == TR::RealRegister::NoReg)
+         {
+         TR::RealRegister::RegNum dependency = interval->_dependencyRegister;
+         if (dependency >= first && dependency <= last && allocatable[dependency] && holder[dependency] == NULL &&
+             (!interval->_crossesCall || properties.isPreservedRegister(dependency)))
+            choice = dependency;
+         }
+
+      if (choice == TR::RealRegister::NoReg)
+         {
+         // Intervals that cross a call want a preserved register to avoid
+         // being spilled around the call; the others want a volatile one so
+         // that preserved registers need not be saved in the prologue.
+         //
+         TR::RealRegister::RegNum fallback = TR::RealRegister::NoReg;
+         for (int32_t r = first; r <= last; r++)
+            {
+            if (!allocatable[r] || holder[r] != NULL)
+               continue;
+
+            if ((properties.isPreservedRegister((TR::RealRegister::RegNum)r) != 0) == interval->_crossesCall)
+               {
+               choice = (TR::RealRegister::RegNum)r;
+               break;
+               }
+
+            if (fallback == TR::RealRegister::NoReg)
+               fallback = (TR::RealRegister::RegNum)r;
+            }
+
+         if (choice == TR::RealRegister::NoReg)
+            choice = fallback;
+         }
+
+      if (choice == TR::RealRegister::NoReg)
+         {
+         // Every register is taken: spill the interval that ends furthest
+         // away, which may be this one.
+         //
+         TR::RealRegister::RegNum victim = TR::RealRegister::NoReg;
+         for (int32_t r = first; r <= last; r++)
+            {
+            if (holder[r] && (victim == TR::RealRegister::NoReg || holder[r]->_end > holder[victim]->_end))
+               victim = (TR::RealRegister::RegNum)r;
+            }
+
+         if (victim != TR::RealRegister::NoReg && holder[victim]->_end > interval->_end)
+            {
+            if (_trace)
+               traceMsg(comp(), "LSRA: spilling %s\n", comp()->getDebug()->getName(holder[victim]->_virtual));
+
+            holder[victim]->_virtual->setAssociation(TR::RealRegister::NoReg);
+            choice = victim;
+            }
+         }
+
+      if (choice != TR::RealRegister::NoReg)
+         {
+         holder[choice] = interval;
+         interval->_virtual->setAssociation(choice);
+         }
+
+      if (_trace)
+         traceMsg(comp(), "LSRA: %s [%u, %u]%s -> %s\n",
+            comp()->getDebug()->getName(interval->_virtual),
+            interval->_start,
+            interval->_end,
+            interval->_crossesCall ? " crosses call" : "",
+            choice != TR::RealRegister::NoReg ? comp()->getDebug()->getName(cg()->machine()->getRealRegister(choice)) : "spilled");
+      }
+   }
+
+void
+TR_X86LinearScanRegisterAllocator::perform(TR_RegisterKinds kindsToAssign)
+   {
+   LexicalTimer t("linear scan register allocation", comp()->phaseTimer());
+
+   if (_trace)
+      traceMsg(comp(), "\n<linearScanRegisterAllocation>\n");
+
+   if (kindsToAssign & TR_GPR_Mask)
+      allocate(TR_GPR_Mask, TR::RealRegister::FirstGPR, TR::RealRegister::LastAssignableGPR);
+
+   // Scalar floating point and vector registers share the XMM registers.
+   //
+   uint32_t xmmKinds = kindsToAssign & (TR_FPR_Mask | TR_VRF_Mask);
+   if (xmmKinds)
+      allocate(xmmKinds, TR::RealRegister::FirstXMMR, TR::RealRegister::LastXMMR);
+
+   if (_trace)
+      traceMsg(comp(), "</linearScanRegisterAllocation>\n");
+   }
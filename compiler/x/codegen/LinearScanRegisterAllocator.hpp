@@ -0,0 +1,104 @@
+/*******************************************************************************
+ * Copyright (c) 2020, 2020 IBM Corp. and others
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at https://www.eclipse.org/legal/epl-2.0/
+ * or the Apache License, Version 2.0 which accompanies this distribution and
+ * is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following
+ * Secondary Licenses when the conditions for such availability set
+ * forth in the Eclipse Public License, v. 2.0 are satisfied: GNU
+ * General Public License, version 2 with the GNU Classpath
+ * Exception [1] and GNU General Public License, version 2 with the
+ * OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] http://openjdk.java.net/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
+ *******************************************************************************/
+
+#ifndef X86LINEARSCANREGISTERALLOCATOR_INCL
+#define X86LINEARSCANREGISTERALLOCATOR_INCL
+
+#include <stdint.h>
+#include "codegen/RealRegister.hpp"
+#include "codegen/RegisterConstants.hpp"
+#include "env/TRMemory.hpp"
+#include "infra/vector.hpp"
+
+namespace TR { class CodeGenerator; }
+namespace TR { class Compilation; }
+namespace TR { class Register; }
+
+/**
+ * @brief Linear scan register allocation over the live intervals of the
+ *        virtual registers in the instruction stream.
+ *
+ * Each virtual register lives from the first to the last instruction that
+ * references it, as recorded by Instruction::useRegister() during instruction
+ * selection. The intervals are visited in order of their start and given a
+ * real register from a pool of free registers; when the pool is empty the
+ * interval that ends furthest away is spilled. Intervals that cross a call
+ * prefer preserved registers, intervals that start at a register to register
+ * move prefer the register of the move source when it dies there, and
+ * registers in a dependency prefer the real register of the dependency.
+ *
+ * The result is a preferred real register recorded as the association of
+ * each virtual register, or NoReg for spilled intervals. The backwards local
+ * register assigner honours these choices when the register is free and
+ * remains responsible for inserting spill, reload and dependency code, so
+ * the allocation only has to be good rather than exact.
+ *
+ * This is a fast alternative to global register allocation plus the local
+ * assigner's weight and interference heuristics for compilations where
+ * compile time matters more than code quality.
+ */
+class TR_X86LinearScanRegisterAllocator
+   {
+   public:
+
+   TR_ALLOC(TR_Memory::CodeGenerator)
+
+   TR_X86LinearScanRegisterAllocator(TR::CodeGenerator *cg);
+
+   /**
+    * @brief Computes a preferred real register for every GPR and XMM virtual
+    *        register of the method whose kind is in kindsToAssign.
+    */
+   void perform(TR_RegisterKinds kindsToAssign);
+
+   TR::CodeGenerator *cg() { return _cg; }
+   TR::Compilation *comp() { return _comp; }
+
+   private:
+
+   struct LiveInterval
+      {
+      TR::Register *_virtual;
+      uint32_t _start;
+      uint32_t _end;
+      TR::Register *_moveSource;
+      TR::RealRegister::RegNum _dependencyRegister;
+      bool _crossesCall;
+      };
+
+   struct ByStart
+      {
+      bool operator()(const LiveInterval &a, const LiveInterval &b) const { return a._start < b._start; }
+      };
+
+   bool crossesCall(uint32_t start, uint32_t end);
+   void collectIntervals(uint32_t kindMask);
+   void allocate(uint32_t kindMask, TR::RealRegister::RegNum first, TR::RealRegister::RegNum last);
+
+   TR::CodeGenerator *_cg;
+   TR::Compilation *_comp;
+   TR::vector<LiveInterval> _intervals;
+   TR::vector<uint32_t> _callSites;
+   bool _trace;
+   };
+
+#endif
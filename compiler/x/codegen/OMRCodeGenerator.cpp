@@ -56,6 +56,7 @@
 #include "compile/ResolvedMethod.hpp"
 #include "compile/SymbolReferenceTable.hpp"
 #include "compile/VirtualGuard.hpp"
+#include "control/OptimizationPlan.hpp"
 #include "control/Options.hpp"
 #include "control/Options_inlines.hpp"
 #include "control/Recompilation.hpp"
@@ -94,11 +95,13 @@
 #include "ras/DebugCounter.hpp"
 #include "runtime/CodeCacheManager.hpp"
 #include "x/codegen/DataSnippet.hpp"
+#include "x/codegen/LinearScanRegisterAllocator.hpp"
 #include "x/codegen/OutlinedInstructions.hpp"
 #include "x/codegen/FPTreeEvaluator.hpp"
 #include "x/codegen/X86Instruction.hpp"
 #include "x/codegen/X86Ops.hpp"
 #include "x/codegen/X86Ops_inlines.hpp"
+#include "x/codegen/X86Peephole.hpp"
 
 namespace OMR { class RegisterUsage; }
 namespace TR { class RegisterDependencyConditions; }
@@ -352,7 +355,17 @@ OMR::X86::CodeGenerator::initialize(TR::Compilation *comp)
       self()->setEnableBetterSpillPlacements();
 
    self()->setEnableRematerialisation();
-   self()->setEnableRegisterAssociations();
+
+   // Fast compilations allocate registers by linear scan instead of GRA. The
+   // local assigner then follows the linear scan choices, which are recorded
+   // in the same association fields that GRA register associations use.
+   //
+   if (comp->getOption(TR_EnableLinearScanRegisterAllocation) ||
+       (comp->getOptimizationPlan() && comp->getOptimizationPlan()->getUseLinearScanRegisterAllocation()))
+      self()->setUseLinearScanRegisterAllocation();
+   else
+      self()->setEnableRegisterAssociations();
+
    self()->setEnableRegisterWeights();
    self()->setEnableRegisterInterferences();
 
@@ -502,6 +515,10 @@ OMR::X86::CodeGenerator::CodeGenerator() :
    _clobberingInstructions(getTypedAllocator<TR::ClobberingInstruction*>(TR::comp()->allocator())),
    _outlinedInstructionsList(getTypedAllocator<TR_OutlinedInstructions*>(TR::comp()->allocator())),
    _numReservedIPICTrampolines(0),
+   _coldCodeStartInstruction(NULL),
+   _coldCodeEstimatedStart(0),
+   _coldCodeEstimatedEnd(0),
+   _encodingColdCode(false),
    _flags(0)
    {
    _clobIterator = _clobberingInstructions.begin();
@@ -999,6 +1016,10 @@ OMR::X86::CodeGenerator::getSupportsOpCodeForAutoSIMD(TR::ILOpCode opcode, TR::D
          else
             return false;
       case TR::vneg:
+         if (dt == TR::Int32 || dt == TR::Int64 || dt == TR::Float || dt == TR::Double)
+            return true;
+         else
+            return false;
       case TR::vrem:
          return false;
       case TR::vxor:
@@ -1600,6 +1621,12 @@ void OMR::X86::CodeGenerator::doRegisterAssignment(TR_RegisterKinds kindsToAssig
       if (self()->enableRegisterAssociations())
          self()->machine()->setGPRWeightsFromAssociations();
 
+      if (self()->getUseLinearScanRegisterAllocation())
+         {
+         TR_X86LinearScanRegisterAllocator linearScan(self());
+         linearScan.perform(kindsToAssign);
+         }
+
       self()->doBackwardsRegisterAssignment(kindsToAssign, self()->getAppendInstruction());
       }
    }
@@ -1627,6 +1654,89 @@ struct DescendingSortX86DataSnippetByDataSize
       return a->getDataSize() > b->getDataSize();
       }
    };
+// Returns the first instruction of the cold tail of the method, which is placed
+// in the cold code cache region: the trailing run of cold or rarely executed
+// blocks that block ordering has moved to the end of the method, followed by
+// the out of line code sections appended after the last block. Returns NULL if
+// the method is not to be split.
+//
+TR::Instruction *
+OMR::X86::CodeGenerator::findColdCodeStartInstruction()
+   {
+   TR::Compilation *comp = self()->comp();
+
+   // Relocatable code, ELF objects and code described by static relocations
+   // all treat a method as a single range
+   //
+   if (!comp->getOption(TR_SplitWarmAndColdBlocks) ||
+       comp->compileRelocatableCode() ||
+       comp->getOption(TR_EmitExecutableELFFile) ||
+       self()->needStaticRelocations())
+      return NULL;
+
+   TR::Block *lastBlock = NULL;
+   TR::Block *firstColdBlock = NULL;
+   for (TR::Block *block = comp->getStartBlock(); block; block = block->getNextBlock())
+      {
+      lastBlock = block;
+      if (!block->isCold() && !block->isRare(comp))
+         {
+         firstColdBlock = NULL;
+         }
+      else if (!firstColdBlock)
+         {
+         // Warm code must not fall through into the cold region
+         //
+         TR::Block *prevBlock = block->getPrevBlock();
+         if (prevBlock &&
+             !block->isExtensionOfPreviousBlock() &&
+             !prevBlock->hasSuccessor(block) &&
+             block->getFirstInstruction())
+            firstColdBlock = block;
+         }
+      }
+
+   if (firstColdBlock)
+      return firstColdBlock->getFirstInstruction();
+
+   if (!lastBlock || !lastBlock->getLastInstruction())
+      return NULL;
+
+   for (TR::Instruction *cursor = lastBlock->getLastInstruction(); cursor; cursor = cursor->getNext())
+      {
+      if (cursor->getOpCodeValue() == LABEL &&
+          self()->findOutlinedInstructionsFromLabel(cursor->getLabelSymbol()))
+         return cursor;
+      }
+
+   return NULL;
+   }
+
+uint8_t *
+OMR::X86::CodeGenerator::getEstimatedCodeLocationBase()
+   {
+   return _encodingColdCode ? self()->getColdCodeStart() - _coldCodeEstimatedStart : self()->getBinaryBufferStart();
+   }
+
+bool
+OMR::X86::CodeGenerator::isEstimatedCodeLocationInOtherRegion(int32_t estimatedCodeLocation)
+   {
+   if (!_coldCodeStartInstruction)
+      return false;
+
+   bool isColdLocation = estimatedCodeLocation >= _coldCodeEstimatedStart && estimatedCodeLocation < _coldCodeEstimatedEnd;
+   return isColdLocation != _encodingColdCode;
+   }
+
+void OMR::X86::CodeGenerator::doPeephole()
+   {
+   if (self()->comp()->getOption(TR_DisablePeephole) || self()->comp()->getOptLevel() == noOpt)
+      return;
+
+   TR_X86Peephole peephole(self());
+   peephole.perform();
+   }
+
 void OMR::X86::CodeGenerator::doBinaryEncoding()
    {
    LexicalTimer pt1("code generation", self()->comp()->phaseTimer());
@@ -1684,6 +1794,11 @@ void OMR::X86::CodeGenerator::doBinaryEncoding()
    //
    std::sort(_dataSnippetList.begin(), _dataSnippetList.end(), DescendingSortX86DataSnippetByDataSize());
 
+   // Find the code to place in the cold code cache region
+   //
+   _coldCodeStartInstruction = self()->findColdCodeStartInstruction();
+   int32_t warmCodeEstimatedEnd = 0;
+
    /////////////////////////////////////////////////////////////////
    //
    // Pass 1: Binary length estimation and prologue creation
@@ -1724,6 +1839,8 @@ void OMR::X86::CodeGenerator::doBinaryEncoding()
    if (recompilation)
       prologueCursor = recompilation->generatePrologue(prologueCursor);
 
+   prologueCursor = self()->generateProjectSpecializedEntryCode(prologueCursor);
+
    // Establish the VFP ground state.
    // This instruction actually ends up immediately AFTER the prologue.
    //
@@ -1754,6 +1871,18 @@ void OMR::X86::CodeGenerator::doBinaryEncoding()
    int32_t estimatedPrologueStartOffset = estimate;
    while (estimateCursor)
       {
+      if (estimateCursor == _coldCodeStartInstruction)
+         {
+         // Estimate the cold code as if it followed the warm code at more than
+         // the reach of a short branch, so that branches between the two are
+         // estimated as long ones.
+         //
+         static const int32_t coldCodeEstimatedGap = 256;
+         warmCodeEstimatedEnd = estimate;
+         estimate += coldCodeEstimatedGap;
+         _coldCodeEstimatedStart = estimate;
+         }
+
       // Update the info bits on the register mask.
       //
       if (estimateCursor->needsGCMap())
@@ -1845,7 +1974,32 @@ void OMR::X86::CodeGenerator::doBinaryEncoding()
    if (self()->comp()->getOption(TR_TraceVFPSubstitution))
       traceMsg(self()->comp(), "\n</instructions>\n");
 
+   // The snippets are emitted after the warm code. Keep their estimated
+   // locations at the same 16 byte alignment relative to the end of it.
+   //
+   int32_t coldCodeEstimatedLength = 0;
+   if (_coldCodeStartInstruction)
+      {
+      _coldCodeEstimatedEnd = estimate;
+      coldCodeEstimatedLength = _coldCodeEstimatedEnd - _coldCodeEstimatedStart;
+      estimate += (16 - (estimate - warmCodeEstimatedEnd) % 16) % 16;
+      }
+   int32_t snippetEstimatedStart = estimate;
+
    estimate = self()->setEstimatedLocationsForSnippetLabels(estimate);
+
+   if (coldCodeEstimatedLength > 0)
+      {
+      estimate = warmCodeEstimatedEnd + (estimate - snippetEstimatedStart);
+      if (self()->comp()->getOption(TR_TraceCG))
+         traceMsg(self()->comp(), "Placing %d estimated bytes of cold code from instruction %p in the cold code cache region\n",
+            coldCodeEstimatedLength, _coldCodeStartInstruction);
+      }
+   else
+      {
+      _coldCodeStartInstruction = NULL;
+      }
+
    // When using copyBinaryToBuffer() to copy the encoding of an instruction we
    // indiscriminatelly copy a whole integer, even if the size of the encoding
    // is less than that. This may cause the write to happen beyond the allocated
@@ -1872,7 +2026,8 @@ void OMR::X86::CodeGenerator::doBinaryEncoding()
       }
 
    uint8_t * coldCode = NULL;
-   uint8_t * temp = self()->allocateCodeMemory(self()->getEstimatedCodeLength(), 0, &coldCode);
+   uint32_t coldCodeAllocationSize = _coldCodeStartInstruction ? coldCodeEstimatedLength + OVER_ESTIMATION : 0;
+   uint8_t * temp = self()->allocateCodeMemory(self()->getEstimatedCodeLength(), coldCodeAllocationSize, &coldCode);
    TR_ASSERT(temp, "Failed to allocate primary code area.");
 
    if (self()->comp()->target().is64Bit() && self()->hasCodeCacheSwitched() && self()->getPicSlotCount() != 0)
@@ -1905,8 +2060,22 @@ void OMR::X86::CodeGenerator::doBinaryEncoding()
 
    // Generate binary for the rest of the instructions
    //
+   uint8_t * warmCodeEnd = NULL;
+   int32_t warmCodeLengthError = 0;
    while (cursorInstruction)
       {
+      if (cursorInstruction == _coldCodeStartInstruction)
+         {
+         // Continue in the cold code cache region
+         //
+         warmCodeEnd = self()->getBinaryBufferCursor();
+         warmCodeLengthError = self()->getAccumulatedInstructionLengthError();
+         self()->setColdCodeStart(coldCode);
+         self()->setBinaryBufferCursor(coldCode);
+         self()->setAccumulatedInstructionLengthError(0);
+         _encodingColdCode = true;
+         }
+
       uint8_t * const instructionStart = self()->getBinaryBufferCursor();
       self()->setBinaryBufferCursor(cursorInstruction->generateBinaryEncoding());
       TR_ASSERT(cursorInstruction->getEstimatedBinaryLength() >= self()->getBinaryBufferCursor() - instructionStart,
@@ -1941,6 +2110,19 @@ void OMR::X86::CodeGenerator::doBinaryEncoding()
       cursorInstruction = cursorInstruction->getNext();
       }
 
+   if (_encodingColdCode)
+      {
+      // The snippets follow the warm code
+      //
+      self()->setColdCodeEnd(self()->getBinaryBufferCursor());
+      TR_ASSERT(self()->getColdCodeEnd() - self()->getColdCodeStart() <= coldCodeAllocationSize,
+              "Cold code length estimate must be conservatively large (estimate=%d, actual=%d)",
+              coldCodeAllocationSize, (int32_t)(self()->getColdCodeEnd() - self()->getColdCodeStart()));
+      self()->setBinaryBufferCursor(warmCodeEnd);
+      self()->setAccumulatedInstructionLengthError(warmCodeLengthError);
+      _encodingColdCode = false;
+      }
+
    // Create exception table entries for outlined instructions.
    //
    for(auto oiIterator = self()->getOutlinedInstructionsList().begin(); oiIterator != self()->getOutlinedInstructionsList().end(); ++oiIterator)
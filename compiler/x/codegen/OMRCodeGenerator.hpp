@@ -351,8 +351,18 @@ class OMR_EXTENSIBLE CodeGenerator : public OMR::CodeGenerator
       } RegisterAssignmentDirection;
 
    void doRegisterAssignment(TR_RegisterKinds kindsToAssign);
+   void doPeephole();
    void doBinaryEncoding();
 
+   /**
+    * @brief Generate project specific code at the very start of the method
+    *        entry, before the linkage prologue; nothing by default.
+    *
+    * @param[in] cursor : the instruction to generate the code after
+    * @return the last instruction generated, or cursor if there is none
+    */
+   TR::Instruction *generateProjectSpecializedEntryCode(TR::Instruction *cursor) { return cursor; }
+
    void doBackwardsRegisterAssignment(TR_RegisterKinds kindsToAssign, TR::Instruction *startInstruction, TR::Instruction *appendInstruction = NULL);
 
    bool hasComplexAddressingMode() { return true; }
@@ -448,6 +458,24 @@ class OMR_EXTENSIBLE CodeGenerator : public OMR::CodeGenerator
    void emitDataSnippets();
    bool hasDataSnippets() { return _dataSnippetList.empty() ? false : true; }
 
+   /** \brief
+    *     Returns the address that the estimated code locations of labels in the
+    *     code currently being encoded are relative to.
+    *
+    *     Estimated locations in the cold part of a method that is split between
+    *     the warm and cold code cache regions are relative to the start of the
+    *     cold code; all others are relative to the start of the binary buffer.
+    */
+   uint8_t *getEstimatedCodeLocationBase();
+
+   /** \brief
+    *     Determines whether code at an estimated location will be placed in the
+    *     other part of a split method than the code currently being encoded,
+    *     in which case its distance from the binary buffer cursor is unknown
+    *     until it is emitted.
+    */
+   bool isEstimatedCodeLocationInOtherRegion(int32_t estimatedCodeLocation);
+
    TR::list<TR::Register*> &getSpilledIntRegisters() {return _spilledIntRegisters;}
 
    TR::list<TR::Register*> &getLiveDiscardableRegisters() {return _liveDiscardableRegisters;}
@@ -708,6 +736,8 @@ class OMR_EXTENSIBLE CodeGenerator : public OMR::CodeGenerator
 
    bool nodeIsFoldableMemOperand(TR::Node *node, TR::Node *parent, TR_RegisterPressureState *state);
 
+   TR::Instruction *findColdCodeStartInstruction();
+
    TR::RealRegister             *_frameRegister;
 
    TR::SymbolReference             *_wordConversionTemp;
@@ -735,6 +765,13 @@ class OMR_EXTENSIBLE CodeGenerator : public OMR::CodeGenerator
    TR_VFPState                     _vfpState;
    TR::X86VFPSaveInstruction       *_vfpResetInstruction;
 
+   // The cold tail of a method placed in the cold code cache region, and its
+   // estimated locations [start, end)
+   TR::Instruction                 *_coldCodeStartInstruction;
+   int32_t                         _coldCodeEstimatedStart;
+   int32_t                         _coldCodeEstimatedEnd;
+   bool                            _encodingColdCode;
+
    TR_X86PaddingTable             *_paddingTable;
 
    TR::LabelSymbol                  *_switchToInterpreterLabel;
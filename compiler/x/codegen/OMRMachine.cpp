@@ -287,6 +287,22 @@ OMR::X86::Machine::findBestFreeGPRegister(TR::Instruction   *currentInstruction,
          TR_ASSERT(0, "unknown register size requested\n");
       }
 
+   // Take the register chosen by linear scan allocation if it is free.
+   //
+   int32_t preferred = (int32_t)virtReg->getAssociation();
+   if (self()->cg()->getUseLinearScanRegisterAllocation() &&
+       preferred >= first &&
+       preferred <= last)
+      {
+      TR::RealRegister *realReg = _registerFile[preferred];
+      if (realReg->getState() == TR::RealRegister::Free ||
+          (considerUnlatched && realReg->getState() == TR::RealRegister::Unlatched))
+         {
+         self()->cg()->setRegisterAssignmentFlag(TR_ByColouring);
+         return realReg;
+         }
+      }
+
    uint32_t                        weight;
    uint32_t                        bestWeightSoFar   = IA32_REGISTER_HEAVIEST_WEIGHT ;
    TR_RegisterMask                 interference      = virtReg->getInterference();
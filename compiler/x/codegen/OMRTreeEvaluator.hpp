@@ -294,6 +294,15 @@ class OMR_EXTENSIBLE TreeEvaluator: public OMR::TreeEvaluator
    static TR::Register *SIMDstoreEvaluator(TR::Node *node, TR::CodeGenerator *cg);
    static TR::Register *SIMDsplatsEvaluator(TR::Node *node, TR::CodeGenerator *cg);
    static TR::Register *SIMDgetvelemEvaluator(TR::Node *node, TR::CodeGenerator *cg);
+   static TR::Register *SIMDsetelemEvaluator(TR::Node *node, TR::CodeGenerator *cg);
+   static TR::Register *SIMDnegEvaluator(TR::Node *node, TR::CodeGenerator *cg);
+   static TR::Register *SIMDcomEvaluator(TR::Node *node, TR::CodeGenerator *cg);
+   static TR::Register *SIMDshiftEvaluator(TR::Node *node, TR::CodeGenerator *cg);
+   static TR::Register *SIMDcompareEvaluator(TR::Node *node, TR::CodeGenerator *cg);
+   static TR::Register *SIMDselectEvaluator(TR::Node *node, TR::CodeGenerator *cg);
+   static TR::Register *SIMDrandEvaluator(TR::Node *node, TR::CodeGenerator *cg);
+   static TR::Register *SIMDv2vEvaluator(TR::Node *node, TR::CodeGenerator *cg);
+   static TR::Register *SIMDl2vdEvaluator(TR::Node *node, TR::CodeGenerator *cg);
 
    static TR::Register *icmpsetEvaluator(TR::Node *node, TR::CodeGenerator *cg);
    static TR::Register *bztestnsetEvaluator(TR::Node *node, TR::CodeGenerator *cg);
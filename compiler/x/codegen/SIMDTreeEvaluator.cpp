@@ -329,3 +329,573 @@ TR::Register* OMR::X86::TreeEvaluator::SIMDgetvelemEvaluator(TR::Node* node, TR:
    return resReg;
    }
 
+
+static int32_t getVectorElementSize(TR::DataType vectorType)
+   {
+   return TR::DataType::getSize(vectorType.getVectorElementType());
+   }
+
+/*
+ * Index of an element size of 1, 2, 4 or 8 bytes into the per-size opcode tables below
+ */
+static int32_t getVectorElementSizeIndex(int32_t elementSize)
+   {
+   switch (elementSize)
+      {
+      case 1:
+         return 0;
+      case 2:
+         return 1;
+      case 4:
+         return 2;
+      case 8:
+         return 3;
+      default:
+         TR_ASSERT_FATAL(false, "Unsupported vector element size %d", elementSize);
+         return -1;
+      }
+   }
+
+static void generateVectorAllOnes(TR::Node* node, TR::Register* reg, TR::CodeGenerator* cg)
+   {
+   generateRegRegInstruction(PCMPEQDRegReg, node, reg, reg, cg);
+   }
+
+/*
+ * Fill reg with elements of elementSize bytes which only have their sign bit set
+ */
+static void generateVectorSignMask(TR::Node* node, TR::Register* reg, int32_t elementSize, TR::CodeGenerator* cg)
+   {
+   generateVectorAllOnes(node, reg, cg);
+   switch (elementSize)
+      {
+      case 1:
+         {
+         // There is no byte shift; merge words of 0x8000 and 0x0080 instead
+         TR::Register* tempReg = cg->allocateRegister(TR_VRF);
+         generateRegImmInstruction(PSLLWRegImm1, node, reg, 15, cg);
+         generateRegRegInstruction(MOVDQURegReg, node, tempReg, reg, cg);
+         generateRegImmInstruction(PSRLWRegImm1, node, tempReg, 8, cg);
+         generateRegRegInstruction(PORRegReg, node, reg, tempReg, cg);
+         cg->stopUsingRegister(tempReg);
+         break;
+         }
+      case 2:
+         generateRegImmInstruction(PSLLWRegImm1, node, reg, 15, cg);
+         break;
+      case 4:
+         generateRegImmInstruction(PSLLDRegImm1, node, reg, 31, cg);
+         break;
+      case 8:
+         generateRegImmInstruction(PSLLQRegImm1, node, reg, 63, cg);
+         break;
+      default:
+         TR_ASSERT_FATAL(false, "Unsupported vector element size %d", elementSize);
+         break;
+      }
+   }
+
+TR::Register* OMR::X86::TreeEvaluator::SIMDsetelemEvaluator(TR::Node* node, TR::CodeGenerator* cg)
+   {
+   TR::Node* vectorNode = node->getChild(0);
+   TR::Node* elementNode = node->getChild(1);
+   TR::Node* valueNode = node->getChild(2);
+
+   TR_ASSERT_FATAL(elementNode->getOpCode().isLoadConst(), "non-const second child not currently supported in SIMDsetelemEvaluator");
+
+   TR::Register* vectorReg = cg->evaluate(vectorNode);
+   TR::Register* valueReg = cg->evaluate(valueNode);
+   TR::Register* resultReg = cg->allocateRegister(TR_VRF);
+
+   // Element indices follow memory order, i.e. element 0 is the least significant element of the register
+   int32_t elem = elementNode->getInt();
+   int32_t elementCount = 16 / getVectorElementSize(node->getDataType());
+   TR_ASSERT_FATAL(elem >= 0 && elem < elementCount, "Element can only be 0 to %d", elementCount - 1);
+
+   if (TR::VectorDouble == node->getDataType())
+      {
+      TR::Register* tempReg = cg->allocateRegister(TR_VRF);
+      if (0 == elem)
+         {
+         generateRegRegImmInstruction(PSHUFDRegRegImm1, node, tempReg, vectorReg, 0xee, cg); // 11 10 11 10 shuffle DCxx to DCDC
+         generateRegRegInstruction(MOVDQURegReg, node, resultReg, valueReg, cg);
+         generateRegRegInstruction(UNPCKLPDRegReg, node, resultReg, tempReg, cg);
+         }
+      else
+         {
+         generateRegRegInstruction(MOVDQURegReg, node, resultReg, vectorReg, cg);
+         generateRegRegInstruction(UNPCKLPDRegReg, node, resultReg, valueReg, cg);
+         }
+      cg->stopUsingRegister(tempReg);
+      }
+   else
+      {
+      generateRegRegInstruction(MOVDQURegReg, node, resultReg, vectorReg, cg);
+      switch (node->getDataType())
+         {
+         case TR::VectorInt8:
+            TR_ASSERT_FATAL(TR::CodeGenerator::getX86ProcessorInfo().supportsSSE4_1(), "PINSRB requires SSE4.1");
+            generateRegRegImmInstruction(PINSRBRegRegImm1, node, resultReg, valueReg, elem, cg);
+            break;
+         case TR::VectorInt16:
+            generateRegRegImmInstruction(PINSRWRegRegImm1, node, resultReg, valueReg, elem, cg);
+            break;
+         case TR::VectorInt32:
+            TR_ASSERT_FATAL(TR::CodeGenerator::getX86ProcessorInfo().supportsSSE4_1(), "PINSRD requires SSE4.1");
+            generateRegRegImmInstruction(PINSRDRegRegImm1, node, resultReg, valueReg, elem, cg);
+            break;
+         case TR::VectorInt64:
+            TR_ASSERT_FATAL(TR::CodeGenerator::getX86ProcessorInfo().supportsSSE4_1(), "PINSRD/PINSRQ requires SSE4.1");
+            if (cg->comp()->target().is32Bit())
+               {
+               generateRegRegImmInstruction(PINSRDRegRegImm1, node, resultReg, valueReg->getLowOrder(), 2 * elem, cg);
+               generateRegRegImmInstruction(PINSRDRegRegImm1, node, resultReg, valueReg->getHighOrder(), 2 * elem + 1, cg);
+               }
+            else
+               {
+               generateRegRegImmInstruction(PINSRQRegRegImm1, node, resultReg, valueReg, elem, cg);
+               }
+            break;
+         case TR::VectorFloat:
+            {
+            TR_ASSERT_FATAL(TR::CodeGenerator::getX86ProcessorInfo().supportsSSE4_1(), "PINSRD requires SSE4.1");
+            TR::Register* tempReg = cg->allocateRegister();
+            generateRegRegInstruction(MOVDReg4Reg, node, tempReg, valueReg, cg);
+            generateRegRegImmInstruction(PINSRDRegRegImm1, node, resultReg, tempReg, elem, cg);
+            cg->stopUsingRegister(tempReg);
+            break;
+            }
+         default:
+            if (cg->comp()->getOption(TR_TraceCG))
+               traceMsg(cg->comp(), "Unsupported data type, Node = %p\n", node);
+            TR_ASSERT(false, "Unsupported data type");
+            break;
+         }
+      }
+
+   node->setRegister(resultReg);
+   cg->decReferenceCount(vectorNode);
+   cg->decReferenceCount(elementNode);
+   cg->decReferenceCount(valueNode);
+   return resultReg;
+   }
+
+TR::Register* OMR::X86::TreeEvaluator::SIMDnegEvaluator(TR::Node* node, TR::CodeGenerator* cg)
+   {
+   TR::Node* childNode = node->getChild(0);
+   TR::Register* childReg = cg->evaluate(childNode);
+   TR::Register* resultReg = cg->allocateRegister(TR_VRF);
+
+   static const TR_X86OpCodes subOpCodes[] = { PSUBBRegReg, PSUBWRegReg, PSUBDRegReg, PSUBQRegReg };
+
+   switch (node->getDataType())
+      {
+      case TR::VectorInt8:
+      case TR::VectorInt16:
+      case TR::VectorInt32:
+      case TR::VectorInt64:
+         generateRegRegInstruction(PXORRegReg, node, resultReg, resultReg, cg);
+         generateRegRegInstruction(subOpCodes[getVectorElementSizeIndex(getVectorElementSize(node->getDataType()))], node, resultReg, childReg, cg);
+         break;
+      case TR::VectorFloat:
+      case TR::VectorDouble:
+         // Flip the sign bits rather than subtracting from zero so that -(0.0) is -0.0
+         generateVectorSignMask(node, resultReg, getVectorElementSize(node->getDataType()), cg);
+         generateRegRegInstruction(PXORRegReg, node, resultReg, childReg, cg);
+         break;
+      default:
+         if (cg->comp()->getOption(TR_TraceCG))
+            traceMsg(cg->comp(), "Unsupported data type, Node = %p\n", node);
+         TR_ASSERT(false, "Unsupported data type");
+         break;
+      }
+
+   node->setRegister(resultReg);
+   cg->decReferenceCount(childNode);
+   return resultReg;
+   }
+
+TR::Register* OMR::X86::TreeEvaluator::SIMDcomEvaluator(TR::Node* node, TR::CodeGenerator* cg)
+   {
+   TR::Node* childNode = node->getChild(0);
+   TR::Register* childReg = cg->evaluate(childNode);
+   TR::Register* resultReg = cg->allocateRegister(TR_VRF);
+
+   generateVectorAllOnes(node, resultReg, cg);
+   generateRegRegInstruction(PXORRegReg, node, resultReg, childReg, cg);
+
+   node->setRegister(resultReg);
+   cg->decReferenceCount(childNode);
+   return resultReg;
+   }
+
+/*
+ * Shift each element of the first child by the second child, which is either a scalar applied to all
+ * elements or, with AVX2, a vector of per-element shift amounts. Shift amounts are taken modulo the
+ * element width, as for scalar shifts.
+ */
+TR::Register* OMR::X86::TreeEvaluator::SIMDshiftEvaluator(TR::Node* node, TR::CodeGenerator* cg)
+   {
+   TR::Node* valueNode = node->getChild(0);
+   TR::Node* amountNode = node->getChild(1);
+
+   int32_t elementSize = getVectorElementSize(node->getDataType());
+   int32_t elementBits = elementSize * 8;
+   TR_ASSERT_FATAL(node->getDataType().getVectorElementType().isIntegral() && elementSize > 1, "Unsupported data type %s in SIMDshiftEvaluator", node->getDataType().toString());
+
+   // Indexed by element size (2, 4, 8 bytes); arithmetic right shifts of 64-bit elements are emulated with logical shifts
+   static const TR_X86OpCodes immOpCodes[3][3] =
+      {
+      { PSLLWRegImm1, PSLLDRegImm1, PSLLQRegImm1 }, // vshl
+      { PSRLWRegImm1, PSRLDRegImm1, PSRLQRegImm1 }, // vushr
+      { PSRAWRegImm1, PSRADRegImm1, PSRLQRegImm1 }, // vshr
+      };
+   static const TR_X86OpCodes regOpCodes[3][3] =
+      {
+      { PSLLWRegReg, PSLLDRegReg, PSLLQRegReg }, // vshl
+      { PSRLWRegReg, PSRLDRegReg, PSRLQRegReg }, // vushr
+      { PSRAWRegReg, PSRADRegReg, PSRLQRegReg }, // vshr
+      };
+   static const TR_X86OpCodes varOpCodes[3][3] =
+      {
+      { BADIA32Op, VPSLLVDRegRegReg, VPSLLVQRegRegReg }, // vshl
+      { BADIA32Op, VPSRLVDRegRegReg, VPSRLVQRegRegReg }, // vushr
+      { BADIA32Op, VPSRAVDRegRegReg, VPSRLVQRegRegReg }, // vshr
+      };
+
+   int32_t shift = -1;
+   switch (node->getOpCodeValue())
+      {
+      case TR::vshl:
+         shift = 0;
+         break;
+      case TR::vushr:
+         shift = 1;
+         break;
+      case TR::vshr:
+         shift = 2;
+         break;
+      default:
+         TR_ASSERT_FATAL(false, "Unsupported OpCode");
+         break;
+      }
+   int32_t size = getVectorElementSizeIndex(elementSize) - 1;
+   bool emulateArithmeticShift = (TR::vshr == node->getOpCodeValue()) && (8 == elementSize);
+
+   TR::Register* valueReg = cg->evaluate(valueNode);
+   TR::Register* resultReg = cg->allocateRegister(TR_VRF);
+   TR::Register* signMaskReg = NULL;
+   if (emulateArithmeticShift)
+      {
+      signMaskReg = cg->allocateRegister(TR_VRF);
+      generateVectorSignMask(node, signMaskReg, elementSize, cg);
+      }
+
+   if (amountNode->getDataType().isVector())
+      {
+      TR_ASSERT_FATAL(TR::CodeGenerator::getX86ProcessorInfo().supportsAVX2(), "Per-element vector shifts require AVX2");
+      TR_ASSERT_FATAL(BADIA32Op != varOpCodes[shift][size], "Unsupported data type %s in SIMDshiftEvaluator", node->getDataType().toString());
+
+      TR::Register* amountReg = cg->evaluate(amountNode);
+      TR::Register* maskedAmountReg = cg->allocateRegister(TR_VRF);
+      generateVectorAllOnes(node, maskedAmountReg, cg);
+      generateRegImmInstruction((4 == elementSize) ? PSRLDRegImm1 : PSRLQRegImm1, node, maskedAmountReg, (4 == elementSize) ? 27 : 58, cg);
+      generateRegRegInstruction(PANDRegReg, node, maskedAmountReg, amountReg, cg);
+
+      generateRegRegRegInstruction(varOpCodes[shift][size], node, resultReg, valueReg, maskedAmountReg, cg);
+      if (emulateArithmeticShift)
+         generateRegRegRegInstruction(VPSRLVQRegRegReg, node, signMaskReg, signMaskReg, maskedAmountReg, cg);
+      cg->stopUsingRegister(maskedAmountReg);
+      }
+   else if (amountNode->getOpCode().isLoadConst())
+      {
+      uint8_t amount = (uint8_t)(amountNode->get64bitIntegralValue() & (elementBits - 1));
+      generateRegRegInstruction(MOVDQURegReg, node, resultReg, valueReg, cg);
+      generateRegImmInstruction(immOpCodes[shift][size], node, resultReg, amount, cg);
+      if (emulateArithmeticShift)
+         generateRegImmInstruction(PSRLQRegImm1, node, signMaskReg, amount, cg);
+      }
+   else
+      {
+      TR::Register* amountReg = cg->evaluate(amountNode);
+      TR::Register* maskedAmountReg = cg->allocateRegister();
+      TR::Register* countReg = cg->allocateRegister(TR_VRF);
+      generateRegRegInstruction(MOV4RegReg, node, maskedAmountReg, amountReg->getRegisterPair() ? amountReg->getLowOrder() : amountReg, cg);
+      generateRegImmInstruction(AND4RegImms, node, maskedAmountReg, elementBits - 1, cg);
+      generateRegRegInstruction(MOVDRegReg4, node, countReg, maskedAmountReg, cg);
+
+      generateRegRegInstruction(MOVDQURegReg, node, resultReg, valueReg, cg);
+      generateRegRegInstruction(regOpCodes[shift][size], node, resultReg, countReg, cg);
+      if (emulateArithmeticShift)
+         generateRegRegInstruction(PSRLQRegReg, node, signMaskReg, countReg, cg);
+      cg->stopUsingRegister(maskedAmountReg);
+      cg->stopUsingRegister(countReg);
+      }
+
+   if (emulateArithmeticShift)
+      {
+      // Sign extend the logically shifted value: (x ^ m) - m where m is the shifted sign bit
+      generateRegRegInstruction(PXORRegReg, node, resultReg, signMaskReg, cg);
+      generateRegRegInstruction(PSUBQRegReg, node, resultReg, signMaskReg, cg);
+      cg->stopUsingRegister(signMaskReg);
+      }
+
+   node->setRegister(resultReg);
+   cg->decReferenceCount(valueNode);
+   cg->decReferenceCount(amountNode);
+   return resultReg;
+   }
+
+/*
+ * Produce a vector of all-ones (true) or all-zeros (false) elements. Integral compares are built from
+ * "equal" and signed "greater than"; unsigned operands are biased by the sign bit to use the signed compare.
+ */
+TR::Register* OMR::X86::TreeEvaluator::SIMDcompareEvaluator(TR::Node* node, TR::CodeGenerator* cg)
+   {
+   TR::Node* firstChild = node->getChild(0);
+   TR::Node* secondChild = node->getChild(1);
+   TR::DataType type = firstChild->getDataType();
+
+   TR::Register* firstReg = cg->evaluate(firstChild);
+   TR::Register* secondReg = cg->evaluate(secondChild);
+   TR::Register* resultReg = cg->allocateRegister(TR_VRF);
+
+   bool swapOperands = false;
+   if (TR::VectorFloat == type || TR::VectorDouble == type)
+      {
+      uint8_t predicate = 0;
+      switch (node->getOpCodeValue())
+         {
+         case TR::vcmpeq:
+            predicate = 0x00; // EQ_OQ
+            break;
+         case TR::vcmpne:
+            predicate = 0x04; // NEQ_UQ
+            break;
+         case TR::vcmplt:
+            predicate = 0x01; // LT_OS
+            break;
+         case TR::vcmple:
+            predicate = 0x02; // LE_OS
+            break;
+         case TR::vcmpgt:
+            predicate = 0x01;
+            swapOperands = true;
+            break;
+         case TR::vcmpge:
+            predicate = 0x02;
+            swapOperands = true;
+            break;
+         default:
+            TR_ASSERT_FATAL(false, "Unsupported OpCode %s for data type %s", node->getOpCode().getName(), type.toString());
+            break;
+         }
+      generateRegRegInstruction(MOVDQURegReg, node, resultReg, swapOperands ? secondReg : firstReg, cg);
+      generateRegRegImmInstruction((TR::VectorFloat == type) ? CMPPSRegRegImm1 : CMPPDRegRegImm1, node, resultReg, swapOperands ? firstReg : secondReg, predicate, cg);
+      }
+   else
+      {
+      static const TR_X86OpCodes equalOpCodes[] = { PCMPEQBRegReg, PCMPEQWRegReg, PCMPEQDRegReg, PCMPEQQRegReg };
+      static const TR_X86OpCodes greaterOpCodes[] = { PCMPGTBRegReg, PCMPGTWRegReg, PCMPGTDRegReg, PCMPGTQRegReg };
+
+      TR::ILOpCodes op = node->getOpCodeValue();
+      bool isEquality = false;
+      bool isUnsigned = (TR::vucmplt == op) || (TR::vucmpgt == op) || (TR::vucmple == op) || (TR::vucmpge == op);
+      bool complementResult = false;
+      switch (op)
+         {
+         case TR::vcmpeq:
+            isEquality = true;
+            break;
+         case TR::vcmpne:
+            isEquality = true;
+            complementResult = true;
+            break;
+         case TR::vcmpgt:
+         case TR::vucmpgt:
+            break;
+         case TR::vcmplt:
+         case TR::vucmplt:
+            swapOperands = true;
+            break;
+         case TR::vcmple:
+         case TR::vucmple:
+            complementResult = true;
+            break;
+         case TR::vcmpge:
+         case TR::vucmpge:
+            swapOperands = true;
+            complementResult = true;
+            break;
+         default:
+            TR_ASSERT_FATAL(false, "Unsupported OpCode %s", node->getOpCode().getName());
+            break;
+         }
+
+      int32_t elementSize = getVectorElementSize(type);
+      if (8 == elementSize)
+         {
+         TR_ASSERT_FATAL(TR::CodeGenerator::getX86ProcessorInfo().supportsSSE4_1(), "PCMPEQQ requires SSE4.1");
+         TR_ASSERT_FATAL(isEquality || TR::CodeGenerator::getX86ProcessorInfo().supportsSSE4_2(), "PCMPGTQ requires SSE4.2");
+         }
+
+      TR::Register* leftReg = swapOperands ? secondReg : firstReg;
+      TR::Register* rightReg = swapOperands ? firstReg : secondReg;
+      TR::Register* tempReg = NULL;
+
+      generateRegRegInstruction(MOVDQURegReg, node, resultReg, leftReg, cg);
+      if (isUnsigned)
+         {
+         tempReg = cg->allocateRegister(TR_VRF);
+         generateVectorSignMask(node, tempReg, elementSize, cg);
+         generateRegRegInstruction(PXORRegReg, node, resultReg, tempReg, cg);
+         generateRegRegInstruction(PXORRegReg, node, tempReg, rightReg, cg);
+         rightReg = tempReg;
+         }
+      int32_t size = getVectorElementSizeIndex(elementSize);
+      generateRegRegInstruction(isEquality ? equalOpCodes[size] : greaterOpCodes[size], node, resultReg, rightReg, cg);
+
+      if (complementResult)
+         {
+         if (!tempReg)
+            tempReg = cg->allocateRegister(TR_VRF);
+         generateVectorAllOnes(node, tempReg, cg);
+         generateRegRegInstruction(PXORRegReg, node, resultReg, tempReg, cg);
+         }
+      if (tempReg)
+         cg->stopUsingRegister(tempReg);
+      }
+
+   node->setRegister(resultReg);
+   cg->decReferenceCount(firstChild);
+   cg->decReferenceCount(secondChild);
+   return resultReg;
+   }
+
+/*
+ * vselect <mask> <a> <b> takes each bit from a where it is set in mask and from b otherwise
+ */
+TR::Register* OMR::X86::TreeEvaluator::SIMDselectEvaluator(TR::Node* node, TR::CodeGenerator* cg)
+   {
+   TR::Node* maskNode = node->getChild(0);
+   TR::Node* trueNode = node->getChild(1);
+   TR::Node* falseNode = node->getChild(2);
+
+   TR::Register* maskReg = cg->evaluate(maskNode);
+   TR::Register* trueReg = cg->evaluate(trueNode);
+   TR::Register* falseReg = cg->evaluate(falseNode);
+   TR::Register* resultReg = cg->allocateRegister(TR_VRF);
+   TR::Register* tempReg = cg->allocateRegister(TR_VRF);
+
+   generateRegRegInstruction(MOVDQURegReg, node, resultReg, maskReg, cg);
+   generateRegRegInstruction(PANDRegReg, node, resultReg, trueReg, cg);
+   generateRegRegInstruction(MOVDQURegReg, node, tempReg, maskReg, cg);
+   generateRegRegInstruction(PANDNRegReg, node, tempReg, falseReg, cg);
+   generateRegRegInstruction(PORRegReg, node, resultReg, tempReg, cg);
+   cg->stopUsingRegister(tempReg);
+
+   node->setRegister(resultReg);
+   cg->decReferenceCount(maskNode);
+   cg->decReferenceCount(trueNode);
+   cg->decReferenceCount(falseNode);
+   return resultReg;
+   }
+
+TR::Register* OMR::X86::TreeEvaluator::SIMDrandEvaluator(TR::Node* node, TR::CodeGenerator* cg)
+   {
+   TR::Node* childNode = node->getChild(0);
+   int32_t elementSize = getVectorElementSize(childNode->getDataType());
+   TR_ASSERT_FATAL(childNode->getDataType().getVectorElementType().isIntegral(), "Unsupported data type %s in SIMDrandEvaluator", childNode->getDataType().toString());
+
+   TR::Register* childReg = cg->evaluate(childNode);
+   TR::Register* workReg = cg->allocateRegister(TR_VRF);
+   TR::Register* tempReg = cg->allocateRegister(TR_VRF);
+
+   // Fold the upper half of the remaining elements onto the lower half until only element 0 is left
+   generateRegRegInstruction(MOVDQURegReg, node, workReg, childReg, cg);
+   for (int32_t bytes = 8; bytes >= elementSize; bytes /= 2)
+      {
+      generateRegRegInstruction(MOVDQURegReg, node, tempReg, workReg, cg);
+      generateRegImmInstruction(PSRLDQRegImm1, node, tempReg, bytes, cg);
+      generateRegRegInstruction(PANDRegReg, node, workReg, tempReg, cg);
+      }
+
+   TR::Register* resultReg = NULL;
+   if (8 == elementSize)
+      {
+      if (cg->comp()->target().is32Bit())
+         {
+         TR::Register* lowReg = cg->allocateRegister();
+         TR::Register* highReg = cg->allocateRegister();
+         generateRegRegInstruction(MOVDReg4Reg, node, lowReg, workReg, cg);
+         generateRegImmInstruction(PSRLDQRegImm1, node, workReg, 4, cg);
+         generateRegRegInstruction(MOVDReg4Reg, node, highReg, workReg, cg);
+         resultReg = cg->allocateRegisterPair(lowReg, highReg);
+         }
+      else
+         {
+         resultReg = cg->allocateRegister();
+         generateRegRegInstruction(MOVQReg8Reg, node, resultReg, workReg, cg);
+         }
+      }
+   else
+      {
+      resultReg = cg->allocateRegister();
+      generateRegRegInstruction(MOVDReg4Reg, node, resultReg, workReg, cg);
+      if (2 == elementSize)
+         generateRegRegInstruction(MOVSXReg4Reg2, node, resultReg, resultReg, cg);
+      else if (1 == elementSize)
+         generateRegRegInstruction(MOVSXReg4Reg1, node, resultReg, resultReg, cg);
+      }
+
+   cg->stopUsingRegister(workReg);
+   cg->stopUsingRegister(tempReg);
+
+   node->setRegister(resultReg);
+   cg->decReferenceCount(childNode);
+   return resultReg;
+   }
+
+TR::Register* OMR::X86::TreeEvaluator::SIMDv2vEvaluator(TR::Node* node, TR::CodeGenerator* cg)
+   {
+   TR::Node* childNode = node->getChild(0);
+   TR::Register* resultReg = cg->evaluate(childNode);
+
+   // The bit pattern is preserved; only copy when the child's register is still needed
+   if (childNode->getReferenceCount() > 1)
+      {
+      TR::Register* copyReg = cg->allocateRegister(TR_VRF);
+      generateRegRegInstruction(MOVDQURegReg, node, copyReg, resultReg, cg);
+      resultReg = copyReg;
+      }
+
+   node->setRegister(resultReg);
+   cg->decReferenceCount(childNode);
+   return resultReg;
+   }
+
+TR::Register* OMR::X86::TreeEvaluator::SIMDl2vdEvaluator(TR::Node* node, TR::CodeGenerator* cg)
+   {
+   TR_ASSERT_FATAL(cg->comp()->target().is64Bit(), "vl2vd is only supported on 64-bit targets");
+
+   TR::Node* childNode = node->getChild(0);
+   TR::Register* childReg = cg->evaluate(childNode);
+   TR::Register* resultReg = cg->allocateRegister(TR_VRF);
+   TR::Register* highReg = cg->allocateRegister(TR_VRF);
+   TR::Register* tempReg = cg->allocateRegister();
+
+   // Convert each element through a GPR, then merge the two doubles
+   generateRegRegInstruction(MOVQReg8Reg, node, tempReg, childReg, cg);
+   generateRegRegInstruction(CVTSI2SDRegReg8, node, resultReg, tempReg, cg);
+   generateRegRegImmInstruction(PSHUFDRegRegImm1, node, highReg, childReg, 0x0e, cg); // 00 00 11 10 shuffle DCxx to xxDC
+   generateRegRegInstruction(MOVQReg8Reg, node, tempReg, highReg, cg);
+   generateRegRegInstruction(CVTSI2SDRegReg8, node, highReg, tempReg, cg);
+   generateRegRegInstruction(UNPCKLPDRegReg, node, resultReg, highReg, cg);
+
+   cg->stopUsingRegister(highReg);
+   cg->stopUsingRegister(tempReg);
+
+   node->setRegister(resultReg);
+   cg->decReferenceCount(childNode);
+   return resultReg;
+   }
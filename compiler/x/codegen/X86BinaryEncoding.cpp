@@ -20,6 +20,7 @@
  *******************************************************************************/
 
 #include <algorithm>
+#include <limits.h>
 #include <stddef.h>
 #include <stdint.h>
 #include "codegen/BackingStore.hpp"
@@ -465,7 +466,7 @@ uint8_t *TR::X86LabelInstruction::generateBinaryEncoding()
             // Conservative estimate of distance if target address is not known exactly.
             // (e.g., a forward relative branch)
             //
-            distance = cg()->getBinaryBufferStart()
+            distance = cg()->getEstimatedCodeLocationBase()
 
                        // +4 == Temporary and possibly incomplete fix for WebSphere problem,
                        //       the buffer start is -4 from the start of the method
@@ -478,7 +479,13 @@ uint8_t *TR::X86LabelInstruction::generateBinaryEncoding()
 
          TR_ASSERT(getOpCodeValue() != XBEGIN4 || !_permitShortening, "XBEGIN4 cannot be shortened and can only be used with a label instruction that cannot shorten - use generateLongLabel!\n");
 
-         if (distance >= -128 && distance <= 127 &&
+         // The distance to an unemitted label between the warm and cold parts
+         // of a split method is not known
+         //
+         bool distanceIsKnown = label->getCodeLocation() != NULL ||
+                                !cg()->isEstimatedCodeLocationInOtherRegion(label->getEstimatedCodeLocation());
+
+         if (distance >= -128 && distance <= 127 && distanceIsKnown &&
              getOpCode().isBranchOp() && _permitShortening)
             {
             // Convert long branch to short branch.
@@ -757,11 +764,14 @@ uint8_t *TR::X86VirtualGuardNOPInstruction::generateBinaryEncoding()
       {
       // Conservative offset estimate
       //
-      offset = cg()->getBinaryBufferStart() +
+      offset = cg()->getEstimatedCodeLocationBase() +
                label->getEstimatedCodeLocation() -
                (patchCursor + IA32LengthOfShortBranch +
                 cg()->getAccumulatedInstructionLengthError());
 
+      if (cg()->isEstimatedCodeLocationInOtherRegion(label->getEstimatedCodeLocation()))
+         offset = INT_MAX;
+
       // Can't call _site->setDestination because we don't know the destination
       // yet, so use a relocation instead.
       //
@@ -2840,7 +2850,7 @@ TR::AMD64RegImm64SymInstruction::addMetaDataForCodeAddress(uint8_t *cursor)
             }
          case TR_NativeMethodAbsolute:
             {
-            if (cg()->comp()->getOption(TR_EmitRelocatableELFFile))
+            if (cg()->needStaticRelocations())
                {
                TR_ResolvedMethod *target = getSymbolReference()->getSymbol()->castToResolvedMethodSymbol()->getResolvedMethod();
                cg()->addStaticRelocation(TR::StaticRelocation(cursor, target->externalName(cg()->trMemory()), TR::StaticRelocationSize::word64, TR::StaticRelocationType::Absolute));
@@ -0,0 +1,520 @@
+/*******************************************************************************
+ * Copyright (c) 2020, 2020 IBM Corp. and others
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at https://www.eclipse.org/legal/epl-2.0/
+ * or the Apache License, Version 2.0 which accompanies this distribution and
+ * is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following
+ * Secondary Licenses when the conditions for such availability set
+ * forth in the Eclipse Public License, v. 2.0 are satisfied: GNU
+ * General Public License, version 2 with the GNU Classpath
+ * Exception [1] and GNU General Public License, version 2 with the
+ * OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] http://openjdk.java.net/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
+ *******************************************************************************/
+
+#include "x/codegen/X86Peephole.hpp"
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include "AtomicSupport.hpp"
+#include "codegen/CodeGenerator.hpp"
+#include "codegen/Instruction.hpp"
+#include "codegen/MemoryReference.hpp"
+#include "codegen/RealRegister.hpp"
+#include "codegen/Register.hpp"
+#include "compile/Compilation.hpp"
+#include "control/Options.hpp"
+#include "control/Options_inlines.hpp"
+#include "il/LabelSymbol.hpp"
+#include "il/Symbol.hpp"
+#include "il/SymbolReference.hpp"
+#include "infra/Assert.hpp"
+#include "ras/Debug.hpp"
+#include "x/codegen/X86Instruction.hpp"
+#include "x/codegen/X86Ops.hpp"
+
+#define OPT_DETAILS "O^O X86 PEEPHOLE: "
+
+uintptr_t TR_X86Peephole::_applications[TR_X86Peephole::NumRules] = { 0 };
+
+// The rule tried at each opcode. The load after store rule also names the
+// load of the same width and the move that replaces it.
+//
+static const struct
+   {
+   TR_X86OpCodes _opCode;
+   TR_X86Peephole::Rule _rule;
+   TR_X86OpCodes _load;
+   TR_X86OpCodes _move;
+   } peepholeRules[] =
+   {
+   { MOV1RegReg,   TR_X86Peephole::RedundantMove,      BADIA32Op, BADIA32Op  },
+   { MOV2RegReg,   TR_X86Peephole::RedundantMove,      BADIA32Op, BADIA32Op  },
+   { MOV4RegReg,   TR_X86Peephole::RedundantMove,      BADIA32Op, BADIA32Op  },
+   { MOV8RegReg,   TR_X86Peephole::RedundantMove,      BADIA32Op, BADIA32Op  },
+   { MOVAPSRegReg, TR_X86Peephole::RedundantMove,      BADIA32Op, BADIA32Op  },
+   { MOVAPDRegReg, TR_X86Peephole::RedundantMove,      BADIA32Op, BADIA32Op  },
+   { MOVSSRegReg,  TR_X86Peephole::RedundantMove,      BADIA32Op, BADIA32Op  },
+   { MOVSDRegReg,  TR_X86Peephole::RedundantMove,      BADIA32Op, BADIA32Op  },
+
+   { S1MemReg,     TR_X86Peephole::LoadAfterStore,     L1RegMem,  MOV1RegReg },
+   { S2MemReg,     TR_X86Peephole::LoadAfterStore,     L2RegMem,  MOV2RegReg },
+   { S4MemReg,     TR_X86Peephole::LoadAfterStore,     L4RegMem,  MOV4RegReg },
+   { S8MemReg,     TR_X86Peephole::LoadAfterStore,     L8RegMem,  MOV8RegReg },
+
+   { TEST1RegReg,  TR_X86Peephole::CompareAgainstZero, BADIA32Op, BADIA32Op  },
+   { TEST2RegReg,  TR_X86Peephole::CompareAgainstZero, BADIA32Op, BADIA32Op  },
+   { TEST4RegReg,  TR_X86Peephole::CompareAgainstZero, BADIA32Op, BADIA32Op  },
+   { TEST8RegReg,  TR_X86Peephole::CompareAgainstZero, BADIA32Op, BADIA32Op  },
+   { CMP1RegImm1,  TR_X86Peephole::CompareAgainstZero, BADIA32Op, BADIA32Op  },
+   { CMP2RegImm2,  TR_X86Peephole::CompareAgainstZero, BADIA32Op, BADIA32Op  },
+   { CMP2RegImms,  TR_X86Peephole::CompareAgainstZero, BADIA32Op, BADIA32Op  },
+   { CMP4RegImm4,  TR_X86Peephole::CompareAgainstZero, BADIA32Op, BADIA32Op  },
+   { CMP4RegImms,  TR_X86Peephole::CompareAgainstZero, BADIA32Op, BADIA32Op  },
+   { CMP8RegImm4,  TR_X86Peephole::CompareAgainstZero, BADIA32Op, BADIA32Op  },
+   { CMP8RegImms,  TR_X86Peephole::CompareAgainstZero, BADIA32Op, BADIA32Op  },
+
+   { JMP4,         TR_X86Peephole::JumpToJump,         BADIA32Op, BADIA32Op  },
+   { JA4,          TR_X86Peephole::JumpToJump,         BADIA32Op, BADIA32Op  },
+   { JAE4,         TR_X86Peephole::JumpToJump,         BADIA32Op, BADIA32Op  },
+   { JB4,          TR_X86Peephole::JumpToJump,         BADIA32Op, BADIA32Op  },
+   { JBE4,         TR_X86Peephole::JumpToJump,         BADIA32Op, BADIA32Op  },
+   { JE4,          TR_X86Peephole::JumpToJump,         BADIA32Op, BADIA32Op  },
+   { JNE4,         TR_X86Peephole::JumpToJump,         BADIA32Op, BADIA32Op  },
+   { JG4,          TR_X86Peephole::JumpToJump,         BADIA32Op, BADIA32Op  },
+   { JGE4,         TR_X86Peephole::JumpToJump,         BADIA32Op, BADIA32Op  },
+   { JL4,          TR_X86Peephole::JumpToJump,         BADIA32Op, BADIA32Op  },
+   { JLE4,         TR_X86Peephole::JumpToJump,         BADIA32Op, BADIA32Op  },
+   { JO4,          TR_X86Peephole::JumpToJump,         BADIA32Op, BADIA32Op  },
+   { JNO4,         TR_X86Peephole::JumpToJump,         BADIA32Op, BADIA32Op  },
+   { JS4,          TR_X86Peephole::JumpToJump,         BADIA32Op, BADIA32Op  },
+   { JNS4,         TR_X86Peephole::JumpToJump,         BADIA32Op, BADIA32Op  },
+   { JPO4,         TR_X86Peephole::JumpToJump,         BADIA32Op, BADIA32Op  },
+   { JPE4,         TR_X86Peephole::JumpToJump,         BADIA32Op, BADIA32Op  },
+   };
+
+// The entry of peepholeRules for every opcode, or -1 for opcodes no rule
+// starts at.
+//
+class PeepholeRuleTable
+   {
+   public:
+
+   PeepholeRuleTable()
+      {
+      memset(_entry, -1, sizeof(_entry));
+      for (size_t i = 0; i < sizeof(peepholeRules) / sizeof(peepholeRules[0]); i++)
+         {
+         TR_ASSERT((int32_t)peepholeRules[i]._opCode < MAX_OPCODES, "More x86 opcodes than the peephole rule table can hold");
+         _entry[peepholeRules[i]._opCode] = (int8_t)i;
+         }
+      }
+
+   int32_t getEntry(TR_X86OpCodes op) { return (int32_t)op < MAX_OPCODES ? _entry[op] : -1; }
+
+   private:
+
+   static const int32_t MAX_OPCODES = 2048;
+
+   int8_t _entry[MAX_OPCODES];
+   };
+
+static int32_t
+peepholeRuleEntryOf(TR_X86OpCodes op)
+   {
+   static PeepholeRuleTable table;
+   return table.getEntry(op);
+   }
+
+// Instructions a rule may look past: register targets only, no implicit
+// operands, prefixes or register dependencies
+//
+static bool
+isSimpleRegisterInstruction(TR::Instruction *instr)
+   {
+   switch (instr->getKind())
+      {
+      case TR::Instruction::IsRegReg:
+      case TR::Instruction::IsRegRegImm:
+      case TR::Instruction::IsRegImm:
+      case TR::Instruction::IsRegImm64:
+      case TR::Instruction::IsRegMem:
+      case TR::Instruction::IsRegMemImm:
+         break;
+      default:
+         return false;
+      }
+
+   TR_X86OpCode &op = instr->getOpCode();
+   return !op.targetRegIsImplicit() &&
+          !op.sourceRegIsImplicit() &&
+          !op.needsLockPrefix() &&
+          !op.needsRepPrefix() &&
+          !op.isPseudoOp() &&
+          !instr->getDependencyConditions() &&
+          !instr->needsGCMap();
+   }
+
+static TR::LabelSymbol *
+branchTarget(TR::Instruction *instr)
+   {
+   TR::X86LabelInstruction *labelInstr = instr->getX86LabelInstruction();
+   return labelInstr ? labelInstr->getLabelSymbol() : NULL;
+   }
+
+// The first instruction at a label that is not a label or a fence
+//
+static TR::Instruction *
+firstInstructionAt(TR::LabelSymbol *label)
+   {
+   TR::Instruction *instr = label->getInstruction();
+   while (instr &&
+          (instr->getOpCodeValue() == LABEL || instr->getOpCodeValue() == FENCE) &&
+          !instr->getDependencyConditions())
+      instr = instr->getNext();
+   return instr;
+   }
+
+TR_X86Peephole::TR_X86Peephole(TR::CodeGenerator *cg)
+   : _cg(cg),
+     _comp(cg->comp()),
+     _removed(0)
+   {
+   }
+
+const char *
+TR_X86Peephole::getRuleName(Rule rule)
+   {
+   static const char *names[] = { "redundant move", "load after store", "compare against zero", "jump to jump" };
+   return names[rule];
+   }
+
+void
+TR_X86Peephole::applied(Rule rule)
+   {
+   VM_AtomicSupport::add(&_applications[rule], 1);
+   }
+
+bool
+TR_X86Peephole::writesRegister(TR::Instruction *instr, TR::Register *reg)
+   {
+   TR_X86OpCode &op = instr->getOpCode();
+   return (op.modifiesTarget() && instr->getTargetRegister() == reg) ||
+          (op.modifiesSource() && instr->getSourceRegister() == reg);
+   }
+
+// mov r, r is a no-op unless it is a 32-bit move on a 64-bit target, which
+// clears the upper half of r. mov r1, r2 followed by mov r2, r1 leaves r2
+// as it was for moves of the full register.
+//
+bool
+TR_X86Peephole::removeRedundantMove(TR::Instruction *instr)
+   {
+   TR_X86OpCodes opCodeValue = instr->getOpCodeValue();
+   TR::Register *target = instr->getTargetRegister();
+   TR::Register *source = instr->getSourceRegister();
+   bool is64Bit = comp()->target().is64Bit();
+
+   if (target == source)
+      {
+      if (opCodeValue == MOV4RegReg && is64Bit)
+         return false;
+      }
+   else
+      {
+      bool copiesFullRegister =
+         opCodeValue == MOV8RegReg ||
+         opCodeValue == MOVAPSRegReg ||
+         opCodeValue == MOVAPDRegReg ||
+         (opCodeValue == MOV4RegReg && !is64Bit);
+      TR::Instruction *prev = instr->getPrev();
+      if (!copiesFullRegister ||
+          !prev ||
+          prev->getOpCodeValue() != opCodeValue ||
+          prev->getDependencyConditions() ||
+          prev->getTargetRegister() != source ||
+          prev->getSourceRegister() != target)
+         return false;
+      }
+
+   if (!performTransformation(comp(), "%sRemoving redundant move [%p]\n", OPT_DETAILS, instr))
+      return false;
+
+   instr->remove();
+   return true;
+   }
+
+// A load from the memory a store wrote a few instructions earlier reads the
+// stored register, as long as nothing in between may write memory, the
+// stored register or the registers of the address.
+//
+bool
+TR_X86Peephole::forwardStoredRegister(TR::Instruction *store)
+   {
+   static const int32_t window = 8;
+
+   TR::MemoryReference *memRef = store->getMemoryReference();
+   TR::SymbolReference &symRef = memRef->getSymbolReference();
+   TR::Symbol *symbol = symRef.getSymbol();
+   if (memRef->getLabel() ||
+       memRef->hasUnresolvedDataSnippet() ||
+       memRef->hasUnresolvedVirtualCallSnippet() ||
+       (symbol && (symRef.isUnresolved() || symbol->isVolatile())))
+      return false;
+
+   int32_t entry = peepholeRuleEntryOf(store->getOpCodeValue());
+   TR_X86OpCodes loadOpCode = peepholeRules[entry]._load;
+   TR::Register *stored = store->getSourceRegister();
+   TR::Register *base = memRef->getBaseRegister();
+   TR::Register *index = memRef->getIndexRegister();
+
+   TR::Instruction *instr = store->getNext();
+   for (int32_t i = 0; instr && i < window; i++, instr = instr->getNext())
+      {
+      if (!isSimpleRegisterInstruction(instr))
+         return false;
+
+      if (instr->getOpCodeValue() == loadOpCode)
+         {
+         TR::MemoryReference *loadMemRef = instr->getMemoryReference();
+         if (loadMemRef->getBaseRegister() == base &&
+             loadMemRef->getIndexRegister() == index &&
+             (!index || loadMemRef->getStride() == memRef->getStride()) &&
+             loadMemRef->getSymbolReference().getSymbol() == symbol &&
+             !loadMemRef->getLabel() &&
+             !loadMemRef->hasUnresolvedDataSnippet() &&
+             loadMemRef->getDisplacement() == memRef->getDisplacement())
+            {
+            TR::Register *target = instr->getTargetRegister();
+            if (!performTransformation(comp(), "%sForwarding the register stored by [%p] to the load [%p]\n", OPT_DETAILS, store, instr))
+               return false;
+
+            // A 32-bit load into the stored register still clears its upper
+            // half on a 64-bit target
+            //
+            if (target != stored || (loadOpCode == L4RegMem && comp()->target().is64Bit()))
+               new (cg()->trHeapMemory()) TR::X86RegRegInstruction(instr->getPrev(), peepholeRules[entry]._move, target, stored, cg());
+            else
+               _removed++;
+            instr->remove();
+            return true;
+            }
+         }
+
+      if (instr->getOpCode().modifiesSource() && instr->getKind() == TR::Instruction::IsRegMem)
+         return false;
+
+      if (writesRegister(instr, stored) ||
+          (base && writesRegister(instr, base)) ||
+          (index && writesRegister(instr, index)))
+         return false;
+      }
+
+   return false;
+   }
+
+// Whether the instructions executed from instr on read no flag but the zero,
+// sign and parity flags before the others are written again, looking at no
+// more than budget instructions in total along all paths.
+//
+bool
+TR_X86Peephole::onlyZeroSignOrParityFlagsRead(TR::Instruction *instr, int32_t &budget)
+   {
+   static const uint8_t otherFlags = IA32EFlags_OF | IA32EFlags_CF;
+
+   for (; instr; instr = instr->getNext())
+      {
+      if (--budget < 0)
+         return false;
+
+      TR_X86OpCode &op = instr->getOpCode();
+      if (op.getTestedEFlags() & otherFlags)
+         return false;
+
+      if (op.isBranchOp())
+         {
+         TR::LabelSymbol *target = branchTarget(instr);
+         if (!target || !target->getInstruction())
+            return false;
+         if (!onlyZeroSignOrParityFlagsRead(target->getInstruction(), budget))
+            return false;
+         if (instr->getOpCodeValue() == JMP4 || instr->getOpCodeValue() == JMP1)
+            return true;
+         continue;
+         }
+
+      if (op.isCallOp() ||
+          instr->getOpCodeValue() == RET ||
+          instr->getOpCodeValue() == RETImm2)
+         return true;
+
+      if ((op.getModifiedEFlags() & otherFlags) == otherFlags && !op.isShiftOp())
+         return true;
+      }
+
+   return true;
+   }
+
+// test r, r and cmp r, 0 set the zero, sign and parity flags from r, and
+// clear the carry and overflow flags. An arithmetic or logical instruction
+// that computed r just before set the zero, sign and parity flags the same
+// way; and, or and xor also clear the other two.
+//
+bool
+TR_X86Peephole::removeCompareAgainstZero(TR::Instruction *instr)
+   {
+   TR::Register *reg = instr->getTargetRegister();
+   if (instr->getKind() == TR::Instruction::IsRegReg)
+      {
+      if (instr->getSourceRegister() != reg)
+         return false;
+      }
+   else
+      {
+      TR::X86RegImmInstruction *regImm = static_cast<TR::X86RegImmInstruction *>(instr);
+      if (instr->getKind() != TR::Instruction::IsRegImm ||
+          regImm->getSourceImmediate() != 0 ||
+          regImm->getReloKind() != TR_NoRelocation)
+         return false;
+      }
+
+   TR::Instruction *prev = instr->getPrev();
+   if (!prev || !isSimpleRegisterInstruction(prev) || prev->getTargetRegister() != reg)
+      return false;
+
+   TR_X86OpCode &op = instr->getOpCode();
+   TR_X86OpCode &prevOp = prev->getOpCode();
+   static const uint8_t resultFlags = IA32EFlags_ZF | IA32EFlags_SF | IA32EFlags_PF;
+   if (!prevOp.setsCCForTest() ||
+       !prevOp.modifiesTarget() ||
+       (prevOp.getModifiedEFlags() & resultFlags) != resultFlags ||
+       prevOp.hasByteTarget() != op.hasByteTarget() ||
+       prevOp.hasShortTarget() != op.hasShortTarget() ||
+       prevOp.hasIntTarget() != op.hasIntTarget() ||
+       prevOp.hasLongTarget() != op.hasLongTarget())
+      return false;
+
+   if (prevOp.isShiftOp())
+      {
+      // A shift by zero leaves the flags alone
+      //
+      if (prev->getKind() != TR::Instruction::IsRegImm ||
+          (static_cast<TR::X86RegImmInstruction *>(prev)->getSourceImmediate() & 0x1f) == 0)
+         return false;
+      }
+
+   bool clearsCarryAndOverflow =
+      !prevOp.setsCCForCompare() &&
+      !prevOp.isShiftOp() &&
+      (prevOp.getModifiedEFlags() & (IA32EFlags_OF | IA32EFlags_CF)) == (IA32EFlags_OF | IA32EFlags_CF);
+   int32_t budget = 16;
+   if (!clearsCarryAndOverflow && !onlyZeroSignOrParityFlagsRead(instr->getNext(), budget))
+      return false;
+
+   if (!performTransformation(comp(), "%sRemoving compare against zero [%p] of the result of [%p]\n", OPT_DETAILS, instr, prev))
+      return false;
+
+   instr->remove();
+   return true;
+   }
+
+// A branch to a label followed by jmp L goes to L directly
+//
+bool
+TR_X86Peephole::forwardJumpTarget(TR::Instruction *instr)
+   {
+   TR::LabelSymbol *label = branchTarget(instr);
+   if (!label)
+      return false;
+
+   TR::LabelSymbol *target = label;
+   for (int32_t hops = 0; hops < 4; hops++)
+      {
+      TR::Instruction *jump = firstInstructionAt(target);
+      if (!jump ||
+          jump->getOpCodeValue() != JMP4 ||
+          jump->getDependencyConditions() ||
+          !branchTarget(jump) ||
+          branchTarget(jump) == label)
+         break;
+      target = branchTarget(jump);
+      }
+
+   if (target == label ||
+       !performTransformation(comp(), "%sForwarding the target of branch [%p] to label %p\n", OPT_DETAILS, instr, target))
+      return false;
+
+   instr->getX86LabelInstruction()->setLabelSymbol(target);
+   return true;
+   }
+
+int32_t
+TR_X86Peephole::perform()
+   {
+   bool trace = comp()->getOption(TR_TraceCG);
+   if (trace)
+      traceMsg(comp(), "\n<peephole>\n");
+
+   TR::Instruction *next = NULL;
+   for (TR::Instruction *instr = cg()->getFirstInstruction(); instr; instr = next)
+      {
+      next = instr->getNext();
+
+      int32_t entry = peepholeRuleEntryOf(instr->getOpCodeValue());
+      if (entry < 0 || instr->getDependencyConditions() || instr->needsGCMap())
+         continue;
+
+      Rule rule = peepholeRules[entry]._rule;
+      bool changed = false;
+      switch (rule)
+         {
+         case RedundantMove:
+            if (instr->getKind() == TR::Instruction::IsRegReg && removeRedundantMove(instr))
+               {
+               _removed++;
+               changed = true;
+               }
+            break;
+         case LoadAfterStore:
+            if (instr->getKind() == TR::Instruction::IsMemReg)
+               changed = forwardStoredRegister(instr);
+            // The forwarded load may have been the next instruction
+            next = instr->getNext();
+            break;
+         case CompareAgainstZero:
+            if (removeCompareAgainstZero(instr))
+               {
+               _removed++;
+               changed = true;
+               }
+            break;
+         case JumpToJump:
+            if (instr->getKind() == TR::Instruction::IsLabel)
+               changed = forwardJumpTarget(instr);
+            break;
+         default:
+            break;
+         }
+
+      if (changed)
+         {
+         applied(rule);
+         if (trace)
+            traceMsg(comp(), "Applied %s at [%p]\n", getRuleName(rule), instr);
+         }
+      }
+
+   if (trace)
+      traceMsg(comp(), "</peephole removed=\"%d\">\n", _removed);
+
+   return _removed;
+   }
@@ -0,0 +1,107 @@
+/*******************************************************************************
+ * Copyright (c) 2020, 2020 IBM Corp. and others
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at https://www.eclipse.org/legal/epl-2.0/
+ * or the Apache License, Version 2.0 which accompanies this distribution and
+ * is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following
+ * Secondary Licenses when the conditions for such availability set
+ * forth in the Eclipse Public License, v. 2.0 are satisfied: GNU
+ * General Public License, version 2 with the GNU Classpath
+ * Exception [1] and GNU General Public License, version 2 with the
+ * OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] http://openjdk.java.net/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
+ *******************************************************************************/
+
+#ifndef X86PEEPHOLE_INCL
+#define X86PEEPHOLE_INCL
+
+#include <stdint.h>
+#include "env/TRMemory.hpp"
+
+namespace TR { class CodeGenerator; }
+namespace TR { class Compilation; }
+namespace TR { class Instruction; }
+namespace TR { class Register; }
+
+/**
+ * @brief Peephole optimization of the x86 instruction stream after register
+ *        assignment.
+ *
+ * Every instruction is looked up in a table of rules keyed by opcode, and the
+ * rule found, if any, is tried at that instruction:
+ *    - RedundantMove removes register to register moves whose target is their
+ *      source, and a move that copies back the register the previous move
+ *      copied from;
+ *    - LoadAfterStore replaces a load from the memory a nearby store just wrote
+ *      with a move from the stored register, or removes it when the load
+ *      targets that register;
+ *    - CompareAgainstZero removes a test or compare of a register against
+ *      zero that follows the instruction computing the register, when that
+ *      instruction already set the flags the following branches and setcc or
+ *      cmov instructions read;
+ *    - JumpToJump retargets a branch to a label that is followed by an
+ *      unconditional jump to the target of that jump.
+ *
+ * Instructions with register dependencies or a GC map are never changed.
+ */
+class TR_X86Peephole
+   {
+   public:
+
+   TR_ALLOC(TR_Memory::CodeGenerator)
+
+   enum Rule
+      {
+      RedundantMove,
+      LoadAfterStore,
+      CompareAgainstZero,
+      JumpToJump,
+      NumRules
+      };
+
+   TR_X86Peephole(TR::CodeGenerator *cg);
+
+   /**
+    * @brief Apply the rules to the method's instruction stream.
+    * @return the number of instructions removed
+    */
+   int32_t perform();
+
+   static const char *getRuleName(Rule rule);
+
+   /**
+    * @brief The number of times the rule has been applied by all
+    *        compilations in the process.
+    */
+   static uintptr_t getApplications(Rule rule) { return _applications[rule]; }
+
+   TR::CodeGenerator *cg() { return _cg; }
+   TR::Compilation *comp() { return _comp; }
+
+   private:
+
+   bool removeRedundantMove(TR::Instruction *instr);
+   bool forwardStoredRegister(TR::Instruction *instr);
+   bool removeCompareAgainstZero(TR::Instruction *instr);
+   bool forwardJumpTarget(TR::Instruction *instr);
+
+   bool writesRegister(TR::Instruction *instr, TR::Register *reg);
+   bool onlyZeroSignOrParityFlagsRead(TR::Instruction *instr, int32_t &budget);
+   void applied(Rule rule);
+
+   TR::CodeGenerator *_cg;
+   TR::Compilation *_comp;
+   int32_t _removed;
+
+   static uintptr_t _applications[NumRules];
+   };
+
+#endif
@@ -242,6 +242,20 @@ public:
 	 * @param[out] hotFieldAlignmentDescriptor pointer to hot field alignment descriptor for class (or NULL)
 	 */
 	void calculateObjectDetailsForCopy(MM_EnvironmentBase *env, MM_ForwardedHeader *forwardedHeader, uintptr_t *objectCopySizeInBytes, uintptr_t *objectReserveSizeInBytes, uintptr_t *hotFieldAlignmentDescriptor);
+
+	/**
+	 * Get the language-defined allocation site of a forwarded object. The scavenger uses this to track
+	 * survival rates per allocation site for pretenuring.
+	 *
+	 * @param[in] forwardedHeader pointer to the MM_ForwardedHeader instance encapsulating the object
+	 * @return the allocation site, or 0 if not known
+	 */
+	MMINLINE uintptr_t
+	getAllocationSite(MM_ForwardedHeader *forwardedHeader)
+	{
+		/* Example objects do not record their allocation site */
+		return 0;
+	}
 #endif /* defined(OMR_GC_MODRON_SCAVENGER) */
 
 	/**
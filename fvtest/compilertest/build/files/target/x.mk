@@ -32,7 +32,9 @@ JIT_PRODUCT_BACKEND_SOURCES+=\
     $(JIT_OMR_DIRTY_DIR)/x/codegen/SIMDTreeEvaluator.cpp \
     $(JIT_OMR_DIRTY_DIR)/x/codegen/HelperCallSnippet.cpp \
     $(JIT_OMR_DIRTY_DIR)/x/codegen/IA32LinkageUtils.cpp \
+    $(JIT_OMR_DIRTY_DIR)/x/codegen/InstructionScheduler.cpp \
     $(JIT_OMR_DIRTY_DIR)/x/codegen/IntegerMultiplyDecomposer.cpp \
+    $(JIT_OMR_DIRTY_DIR)/x/codegen/LinearScanRegisterAllocator.cpp \
     $(JIT_OMR_DIRTY_DIR)/x/codegen/OMRMemoryReference.cpp \
     $(JIT_OMR_DIRTY_DIR)/x/codegen/OpBinary.cpp \
     $(JIT_OMR_DIRTY_DIR)/x/codegen/OpNames.cpp \
@@ -44,6 +46,7 @@ JIT_PRODUCT_BACKEND_SOURCES+=\
     $(JIT_OMR_DIRTY_DIR)/x/codegen/X86BinaryEncoding.cpp \
     $(JIT_OMR_DIRTY_DIR)/x/codegen/X86Debug.cpp \
     $(JIT_OMR_DIRTY_DIR)/x/codegen/X86FPConversionSnippet.cpp \
+    $(JIT_OMR_DIRTY_DIR)/x/codegen/X86Peephole.cpp \
     $(JIT_OMR_DIRTY_DIR)/x/codegen/OMRInstruction.cpp \
     $(JIT_OMR_DIRTY_DIR)/x/codegen/OMRInstructionDelegate.cpp \
     $(JIT_OMR_DIRTY_DIR)/x/codegen/OMRX86Instruction.cpp \
@@ -55,11 +58,13 @@ JIT_PRODUCT_BACKEND_SOURCES+=\
     $(JIT_OMR_DIRTY_DIR)/x/codegen/OMRSnippet.cpp \
     $(JIT_OMR_DIRTY_DIR)/x/codegen/X86SystemLinkage.cpp \
     $(JIT_OMR_DIRTY_DIR)/x/codegen/XMMBinaryArithmeticAnalyser.cpp \
-    $(JIT_OMR_DIRTY_DIR)/x/codegen/OMRCodeGenerator.cpp
+    $(JIT_OMR_DIRTY_DIR)/x/codegen/OMRCodeGenerator.cpp \
+    $(JIT_OMR_DIRTY_DIR)/x/codegen/OMRCodeGenPhase.cpp
 
 JIT_PRODUCT_SOURCE_FILES+=\
     $(JIT_PRODUCT_DIR)/x/codegen/Evaluator.cpp \
     $(JIT_OMR_DIRTY_DIR)/x/env/OMRDebugEnv.cpp \
-    $(JIT_OMR_DIRTY_DIR)/x/env/OMRCPU.cpp
+    $(JIT_OMR_DIRTY_DIR)/x/env/OMRCPU.cpp \
+    $(JIT_OMR_DIRTY_DIR)/x/runtime/VirtualGuardRuntime.cpp
 
 include $(JIT_MAKE_DIR)/files/target/$(TARGET_SUBARCH).mk
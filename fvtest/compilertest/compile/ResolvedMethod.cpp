@@ -48,6 +48,7 @@ ResolvedMethod::ResolvedMethod(TR_OpaqueMethodBlock *method)
    _returnType = resolvedMethod->returnIlType();
    _signature = resolvedMethod->getSignature();
    _entryPoint = resolvedMethod->getEntryPoint();
+   _allocationSizeParameter = resolvedMethod->getAllocationSizeParameter();
    strncpy(_signatureChars, resolvedMethod->signatureChars(), 62); // TODO: introduce concept of robustness
    }
 
@@ -60,7 +61,8 @@ ResolvedMethod::ResolvedMethod(TR::MethodBuilder *m)
      _returnType(m->getReturnType()),
      _entryPoint(0),
      _signature(0),
-     _ilInjector(static_cast<TR::IlInjector *>(m))
+     _ilInjector(static_cast<TR::IlInjector *>(m)),
+     _allocationSizeParameter(-1)
    {
    computeSignatureChars();
    }
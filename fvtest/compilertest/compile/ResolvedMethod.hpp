@@ -104,7 +104,8 @@ class ResolvedMethod : public ResolvedMethodBase, public Method
         _parmTypes(parmTypes),
         _returnType(returnType),
         _entryPoint(entryPoint),
-        _ilInjector(ilInjector)
+        _ilInjector(ilInjector),
+        _allocationSizeParameter(-1)
       {
       computeSignatureChars();
       }
@@ -142,6 +143,8 @@ class ResolvedMethod : public ResolvedMethodBase, public Method
    int32_t                       getNumArgs()                               { return _numParms;}
    void                          setEntryPoint(void *ep)                    { _entryPoint = ep; }
    void                        * getEntryPoint()                            { return _entryPoint; }
+   int32_t                       getAllocationSizeParameter()               { return _allocationSizeParameter; }
+   void                          setAllocationSizeParameter(int32_t p)      { _allocationSizeParameter = p; }
 
    void                          computeSignatureCharsPrimitive();
    void                          computeSignatureChars();
@@ -164,6 +167,7 @@ class ResolvedMethod : public ResolvedMethodBase, public Method
    TR::IlType     * _returnType;
    void           * _entryPoint;
    TR::IlInjector * _ilInjector;
+   int32_t          _allocationSizeParameter;
    };
 
 
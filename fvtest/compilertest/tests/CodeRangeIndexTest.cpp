@@ -0,0 +1,194 @@
+/*******************************************************************************
+ * Copyright (c) 2020, 2020 IBM Corp. and others
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at https://www.eclipse.org/legal/epl-2.0/
+ * or the Apache License, Version 2.0 which accompanies this distribution and
+ * is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following
+ * Secondary Licenses when the conditions for such availability set
+ * forth in the Eclipse Public License, v. 2.0 are satisfied: GNU
+ * General Public License, version 2 with the GNU Classpath
+ * Exception [1] and GNU General Public License, version 2 with the
+ * OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] http://openjdk.java.net/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
+ *******************************************************************************/
+
+#include <stdint.h>
+#include <stdio.h>
+#include <chrono>
+#include <thread>
+#include <vector>
+#include "gtest/gtest.h"
+#include "env/RawAllocator.hpp"
+#include "runtime/CodeRangeIndex.hpp"
+
+namespace TestCompiler
+{
+
+struct FakeMethod
+   {
+   uintptr_t _start;
+   uintptr_t _end;
+   };
+
+static const uintptr_t methodBase = 0x10000000;
+static const uintptr_t methodSize = 0x80;
+static const uintptr_t methodStride = 0x100;
+
+// Method i occupies [methodBase + i * methodStride, ... + methodSize)
+static std::vector<FakeMethod>
+createMethods(size_t numMethods)
+   {
+   std::vector<FakeMethod> methods(numMethods);
+   for (size_t i = 0; i < numMethods; i++)
+      {
+      methods[i]._start = methodBase + i * methodStride;
+      methods[i]._end = methods[i]._start + methodSize;
+      }
+   return methods;
+   }
+
+TEST(CodeRangeIndexTest, FindInsertedRanges)
+   {
+   TR::CodeRangeIndex<FakeMethod> index((TR::RawAllocator()));
+   std::vector<FakeMethod> methods = createMethods(1000);
+
+   EXPECT_EQ(NULL, index.find(methodBase));
+
+   // Insert out of order so that leaves are split in the middle
+   for (size_t i = 0; i < methods.size(); i += 2)
+      ASSERT_TRUE(index.insert(methods[i]._start, methods[i]._end, &methods[i]));
+   for (size_t i = 1; i < methods.size(); i += 2)
+      ASSERT_TRUE(index.insert(methods[i]._start, methods[i]._end, &methods[i]));
+   EXPECT_EQ(methods.size(), index.size());
+
+   for (size_t i = 0; i < methods.size(); i++)
+      {
+      EXPECT_EQ(&methods[i], index.find(methods[i]._start));
+      EXPECT_EQ(&methods[i], index.find(methods[i]._end - 1));
+      EXPECT_EQ(NULL, index.find(methods[i]._end));
+      }
+   EXPECT_EQ(NULL, index.find(methodBase - 1));
+   }
+
+TEST(CodeRangeIndexTest, RemoveRanges)
+   {
+   TR::CodeRangeIndex<FakeMethod> index((TR::RawAllocator()));
+   std::vector<FakeMethod> methods = createMethods(500);
+
+   for (size_t i = 0; i < methods.size(); i++)
+      ASSERT_TRUE(index.insert(methods[i]._start, methods[i]._end, &methods[i]));
+
+   for (size_t i = 0; i < methods.size(); i += 3)
+      EXPECT_TRUE(index.remove(methods[i]._start));
+   EXPECT_FALSE(index.remove(methods[0]._start));
+   EXPECT_FALSE(index.remove(methods[1]._start + 1));
+
+   for (size_t i = 0; i < methods.size(); i++)
+      EXPECT_EQ((i % 3 == 0) ? NULL : &methods[i], index.find(methods[i]._start + 1));
+
+   for (size_t i = 0; i < methods.size(); i++)
+      if (i % 3 != 0)
+         EXPECT_TRUE(index.remove(methods[i]._start));
+   EXPECT_EQ(0, index.size());
+   EXPECT_EQ(NULL, index.find(methods[1]._start));
+   }
+
+TEST(CodeRangeIndexTest, LookupDuringUpdates)
+   {
+   static const size_t numMethods = 20000;
+   static const int32_t numReaders = 4;
+
+   TR::CodeRangeIndex<FakeMethod> index((TR::RawAllocator()));
+   std::vector<FakeMethod> methods = createMethods(numMethods);
+
+   // Readers only ever find the method containing the PC, or nothing
+   volatile bool done = false;
+   std::vector<int32_t> numFailures(numReaders, 0);
+   std::vector<std::thread> readers;
+   for (int32_t r = 0; r < numReaders; r++)
+      {
+      readers.push_back(std::thread([&, r]()
+         {
+         size_t i = r;
+         while (!done)
+            {
+            FakeMethod *method = index.find(methods[i]._start + r);
+            if (method != NULL && method != &methods[i])
+               numFailures[r]++;
+            i = (i + 7919) % numMethods;
+            }
+         }));
+      }
+
+   for (size_t i = 0; i < numMethods; i++)
+      index.insert(methods[i]._start, methods[i]._end, &methods[i]);
+   for (size_t i = 0; i < numMethods; i += 2)
+      index.remove(methods[i]._start);
+
+   done = true;
+   for (int32_t r = 0; r < numReaders; r++)
+      readers[r].join();
+
+   for (int32_t r = 0; r < numReaders; r++)
+      EXPECT_EQ(0, numFailures[r]) << "reader " << r;
+   EXPECT_EQ(numMethods / 2, index.size());
+   }
+
+/*
+ * Compares PC lookup through the index against the linear scan it replaces
+ * for 100,000 compiled method bodies.
+ */
+TEST(CodeRangeIndexTest, LookupBenchmark)
+   {
+   static const size_t numMethods = 100000;
+   static const size_t numLookups = 1000000;
+   static const size_t numLinearLookups = 2000;
+
+   TR::CodeRangeIndex<FakeMethod> index((TR::RawAllocator()));
+   std::vector<FakeMethod> methods = createMethods(numMethods);
+
+   std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+   for (size_t i = 0; i < numMethods; i++)
+      ASSERT_TRUE(index.insert(methods[i]._start, methods[i]._end, &methods[i]));
+   double insertNs = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / numMethods;
+
+   size_t numFound = 0;
+   start = std::chrono::steady_clock::now();
+   for (size_t i = 0; i < numLookups; i++)
+      {
+      size_t m = (i * 7919) % numMethods;
+      numFound += index.find(methods[m]._start + (i & (methodSize - 1))) == &methods[m];
+      }
+   double indexNs = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / numLookups;
+   EXPECT_EQ(numLookups, numFound);
+
+   numFound = 0;
+   start = std::chrono::steady_clock::now();
+   for (size_t i = 0; i < numLinearLookups; i++)
+      {
+      uintptr_t pc = methods[(i * 7919) % numMethods]._start;
+      for (size_t m = 0; m < numMethods; m++)
+         {
+         if (methods[m]._start <= pc && pc < methods[m]._end)
+            {
+            numFound++;
+            break;
+            }
+         }
+      }
+   double linearNs = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / numLinearLookups;
+   EXPECT_EQ(numLinearLookups, numFound);
+
+   printf("CodeRangeIndex with %zu methods: insert %.1f ns, lookup %.1f ns, linear scan %.1f ns\n",
+          numMethods, insertNs, indexNs, linearNs);
+   }
+
+} // namespace TestCompiler
@@ -0,0 +1,135 @@
+/*******************************************************************************
+ * Copyright (c) 2020, 2020 IBM Corp. and others
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at https://www.eclipse.org/legal/epl-2.0/
+ * or the Apache License, Version 2.0 which accompanies this distribution and
+ * is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following
+ * Secondary Licenses when the conditions for such availability set
+ * forth in the Eclipse Public License, v. 2.0 are satisfied: GNU
+ * General Public License, version 2 with the GNU Classpath
+ * Exception [1] and GNU General Public License, version 2 with the
+ * OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] http://openjdk.java.net/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
+ *******************************************************************************/
+
+#include <stdint.h>
+#include <thread>
+#include <vector>
+#include "gtest/gtest.h"
+#include "ilgen/MethodBuilder.hpp"
+#include "ilgen/TypeDictionary.hpp"
+#include "tests/TestDriver.hpp"
+
+extern "C" int32_t compileMethodBuilder(TR::MethodBuilder *m, uint8_t **entry);
+
+namespace TestCompiler
+{
+
+typedef int32_t (ScaleAndAddFunctionType)(int32_t, int32_t);
+
+/*
+ * Computes a * scale + b for a constant scale, with a loop and a branch so
+ * that every compilation runs through the loop and global optimizations.
+ */
+class ScaleAndAddMethod : public TR::MethodBuilder
+   {
+   public:
+   ScaleAndAddMethod(TR::TypeDictionary *types, int32_t scale)
+      : TR::MethodBuilder(types),
+        _scale(scale)
+      {
+      DefineLine(LINETOSTR(__LINE__));
+      DefineFile(__FILE__);
+
+      DefineName("scaleAndAdd");
+      DefineParameter("a", Int32);
+      DefineParameter("b", Int32);
+      DefineReturnType(Int32);
+      }
+
+   virtual bool buildIL()
+      {
+      Store("sum",
+         Load("b"));
+
+      TR::IlBuilder *body = NULL;
+      ForLoopUp("i", &body,
+         ConstInt32(0),
+         ConstInt32(_scale),
+         ConstInt32(1));
+
+      body->Store("sum",
+      body->   Add(
+      body->      Load("sum"),
+      body->      Load("a")));
+
+      TR::IlBuilder *negative = NULL;
+      IfThen(&negative,
+         LessThan(
+            Load("sum"),
+            ConstInt32(0)));
+      negative->Store("sum",
+      negative->   Sub(
+      negative->      ConstInt32(0),
+      negative->      Load("sum")));
+
+      Return(
+         Load("sum"));
+      return true;
+      }
+
+   private:
+   int32_t _scale;
+   };
+
+static const int32_t numCompilationThreads = 16;
+static const int32_t methodsPerThread = 128;
+
+static void
+compileAndRunMethods(int32_t threadIndex, int32_t *numFailures)
+   {
+   TR::TypeDictionary types;
+   for (int32_t i = 0; i < methodsPerThread; i++)
+      {
+      int32_t scale = threadIndex * methodsPerThread + i;
+      ScaleAndAddMethod method(&types, scale % 17);
+
+      uint8_t *entry = NULL;
+      int32_t rc = compileMethodBuilder(&method, &entry);
+      if (rc != 0 || entry == NULL)
+         {
+         (*numFailures)++;
+         continue;
+         }
+
+      ScaleAndAddFunctionType *function = (ScaleAndAddFunctionType *) entry;
+      int32_t expected = 3 * (scale % 17) + threadIndex;
+      if (function(3, threadIndex) != expected)
+         (*numFailures)++;
+      }
+   }
+
+TEST(ConcurrentCompilationTest, CompileFromManyThreads)
+   {
+   std::vector<std::thread> threads;
+   std::vector<int32_t> numFailures(numCompilationThreads, 0);
+
+   for (int32_t t = 0; t < numCompilationThreads; t++)
+      threads.push_back(std::thread(compileAndRunMethods, t, &numFailures[t]));
+
+   for (int32_t t = 0; t < numCompilationThreads; t++)
+      threads[t].join();
+
+   for (int32_t t = 0; t < numCompilationThreads; t++)
+      EXPECT_EQ(0, numFailures[t]) << "compilation thread " << t;
+   }
+
+} // namespace TestCompiler
@@ -0,0 +1,254 @@
+/*******************************************************************************
+ * Copyright (c) 2020, 2020 IBM Corp. and others
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at https://www.eclipse.org/legal/epl-2.0/
+ * or the Apache License, Version 2.0 which accompanies this distribution and
+ * is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following
+ * Secondary Licenses when the conditions for such availability set
+ * forth in the Eclipse Public License, v. 2.0 are satisfied: GNU
+ * General Public License, version 2 with the GNU Classpath
+ * Exception [1] and GNU General Public License, version 2 with the
+ * OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] http://openjdk.java.net/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
+ *******************************************************************************/
+
+#include "JitTest.hpp"
+#include "default_compiler.hpp"
+#include "control/Options.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <stdint.h>
+#include <string>
+
+/**
+ * Compiles each method without instruction scheduling, with scheduling after
+ * register assignment only, which is the default, and with scheduling both
+ * before and after register assignment. All versions must compute the same
+ * results.
+ */
+class InstructionSchedulerTest : public TRTest::JitTest
+   {
+   public:
+
+   enum Mode
+      {
+      NoScheduling,
+      PostRAScheduling,
+      PreAndPostRAScheduling,
+      NumModes
+      };
+
+   ~InstructionSchedulerTest()
+      {
+      setMode(PostRAScheduling);
+      }
+
+   static const char *modeName(Mode mode)
+      {
+      static const char *names[] = { "no scheduling", "post-RA", "pre- and post-RA" };
+      return names[mode];
+      }
+
+   void setMode(Mode mode)
+      {
+      TR::Options::getCmdLineOptions()->setOption(TR_DisableInstructionScheduling, mode == NoScheduling);
+      TR::Options::getCmdLineOptions()->setOption(TR_EnablePreRAInstructionScheduling, mode == PreAndPostRAScheduling);
+      }
+
+   template <typename T>
+   T compile(ASTNode *trees, Mode mode)
+      {
+      setMode(mode);
+      Tril::DefaultCompiler compiler(trees);
+      EXPECT_EQ(0, compiler.compile()) << "Compilation failed unexpectedly in mode " << modeName(mode);
+      setMode(PostRAScheduling);
+      return compiler.getEntryPoint<T>();
+      }
+   };
+
+/*
+ * Four independent products per iteration whose loads can be issued ahead of
+ * the multiplies and adds that use them.
+ */
+TEST_F(InstructionSchedulerTest, DotProduct)
+   {
+   auto trees = parseString(
+      "(method return=Double args=[Address, Address, Int32]"
+      "  (block"
+      "    (dstore temp=\"sum\" (dconst 0.0))"
+      "    (astore temp=\"a\" (aload parm=0))"
+      "    (astore temp=\"b\" (aload parm=1))"
+      "    (istore temp=\"i\" (iconst 0)))"
+      "  (block name=\"loop\""
+      "    (ificmpge target=\"exit\" (iload temp=\"i\") (iload parm=2)))"
+      "  (block"
+      "    (dstore temp=\"sum\" (dadd (dload temp=\"sum\")"
+      "      (dadd (dadd (dmul (dloadi offset=0 (aload temp=\"a\")) (dloadi offset=0 (aload temp=\"b\")))"
+      "                  (dmul (dloadi offset=8 (aload temp=\"a\")) (dloadi offset=8 (aload temp=\"b\"))))"
+      "            (dadd (dmul (dloadi offset=16 (aload temp=\"a\")) (dloadi offset=16 (aload temp=\"b\")))"
+      "                  (dmul (dloadi offset=24 (aload temp=\"a\")) (dloadi offset=24 (aload temp=\"b\")))))))"
+      "    (astore temp=\"a\" (aladd (aload temp=\"a\") (lconst 32)))"
+      "    (astore temp=\"b\" (aladd (aload temp=\"b\") (lconst 32)))"
+      "    (istore temp=\"i\" (iadd (iload temp=\"i\") (iconst 4)))"
+      "    (goto target=\"loop\"))"
+      "  (block name=\"exit\""
+      "    (dreturn (dload temp=\"sum\"))))");
+   ASSERT_NOTNULL(trees);
+
+   static const int32_t length = 1024;
+   static double a[length], b[length];
+   double expected = 0.0;
+   for (int32_t i = 0; i < length; i++)
+      {
+      a[i] = (i % 17) - 8;
+      b[i] = (i % 5) * 0.5;
+      }
+   for (int32_t i = 0; i < length; i += 4)
+      expected += (a[i] * b[i] + a[i + 1] * b[i + 1]) + (a[i + 2] * b[i + 2] + a[i + 3] * b[i + 3]);
+
+   typedef double (*Method)(double *, double *, int32_t);
+   for (int32_t mode = 0; mode < NumModes; mode++)
+      {
+      Method method = compile<Method>(trees, (Mode)mode);
+      ASSERT_NOTNULL(method);
+      EXPECT_DOUBLE_EQ(expected, method(a, b, length)) << modeName((Mode)mode);
+      EXPECT_DOUBLE_EQ(0.0, method(a, b, 0)) << modeName((Mode)mode);
+
+      static const int32_t iterations = 2000;
+      std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+      double sum = 0.0;
+      for (int32_t i = 0; i < iterations; i++)
+         sum += method(a, b, length);
+      std::chrono::steady_clock::duration elapsed = std::chrono::steady_clock::now() - start;
+      EXPECT_DOUBLE_EQ(expected * iterations, sum);
+      printf("[ BENCHMARK] dot product of %d doubles, %s: %lld ns\n", length, modeName((Mode)mode),
+             (long long)(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count() / iterations));
+      }
+   }
+
+/*
+ * Stores and loads through the same base register at overlapping and
+ * disjoint offsets; only the disjoint accesses may be reordered.
+ */
+TEST_F(InstructionSchedulerTest, OverlappingMemoryAccesses)
+   {
+   auto trees = parseString(
+      "(method return=Int32 args=[Address, Int32]"
+      "  (block"
+      "    (istorei offset=8 (aload parm=0) (imul (iload parm=1) (iconst 3)))"
+      "    (bstorei offset=1 (aload parm=0) (i2b (iadd (iload parm=1) (iconst 5))))"
+      "    (istorei offset=12 (aload parm=0) (iadd (iloadi offset=0 (aload parm=0)) (iloadi offset=4 (aload parm=0))))"
+      "    (ireturn (isub (iloadi offset=12 (aload parm=0)) (iloadi offset=8 (aload parm=0))))))");
+   ASSERT_NOTNULL(trees);
+
+   typedef int32_t (*Method)(int32_t *, int32_t);
+   const int32_t inputs[] = { 0, 1, -7, 0x12345678, INT32_MIN };
+   for (int32_t mode = 0; mode < NumModes; mode++)
+      {
+      Method method = compile<Method>(trees, (Mode)mode);
+      ASSERT_NOTNULL(method);
+      for (size_t i = 0; i < sizeof(inputs) / sizeof(inputs[0]); i++)
+         {
+         int32_t x = inputs[i];
+         int32_t memory[4] = { 0x11223344, 42, 0, 0 };
+         int32_t expectedMemory[4] = { 0x11223344, 42, (int32_t)((uint32_t)x * 3), 0 };
+         ((int8_t *)expectedMemory)[1] = (int8_t)((uint32_t)x + 5);
+         expectedMemory[3] = (int32_t)((uint32_t)expectedMemory[0] + (uint32_t)expectedMemory[1]);
+         int32_t expected = (int32_t)((uint32_t)expectedMemory[3] - (uint32_t)expectedMemory[2]);
+
+         EXPECT_EQ(expected, method(memory, x)) << modeName((Mode)mode) << ", x = " << x;
+         for (int32_t j = 0; j < 4; j++)
+            EXPECT_EQ(expectedMemory[j], memory[j]) << modeName((Mode)mode) << ", x = " << x << ", word " << j;
+         }
+      }
+   }
+
+/*
+ * Independent arithmetic ahead of compares and conditional code, so that
+ * the last flag setting instruction before each branch must stay last.
+ */
+TEST_F(InstructionSchedulerTest, FlagsAtBranches)
+   {
+   auto trees = parseString(
+      "(method return=Int32 args=[Int32, Int32, Int32]"
+      "  (block"
+      "    (istore temp=\"s\" (iadd (imul (iload parm=0) (iload parm=1)) (iload parm=2)))"
+      "    (istore temp=\"t\" (ixor (isub (iload parm=0) (iload parm=2)) (ishl (iload parm=1) (iconst 3))))"
+      "    (ificmplt target=\"less\" (iload temp=\"s\") (iload temp=\"t\")))"
+      "  (block"
+      "    (ireturn (iadd (icmpeq (iand (iload temp=\"s\") (iconst 255)) (iconst 0)) (iload temp=\"t\"))))"
+      "  (block name=\"less\""
+      "    (ireturn (isub (iload temp=\"t\") (iload temp=\"s\")))))");
+   ASSERT_NOTNULL(trees);
+
+   typedef int32_t (*Method)(int32_t, int32_t, int32_t);
+   const int32_t inputs[][3] = { {1, 2, 3}, {-4, 9, 100}, {1000, 1000, -7}, {0, 0, 0}, {256, 1, -256} };
+   for (int32_t mode = 0; mode < NumModes; mode++)
+      {
+      Method method = compile<Method>(trees, (Mode)mode);
+      ASSERT_NOTNULL(method);
+      for (size_t i = 0; i < sizeof(inputs) / sizeof(inputs[0]); i++)
+         {
+         uint32_t x = inputs[i][0], y = inputs[i][1], z = inputs[i][2];
+         int32_t s = (int32_t)(x * y + z);
+         int32_t t = (int32_t)((x - z) ^ (y << 3));
+         int32_t expected = s < t ? (int32_t)((uint32_t)t - (uint32_t)s) : (int32_t)(((s & 255) == 0) + (uint32_t)t);
+         EXPECT_EQ(expected, method(inputs[i][0], inputs[i][1], inputs[i][2])) << modeName((Mode)mode) << ", input " << i;
+         }
+      }
+   }
+
+/*
+ * More values live at once than there are registers, so that scheduling
+ * before register assignment has to be paid for with spills.
+ */
+TEST_F(InstructionSchedulerTest, RegisterPressure)
+   {
+   static const int32_t numValues = 20;
+   std::string method = "(method return=Int64 args=[Int64, Int64, Int64, Int64] (block";
+   char buffer[200];
+
+   for (int32_t k = 0; k < numValues; k++)
+      {
+      snprintf(buffer, sizeof(buffer), " (treetop (ladd id=\"t%d\" (lmul (lload parm=%d) (lconst %d)) (lload parm=%d)))",
+               k, k % 4, k + 5, (k + 3) % 4);
+      method += buffer;
+      }
+
+   std::string sum = "(@id \"t0\")";
+   for (int32_t k = 1; k < numValues; k++)
+      {
+      snprintf(buffer, sizeof(buffer), "(lxor (lmul (@id \"t%d\") (lconst %d)) ", k, 2 * k + 1);
+      sum = buffer + sum + ")";
+      }
+   method += " (lreturn " + sum + ")))";
+
+   auto trees = parseString(method.c_str());
+   ASSERT_NOTNULL(trees) << "Trees failed to parse\n" << method;
+
+   typedef int64_t (*Method)(int64_t, int64_t, int64_t, int64_t);
+   const int64_t inputs[][4] = { {1, 2, 3, 4}, {-5, 17, 0, 1000000007}, {INT64_MAX, INT64_MIN, -1, 12345} };
+   for (int32_t mode = 0; mode < NumModes; mode++)
+      {
+      Method entry = compile<Method>(trees, (Mode)mode);
+      ASSERT_NOTNULL(entry);
+      for (size_t i = 0; i < sizeof(inputs) / sizeof(inputs[0]); i++)
+         {
+         uint64_t p[4] = { (uint64_t)inputs[i][0], (uint64_t)inputs[i][1], (uint64_t)inputs[i][2], (uint64_t)inputs[i][3] };
+         uint64_t expected = p[0] * 5 + p[3];
+         for (int32_t k = 1; k < numValues; k++)
+            expected = ((p[k % 4] * (k + 5) + p[(k + 3) % 4]) * (2 * k + 1)) ^ expected;
+
+         EXPECT_EQ((int64_t)expected, entry(inputs[i][0], inputs[i][1], inputs[i][2], inputs[i][3])) << modeName((Mode)mode);
+         }
+      }
+   }
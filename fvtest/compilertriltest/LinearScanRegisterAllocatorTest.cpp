@@ -0,0 +1,232 @@
+/*******************************************************************************
+ * Copyright (c) 2020, 2020 IBM Corp. and others
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at https://www.eclipse.org/legal/epl-2.0/
+ * or the Apache License, Version 2.0 which accompanies this distribution and
+ * is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following
+ * Secondary Licenses when the conditions for such availability set
+ * forth in the Eclipse Public License, v. 2.0 are satisfied: GNU
+ * General Public License, version 2 with the GNU Classpath
+ * Exception [1] and GNU General Public License, version 2 with the
+ * OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] http://openjdk.java.net/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
+ *******************************************************************************/
+
+#include "JitTest.hpp"
+#include "default_compiler.hpp"
+#include "control/Options.hpp"
+#include "runtime/CodeCache.hpp"
+#include "runtime/CodeCacheManager.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <stdint.h>
+#include <string>
+
+/**
+ * Compiles each method once with the default register allocation pipeline,
+ * GRA followed by the local register assigner, and once with linear scan
+ * register allocation. Both versions must compute the same results. The
+ * compile time and code size of each are reported so that the two pipelines
+ * can be compared.
+ */
+class LinearScanRegisterAllocatorTest : public TRTest::JitTest
+   {
+   public:
+
+   ~LinearScanRegisterAllocatorTest()
+      {
+      TR::Options::getCmdLineOptions()->setOption(TR_EnableLinearScanRegisterAllocation, false);
+      }
+
+   template <typename T>
+   struct Measurement
+      {
+      T _entryPoint;
+      double _compileMicroseconds;
+      size_t _codeSize;
+      };
+
+   /**
+    * Compiles the trees a number of times and returns the entry point of the
+    * last body, the mean compile time and the code cache space of one body.
+    */
+   template <typename T>
+   Measurement<T> compile(ASTNode *trees, bool useLinearScan)
+      {
+      static const int32_t repetitions = 20;
+      Measurement<T> result = { NULL, 0.0, 0 };
+
+      TR::Options::getCmdLineOptions()->setOption(TR_EnableLinearScanRegisterAllocation, useLinearScan);
+      TR::CodeCache *codeCache = TR::CodeCacheManager::instance()->getFirstCodeCache();
+
+      std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+      for (int32_t i = 0; i < repetitions; i++)
+         {
+         Tril::DefaultCompiler compiler(trees);
+         uint8_t *warmCodeAlloc = codeCache->getWarmCodeAlloc();
+         EXPECT_EQ(0, compiler.compile()) << "Compilation failed unexpectedly";
+         result._codeSize = codeCache->getWarmCodeAlloc() - warmCodeAlloc;
+         result._entryPoint = compiler.getEntryPoint<T>();
+         }
+      result._compileMicroseconds = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count() / repetitions;
+
+      TR::Options::getCmdLineOptions()->setOption(TR_EnableLinearScanRegisterAllocation, false);
+      return result;
+      }
+
+   template <typename T>
+   void report(const char *name, const Measurement<T> &gra, const Measurement<T> &linearScan)
+      {
+      printf("%s: GRA and local RA %.1f us, %zu bytes; linear scan %.1f us, %zu bytes\n",
+             name, gra._compileMicroseconds, gra._codeSize, linearScan._compileMicroseconds, linearScan._codeSize);
+      }
+   };
+
+static int32_t linearScanCallee(int32_t x) { return x * 7 + 1; }
+
+TEST_F(LinearScanRegisterAllocatorTest, SumOfSquaresLoop)
+   {
+   auto trees = parseString(
+      "(method return=Int32 args=[Int32]"
+      "  (block"
+      "    (istore temp=\"sum\" (iconst 0))"
+      "    (istore temp=\"i\" (iconst 0)))"
+      "  (block name=\"loop\""
+      "    (ificmpge target=\"exit\" (iload temp=\"i\") (iload parm=0)))"
+      "  (block"
+      "    (istore temp=\"sum\" (iadd (iload temp=\"sum\") (imul (iload temp=\"i\") (iload temp=\"i\"))))"
+      "    (istore temp=\"i\" (iadd (iload temp=\"i\") (iconst 1)))"
+      "    (goto target=\"loop\"))"
+      "  (block name=\"exit\""
+      "    (ireturn (iload temp=\"sum\"))))");
+   ASSERT_NOTNULL(trees);
+
+   typedef int32_t (*Method)(int32_t);
+   Measurement<Method> gra = compile<Method>(trees, false);
+   Measurement<Method> linearScan = compile<Method>(trees, true);
+   ASSERT_NOTNULL(gra._entryPoint);
+   ASSERT_NOTNULL(linearScan._entryPoint);
+
+   for (int32_t n = 0; n < 100; n += 7)
+      {
+      uint32_t sum = 0;
+      for (uint32_t i = 0; i < (uint32_t)n; i++)
+         sum += i * i;
+      EXPECT_EQ((int32_t)sum, gra._entryPoint(n));
+      EXPECT_EQ((int32_t)sum, linearScan._entryPoint(n));
+      }
+
+   report("SumOfSquaresLoop", gra, linearScan);
+   }
+
+/*
+ * Keeps more values live at once than there are registers, so that some
+ * intervals must be spilled.
+ */
+TEST_F(LinearScanRegisterAllocatorTest, RegisterPressure)
+   {
+   static const int32_t numValues = 20;
+   std::string method = "(method return=Int64 args=[Int64, Int64, Int64, Int64] (block";
+   char buffer[200];
+
+   for (int32_t k = 0; k < numValues; k++)
+      {
+      snprintf(buffer, sizeof(buffer), " (treetop (lxor id=\"t%d\" (lmul (lload parm=%d) (lconst %d)) (lload parm=%d)))",
+               k, k % 4, k + 3, (k + 1) % 4);
+      method += buffer;
+      }
+
+   std::string sum = "(@id \"t0\")";
+   for (int32_t k = 1; k < numValues; k++)
+      {
+      snprintf(buffer, sizeof(buffer), "(ladd (lmul (@id \"t%d\") (lconst %d)) ", k, k + 1);
+      sum = buffer + sum + ")";
+      }
+   method += " (lreturn " + sum + ")))";
+
+   auto trees = parseString(method.c_str());
+   ASSERT_NOTNULL(trees) << "Trees failed to parse\n" << method;
+
+   typedef int64_t (*Method)(int64_t, int64_t, int64_t, int64_t);
+   Measurement<Method> gra = compile<Method>(trees, false);
+   Measurement<Method> linearScan = compile<Method>(trees, true);
+   ASSERT_NOTNULL(gra._entryPoint);
+   ASSERT_NOTNULL(linearScan._entryPoint);
+
+   const int64_t inputs[][4] = { {1, 2, 3, 4}, {-5, 17, 0, 1000000007}, {INT64_MAX, INT64_MIN, -1, 12345} };
+   for (size_t i = 0; i < sizeof(inputs) / sizeof(inputs[0]); i++)
+      {
+      uint64_t p[4] = { (uint64_t)inputs[i][0], (uint64_t)inputs[i][1], (uint64_t)inputs[i][2], (uint64_t)inputs[i][3] };
+      uint64_t expected = (p[0] * 3) ^ p[1];
+      for (int32_t k = 1; k < numValues; k++)
+         expected = ((p[k % 4] * (k + 3)) ^ p[(k + 1) % 4]) * (k + 1) + expected;
+
+      EXPECT_EQ((int64_t)expected, gra._entryPoint(inputs[i][0], inputs[i][1], inputs[i][2], inputs[i][3]));
+      EXPECT_EQ((int64_t)expected, linearScan._entryPoint(inputs[i][0], inputs[i][1], inputs[i][2], inputs[i][3]));
+      }
+
+   report("RegisterPressure", gra, linearScan);
+   }
+
+/*
+ * The product is live across the call, so it wants a preserved register.
+ */
+TEST_F(LinearScanRegisterAllocatorTest, ValueLiveAcrossCall)
+   {
+   char inputTrees[300] = {0};
+   const auto format_string =
+      "(method return=Int32 args=[Int32, Int32]"
+      "  (block"
+      "    (ireturn (iadd (imul (iload parm=0) (iload parm=1)) (icall address=0x%jX args=[Int32] (iload parm=1))))))";
+   std::snprintf(inputTrees, sizeof(inputTrees), format_string, reinterpret_cast<uintmax_t>(&linearScanCallee));
+   auto trees = parseString(inputTrees);
+   ASSERT_NOTNULL(trees) << "Trees failed to parse\n" << inputTrees;
+
+   // Execution of this test is disabled on non-X86 platforms, as we
+   // do not have trampoline support, and so this call may be out of
+   // range for some architectures.
+#ifdef TR_TARGET_X86
+   typedef int32_t (*Method)(int32_t, int32_t);
+   Measurement<Method> gra = compile<Method>(trees, false);
+   Measurement<Method> linearScan = compile<Method>(trees, true);
+   ASSERT_NOTNULL(gra._entryPoint);
+   ASSERT_NOTNULL(linearScan._entryPoint);
+
+   EXPECT_EQ(3 * 4 + linearScanCallee(4), gra._entryPoint(3, 4));
+   EXPECT_EQ(3 * 4 + linearScanCallee(4), linearScan._entryPoint(3, 4));
+   EXPECT_EQ(-9 * 11 + linearScanCallee(11), linearScan._entryPoint(-9, 11));
+
+   report("ValueLiveAcrossCall", gra, linearScan);
+#endif
+   }
+
+TEST_F(LinearScanRegisterAllocatorTest, DoubleArithmetic)
+   {
+   auto trees = parseString(
+      "(method return=Double args=[Double, Double, Double]"
+      "  (block"
+      "    (dreturn (dadd (dmul (dload parm=0) (dload parm=1))"
+      "                   (ddiv (dsub (dload parm=2) (dload parm=0)) (dadd (dload parm=1) (dconst 2.0)))))))");
+   ASSERT_NOTNULL(trees);
+
+   typedef double (*Method)(double, double, double);
+   Measurement<Method> gra = compile<Method>(trees, false);
+   Measurement<Method> linearScan = compile<Method>(trees, true);
+   ASSERT_NOTNULL(gra._entryPoint);
+   ASSERT_NOTNULL(linearScan._entryPoint);
+
+   EXPECT_DOUBLE_EQ(1.5 * 2.0 + (4.0 - 1.5) / (2.0 + 2.0), gra._entryPoint(1.5, 2.0, 4.0));
+   EXPECT_DOUBLE_EQ(1.5 * 2.0 + (4.0 - 1.5) / (2.0 + 2.0), linearScan._entryPoint(1.5, 2.0, 4.0));
+   EXPECT_DOUBLE_EQ(-3.0 * 0.5 + (7.0 + 3.0) / (0.5 + 2.0), linearScan._entryPoint(-3.0, 0.5, 7.0));
+
+   report("DoubleArithmetic", gra, linearScan);
+   }
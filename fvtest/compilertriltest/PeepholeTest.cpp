@@ -0,0 +1,262 @@
+/*******************************************************************************
+ * Copyright (c) 2020, 2020 IBM Corp. and others
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at https://www.eclipse.org/legal/epl-2.0/
+ * or the Apache License, Version 2.0 which accompanies this distribution and
+ * is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following
+ * Secondary Licenses when the conditions for such availability set
+ * forth in the Eclipse Public License, v. 2.0 are satisfied: GNU
+ * General Public License, version 2 with the GNU Classpath
+ * Exception [1] and GNU General Public License, version 2 with the
+ * OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] http://openjdk.java.net/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
+ *******************************************************************************/
+
+#include "JitTest.hpp"
+#include "default_compiler.hpp"
+#include "control/Options.hpp"
+#include "optimizer/Optimizations.hpp"
+#include "runtime/CodeCache.hpp"
+#include "runtime/CodeCacheManager.hpp"
+
+#include <stdint.h>
+
+#ifdef TR_TARGET_X86
+#include "x/codegen/X86Peephole.hpp"
+
+/**
+ * Compiles each method once with the peephole pass and once with
+ * disablePeephole. Both versions must compute the same results, and the
+ * version compiled with the pass must have had the expected rule applied and
+ * take no more code cache space. The code cache allocates bodies in aligned
+ * chunks, so removing a few bytes does not always show up in the space used.
+ *
+ * The optimizer removes most of the patterns the rules look for before code
+ * generation, so some tests disable the optimization that would otherwise
+ * hide the pattern from the pass.
+ */
+class PeepholeTest : public TRTest::JitTest
+   {
+   public:
+
+   ~PeepholeTest()
+      {
+      TR::Options::getCmdLineOptions()->setOption(TR_DisablePeephole, false);
+      TR::Options::getCmdLineOptions()->setDisabled(OMR::localCSE, false);
+      TR::Options::getCmdLineOptions()->setDisabled(OMR::basicBlockExtension, false);
+      }
+
+   template <typename T>
+   struct Measurement
+      {
+      T _entryPoint;
+      size_t _codeSize;
+      uintptr_t _applications[TR_X86Peephole::NumRules];
+      };
+
+   template <typename T>
+   Measurement<T> compile(ASTNode *trees, bool usePeephole)
+      {
+      Measurement<T> result;
+      TR::CodeCache *codeCache = TR::CodeCacheManager::instance()->getFirstCodeCache();
+
+      for (int32_t rule = 0; rule < TR_X86Peephole::NumRules; rule++)
+         result._applications[rule] = TR_X86Peephole::getApplications((TR_X86Peephole::Rule)rule);
+
+      TR::Options::getCmdLineOptions()->setOption(TR_DisablePeephole, !usePeephole);
+      Tril::DefaultCompiler compiler(trees);
+      uint8_t *warmCodeAlloc = codeCache->getWarmCodeAlloc();
+      EXPECT_EQ(0, compiler.compile()) << "Compilation failed unexpectedly";
+      result._codeSize = codeCache->getWarmCodeAlloc() - warmCodeAlloc;
+      result._entryPoint = compiler.getEntryPoint<T>();
+      TR::Options::getCmdLineOptions()->setOption(TR_DisablePeephole, false);
+
+      for (int32_t rule = 0; rule < TR_X86Peephole::NumRules; rule++)
+         result._applications[rule] = TR_X86Peephole::getApplications((TR_X86Peephole::Rule)rule) - result._applications[rule];
+
+      return result;
+      }
+   };
+
+/*
+ * The xor sets the sign flag from its result, so the test before the
+ * branch is not needed.
+ */
+TEST_F(PeepholeTest, CompareAgainstZeroAfterXor)
+   {
+   auto trees = parseString(
+      "(method return=Int32 args=[Int32, Int32]"
+      "  (block"
+      "    (ificmplt target=\"negative\" (ixor (iload parm=0) (iload parm=1)) (iconst 0)))"
+      "  (block"
+      "    (ireturn (iconst 1)))"
+      "  (block name=\"negative\""
+      "    (ireturn (iconst -1))))");
+   ASSERT_NOTNULL(trees);
+
+   typedef int32_t (*Method)(int32_t, int32_t);
+   Measurement<Method> without = compile<Method>(trees, false);
+   Measurement<Method> with = compile<Method>(trees, true);
+   ASSERT_NOTNULL(without._entryPoint);
+   ASSERT_NOTNULL(with._entryPoint);
+
+   EXPECT_EQ(0, without._applications[TR_X86Peephole::CompareAgainstZero]);
+   EXPECT_EQ(1, with._applications[TR_X86Peephole::CompareAgainstZero]);
+   EXPECT_LE(with._codeSize, without._codeSize);
+
+   const int32_t inputs[][2] = { {0, 0}, {1, 2}, {-1, 2}, {INT32_MIN, 0}, {INT32_MIN, INT32_MIN}, {INT32_MAX, -1} };
+   for (size_t i = 0; i < sizeof(inputs) / sizeof(inputs[0]); i++)
+      {
+      int32_t expected = (inputs[i][0] ^ inputs[i][1]) < 0 ? -1 : 1;
+      EXPECT_EQ(expected, without._entryPoint(inputs[i][0], inputs[i][1]));
+      EXPECT_EQ(expected, with._entryPoint(inputs[i][0], inputs[i][1]));
+      }
+   }
+
+/*
+ * The add sets the zero flag from its result, and only the zero flag is read.
+ */
+TEST_F(PeepholeTest, CompareAgainstZeroAfterAdd)
+   {
+   auto trees = parseString(
+      "(method return=Int32 args=[Int32, Int32]"
+      "  (block"
+      "    (ificmpeq target=\"zero\" (iadd (iload parm=0) (iload parm=1)) (iconst 0)))"
+      "  (block"
+      "    (ireturn (iconst 1)))"
+      "  (block name=\"zero\""
+      "    (ireturn (iconst -1))))");
+   ASSERT_NOTNULL(trees);
+
+   typedef int32_t (*Method)(int32_t, int32_t);
+   Measurement<Method> without = compile<Method>(trees, false);
+   Measurement<Method> with = compile<Method>(trees, true);
+   ASSERT_NOTNULL(without._entryPoint);
+   ASSERT_NOTNULL(with._entryPoint);
+
+   EXPECT_EQ(1, with._applications[TR_X86Peephole::CompareAgainstZero]);
+   EXPECT_LE(with._codeSize, without._codeSize);
+
+   const int32_t inputs[][2] = { {0, 0}, {1, -1}, {1, 2}, {INT32_MAX, 1}, {INT32_MIN, INT32_MIN} };
+   for (size_t i = 0; i < sizeof(inputs) / sizeof(inputs[0]); i++)
+      {
+      int32_t expected = (int32_t)((uint32_t)inputs[i][0] + (uint32_t)inputs[i][1]) == 0 ? -1 : 1;
+      EXPECT_EQ(expected, without._entryPoint(inputs[i][0], inputs[i][1]));
+      EXPECT_EQ(expected, with._entryPoint(inputs[i][0], inputs[i][1]));
+      }
+   }
+
+/*
+ * The add can overflow and the branch reads the overflow flag, so the test
+ * must be kept.
+ */
+TEST_F(PeepholeTest, CompareAgainstZeroAfterAddReadsOverflow)
+   {
+   auto trees = parseString(
+      "(method return=Int32 args=[Int32, Int32]"
+      "  (block"
+      "    (ificmplt target=\"negative\" (iadd (iload parm=0) (iload parm=1)) (iconst 0)))"
+      "  (block"
+      "    (ireturn (iconst 1)))"
+      "  (block name=\"negative\""
+      "    (ireturn (iconst -1))))");
+   ASSERT_NOTNULL(trees);
+
+   typedef int32_t (*Method)(int32_t, int32_t);
+   Measurement<Method> with = compile<Method>(trees, true);
+   ASSERT_NOTNULL(with._entryPoint);
+
+   EXPECT_EQ(0, with._applications[TR_X86Peephole::CompareAgainstZero]);
+
+   const int32_t inputs[][2] = { {0, 0}, {1, -2}, {INT32_MAX, 1}, {INT32_MIN, -1}, {INT32_MIN, INT32_MIN} };
+   for (size_t i = 0; i < sizeof(inputs) / sizeof(inputs[0]); i++)
+      {
+      int32_t expected = (int32_t)((uint32_t)inputs[i][0] + (uint32_t)inputs[i][1]) < 0 ? -1 : 1;
+      EXPECT_EQ(expected, with._entryPoint(inputs[i][0], inputs[i][1]));
+      }
+   }
+
+/*
+ * Without basic block extension the block that only jumps to the exit is
+ * kept, and the branch to it can go to the exit directly.
+ */
+TEST_F(PeepholeTest, JumpToJump)
+   {
+   auto trees = parseString(
+      "(method return=Int32 args=[Int32, Int32]"
+      "  (block"
+      "    (ificmpeq target=\"hop\" (iload parm=0) (iconst 0)))"
+      "  (block"
+      "    (ificmpeq target=\"one\" (iload parm=1) (iconst 1)))"
+      "  (block"
+      "    (ireturn (iload parm=1)))"
+      "  (block name=\"hop\""
+      "    (goto target=\"exit\"))"
+      "  (block name=\"one\""
+      "    (ireturn (iconst 3)))"
+      "  (block name=\"exit\""
+      "    (ireturn (iconst 7))))");
+   ASSERT_NOTNULL(trees);
+
+   TR::Options::getCmdLineOptions()->setDisabled(OMR::basicBlockExtension, true);
+
+   typedef int32_t (*Method)(int32_t, int32_t);
+   Measurement<Method> without = compile<Method>(trees, false);
+   Measurement<Method> with = compile<Method>(trees, true);
+   ASSERT_NOTNULL(without._entryPoint);
+   ASSERT_NOTNULL(with._entryPoint);
+
+   EXPECT_EQ(1, with._applications[TR_X86Peephole::JumpToJump]);
+
+   const int32_t inputs[][2] = { {0, 0}, {0, 1}, {1, 1}, {1, 5}, {-1, -1} };
+   for (size_t i = 0; i < sizeof(inputs) / sizeof(inputs[0]); i++)
+      {
+      int32_t expected = inputs[i][0] == 0 ? 7 : (inputs[i][1] == 1 ? 3 : inputs[i][1]);
+      EXPECT_EQ(expected, without._entryPoint(inputs[i][0], inputs[i][1]));
+      EXPECT_EQ(expected, with._entryPoint(inputs[i][0], inputs[i][1]));
+      }
+   }
+
+/*
+ * Without local CSE the temp is reloaded right after it is stored, and the
+ * load can be replaced by a register move.
+ */
+TEST_F(PeepholeTest, LoadAfterStore)
+   {
+   auto trees = parseString(
+      "(method return=Int32 args=[Int32, Int32]"
+      "  (block"
+      "    (istore temp=\"t\" (iadd (iload parm=0) (iload parm=1)))"
+      "    (ireturn (ishl (iload temp=\"t\") (iload parm=1)))))");
+   ASSERT_NOTNULL(trees);
+
+   TR::Options::getCmdLineOptions()->setDisabled(OMR::localCSE, true);
+
+   typedef int32_t (*Method)(int32_t, int32_t);
+   Measurement<Method> without = compile<Method>(trees, false);
+   Measurement<Method> with = compile<Method>(trees, true);
+   ASSERT_NOTNULL(without._entryPoint);
+   ASSERT_NOTNULL(with._entryPoint);
+
+   EXPECT_EQ(1, with._applications[TR_X86Peephole::LoadAfterStore]);
+   EXPECT_LE(with._codeSize, without._codeSize);
+
+   const int32_t inputs[][2] = { {0, 0}, {1, 2}, {-7, 3}, {INT32_MAX, 1}, {12345, 31} };
+   for (size_t i = 0; i < sizeof(inputs) / sizeof(inputs[0]); i++)
+      {
+      uint32_t sum = (uint32_t)inputs[i][0] + (uint32_t)inputs[i][1];
+      int32_t expected = (int32_t)(sum << (inputs[i][1] & 31));
+      EXPECT_EQ(expected, without._entryPoint(inputs[i][0], inputs[i][1]));
+      EXPECT_EQ(expected, with._entryPoint(inputs[i][0], inputs[i][1]));
+      }
+   }
+
+#endif
@@ -22,8 +22,17 @@
 #include "JitTest.hpp"
 #include "default_compiler.hpp"
 
+#include <algorithm>
+#include <cmath>
+
 class VectorTest : public TRTest::JitTest {};
 
+/*
+ * The general vector opcodes below are only implemented by the x86 code generator
+ */
+#define SKIP_ON_NON_X86(reason) \
+   SKIP_IF(strcmp(OMRPORT_ARCH_X86, omrsysinfo_get_CPU_architecture()) && strcmp(OMRPORT_ARCH_HAMMER, omrsysinfo_get_CPU_architecture()), reason)
+
 
 TEST_F(VectorTest, VDoubleAdd) { 
 
@@ -65,3 +74,418 @@ TEST_F(VectorTest, VDoubleAdd) {
     EXPECT_DOUBLE_EQ(inputA[0] + inputB[0], output[0]); // Epsilon = 4ULP -- is this necessary? 
     EXPECT_DOUBLE_EQ(inputA[1] + inputB[1], output[1]); // Epsilon = 4ULP -- is this necessary? 
 }
+
+TEST_F(VectorTest, VInt32Neg) {
+
+   auto inputTrees = "(method return= NoType args=[Address,Address]                   "
+                     "  (block                                                        "
+                     "     (vstorei type=VectorInt32 offset=0                         "
+                     "         (aload parm=0)                                         "
+                     "            (vneg                                               "
+                     "                 (vloadi type=VectorInt32 (aload parm=1))))     "
+                     "     (return)))                                                 ";
+
+    auto trees = parseString(inputTrees);
+
+    ASSERT_NOTNULL(trees);
+    SKIP_ON_NON_X86(MissingImplementation) << "General vector opcodes are only implemented on x86";
+
+    Tril::DefaultCompiler compiler(trees);
+    ASSERT_EQ(0, compiler.compile()) << "Compilation failed unexpectedly\n" << "Input trees: " << inputTrees;
+
+    auto entry_point = compiler.getEntryPoint<void (*)(int32_t[],int32_t[])>();
+
+    int32_t output[] = {0, 0, 0, 0};
+    int32_t input[] =  {1, -2, 0, INT32_MAX};
+
+    entry_point(output,input);
+    for (int i = 0; i < 4; i++)
+       EXPECT_EQ(-input[i], output[i]);
+}
+
+TEST_F(VectorTest, VFloatNeg) {
+
+   auto inputTrees = "(method return= NoType args=[Address,Address]                   "
+                     "  (block                                                        "
+                     "     (vstorei type=VectorFloat offset=0                         "
+                     "         (aload parm=0)                                         "
+                     "            (vneg                                               "
+                     "                 (vloadi type=VectorFloat (aload parm=1))))     "
+                     "     (return)))                                                 ";
+
+    auto trees = parseString(inputTrees);
+
+    ASSERT_NOTNULL(trees);
+    SKIP_ON_NON_X86(MissingImplementation) << "General vector opcodes are only implemented on x86";
+
+    Tril::DefaultCompiler compiler(trees);
+    ASSERT_EQ(0, compiler.compile()) << "Compilation failed unexpectedly\n" << "Input trees: " << inputTrees;
+
+    auto entry_point = compiler.getEntryPoint<void (*)(float[],float[])>();
+
+    float output[] = {0.0f, 0.0f, 0.0f, 0.0f};
+    float input[] =  {1.5f, -2.0f, 0.0f, -0.0f};
+
+    entry_point(output,input);
+    for (int i = 0; i < 4; i++)
+       {
+       EXPECT_FLOAT_EQ(-input[i], output[i]);
+       EXPECT_NE(std::signbit(input[i]), std::signbit(output[i]));
+       }
+}
+
+TEST_F(VectorTest, VInt64Com) {
+
+   auto inputTrees = "(method return= NoType args=[Address,Address]                   "
+                     "  (block                                                        "
+                     "     (vstorei type=VectorInt64 offset=0                         "
+                     "         (aload parm=0)                                         "
+                     "            (vcom                                               "
+                     "                 (vloadi type=VectorInt64 (aload parm=1))))     "
+                     "     (return)))                                                 ";
+
+    auto trees = parseString(inputTrees);
+
+    ASSERT_NOTNULL(trees);
+    SKIP_ON_NON_X86(MissingImplementation) << "General vector opcodes are only implemented on x86";
+
+    Tril::DefaultCompiler compiler(trees);
+    ASSERT_EQ(0, compiler.compile()) << "Compilation failed unexpectedly\n" << "Input trees: " << inputTrees;
+
+    auto entry_point = compiler.getEntryPoint<void (*)(int64_t[],int64_t[])>();
+
+    int64_t output[] = {0, 0};
+    int64_t input[] =  {0x0123456789abcdefLL, -1};
+
+    entry_point(output,input);
+    EXPECT_EQ(~input[0], output[0]);
+    EXPECT_EQ(~input[1], output[1]);
+}
+
+TEST_F(VectorTest, VInt32ShiftLeftByConst) {
+
+   auto inputTrees = "(method return= NoType args=[Address,Address]                   "
+                     "  (block                                                        "
+                     "     (vstorei type=VectorInt32 offset=0                         "
+                     "         (aload parm=0)                                         "
+                     "            (vshl                                               "
+                     "                 (vloadi type=VectorInt32 (aload parm=1))       "
+                     "                 (iconst 3)))                                   "
+                     "     (return)))                                                 ";
+
+    auto trees = parseString(inputTrees);
+
+    ASSERT_NOTNULL(trees);
+    SKIP_ON_NON_X86(MissingImplementation) << "General vector opcodes are only implemented on x86";
+
+    Tril::DefaultCompiler compiler(trees);
+    ASSERT_EQ(0, compiler.compile()) << "Compilation failed unexpectedly\n" << "Input trees: " << inputTrees;
+
+    auto entry_point = compiler.getEntryPoint<void (*)(int32_t[],int32_t[])>();
+
+    int32_t output[] = {0, 0, 0, 0};
+    int32_t input[] =  {1, -2, 0x10000000, 7};
+
+    entry_point(output,input);
+    for (int i = 0; i < 4; i++)
+       EXPECT_EQ((int32_t)((uint32_t)input[i] << 3), output[i]);
+}
+
+TEST_F(VectorTest, VInt64ShiftRightByConst) {
+
+   auto inputTrees = "(method return= NoType args=[Address,Address]                   "
+                     "  (block                                                        "
+                     "     (vstorei type=VectorInt64 offset=0                         "
+                     "         (aload parm=0)                                         "
+                     "            (vshr                                               "
+                     "                 (vloadi type=VectorInt64 (aload parm=1))       "
+                     "                 (iconst 4)))                                   "
+                     "     (return)))                                                 ";
+
+    auto trees = parseString(inputTrees);
+
+    ASSERT_NOTNULL(trees);
+    SKIP_ON_NON_X86(MissingImplementation) << "General vector opcodes are only implemented on x86";
+
+    Tril::DefaultCompiler compiler(trees);
+    ASSERT_EQ(0, compiler.compile()) << "Compilation failed unexpectedly\n" << "Input trees: " << inputTrees;
+
+    auto entry_point = compiler.getEntryPoint<void (*)(int64_t[],int64_t[])>();
+
+    int64_t output[] = {0, 0};
+    int64_t input[] =  {-4096, 4096};
+
+    entry_point(output,input);
+    EXPECT_EQ(-256, output[0]);
+    EXPECT_EQ(256, output[1]);
+}
+
+TEST_F(VectorTest, VInt16ShiftRightUnsignedByParam) {
+
+   auto inputTrees = "(method return= NoType args=[Address,Address,Int32]             "
+                     "  (block                                                        "
+                     "     (vstorei type=VectorInt16 offset=0                         "
+                     "         (aload parm=0)                                         "
+                     "            (vushr                                              "
+                     "                 (vloadi type=VectorInt16 (aload parm=1))       "
+                     "                 (iload parm=2)))                               "
+                     "     (return)))                                                 ";
+
+    auto trees = parseString(inputTrees);
+
+    ASSERT_NOTNULL(trees);
+    SKIP_ON_NON_X86(MissingImplementation) << "General vector opcodes are only implemented on x86";
+
+    Tril::DefaultCompiler compiler(trees);
+    ASSERT_EQ(0, compiler.compile()) << "Compilation failed unexpectedly\n" << "Input trees: " << inputTrees;
+
+    auto entry_point = compiler.getEntryPoint<void (*)(uint16_t[],uint16_t[],int32_t)>();
+
+    uint16_t output[] = {0, 0, 0, 0, 0, 0, 0, 0};
+    uint16_t input[] =  {0xffff, 0x8000, 1, 2, 3, 0x1234, 0x7fff, 0};
+
+    entry_point(output,input,2);
+    for (int i = 0; i < 8; i++)
+       EXPECT_EQ(input[i] >> 2, output[i]);
+}
+
+TEST_F(VectorTest, VInt32CompareGreaterThan) {
+
+   auto inputTrees = "(method return= NoType args=[Address,Address,Address]           "
+                     "  (block                                                        "
+                     "     (vstorei type=VectorInt32 offset=0                         "
+                     "         (aload parm=0)                                         "
+                     "            (vcmpgt                                             "
+                     "                 (vloadi type=VectorInt32 (aload parm=1))       "
+                     "                 (vloadi type=VectorInt32 (aload parm=2))))     "
+                     "     (return)))                                                 ";
+
+    auto trees = parseString(inputTrees);
+
+    ASSERT_NOTNULL(trees);
+    SKIP_ON_NON_X86(MissingImplementation) << "General vector opcodes are only implemented on x86";
+
+    Tril::DefaultCompiler compiler(trees);
+    ASSERT_EQ(0, compiler.compile()) << "Compilation failed unexpectedly\n" << "Input trees: " << inputTrees;
+
+    auto entry_point = compiler.getEntryPoint<void (*)(int32_t[],int32_t[],int32_t[])>();
+
+    int32_t output[] = {0, 0, 0, 0};
+    int32_t inputA[] = {1, -1, 5, INT32_MIN};
+    int32_t inputB[] = {0, 1, 5, INT32_MAX};
+
+    entry_point(output,inputA,inputB);
+    for (int i = 0; i < 4; i++)
+       EXPECT_EQ(inputA[i] > inputB[i] ? -1 : 0, output[i]);
+}
+
+TEST_F(VectorTest, VInt8UnsignedCompareLessThan) {
+
+   auto inputTrees = "(method return= NoType args=[Address,Address,Address]           "
+                     "  (block                                                        "
+                     "     (vstorei type=VectorInt8 offset=0                          "
+                     "         (aload parm=0)                                         "
+                     "            (vucmplt                                            "
+                     "                 (vloadi type=VectorInt8 (aload parm=1))        "
+                     "                 (vloadi type=VectorInt8 (aload parm=2))))      "
+                     "     (return)))                                                 ";
+
+    auto trees = parseString(inputTrees);
+
+    ASSERT_NOTNULL(trees);
+    SKIP_ON_NON_X86(MissingImplementation) << "General vector opcodes are only implemented on x86";
+
+    Tril::DefaultCompiler compiler(trees);
+    ASSERT_EQ(0, compiler.compile()) << "Compilation failed unexpectedly\n" << "Input trees: " << inputTrees;
+
+    auto entry_point = compiler.getEntryPoint<void (*)(uint8_t[],uint8_t[],uint8_t[])>();
+
+    uint8_t output[16] = {0};
+    uint8_t inputA[] = {0, 1, 0x7f, 0x80, 0xff, 0xfe, 3, 3, 0, 0x80, 0x7f, 10, 200, 100, 0xff, 1};
+    uint8_t inputB[] = {1, 0, 0x80, 0x7f, 0xfe, 0xff, 3, 4, 0xff, 0x81, 0xff, 9, 100, 200, 0, 0x80};
+
+    entry_point(output,inputA,inputB);
+    for (int i = 0; i < 16; i++)
+       EXPECT_EQ(inputA[i] < inputB[i] ? 0xff : 0, output[i]) << "element " << i;
+}
+
+TEST_F(VectorTest, VInt64CompareNotEqual) {
+
+   auto inputTrees = "(method return= NoType args=[Address,Address,Address]           "
+                     "  (block                                                        "
+                     "     (vstorei type=VectorInt64 offset=0                         "
+                     "         (aload parm=0)                                         "
+                     "            (vcmpne                                             "
+                     "                 (vloadi type=VectorInt64 (aload parm=1))       "
+                     "                 (vloadi type=VectorInt64 (aload parm=2))))     "
+                     "     (return)))                                                 ";
+
+    auto trees = parseString(inputTrees);
+
+    ASSERT_NOTNULL(trees);
+    SKIP_ON_NON_X86(MissingImplementation) << "General vector opcodes are only implemented on x86";
+
+    Tril::DefaultCompiler compiler(trees);
+    ASSERT_EQ(0, compiler.compile()) << "Compilation failed unexpectedly\n" << "Input trees: " << inputTrees;
+
+    auto entry_point = compiler.getEntryPoint<void (*)(int64_t[],int64_t[],int64_t[])>();
+
+    int64_t output[] = {0, 0};
+    int64_t inputA[] = {42, INT64_MIN};
+    int64_t inputB[] = {42, INT64_MAX};
+
+    entry_point(output,inputA,inputB);
+    EXPECT_EQ(0, output[0]);
+    EXPECT_EQ(-1, output[1]);
+}
+
+TEST_F(VectorTest, VDoubleCompareGreaterOrEqual) {
+
+   auto inputTrees = "(method return= NoType args=[Address,Address,Address]           "
+                     "  (block                                                        "
+                     "     (vstorei type=VectorInt64 offset=0                         "
+                     "         (aload parm=0)                                         "
+                     "            (vcmpge                                             "
+                     "                 (vloadi type=VectorDouble (aload parm=1))      "
+                     "                 (vloadi type=VectorDouble (aload parm=2))))    "
+                     "     (return)))                                                 ";
+
+    auto trees = parseString(inputTrees);
+
+    ASSERT_NOTNULL(trees);
+    SKIP_ON_NON_X86(MissingImplementation) << "General vector opcodes are only implemented on x86";
+
+    Tril::DefaultCompiler compiler(trees);
+    ASSERT_EQ(0, compiler.compile()) << "Compilation failed unexpectedly\n" << "Input trees: " << inputTrees;
+
+    auto entry_point = compiler.getEntryPoint<void (*)(int64_t[],double[],double[])>();
+
+    int64_t output[] = {0, 0};
+    double inputA[] = {1.0, 2.0};
+    double inputB[] = {1.0, 2.5};
+
+    entry_point(output,inputA,inputB);
+    EXPECT_EQ(-1, output[0]);
+    EXPECT_EQ(0, output[1]);
+}
+
+TEST_F(VectorTest, VInt32SelectMaximum) {
+
+   auto inputTrees = "(method return= NoType args=[Address,Address,Address]           "
+                     "  (block                                                        "
+                     "     (vstorei type=VectorInt32 offset=0                         "
+                     "         (aload parm=0)                                         "
+                     "            (vselect                                            "
+                     "                 (vcmpgt                                        "
+                     "                      (vloadi type=VectorInt32 (aload parm=1))  "
+                     "                      (vloadi type=VectorInt32 (aload parm=2))) "
+                     "                 (vloadi type=VectorInt32 (aload parm=1))       "
+                     "                 (vloadi type=VectorInt32 (aload parm=2))))     "
+                     "     (return)))                                                 ";
+
+    auto trees = parseString(inputTrees);
+
+    ASSERT_NOTNULL(trees);
+    SKIP_ON_NON_X86(MissingImplementation) << "General vector opcodes are only implemented on x86";
+
+    Tril::DefaultCompiler compiler(trees);
+    ASSERT_EQ(0, compiler.compile()) << "Compilation failed unexpectedly\n" << "Input trees: " << inputTrees;
+
+    auto entry_point = compiler.getEntryPoint<void (*)(int32_t[],int32_t[],int32_t[])>();
+
+    int32_t output[] = {0, 0, 0, 0};
+    int32_t inputA[] = {1, -1, 5, INT32_MIN};
+    int32_t inputB[] = {0, 1, 5, INT32_MAX};
+
+    entry_point(output,inputA,inputB);
+    for (int i = 0; i < 4; i++)
+       EXPECT_EQ(std::max(inputA[i], inputB[i]), output[i]);
+}
+
+TEST_F(VectorTest, VInt32AndReduction) {
+
+   auto inputTrees = "(method return= NoType args=[Address,Address]                   "
+                     "  (block                                                        "
+                     "     (istorei offset=0                                          "
+                     "         (aload parm=0)                                         "
+                     "            (vrand                                              "
+                     "                 (vloadi type=VectorInt32 (aload parm=1))))     "
+                     "     (return)))                                                 ";
+
+    auto trees = parseString(inputTrees);
+
+    ASSERT_NOTNULL(trees);
+    SKIP_ON_NON_X86(MissingImplementation) << "General vector opcodes are only implemented on x86";
+
+    Tril::DefaultCompiler compiler(trees);
+    ASSERT_EQ(0, compiler.compile()) << "Compilation failed unexpectedly\n" << "Input trees: " << inputTrees;
+
+    auto entry_point = compiler.getEntryPoint<void (*)(int32_t *,int32_t[])>();
+
+    int32_t output = 0;
+    int32_t input[] = {0x7ffffff0, 0x0ffffff3, 0x3ffffff7, 0x1fffff3f};
+
+    entry_point(&output,input);
+    EXPECT_EQ(input[0] & input[1] & input[2] & input[3], output);
+}
+
+TEST_F(VectorTest, VInt32SetElement) {
+
+   auto inputTrees = "(method return= NoType args=[Address,Address,Int32]             "
+                     "  (block                                                        "
+                     "     (vstorei type=VectorInt32 offset=0                         "
+                     "         (aload parm=0)                                         "
+                     "            (vsetelem                                           "
+                     "                 (vloadi type=VectorInt32 (aload parm=1))       "
+                     "                 (iconst 2)                                     "
+                     "                 (iload parm=2)))                               "
+                     "     (return)))                                                 ";
+
+    auto trees = parseString(inputTrees);
+
+    ASSERT_NOTNULL(trees);
+    SKIP_ON_NON_X86(MissingImplementation) << "General vector opcodes are only implemented on x86";
+
+    Tril::DefaultCompiler compiler(trees);
+    ASSERT_EQ(0, compiler.compile()) << "Compilation failed unexpectedly\n" << "Input trees: " << inputTrees;
+
+    auto entry_point = compiler.getEntryPoint<void (*)(int32_t[],int32_t[],int32_t)>();
+
+    int32_t output[] = {0, 0, 0, 0};
+    int32_t input[] =  {1, 2, 3, 4};
+
+    entry_point(output,input,42);
+    EXPECT_EQ(1, output[0]);
+    EXPECT_EQ(2, output[1]);
+    EXPECT_EQ(42, output[2]);
+    EXPECT_EQ(4, output[3]);
+}
+
+TEST_F(VectorTest, VLongToDouble) {
+
+   auto inputTrees = "(method return= NoType args=[Address,Address]                   "
+                     "  (block                                                        "
+                     "     (vstorei type=VectorDouble offset=0                        "
+                     "         (aload parm=0)                                         "
+                     "            (vl2vd                                              "
+                     "                 (vloadi type=VectorInt64 (aload parm=1))))     "
+                     "     (return)))                                                 ";
+
+    auto trees = parseString(inputTrees);
+
+    ASSERT_NOTNULL(trees);
+    SKIP_ON_NON_X86(MissingImplementation) << "General vector opcodes are only implemented on x86";
+    SKIP_ON_X86(MissingImplementation) << "vl2vd is only implemented for 64-bit targets";
+
+    Tril::DefaultCompiler compiler(trees);
+    ASSERT_EQ(0, compiler.compile()) << "Compilation failed unexpectedly\n" << "Input trees: " << inputTrees;
+
+    auto entry_point = compiler.getEntryPoint<void (*)(double[],int64_t[])>();
+
+    double output[] = {0.0, 0.0};
+    int64_t input[] = {-3, 1LL << 40};
+
+    entry_point(output,input);
+    EXPECT_DOUBLE_EQ((double)input[0], output[0]);
+    EXPECT_DOUBLE_EQ((double)input[1], output[1]);
+}
@@ -0,0 +1,258 @@
+/*******************************************************************************
+ * Copyright (c) 2020, 2020 IBM Corp. and others
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at https://www.eclipse.org/legal/epl-2.0/
+ * or the Apache License, Version 2.0 which accompanies this distribution and
+ * is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following
+ * Secondary Licenses when the conditions for such availability set
+ * forth in the Eclipse Public License, v. 2.0 are satisfied: GNU
+ * General Public License, version 2 with the GNU Classpath
+ * Exception [1] and GNU General Public License, version 2 with the
+ * OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] http://openjdk.java.net/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
+ *******************************************************************************/
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <iostream>
+#include <vector>
+
+#include "env/RawAllocator.hpp"
+#include "env/SystemSegmentProvider.hpp"
+#include "infra/BitVector.hpp"
+#include "infra/BitVectorOperations.hpp"
+
+typedef TR::BitVectorOperations::Word Word;
+
+namespace {
+
+/**
+ * Runs a test body once with the vector instructions enabled, if the host
+ * supports them, and once with the scalar loops.
+ */
+class BitVectorTest : public ::testing::TestWithParam<bool> {
+    TR::RawAllocator _rawAllocator;
+    TR::SystemSegmentProvider _segmentProvider;
+    TR::Region _region;
+    bool _previous;
+
+public:
+    BitVectorTest() :
+        _rawAllocator(),
+        _segmentProvider(1 << 16, _rawAllocator),
+        _region(_segmentProvider, _rawAllocator) {
+    }
+
+    virtual void SetUp() {
+        _previous = TR::BitVectorOperations::enableVectorInstructions(GetParam());
+    }
+
+    virtual void TearDown() {
+        TR::BitVectorOperations::enableVectorInstructions(_previous);
+    }
+
+    TR::Region &region() { return _region; }
+};
+
+// A deterministic pseudo-random pattern of words with runs of zero words
+std::vector<Word> pattern(int32_t count, uint32_t seed) {
+    std::vector<Word> words(count);
+    uint64_t state = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+    for (int32_t i = 0; i < count; i++) {
+        state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+        words[i] = (state >> 33) % 4 == 0 ? 0 : (Word)(state >> 7);
+    }
+    return words;
+}
+
+void fill(TR_BitVector &bv, const std::vector<Word> &words) {
+    for (size_t i = 0; i < words.size(); i++)
+        for (int32_t bit = 0; bit < (int32_t)(8 * sizeof(Word)); bit++)
+            if ((words[i] >> bit) & 1)
+                bv.set(i * 8 * sizeof(Word) + bit);
+}
+
+}
+
+TEST_P(BitVectorTest, WordOperations) {
+    // Lengths below, at and above the threshold and with partial vectors
+    const int32_t lengths[] = { 0, 1, 3, 7, 8, 9, 31, 64, 67 };
+
+    for (size_t l = 0; l < sizeof(lengths) / sizeof(lengths[0]); l++) {
+        int32_t count = lengths[l];
+        std::vector<Word> a = pattern(count, 1), b = pattern(count, 2), c = pattern(count, 3);
+        std::vector<Word> expected(count), result(count);
+
+        bool expectedChanged = false;
+        for (int32_t i = 0; i < count; i++) {
+            expected[i] = a[i] | b[i];
+            expectedChanged |= expected[i] != a[i];
+        }
+        result = a;
+        EXPECT_EQ(expectedChanged, TR::BitVectorOperations::orWords(result.data(), result.data(), b.data(), count)) << "count " << count;
+        EXPECT_EQ(expected, result) << "count " << count;
+        EXPECT_FALSE(TR::BitVectorOperations::orWords(result.data(), result.data(), b.data(), count)) << "count " << count;
+
+        expectedChanged = false;
+        for (int32_t i = 0; i < count; i++) {
+            expected[i] = a[i] & b[i];
+            expectedChanged |= expected[i] != a[i];
+        }
+        EXPECT_EQ(expectedChanged, TR::BitVectorOperations::andWords(result.data(), a.data(), b.data(), count)) << "count " << count;
+        EXPECT_EQ(expected, result) << "count " << count;
+
+        for (int32_t i = 0; i < count; i++)
+            expected[i] = a[i] & ~b[i];
+        TR::BitVectorOperations::andNotWords(result.data(), a.data(), b.data(), count);
+        EXPECT_EQ(expected, result) << "count " << count;
+
+        for (int32_t i = 0; i < count; i++)
+            expected[i] = b[i] | (a[i] & ~c[i]);
+        result = a;
+        EXPECT_EQ(expected != a, TR::BitVectorOperations::transferWords(result.data(), result.data(), b.data(), c.data(), count)) << "count " << count;
+        EXPECT_EQ(expected, result) << "count " << count;
+        EXPECT_FALSE(TR::BitVectorOperations::transferWords(result.data(), a.data(), b.data(), c.data(), count)) << "count " << count;
+
+        result = a;
+        EXPECT_EQ(a != b, TR::BitVectorOperations::copyWords(result.data(), b.data(), count)) << "count " << count;
+        EXPECT_EQ(b, result) << "count " << count;
+        EXPECT_TRUE(TR::BitVectorOperations::equalWords(result.data(), b.data(), count)) << "count " << count;
+
+        if (count > 0) {
+            result[count - 1] ^= 1;
+            EXPECT_FALSE(TR::BitVectorOperations::equalWords(result.data(), b.data(), count)) << "count " << count;
+
+            std::vector<Word> disjoint(count);
+            for (int32_t i = 0; i < count; i++)
+                disjoint[i] = ~a[i];
+            EXPECT_FALSE(TR::BitVectorOperations::intersectWords(a.data(), disjoint.data(), count)) << "count " << count;
+            disjoint[count - 1] |= 1;
+            a[count - 1] |= 1;
+            EXPECT_TRUE(TR::BitVectorOperations::intersectWords(a.data(), disjoint.data(), count)) << "count " << count;
+        }
+    }
+}
+
+TEST_P(BitVectorTest, Transfer) {
+    const int32_t bits = 2048;
+    TR_BitVector in(bits, region(), notGrowable), gen(bits, region(), notGrowable), kill(bits, region(), notGrowable);
+    fill(in, pattern(bits / 64, 4));
+    gen.set(5);
+    gen.set(bits - 1);
+    kill.setAll(100, 1500);
+
+    TR_BitVector expected(bits, region(), notGrowable);
+    expected = in;
+    expected -= kill;
+    expected |= gen;
+
+    TR_BitVector out(bits, region(), notGrowable);
+    EXPECT_TRUE(out.transfer(in, &gen, &kill));
+    EXPECT_TRUE(out == expected);
+    EXPECT_FALSE(out.transfer(in, &gen, &kill));
+
+    // In place, with the kill set only
+    TR_BitVector inPlace(bits, region(), notGrowable);
+    inPlace = in;
+    inPlace.transfer(inPlace, NULL, &kill);
+    expected = in;
+    expected -= kill;
+    EXPECT_TRUE(inPlace == expected);
+
+    // An empty in set and a gen set that is larger than this vector
+    TR_BitVector small(64, region(), growable), empty(64, region(), notGrowable);
+    EXPECT_TRUE(small.transfer(empty, &gen, NULL));
+    EXPECT_TRUE(small == gen);
+
+    // Everything killed leaves an empty vector
+    TR_BitVector all(bits, region(), notGrowable);
+    all.setAll(bits);
+    out.transfer(in, NULL, &all);
+    EXPECT_TRUE(out.isEmpty());
+}
+
+TEST_P(BitVectorTest, AssignAndCheckForChange) {
+    const int32_t bits = 1024;
+    TR_BitVector a(bits, region(), notGrowable), b(bits, region(), notGrowable);
+    fill(a, pattern(bits / 64, 5));
+
+    EXPECT_TRUE(b.assignAndCheckForChange(a));
+    EXPECT_TRUE(b == a);
+    EXPECT_FALSE(b.assignAndCheckForChange(a));
+
+    a.set(bits / 2);
+    a.reset(bits / 2 + 1);
+    bool changed = !(b == a);
+    EXPECT_EQ(changed, b.assignAndCheckForChange(a));
+    EXPECT_TRUE(b == a);
+
+    a.empty();
+    EXPECT_TRUE(b.assignAndCheckForChange(a));
+    EXPECT_TRUE(b.isEmpty());
+    EXPECT_FALSE(b.assignAndCheckForChange(a));
+}
+
+INSTANTIATE_TEST_CASE_P(VectorAndScalar, BitVectorTest, ::testing::Values(true, false));
+
+/**
+ * Measures the transfer function of a gen/kill dataflow analysis over sets of
+ * 4096 bits, computed with separate operations on TR_BitVector as the solver
+ * used to and with the fused operation, and with and without vector
+ * instructions. The times are reported but not checked.
+ */
+TEST(BitVectorBenchmark, Transfer) {
+    TR::RawAllocator rawAllocator;
+    TR::SystemSegmentProvider segmentProvider(1 << 16, rawAllocator);
+    TR::Region region(segmentProvider, rawAllocator);
+
+    const int32_t bits = 4096;
+    const int32_t iterations = 20000;
+    TR_BitVector in(bits, region, notGrowable), gen(bits, region, notGrowable), kill(bits, region, notGrowable);
+    TR_BitVector out(bits, region, notGrowable), previous(bits, region, notGrowable);
+    fill(in, pattern(bits / 64, 6));
+    fill(gen, pattern(bits / 64, 7));
+    fill(kill, pattern(bits / 64, 8));
+
+    bool previousSetting = TR::BitVectorOperations::vectorInstructionsEnabled();
+    for (int vector = 1; vector >= 0; vector--) {
+        TR::BitVectorOperations::enableVectorInstructions(vector != 0);
+        const char *mode = TR::BitVectorOperations::vectorInstructionsEnabled() ? "vector" : "scalar";
+
+        int32_t changes = 0;
+        previous.empty();
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        for (int32_t i = 0; i < iterations; i++) {
+            out = in;
+            out -= kill;
+            out |= gen;
+            if (!(out == previous))
+                changes++;
+            previous = out;
+        }
+        std::chrono::steady_clock::duration separate = std::chrono::steady_clock::now() - start;
+
+        previous.empty();
+        start = std::chrono::steady_clock::now();
+        for (int32_t i = 0; i < iterations; i++) {
+            out.transfer(in, &gen, &kill);
+            if (previous.assignAndCheckForChange(out))
+                changes--;
+        }
+        std::chrono::steady_clock::duration fused = std::chrono::steady_clock::now() - start;
+
+        EXPECT_EQ(0, changes);
+        std::cout << "[ BENCHMARK] " << mode << " transfer of " << bits << " bits: separate operations "
+                  << std::chrono::duration_cast<std::chrono::nanoseconds>(separate).count() / iterations << " ns, fused "
+                  << std::chrono::duration_cast<std::chrono::nanoseconds>(fused).count() / iterations << " ns" << std::endl;
+    }
+    TR::BitVectorOperations::enableVectorInstructions(previousSetting);
+}
@@ -0,0 +1,142 @@
+/*******************************************************************************
+ * Copyright (c) 2020, 2020 IBM Corp. and others
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at https://www.eclipse.org/legal/epl-2.0/
+ * or the Apache License, Version 2.0 which accompanies this distribution and
+ * is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following
+ * Secondary Licenses when the conditions for such availability set
+ * forth in the Eclipse Public License, v. 2.0 are satisfied: GNU
+ * General Public License, version 2 with the GNU Classpath
+ * Exception [1] and GNU General Public License, version 2 with the
+ * OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] http://openjdk.java.net/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
+ *******************************************************************************/
+
+#include <gtest/gtest.h>
+
+#include <string.h>
+#include <vector>
+
+#include "env/RawAllocator.hpp"
+#include "env/Region.hpp"
+#include "env/SegmentCache.hpp"
+#include "env/SystemSegmentProvider.hpp"
+
+static const size_t MIN_SIZE = TR::SegmentCache::MIN_SEGMENT_SIZE;
+
+TEST(SegmentCacheTest, SegmentSize) {
+    EXPECT_EQ(MIN_SIZE, TR::SegmentCache::segmentSize(1));
+    EXPECT_EQ(MIN_SIZE, TR::SegmentCache::segmentSize(MIN_SIZE));
+    EXPECT_EQ(2 * MIN_SIZE, TR::SegmentCache::segmentSize(MIN_SIZE + 1));
+    EXPECT_EQ(4 * MIN_SIZE, TR::SegmentCache::segmentSize(3 * MIN_SIZE));
+    EXPECT_EQ(TR::SegmentCache::MAX_SEGMENT_SIZE, TR::SegmentCache::segmentSize(TR::SegmentCache::MAX_SEGMENT_SIZE));
+
+    // Segments too large to cache are only rounded to the smallest size
+    EXPECT_EQ(TR::SegmentCache::MAX_SEGMENT_SIZE + MIN_SIZE, TR::SegmentCache::segmentSize(TR::SegmentCache::MAX_SEGMENT_SIZE + 1));
+}
+
+TEST(SegmentCacheTest, ReusesIdleSegments) {
+    TR::SegmentCache cache(TR::SegmentCache::DEFAULT_RETAINED_BYTES);
+
+    void *small = cache.allocate(MIN_SIZE);
+    void *large = cache.allocate(4 * MIN_SIZE);
+    memset(small, 1, MIN_SIZE);
+    memset(large, 2, 4 * MIN_SIZE);
+    cache.deallocate(small, MIN_SIZE);
+    cache.deallocate(large, 4 * MIN_SIZE);
+    EXPECT_EQ(5 * MIN_SIZE, cache.statistics()._retainedBytes);
+    EXPECT_EQ(5 * MIN_SIZE, cache.statistics()._residentBytes);
+
+    EXPECT_EQ(large, cache.allocate(4 * MIN_SIZE));
+    EXPECT_EQ(small, cache.allocate(MIN_SIZE));
+    EXPECT_EQ(4u, cache.statistics()._requests);
+    EXPECT_EQ(2u, cache.statistics()._hits);
+    EXPECT_EQ(2u, cache.statistics()._systemAllocations);
+    EXPECT_EQ(0u, cache.statistics()._retainedBytes);
+
+    // Segments too large to cache go straight back to the system
+    size_t hugeSize = TR::SegmentCache::segmentSize(TR::SegmentCache::MAX_SEGMENT_SIZE + 1);
+    void *huge = cache.allocate(hugeSize);
+    cache.deallocate(huge, hugeSize);
+    EXPECT_EQ(1u, cache.statistics()._systemReleases);
+
+    cache.deallocate(small, MIN_SIZE);
+    cache.deallocate(large, 4 * MIN_SIZE);
+}
+
+TEST(SegmentCacheTest, Bounds) {
+    const int32_t count = TR::SegmentCache::MAX_IDLE_SEGMENTS + 4;
+    std::vector<void *> segments;
+
+    // At most MAX_IDLE_SEGMENTS segments of a size
+    TR::SegmentCache cache(TR::SegmentCache::DEFAULT_RETAINED_BYTES);
+    for (int32_t i = 0; i < count; i++)
+        segments.push_back(cache.allocate(MIN_SIZE));
+    for (int32_t i = 0; i < count; i++)
+        cache.deallocate(segments[i], MIN_SIZE);
+    EXPECT_EQ(TR::SegmentCache::MAX_IDLE_SEGMENTS * MIN_SIZE, cache.statistics()._retainedBytes);
+    EXPECT_EQ(4u, cache.statistics()._systemReleases);
+
+    // At most the retention limit in all
+    segments.clear();
+    TR::SegmentCache limited(4 * MIN_SIZE);
+    for (int32_t i = 0; i < 8; i++)
+        segments.push_back(limited.allocate(MIN_SIZE));
+    for (int32_t i = 0; i < 8; i++)
+        limited.deallocate(segments[i], MIN_SIZE);
+    EXPECT_EQ(4 * MIN_SIZE, limited.statistics()._retainedBytes);
+    EXPECT_EQ(4 * MIN_SIZE, limited.statistics()._maxRetainedBytes);
+}
+
+TEST(SegmentCacheTest, TrimsToRecentHighWaterMark) {
+    TR::SegmentCache cache(TR::SegmentCache::DEFAULT_RETAINED_BYTES);
+    std::vector<void *> segments;
+
+    // A large compilation followed by small ones
+    for (int32_t i = 0; i < 8; i++)
+        segments.push_back(cache.allocate(2 * MIN_SIZE));
+    for (int32_t i = 0; i < 8; i++)
+        cache.deallocate(segments[i], 2 * MIN_SIZE);
+    cache.compilationEnded();
+    EXPECT_EQ(16 * MIN_SIZE, cache.statistics()._retainedBytes);
+    EXPECT_EQ(0u, cache.statistics()._residentBytes);
+
+    size_t previousRetainedBytes = cache.statistics()._retainedBytes;
+    for (int32_t compilation = 0; compilation < 16; compilation++) {
+        void *segment = cache.allocate(MIN_SIZE);
+        memset(segment, 3, MIN_SIZE);
+        cache.deallocate(segment, MIN_SIZE);
+        cache.compilationEnded();
+        EXPECT_LE(cache.statistics()._retainedBytes, previousRetainedBytes);
+        previousRetainedBytes = cache.statistics()._retainedBytes;
+    }
+    EXPECT_EQ(MIN_SIZE, cache.statistics()._retainedBytes);
+    EXPECT_EQ(0u, cache.statistics()._residentBytes);
+}
+
+TEST(SegmentCacheTest, SystemSegmentProvider) {
+    TR::RawAllocator rawAllocator;
+    TR::SegmentCache cache(TR::SegmentCache::DEFAULT_RETAINED_BYTES);
+
+    for (int32_t compilation = 0; compilation < 4; compilation++) {
+        TR::SystemSegmentProvider segmentProvider(1 << 16, rawAllocator, &cache);
+        TR::Region region(segmentProvider, rawAllocator);
+        for (int32_t i = 0; i < 64; i++)
+            memset(region.allocate(4096), i, 4096);
+        memset(region.allocate(3 * MIN_SIZE), 0, 3 * MIN_SIZE);
+    }
+
+    // Every compilation after the first reuses the segments of the one before
+    const TR::SegmentCache::Statistics &statistics = cache.statistics();
+    EXPECT_EQ(statistics._requests / 4, statistics._systemAllocations);
+    EXPECT_EQ(statistics._requests - statistics._systemAllocations, statistics._hits);
+    EXPECT_EQ(0u, statistics._systemReleases);
+}
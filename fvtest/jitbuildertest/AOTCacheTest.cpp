@@ -0,0 +1,221 @@
+/*******************************************************************************
+ * Copyright (c) 2020, 2020 IBM Corp. and others
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at https://www.eclipse.org/legal/epl-2.0/
+ * or the Apache License, Version 2.0 which accompanies this distribution and
+ * is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following
+ * Secondary Licenses when the conditions for such availability set
+ * forth in the Eclipse Public License, v. 2.0 are satisfied: GNU
+ * General Public License, version 2 with the GNU Classpath
+ * Exception [1] and GNU General Public License, version 2 with the
+ * OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] http://openjdk.java.net/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
+ *******************************************************************************/
+
+#include "JBTestUtil.hpp"
+
+#include <chrono>
+#include <stdio.h>
+#include <string>
+
+/*
+ * Methods compiled while an AOT cache is open are written to the cache file
+ * when it is closed. The tests reopen the file and build the same methods
+ * again, which binds them to the persisted code instead of compiling them.
+ */
+
+static int32_t
+aotCalleeAddOne(int32_t value)
+   {
+   return value + 1;
+   }
+
+static int32_t
+aotCalleeAddTwo(int32_t value)
+   {
+   return value + 2;
+   }
+
+// the function the persisted method calls is redefined between runs
+static void *aotCalleeEntry = (void *)&aotCalleeAddOne;
+
+DEFINE_BUILDER(TestAOTSumOfSquares,
+               Int64,
+               PARAM("count", Int32))
+   {
+   Store("sum",
+      ConstInt64(0));
+
+   OMR::JitBuilder::IlBuilder *loop = NULL;
+   ForLoopUp("i", &loop, ConstInt32(0), Load("count"), ConstInt32(1));
+
+   loop->Store("square",
+   loop->   ConvertTo(Int64,
+   loop->      Mul(
+   loop->         Load("i"),
+   loop->         Load("i"))));
+   loop->Store("sum",
+   loop->   Add(
+   loop->      Load("sum"),
+   loop->      Load("square")));
+
+   Return(
+      Load("sum"));
+   return true;
+   }
+
+DEFINE_BUILDER(TestAOTCall,
+               Int32,
+               PARAM("value", Int32))
+   {
+   DefineFunction((char *)"aotCallee",
+                  (char *)__FILE__,
+                  (char *)LINETOSTR(__LINE__),
+                  aotCalleeEntry,
+                  Int32,
+                  1,
+                  Int32);
+
+   Return(
+      Mul(
+         Call("aotCallee", 1, Load("value")),
+         ConstInt32(10)));
+   return true;
+   }
+
+class AOTCacheTest : public ::testing::Test
+   {
+   public:
+
+   static void SetUpTestCase()
+      {
+      ASSERT_TRUE(initializeJit()) << "Failed to initialize the JIT.";
+      }
+
+   static void TearDownTestCase()
+      {
+      shutdownJit();
+      }
+
+   virtual void SetUp()
+      {
+      const ::testing::TestInfo *testInfo = ::testing::UnitTest::GetInstance()->current_test_info();
+      _fileName = std::string(testInfo->test_case_name()) + "_" + testInfo->name() + ".aot";
+      remove(_fileName.c_str());
+      }
+
+   virtual void TearDown()
+      {
+      closeAOTCache();
+      remove(_fileName.c_str());
+      aotCalleeEntry = (void *)&aotCalleeAddOne;
+      }
+
+   protected:
+
+   std::string _fileName;
+   };
+
+typedef int64_t (*AOTSumOfSquaresFunction)(int32_t);
+TEST_F(AOTCacheTest, ReloadMethod)
+   {
+   ASSERT_TRUE(openAOTCache(_fileName.c_str()));
+
+   AOTSumOfSquaresFunction compiledFunction;
+   ASSERT_COMPILE(OMR::JitBuilder::TypeDictionary, TestAOTSumOfSquares, compiledFunction);
+   ASSERT_EQ(0, getAOTCacheLoadCount());
+   ASSERT_EQ(285, compiledFunction(10));
+
+   ASSERT_TRUE(closeAOTCache());
+   ASSERT_TRUE(openAOTCache(_fileName.c_str()));
+
+   AOTSumOfSquaresFunction loadedFunction;
+   ASSERT_COMPILE(OMR::JitBuilder::TypeDictionary, TestAOTSumOfSquares, loadedFunction);
+   ASSERT_EQ(1, getAOTCacheLoadCount());
+   ASSERT_NE((void *)compiledFunction, (void *)loadedFunction);
+   ASSERT_EQ(0, loadedFunction(0));
+   ASSERT_EQ(285, loadedFunction(10));
+   ASSERT_EQ(328350, loadedFunction(100));
+   }
+
+typedef int32_t (*AOTCallFunction)(int32_t);
+TEST_F(AOTCacheTest, RebindCalledFunction)
+   {
+   ASSERT_TRUE(openAOTCache(_fileName.c_str()));
+
+   AOTCallFunction compiledFunction;
+   ASSERT_COMPILE(OMR::JitBuilder::TypeDictionary, TestAOTCall, compiledFunction);
+   ASSERT_EQ(0, getAOTCacheLoadCount());
+   ASSERT_EQ(50, compiledFunction(4));
+
+   ASSERT_TRUE(closeAOTCache());
+   ASSERT_TRUE(openAOTCache(_fileName.c_str()));
+
+   aotCalleeEntry = (void *)&aotCalleeAddTwo;
+   AOTCallFunction loadedFunction;
+   ASSERT_COMPILE(OMR::JitBuilder::TypeDictionary, TestAOTCall, loadedFunction);
+   ASSERT_EQ(1, getAOTCacheLoadCount());
+   ASSERT_EQ(60, loadedFunction(4));
+   ASSERT_EQ(20, compiledFunction(1));
+   }
+
+TEST_F(AOTCacheTest, IgnoreDamagedFile)
+   {
+   FILE *file = fopen(_fileName.c_str(), "wb");
+   ASSERT_TRUE(file != NULL);
+   fputs("not an AOT cache", file);
+   fclose(file);
+
+   ASSERT_TRUE(openAOTCache(_fileName.c_str()));
+
+   AOTSumOfSquaresFunction testFunction;
+   ASSERT_COMPILE(OMR::JitBuilder::TypeDictionary, TestAOTSumOfSquares, testFunction);
+   ASSERT_EQ(0, getAOTCacheLoadCount());
+   ASSERT_EQ(285, testFunction(10));
+   }
+
+/*
+ * Not a correctness test: reports how long building a set of methods takes
+ * with a cold cache, when every method is compiled, and with a warm one,
+ * when every method is loaded from the cache file.
+ */
+TEST_F(AOTCacheTest, ColdAndWarmStartup)
+   {
+   const int32_t numMethods = 20;
+   typedef std::chrono::steady_clock Clock;
+
+   ASSERT_TRUE(openAOTCache(_fileName.c_str()));
+   Clock::time_point coldStart = Clock::now();
+   for (int32_t m = 0; m < numMethods; m++)
+      {
+      AOTSumOfSquaresFunction testFunction;
+      ASSERT_COMPILE(OMR::JitBuilder::TypeDictionary, TestAOTSumOfSquares, testFunction);
+      ASSERT_EQ(285, testFunction(10));
+      }
+   Clock::duration coldTime = Clock::now() - coldStart;
+   ASSERT_TRUE(closeAOTCache());
+
+   ASSERT_TRUE(openAOTCache(_fileName.c_str()));
+   Clock::time_point warmStart = Clock::now();
+   for (int32_t m = 0; m < numMethods; m++)
+      {
+      AOTSumOfSquaresFunction testFunction;
+      ASSERT_COMPILE(OMR::JitBuilder::TypeDictionary, TestAOTSumOfSquares, testFunction);
+      ASSERT_EQ(285, testFunction(10));
+      }
+   Clock::duration warmTime = Clock::now() - warmStart;
+   ASSERT_EQ(numMethods, getAOTCacheLoadCount());
+
+   printf("AOT cache: %d methods built in %lld us cold, %lld us warm\n",
+          numMethods,
+          (long long)std::chrono::duration_cast<std::chrono::microseconds>(coldTime).count(),
+          (long long)std::chrono::duration_cast<std::chrono::microseconds>(warmTime).count());
+   }
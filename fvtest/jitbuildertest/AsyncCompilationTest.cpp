@@ -0,0 +1,161 @@
+/*******************************************************************************
+ * Copyright (c) 2020, 2020 IBM Corp. and others
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at https://www.eclipse.org/legal/epl-2.0/
+ * or the Apache License, Version 2.0 which accompanies this distribution and
+ * is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following
+ * Secondary Licenses when the conditions for such availability set
+ * forth in the Eclipse Public License, v. 2.0 are satisfied: GNU
+ * General Public License, version 2 with the GNU Classpath
+ * Exception [1] and GNU General Public License, version 2 with the
+ * OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] http://openjdk.java.net/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
+ *******************************************************************************/
+
+#include "JBTestUtil.hpp"
+
+#include <atomic>
+#include <thread>
+
+class ReturnConstantBuilder : public OMR::JitBuilder::MethodBuilder
+   {
+   public:
+   ReturnConstantBuilder(OMR::JitBuilder::TypeDictionary *types, int32_t value, std::atomic<bool> *gate = NULL)
+      : OMR::JitBuilder::MethodBuilder(types),
+        _value(value),
+        _gate(gate)
+      {
+      DefineLine(LINETOSTR(__LINE__));
+      DefineFile(__FILE__);
+      DefineName("returnConstant");
+      DefineReturnType(Int32);
+      }
+
+   virtual bool buildIL()
+      {
+      // Hold the compilation thread here until the test opens the gate
+      while (_gate != NULL && !_gate->load())
+         std::this_thread::yield();
+
+      Return(ConstInt32(_value));
+      return true;
+      }
+
+   private:
+   int32_t _value;
+   std::atomic<bool> *_gate;
+   };
+
+typedef int32_t (*ReturnConstantFunction)();
+
+struct CallbackRecord
+   {
+   CallbackRecord() : _numCalls(0), _numCompleted(0) {}
+
+   std::atomic<int32_t> _numCalls;
+   std::atomic<int32_t> _numCompleted;
+   int32_t _values[8];
+   };
+
+static void
+recordCompletion(void *userData, int32_t returnCode, void *entryPoint)
+   {
+   CallbackRecord *record = static_cast<CallbackRecord *>(userData);
+   int32_t index = record->_numCalls++;
+   record->_values[index] = returnCode == 0 ? ((ReturnConstantFunction)entryPoint)() : -1;
+   record->_numCompleted++;
+   }
+
+class AsyncCompilationTest : public JitBuilderTest {};
+
+TEST_F(AsyncCompilationTest, CompileAndWait)
+   {
+   ASSERT_TRUE(startCompilationThreads(2));
+
+   OMR::JitBuilder::TypeDictionary types;
+   ReturnConstantBuilder builder0(&types, 0), builder1(&types, 1), builder2(&types, 2), builder3(&types, 3);
+   ReturnConstantBuilder *builders[] = { &builder0, &builder1, &builder2, &builder3 };
+
+   void *requests[4];
+   for (int32_t i = 0; i < 4; i++)
+      {
+      requests[i] = compileMethodBuilderAsync(builders[i], 0);
+      ASSERT_TRUE(requests[i] != NULL);
+      }
+
+   for (int32_t i = 0; i < 4; i++)
+      {
+      void *entry = NULL;
+      ASSERT_EQ(0, waitForCompilation(requests[i], &entry));
+      ASSERT_EQ(i, ((ReturnConstantFunction)entry)());
+      }
+
+   ASSERT_EQ(0, getCompilationQueueDepth());
+   ASSERT_LE(0, getAverageCompilationLatency());
+   ASSERT_LE(getAverageCompilationLatency(), getMaxCompilationLatency());
+   }
+
+TEST_F(AsyncCompilationTest, PollForCompletion)
+   {
+   std::atomic<bool> gate(false);
+   OMR::JitBuilder::TypeDictionary types;
+   ReturnConstantBuilder builder(&types, 42, &gate);
+
+   void *request = compileMethodBuilderAsync(&builder, 0);
+   ASSERT_TRUE(request != NULL);
+   ASSERT_FALSE(isCompilationComplete(request));
+
+   gate = true;
+   while (!isCompilationComplete(request))
+      std::this_thread::yield();
+
+   void *entry = NULL;
+   ASSERT_EQ(0, waitForCompilation(request, &entry));
+   ASSERT_EQ(42, ((ReturnConstantFunction)entry)());
+   }
+
+// A separate test case so that the JIT, and with it the compilation thread
+// pool, is initialized afresh
+class AsyncCompilationPriorityTest : public JitBuilderTest {};
+
+TEST_F(AsyncCompilationPriorityTest, HigherPriorityCompiledFirst)
+   {
+   std::atomic<bool> gate(false);
+   OMR::JitBuilder::TypeDictionary types;
+   ReturnConstantBuilder blocker(&types, 100, &gate);
+   ReturnConstantBuilder low(&types, 1), high(&types, 3), lowLater(&types, 2), highest(&types, 4);
+
+   // A single compilation thread, held in the blocker's buildIL while the
+   // remaining requests pile up in the queue
+   CallbackRecord record;
+   ASSERT_TRUE(compileMethodBuilderWithCallback(&blocker, 0, (void *)recordCompletion, &record));
+   while (getCompilationQueueDepth() != 0)
+      std::this_thread::yield();
+
+   ASSERT_TRUE(compileMethodBuilderWithCallback(&low, 1, (void *)recordCompletion, &record));
+   ASSERT_TRUE(compileMethodBuilderWithCallback(&high, 5, (void *)recordCompletion, &record));
+   ASSERT_TRUE(compileMethodBuilderWithCallback(&lowLater, 1, (void *)recordCompletion, &record));
+   ASSERT_TRUE(compileMethodBuilderWithCallback(&highest, 10, (void *)recordCompletion, &record));
+
+   while (getCompilationQueueDepth() != 4)
+      std::this_thread::yield();
+   ASSERT_LE(4, getMaxCompilationQueueDepth());
+
+   gate = true;
+   while (record._numCompleted != 5)
+      std::this_thread::yield();
+
+   ASSERT_EQ(100, record._values[0]);
+   ASSERT_EQ(4, record._values[1]);
+   ASSERT_EQ(3, record._values[2]);
+   ASSERT_EQ(1, record._values[3]);
+   ASSERT_EQ(2, record._values[4]);
+   }
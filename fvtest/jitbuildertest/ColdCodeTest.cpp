@@ -0,0 +1,111 @@
+/*******************************************************************************
+ * Copyright (c) 2020, 2020 IBM Corp. and others
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at https://www.eclipse.org/legal/epl-2.0/
+ * or the Apache License, Version 2.0 which accompanies this distribution and
+ * is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following
+ * Secondary Licenses when the conditions for such availability set
+ * forth in the Eclipse Public License, v. 2.0 are satisfied: GNU
+ * General Public License, version 2 with the GNU Classpath
+ * Exception [1] and GNU General Public License, version 2 with the
+ * OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] http://openjdk.java.net/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
+ *******************************************************************************/
+
+#include "JBTestUtil.hpp"
+
+#include <limits>
+#include <math.h>
+
+/*
+ * Floating point to integer conversions handle NaN and out of range values
+ * on an outlined path. The tests compile them with outlined paths placed in
+ * the cold code cache region, so the branches to and from the slow path and
+ * its constant operands all cross regions.
+ */
+
+DEFINE_BUILDER(TestColdDoubleToInt32,
+               Int32,
+               PARAM("value", Double))
+   {
+   Return(
+      ConvertTo(Int32,
+         Load("value")));
+   return true;
+   }
+
+DEFINE_BUILDER(TestColdScaledFloatToInt64,
+               Int64,
+               PARAM("value", Float),
+               PARAM("count", Int32))
+   {
+   Store("sum",
+      ConstInt64(0));
+
+   OMR::JitBuilder::IlBuilder *loop = NULL;
+   ForLoopUp("i", &loop, ConstInt32(0), Load("count"), ConstInt32(1));
+
+   loop->Store("sum",
+   loop->   Add(
+   loop->      Load("sum"),
+   loop->      ConvertTo(Int64,
+   loop->         Load("value"))));
+
+   Return(
+      Load("sum"));
+   return true;
+   }
+
+class ColdCodeTest : public ::testing::Test
+   {
+   public:
+
+   static void SetUpTestCase()
+      {
+      ASSERT_TRUE(initializeJitWithOptions((char *)"-Xjit:acceptHugeMethods,enableBasicBlockHoisting,omitFramePointer,useILValidator,splitWarmAndColdBlocks"))
+         << "Failed to initialize the JIT.";
+      }
+
+   static void TearDownTestCase()
+      {
+      shutdownJit();
+      }
+   };
+
+typedef int32_t (*ColdDoubleToInt32Function)(double);
+TEST_F(ColdCodeTest, DoubleToInt32)
+   {
+   ColdDoubleToInt32Function testFunction;
+   ASSERT_COMPILE(OMR::JitBuilder::TypeDictionary, TestColdDoubleToInt32, testFunction);
+
+   ASSERT_EQ(3, testFunction(3.75));
+   ASSERT_EQ(-12, testFunction(-12.5));
+   ASSERT_EQ(std::numeric_limits<int32_t>::max(), testFunction(1.0e12));
+   ASSERT_EQ(std::numeric_limits<int32_t>::min(), testFunction(-1.0e12));
+   ASSERT_EQ(std::numeric_limits<int32_t>::max(), testFunction(std::numeric_limits<double>::infinity()));
+   ASSERT_EQ(0, testFunction(std::numeric_limits<double>::quiet_NaN()));
+   ASSERT_EQ(42, testFunction(42.0));
+   }
+
+typedef int64_t (*ColdScaledFloatToInt64Function)(float, int32_t);
+TEST_F(ColdCodeTest, ScaledFloatToInt64)
+   {
+   ColdScaledFloatToInt64Function testFunction;
+   ASSERT_COMPILE(OMR::JitBuilder::TypeDictionary, TestColdScaledFloatToInt64, testFunction);
+
+   ASSERT_EQ(0, testFunction(2.5f, 0));
+   ASSERT_EQ(20, testFunction(2.5f, 10));
+   ASSERT_EQ(-30, testFunction(-3.9f, 10));
+   ASSERT_EQ(0, testFunction(std::numeric_limits<float>::quiet_NaN(), 5));
+   ASSERT_EQ(std::numeric_limits<int64_t>::max(), testFunction(1.0e30f, 1));
+   ASSERT_EQ(std::numeric_limits<int64_t>::min(), testFunction(-1.0e30f, 1));
+   ASSERT_EQ(7, testFunction(7.0f, 1));
+   }
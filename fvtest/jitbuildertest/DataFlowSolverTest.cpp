@@ -0,0 +1,201 @@
+/*******************************************************************************
+ * Copyright (c) 2020, 2020 IBM Corp. and others
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at https://www.eclipse.org/legal/epl-2.0/
+ * or the Apache License, Version 2.0 which accompanies this distribution and
+ * is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following
+ * Secondary Licenses when the conditions for such availability set
+ * forth in the Eclipse Public License, v. 2.0 are satisfied: GNU
+ * General Public License, version 2 with the GNU Classpath
+ * Exception [1] and GNU General Public License, version 2 with the
+ * OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] http://openjdk.java.net/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
+ *******************************************************************************/
+
+#include "JBTestUtil.hpp"
+
+/*
+ * Methods whose locals are live and defined across irreducible and nested
+ * loops, compiled with the bit vector analyses solved over the structure, over
+ * the CFG, and over the CFG only where the structure has improper regions.
+ */
+
+DEFINE_BUILDER(TestIrreducibleLoop,
+               Int32,
+               PARAM("n", Int32),
+               PARAM("start", Int32))
+   {
+   Store("count",
+      ConstInt32(0));
+   Store("sum",
+      ConstInt32(0));
+   Store("bias",
+      Load("start"));
+
+   // The cycle through first and second is entered at both, so it has no
+   // single loop header
+   OMR::JitBuilder::IlBuilder *first = OrphanBuilder();
+   OMR::JitBuilder::IlBuilder *second = OrphanBuilder();
+   IfCmpNotEqualZero(second,
+      Load("start"));
+
+   AppendBuilder(first);
+   first->Store("sum",
+   first->   Add(
+   first->      Load("sum"),
+   first->      Load("count")));
+   first->Store("count",
+   first->   Add(
+   first->      Load("count"),
+   first->      ConstInt32(1)));
+
+   AppendBuilder(second);
+   second->Store("sum",
+   second->   Add(
+   second->      Load("sum"),
+   second->      Add(
+   second->         Mul(
+   second->            Load("count"),
+   second->            ConstInt32(2)),
+   second->         Load("bias"))));
+   second->IfCmpLessThan(first,
+   second->   Load("count"),
+   second->   Load("n"));
+
+   Return(
+      Load("sum"));
+   return true;
+   }
+
+static int32_t
+irreducibleLoop(int32_t n, int32_t start)
+   {
+   int32_t count = 0;
+   int32_t sum = 0;
+   int32_t bias = start;
+   if (start != 0)
+      goto second;
+first:
+   sum += count;
+   count += 1;
+second:
+   sum += count * 2 + bias;
+   if (count < n)
+      goto first;
+   return sum;
+   }
+
+DEFINE_BUILDER(TestNestedLoops,
+               Int32,
+               PARAM("n", Int32))
+   {
+   Store("total",
+      ConstInt32(0));
+   Store("last",
+      ConstInt32(-1));
+
+   OMR::JitBuilder::IlBuilder *outer = NULL;
+   ForLoopUp("i", &outer, ConstInt32(0), Load("n"), ConstInt32(1));
+
+   // last is only changed on some iterations of the inner loop, so its
+   // definitions reach the outer loop along the back edges of both loops
+   OMR::JitBuilder::IlBuilder *inner = NULL;
+   outer->ForLoopUp("j", &inner,
+   outer->   Load("i"),
+   outer->   Load("n"),
+   outer->   ConstInt32(1));
+
+   OMR::JitBuilder::IlBuilder *odd = NULL;
+   inner->IfThen(&odd,
+   inner->   NotEqualTo(
+   inner->      And(
+   inner->         Add(
+   inner->            Load("i"),
+   inner->            Load("j")),
+   inner->         ConstInt32(1)),
+   inner->      ConstInt32(0)));
+   odd->Store("last",
+   odd->   Load("j"));
+   inner->Store("total",
+   inner->   Add(
+   inner->      Load("total"),
+   inner->      Load("last")));
+
+   Return(
+      Add(
+         Mul(
+            Load("total"),
+            ConstInt32(10)),
+         Load("last")));
+   return true;
+   }
+
+static int32_t
+nestedLoops(int32_t n)
+   {
+   int32_t total = 0;
+   int32_t last = -1;
+   for (int32_t i = 0; i < n; i++)
+      {
+      for (int32_t j = i; j < n; j++)
+         {
+         if (((i + j) & 1) != 0)
+            last = j;
+         total += last;
+         }
+      }
+   return total * 10 + last;
+   }
+
+class DataFlowSolverTest : public ::testing::TestWithParam<const char *>
+   {
+   public:
+
+   virtual void SetUp()
+      {
+      ASSERT_TRUE(initializeJitWithOptions((char *)GetParam())) << "Failed to initialize the JIT.";
+      }
+
+   virtual void TearDown()
+      {
+      shutdownJit();
+      }
+   };
+
+typedef int32_t (*IrreducibleLoopFunction)(int32_t, int32_t);
+TEST_P(DataFlowSolverTest, IrreducibleLoop)
+   {
+   IrreducibleLoopFunction testFunction;
+   ASSERT_COMPILE(OMR::JitBuilder::TypeDictionary, TestIrreducibleLoop, testFunction);
+
+   for (int32_t n = 0; n < 5; n++)
+      {
+      ASSERT_EQ(irreducibleLoop(n, 0), testFunction(n, 0)) << "n " << n;
+      ASSERT_EQ(irreducibleLoop(n, 3), testFunction(n, 3)) << "n " << n;
+      }
+   ASSERT_EQ(irreducibleLoop(100, -7), testFunction(100, -7));
+   }
+
+typedef int32_t (*NestedLoopsFunction)(int32_t);
+TEST_P(DataFlowSolverTest, NestedLoops)
+   {
+   NestedLoopsFunction testFunction;
+   ASSERT_COMPILE(OMR::JitBuilder::TypeDictionary, TestNestedLoops, testFunction);
+
+   for (int32_t n = 0; n < 6; n++)
+      ASSERT_EQ(nestedLoops(n), testFunction(n)) << "n " << n;
+   ASSERT_EQ(nestedLoops(50), testFunction(50));
+   }
+
+INSTANTIATE_TEST_CASE_P(SolverSelection, DataFlowSolverTest, ::testing::Values(
+   "-Xjit:acceptHugeMethods,enableBasicBlockHoisting,omitFramePointer,useILValidator",
+   "-Xjit:acceptHugeMethods,enableBasicBlockHoisting,omitFramePointer,useILValidator,enableCFGDataFlowSolver",
+   "-Xjit:acceptHugeMethods,enableBasicBlockHoisting,omitFramePointer,useILValidator,disableCFGDataFlowSolver"));
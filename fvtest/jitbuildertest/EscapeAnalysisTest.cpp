@@ -0,0 +1,325 @@
+/*******************************************************************************
+ * Copyright (c) 2020, 2020 IBM Corp. and others
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at https://www.eclipse.org/legal/epl-2.0/
+ * or the Apache License, Version 2.0 which accompanies this distribution and
+ * is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following
+ * Secondary Licenses when the conditions for such availability set
+ * forth in the Eclipse Public License, v. 2.0 are satisfied: GNU
+ * General Public License, version 2 with the GNU Classpath
+ * Exception [1] and GNU General Public License, version 2 with the
+ * OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] http://openjdk.java.net/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
+ *******************************************************************************/
+
+#include "JBTestUtil.hpp"
+
+#include <stdlib.h>
+
+/*
+ * Methods that allocate objects through a function declared with
+ * DefineAllocator. The allocator counts the objects it allocates, so that the
+ * tests can tell which objects escape analysis kept off the heap.
+ */
+
+struct Point
+   {
+   int32_t x;
+   int32_t y;
+   };
+
+struct ListNode
+   {
+   int64_t value;
+   ListNode *next;
+   };
+
+static int32_t allocations = 0;
+
+static void *
+allocate(int32_t size)
+   {
+   #define ALLOCATE_LINE LINETOSTR(__LINE__)
+   allocations++;
+   return calloc(1, size);
+   }
+
+static int32_t
+consume(Point *p)
+   {
+   #define CONSUME_LINE LINETOSTR(__LINE__)
+   int32_t result = p->x - p->y;
+   free(p);
+   return result;
+   }
+
+#define DEFINE_ALLOCATOR() \
+   DefineFunction("allocate", __FILE__, ALLOCATE_LINE, (void *)&allocate, Address, 1, Int32); \
+   DefineAllocator("allocate", 0)
+
+DEFINE_TYPES(PointTypes)
+   {
+   DEFINE_STRUCT(Point);
+   DEFINE_FIELD(Point, x, toIlType<int32_t>());
+   DEFINE_FIELD(Point, y, toIlType<int32_t>());
+   CLOSE_STRUCT(Point);
+
+   DEFINE_STRUCT(ListNode);
+   DEFINE_FIELD(ListNode, value, toIlType<int64_t>());
+   DEFINE_FIELD(ListNode, next, toIlType<void *>());
+   CLOSE_STRUCT(ListNode);
+   }
+
+// The fields of p are replaced by locals
+DEFINE_BUILDER(TestScalarReplacement,
+               Int32,
+               PARAM("a", Int32),
+               PARAM("b", Int32))
+   {
+   DEFINE_ALLOCATOR();
+
+   Store("p",
+      Call("allocate", 1,
+         ConstInt32(sizeof(Point))));
+   StoreIndirect("Point", "x",
+      Load("p"),
+      Load("a"));
+   StoreIndirect("Point", "y",
+      Load("p"),
+      Mul(
+         LoadIndirect("Point", "x",
+            Load("p")),
+         Load("b")));
+
+   Return(
+      Add(
+         LoadIndirect("Point", "x",
+            Load("p")),
+         LoadIndirect("Point", "y",
+            Load("p"))));
+   return true;
+   }
+
+// p and q are compared, so they must have distinct addresses on the stack
+DEFINE_BUILDER(TestStackAllocation,
+               Int32,
+               PARAM("a", Int32))
+   {
+   DEFINE_ALLOCATOR();
+
+   Store("p",
+      Call("allocate", 1,
+         ConstInt32(sizeof(Point))));
+   Store("q",
+      Call("allocate", 1,
+         ConstInt32(sizeof(Point))));
+   StoreIndirect("Point", "x",
+      Load("p"),
+      Load("a"));
+
+   OMR::JitBuilder::IlBuilder *same = NULL;
+   IfThen(&same,
+      EqualTo(
+         Load("p"),
+         Load("q")));
+   same->Return(
+   same->   ConstInt32(-1));
+
+   Return(
+      Add(
+         LoadIndirect("Point", "x",
+            Load("p")),
+         LoadIndirect("Point", "y",
+            Load("q"))));
+   return true;
+   }
+
+// A new object on each iteration, which is dead by the next one
+DEFINE_BUILDER(TestAllocationInLoop,
+               Int32,
+               PARAM("n", Int32))
+   {
+   DEFINE_ALLOCATOR();
+
+   Store("sum",
+      ConstInt32(0));
+   OMR::JitBuilder::IlBuilder *loop = NULL;
+   ForLoopUp("i", &loop, ConstInt32(0), Load("n"), ConstInt32(1));
+   loop->Store("p",
+   loop->   Call("allocate", 1,
+   loop->      ConstInt32(sizeof(Point))));
+   loop->StoreIndirect("Point", "x",
+   loop->   Load("p"),
+   loop->   Load("i"));
+   loop->Store("sum",
+   loop->   Add(
+   loop->      Load("sum"),
+   loop->      Add(
+   loop->         LoadIndirect("Point", "x",
+   loop->            Load("p")),
+   loop->         LoadIndirect("Point", "y",
+   loop->            Load("p")))));
+
+   Return(
+      Load("sum"));
+   return true;
+   }
+
+// p is passed to a call, which frees it
+DEFINE_BUILDER(TestEscapeToCall,
+               Int32,
+               PARAM("a", Int32))
+   {
+   DEFINE_ALLOCATOR();
+   DefineFunction("consume", __FILE__, CONSUME_LINE, (void *)&consume, Int32, 1, Address);
+
+   Store("p",
+      Call("allocate", 1,
+         ConstInt32(sizeof(Point))));
+   StoreIndirect("Point", "x",
+      Load("p"),
+      Load("a"));
+
+   Return(
+      Call("consume", 1,
+         Load("p")));
+   return true;
+   }
+
+// p is returned
+DEFINE_BUILDER(TestEscapeToReturn,
+               Address,
+               PARAM("a", Int32))
+   {
+   DEFINE_ALLOCATOR();
+
+   Store("p",
+      Call("allocate", 1,
+         ConstInt32(sizeof(Point))));
+   StoreIndirect("Point", "y",
+      Load("p"),
+      Load("a"));
+
+   Return(
+      Load("p"));
+   return true;
+   }
+
+// An address is stored into n, which is compared with m, so n stays on the heap
+DEFINE_BUILDER(TestAddressStoredInto,
+               Int64,
+               PARAM("m", Address))
+   {
+   DEFINE_ALLOCATOR();
+
+   Store("n",
+      Call("allocate", 1,
+         ConstInt32(sizeof(ListNode))));
+   StoreIndirect("ListNode", "next",
+      Load("n"),
+      Load("m"));
+   StoreIndirect("ListNode", "value",
+      Load("n"),
+      ConstInt64(5));
+
+   OMR::JitBuilder::IlBuilder *same = NULL;
+   IfThen(&same,
+      EqualTo(
+         Load("n"),
+         Load("m")));
+   same->Return(
+   same->   ConstInt64(-1));
+
+   Return(
+      Add(
+         LoadIndirect("ListNode", "value",
+            Load("n")),
+         LoadIndirect("ListNode", "value",
+            LoadIndirect("ListNode", "next",
+               Load("n")))));
+   return true;
+   }
+
+class EscapeAnalysisTest : public JitBuilderTest
+   {
+   public:
+   virtual void SetUp()
+      {
+      JitBuilderTest::SetUp();
+      allocations = 0;
+      }
+   };
+
+typedef int32_t (*Int32Function)(int32_t);
+typedef int32_t (*Int32Int32Function)(int32_t, int32_t);
+typedef Point *(*AllocatingFunction)(int32_t);
+typedef int64_t (*NodeFunction)(ListNode *);
+
+TEST_F(EscapeAnalysisTest, ScalarReplacement)
+   {
+   Int32Int32Function testFunction;
+   ASSERT_COMPILE(PointTypes, TestScalarReplacement, testFunction);
+
+   ASSERT_EQ(3 + 3 * 4, testFunction(3, 4));
+   ASSERT_EQ(-2 + -2 * 5, testFunction(-2, 5));
+   ASSERT_EQ(0, allocations);
+   }
+
+TEST_F(EscapeAnalysisTest, StackAllocation)
+   {
+   Int32Function testFunction;
+   ASSERT_COMPILE(PointTypes, TestStackAllocation, testFunction);
+
+   ASSERT_EQ(7, testFunction(7));
+   ASSERT_EQ(-3, testFunction(-3));
+   ASSERT_EQ(0, allocations);
+   }
+
+TEST_F(EscapeAnalysisTest, AllocationInLoop)
+   {
+   Int32Function testFunction;
+   ASSERT_COMPILE(PointTypes, TestAllocationInLoop, testFunction);
+
+   ASSERT_EQ(0, testFunction(0));
+   ASSERT_EQ(45, testFunction(10));
+   ASSERT_EQ(0, allocations);
+   }
+
+TEST_F(EscapeAnalysisTest, EscapeToCall)
+   {
+   Int32Function testFunction;
+   ASSERT_COMPILE(PointTypes, TestEscapeToCall, testFunction);
+
+   ASSERT_EQ(9, testFunction(9));
+   ASSERT_EQ(1, allocations);
+   }
+
+TEST_F(EscapeAnalysisTest, EscapeToReturn)
+   {
+   AllocatingFunction testFunction;
+   ASSERT_COMPILE(PointTypes, TestEscapeToReturn, testFunction);
+
+   Point *p = testFunction(11);
+   ASSERT_EQ(1, allocations);
+   ASSERT_EQ(0, p->x);
+   ASSERT_EQ(11, p->y);
+   free(p);
+   }
+
+TEST_F(EscapeAnalysisTest, AddressStoredInto)
+   {
+   NodeFunction testFunction;
+   ASSERT_COMPILE(PointTypes, TestAddressStoredInto, testFunction);
+
+   ListNode m = { 37, NULL };
+   ASSERT_EQ(42, testFunction(&m));
+   ASSERT_EQ(1, allocations);
+   }
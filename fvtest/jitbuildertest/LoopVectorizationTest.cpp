@@ -0,0 +1,223 @@
+/*******************************************************************************
+ * Copyright (c) 2020, 2020 IBM Corp. and others
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at https://www.eclipse.org/legal/epl-2.0/
+ * or the Apache License, Version 2.0 which accompanies this distribution and
+ * is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following
+ * Secondary Licenses when the conditions for such availability set
+ * forth in the Eclipse Public License, v. 2.0 are satisfied: GNU
+ * General Public License, version 2 with the GNU Classpath
+ * Exception [1] and GNU General Public License, version 2 with the
+ * OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] http://openjdk.java.net/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
+ *******************************************************************************/
+
+#include "JBTestUtil.hpp"
+
+/*
+ * Loops of unit stride array accesses that the loop vectorizer rewrites. Each
+ * test runs enough lengths to exercise the vector loop on its own, the scalar
+ * epilogue on its own, and both together.
+ */
+
+DEFINE_BUILDER(TestDoubleMultiplyLoop,
+               NoType,
+               PARAM("result", PointerTo(Double)),
+               PARAM("vector1", PointerTo(Double)),
+               PARAM("vector2", PointerTo(Double)),
+               PARAM("length", Int32))
+   {
+   OMR::JitBuilder::IlType *pDouble = PointerTo(Double);
+   OMR::JitBuilder::IlBuilder *loop = NULL;
+   ForLoopUp("i", &loop, ConstInt32(0), Load("length"), ConstInt32(1));
+
+   loop->StoreAt(
+   loop->   IndexAt(pDouble,
+   loop->      Load("result"),
+   loop->      Load("i")),
+   loop->   Mul(
+   loop->      LoadAt(pDouble,
+   loop->         IndexAt(pDouble,
+   loop->            Load("vector1"),
+   loop->            Load("i"))),
+   loop->      LoadAt(pDouble,
+   loop->         IndexAt(pDouble,
+   loop->            Load("vector2"),
+   loop->            Load("i")))));
+
+   Return();
+   return true;
+   }
+
+DEFINE_BUILDER(TestInt32AddInvariantLoop,
+               NoType,
+               PARAM("result", PointerTo(Int32)),
+               PARAM("vector", PointerTo(Int32)),
+               PARAM("addend", Int32),
+               PARAM("length", Int32))
+   {
+   OMR::JitBuilder::IlType *pInt32 = PointerTo(Int32);
+   OMR::JitBuilder::IlBuilder *loop = NULL;
+   ForLoopUp("i", &loop, ConstInt32(0), Load("length"), ConstInt32(1));
+
+   loop->StoreAt(
+   loop->   IndexAt(pInt32,
+   loop->      Load("result"),
+   loop->      Load("i")),
+   loop->   Add(
+   loop->      LoadAt(pInt32,
+   loop->         IndexAt(pInt32,
+   loop->            Load("vector"),
+   loop->            Load("i"))),
+   loop->      Load("addend")));
+
+   Return();
+   return true;
+   }
+
+DEFINE_BUILDER(TestInt64XorLoop,
+               NoType,
+               PARAM("result", PointerTo(Int64)),
+               PARAM("vector1", PointerTo(Int64)),
+               PARAM("vector2", PointerTo(Int64)),
+               PARAM("start", Int32),
+               PARAM("length", Int32))
+   {
+   OMR::JitBuilder::IlType *pInt64 = PointerTo(Int64);
+   OMR::JitBuilder::IlBuilder *loop = NULL;
+   ForLoopUp("i", &loop, Load("start"), Load("length"), ConstInt32(1));
+
+   loop->StoreAt(
+   loop->   IndexAt(pInt64,
+   loop->      Load("result"),
+   loop->      Load("i")),
+   loop->   Xor(
+   loop->      LoadAt(pInt64,
+   loop->         IndexAt(pInt64,
+   loop->            Load("vector1"),
+   loop->            Load("i"))),
+   loop->      LoadAt(pInt64,
+   loop->         IndexAt(pInt64,
+   loop->            Load("vector2"),
+   loop->            Load("i")))));
+
+   Return();
+   return true;
+   }
+
+class LoopVectorizationTest : public JitBuilderTest {};
+
+typedef void (*DoubleMultiplyLoopFunction)(double *, double *, double *, int32_t);
+TEST_F(LoopVectorizationTest, DoubleMultiply)
+   {
+   DoubleMultiplyLoopFunction testFunction;
+   ASSERT_COMPILE(OMR::JitBuilder::TypeDictionary, TestDoubleMultiplyLoop, testFunction);
+
+   double vector1[33], vector2[33], result[34];
+   for (int32_t i = 0; i < 33; i++)
+      {
+      vector1[i] = i + 0.5;
+      vector2[i] = 33 - i;
+      }
+
+   for (int32_t length = 0; length <= 33; length++)
+      {
+      for (int32_t i = 0; i < 34; i++)
+         result[i] = -1.0;
+
+      testFunction(result, vector1, vector2, length);
+
+      for (int32_t i = 0; i < length; i++)
+         ASSERT_EQ(vector1[i] * vector2[i], result[i]) << "length " << length << " element " << i;
+      ASSERT_EQ(-1.0, result[length]) << "store past the end for length " << length;
+      }
+   }
+
+typedef void (*Int32AddInvariantLoopFunction)(int32_t *, int32_t *, int32_t, int32_t);
+TEST_F(LoopVectorizationTest, Int32AddInvariant)
+   {
+   Int32AddInvariantLoopFunction testFunction;
+   ASSERT_COMPILE(OMR::JitBuilder::TypeDictionary, TestInt32AddInvariantLoop, testFunction);
+
+   int32_t vector[19], result[20];
+   for (int32_t i = 0; i < 19; i++)
+      vector[i] = i * 3 - 20;
+
+   for (int32_t length = 0; length <= 19; length++)
+      {
+      for (int32_t i = 0; i < 20; i++)
+         result[i] = -1;
+
+      testFunction(result, vector, 7, length);
+
+      for (int32_t i = 0; i < length; i++)
+         ASSERT_EQ(vector[i] + 7, result[i]) << "length " << length << " element " << i;
+      ASSERT_EQ(-1, result[length]) << "store past the end for length " << length;
+      }
+   }
+
+TEST_F(LoopVectorizationTest, Int32AddInvariantOverlapping)
+   {
+   Int32AddInvariantLoopFunction testFunction;
+   ASSERT_COMPILE(OMR::JitBuilder::TypeDictionary, TestInt32AddInvariantLoop, testFunction);
+
+   // Each element is computed from the one stored by the previous iteration, which
+   // a vector loop would observe too early
+   int32_t buffer[17] = { 0 };
+   testFunction(buffer + 1, buffer, 1, 16);
+   for (int32_t i = 0; i < 17; i++)
+      ASSERT_EQ(i, buffer[i]) << "element " << i;
+
+   // Each element is computed from the next one before it is overwritten
+   for (int32_t i = 0; i < 17; i++)
+      buffer[i] = i * i;
+   testFunction(buffer, buffer + 1, 1, 16);
+   for (int32_t i = 0; i < 16; i++)
+      ASSERT_EQ((i + 1) * (i + 1) + 1, buffer[i]) << "element " << i;
+
+   // Fully overlapping arrays update in place
+   for (int32_t i = 0; i < 17; i++)
+      buffer[i] = i;
+   testFunction(buffer, buffer, 5, 17);
+   for (int32_t i = 0; i < 17; i++)
+      ASSERT_EQ(i + 5, buffer[i]) << "element " << i;
+   }
+
+typedef void (*Int64XorLoopFunction)(int64_t *, int64_t *, int64_t *, int32_t, int32_t);
+TEST_F(LoopVectorizationTest, Int64XorFromNonZeroStart)
+   {
+   Int64XorLoopFunction testFunction;
+   ASSERT_COMPILE(OMR::JitBuilder::TypeDictionary, TestInt64XorLoop, testFunction);
+
+   int64_t vector1[12], vector2[12], result[12];
+   for (int32_t i = 0; i < 12; i++)
+      {
+      vector1[i] = INT64_C(0x0123456789abcdef) * (i + 1);
+      vector2[i] = ~INT64_C(0) << i;
+      }
+
+   for (int32_t start = 0; start < 4; start++)
+      {
+      for (int32_t length = start; length <= 12; length++)
+         {
+         for (int32_t i = 0; i < 12; i++)
+            result[i] = -1;
+
+         testFunction(result, vector1, vector2, start, length);
+
+         for (int32_t i = 0; i < 12; i++)
+            {
+            int64_t expected = (i >= start && i < length) ? (vector1[i] ^ vector2[i]) : -1;
+            ASSERT_EQ(expected, result[i]) << "start " << start << " length " << length << " element " << i;
+            }
+         }
+      }
+   }
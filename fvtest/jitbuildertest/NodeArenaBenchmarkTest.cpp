@@ -0,0 +1,128 @@
+/*******************************************************************************
+ * Copyright (c) 2020, 2020 IBM Corp. and others
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at https://www.eclipse.org/legal/epl-2.0/
+ * or the Apache License, Version 2.0 which accompanies this distribution and
+ * is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following
+ * Secondary Licenses when the conditions for such availability set
+ * forth in the Eclipse Public License, v. 2.0 are satisfied: GNU
+ * General Public License, version 2 with the GNU Classpath
+ * Exception [1] and GNU General Public License, version 2 with the
+ * OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] http://openjdk.java.net/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
+ *******************************************************************************/
+
+#include "JBTestUtil.hpp"
+
+#include <chrono>
+#include <iostream>
+
+/*
+ * Compiles a large method, whose optimization is dominated by walks over its
+ * trees, with the nodes allocated from cache line aligned chunks and allocated
+ * one at a time, and reports the compile time of each.
+ */
+
+static const int32_t numDiamonds = 500;
+
+DEFINE_BUILDER(TestNodeArenaMethod,
+               Int32,
+               PARAM("x", Int32))
+   {
+   Store("a",
+      Load("x"));
+   Store("b",
+      ConstInt32(1));
+
+   for (int32_t k = 0; k < numDiamonds; k++)
+      {
+      OMR::JitBuilder::IlBuilder *thenPath = NULL, *elsePath = NULL;
+      IfThenElse(&thenPath, &elsePath,
+         LessThan(
+            And(
+               Load("a"),
+               ConstInt32(7)),
+            ConstInt32(k & 7)));
+      thenPath->Store("a",
+      thenPath->   Add(
+      thenPath->      Load("a"),
+      thenPath->      Mul(
+      thenPath->         Load("b"),
+      thenPath->         ConstInt32(k))));
+      elsePath->Store("b",
+      elsePath->   Xor(
+      elsePath->      Load("b"),
+      elsePath->      Add(
+      elsePath->         Load("a"),
+      elsePath->         ConstInt32(k))));
+      }
+
+   Return(
+      Add(
+         Load("a"),
+         Load("b")));
+   return true;
+   }
+
+static int32_t
+largeMethod(int32_t x)
+   {
+   uint32_t a = x;
+   uint32_t b = 1;
+   for (int32_t k = 0; k < numDiamonds; k++)
+      {
+      if ((int32_t)(a & 7) < (k & 7))
+         a = a + b * k;
+      else
+         b = b ^ (a + k);
+      }
+   return (int32_t)(a + b);
+   }
+
+class NodeArenaBenchmarkTest : public ::testing::TestWithParam<const char *>
+   {
+   public:
+
+   virtual void SetUp()
+      {
+      ASSERT_TRUE(initializeJitWithOptions((char *)GetParam())) << "Failed to initialize the JIT.";
+      }
+
+   virtual void TearDown()
+      {
+      shutdownJit();
+      }
+   };
+
+typedef int32_t (*LargeMethodFunction)(int32_t);
+TEST_P(NodeArenaBenchmarkTest, LargeMethod)
+   {
+   const int32_t compilations = 3;
+   LargeMethodFunction testFunction;
+
+   std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+   for (int32_t i = 0; i < compilations; i++)
+      {
+      ASSERT_COMPILE(OMR::JitBuilder::TypeDictionary, TestNodeArenaMethod, testFunction);
+      }
+   std::chrono::steady_clock::duration elapsed = std::chrono::steady_clock::now() - start;
+
+   for (int32_t x = -3; x < 20; x++)
+      ASSERT_EQ(largeMethod(x), testFunction(x)) << "x " << x;
+
+   std::cout << "[ BENCHMARK] " << GetParam() << ": "
+             << std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count() / compilations
+             << " us per compilation of " << numDiamonds << " diamonds" << std::endl;
+   }
+
+INSTANTIATE_TEST_CASE_P(NodeAllocation, NodeArenaBenchmarkTest, ::testing::Values(
+   "-Xjit:acceptHugeMethods",
+   "-Xjit:acceptHugeMethods,disableNodeArena"));
@@ -0,0 +1,117 @@
+/*******************************************************************************
+ * Copyright (c) 2020, 2020 IBM Corp. and others
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at https://www.eclipse.org/legal/epl-2.0/
+ * or the Apache License, Version 2.0 which accompanies this distribution and
+ * is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following
+ * Secondary Licenses when the conditions for such availability set
+ * forth in the Eclipse Public License, v. 2.0 are satisfied: GNU
+ * General Public License, version 2 with the GNU Classpath
+ * Exception [1] and GNU General Public License, version 2 with the
+ * OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] http://openjdk.java.net/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
+ *******************************************************************************/
+
+#include "JBTestUtil.hpp"
+
+#include <stdio.h>
+#include <string>
+
+/*
+ * With the profileCompilationPhases option, every optimization and codegen
+ * phase of every compilation is measured and a report of the totals is
+ * written when the JIT shuts down.
+ */
+
+DEFINE_BUILDER(TestProfiledLoop,
+               Int32,
+               PARAM("count", Int32))
+   {
+   Store("sum",
+      ConstInt32(0));
+
+   OMR::JitBuilder::IlBuilder *loop = NULL;
+   ForLoopUp("i", &loop, ConstInt32(0), Load("count"), ConstInt32(1));
+
+   loop->Store("sum",
+   loop->   Add(
+   loop->      Load("sum"),
+   loop->      Load("i")));
+
+   Return(
+      Load("sum"));
+   return true;
+   }
+
+static std::string
+readFile(const char *fileName)
+   {
+   std::string contents;
+   FILE *file = fopen(fileName, "r");
+   if (file != NULL)
+      {
+      char buffer[1024];
+      size_t length;
+      while ((length = fread(buffer, 1, sizeof(buffer), file)) > 0)
+         contents.append(buffer, length);
+      fclose(file);
+      }
+   return contents;
+   }
+
+typedef int32_t (*ProfiledLoopFunction)(int32_t);
+
+static void
+compileProfiledMethods(const char *options)
+   {
+   ASSERT_TRUE(initializeJitWithOptions((char *)options)) << "Failed to initialize the JIT.";
+
+   for (int32_t m = 0; m < 3; m++)
+      {
+      ProfiledLoopFunction testFunction;
+      ASSERT_COMPILE(OMR::JitBuilder::TypeDictionary, TestProfiledLoop, testFunction);
+      ASSERT_EQ(45, testFunction(10));
+      }
+
+   shutdownJit();
+   }
+
+TEST(PhaseProfilerTest, CSVReport)
+   {
+   const char *fileName = "PhaseProfilerTest.csv";
+   remove(fileName);
+
+   compileProfiledMethods("-Xjit:acceptHugeMethods,enableBasicBlockHoisting,omitFramePointer,useILValidator,profileCompilationPhases,phaseProfileReport=PhaseProfilerTest.csv");
+
+   std::string report = readFile(fileName);
+   remove(fileName);
+
+   ASSERT_EQ(0u, report.find("category,phase,hotness,count,wallTimeNs,maxWallTimeNs,cpuTimeNs,regionBytes\n"));
+   ASSERT_NE(std::string::npos, report.find("\ncompilation,compile,warm,3,"));
+   ASSERT_NE(std::string::npos, report.find("\nopt,"));
+   ASSERT_NE(std::string::npos, report.find("\ncodegen,"));
+   }
+
+TEST(PhaseProfilerTest, JSONReport)
+   {
+   const char *fileName = "PhaseProfilerTest.json";
+   remove(fileName);
+
+   compileProfiledMethods("-Xjit:acceptHugeMethods,enableBasicBlockHoisting,omitFramePointer,useILValidator,profileCompilationPhases,phaseProfileReport=PhaseProfilerTest.json");
+
+   std::string report = readFile(fileName);
+   remove(fileName);
+
+   ASSERT_EQ(0u, report.find("[\n"));
+   ASSERT_NE(std::string::npos, report.find("{ \"category\": \"compilation\", \"phase\": \"compile\", \"hotness\": \"warm\", \"count\": 3,"));
+   ASSERT_NE(std::string::npos, report.find("\"category\": \"codegen\""));
+   ASSERT_NE(std::string::npos, report.find("]\n"));
+   }
@@ -0,0 +1,270 @@
+/*******************************************************************************
+ * Copyright (c) 2020, 2020 IBM Corp. and others
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at https://www.eclipse.org/legal/epl-2.0/
+ * or the Apache License, Version 2.0 which accompanies this distribution and
+ * is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following
+ * Secondary Licenses when the conditions for such availability set
+ * forth in the Eclipse Public License, v. 2.0 are satisfied: GNU
+ * General Public License, version 2 with the GNU Classpath
+ * Exception [1] and GNU General Public License, version 2 with the
+ * OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] http://openjdk.java.net/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
+ *******************************************************************************/
+
+#include "JBTestUtil.hpp"
+
+#include <stdio.h>
+#include <string>
+
+/*
+ * Methods whose locals are constant or copies of each other only once the
+ * branches and loops of the method are taken into account, as found by sparse
+ * conditional constant propagation and sparse copy propagation.
+ */
+
+DEFINE_BUILDER(TestConstantThroughBranches,
+               Int32,
+               PARAM("n", Int32))
+   {
+   Store("a",
+      ConstInt32(3));
+
+   OMR::JitBuilder::IlBuilder *thenPath = NULL;
+   OMR::JitBuilder::IlBuilder *elsePath = NULL;
+   IfThenElse(&thenPath, &elsePath,
+      GreaterThan(
+         Load("n"),
+         ConstInt32(0)));
+   thenPath->Store("b",
+   thenPath->   Add(
+   thenPath->      Load("a"),
+   thenPath->      ConstInt32(4)));
+   elsePath->Store("b",
+   elsePath->   ConstInt32(7));
+
+   // b is 7 on both paths, so the else path of the loop body is never taken
+   Store("sum",
+      ConstInt32(0));
+   OMR::JitBuilder::IlBuilder *loop = NULL;
+   ForLoopUp("i", &loop, ConstInt32(0), Load("n"), ConstInt32(1));
+
+   OMR::JitBuilder::IlBuilder *seven = NULL;
+   OMR::JitBuilder::IlBuilder *notSeven = NULL;
+   loop->IfThenElse(&seven, &notSeven,
+   loop->   EqualTo(
+   loop->      Load("b"),
+   loop->      ConstInt32(7)));
+   seven->Store("sum",
+   seven->   Add(
+   seven->      Load("sum"),
+   seven->      Load("i")));
+   notSeven->Store("sum",
+   notSeven->   ConstInt32(-1000));
+
+   Return(
+      Add(
+         Load("sum"),
+         Mul(
+            Load("b"),
+            ConstInt32(100))));
+   return true;
+   }
+
+DEFINE_BUILDER(TestConstantChangedInLoop,
+               Int32,
+               PARAM("n", Int32))
+   {
+   Store("k",
+      ConstInt32(1));
+   Store("flag",
+      ConstInt32(0));
+
+   // k is only constant until the loop changes flag
+   OMR::JitBuilder::IlBuilder *loop = NULL;
+   ForLoopUp("i", &loop, ConstInt32(0), Load("n"), ConstInt32(1));
+
+   OMR::JitBuilder::IlBuilder *flagSet = NULL;
+   loop->IfThen(&flagSet,
+   loop->   EqualTo(
+   loop->      Load("flag"),
+   loop->      ConstInt32(1)));
+   flagSet->Store("k",
+   flagSet->   Mul(
+   flagSet->      Load("k"),
+   flagSet->      ConstInt32(2)));
+   loop->Store("flag",
+   loop->   ConstInt32(1));
+
+   Return(
+      Load("k"));
+   return true;
+   }
+
+DEFINE_BUILDER(TestCopyThroughLoop,
+               Int64,
+               PARAM("x", Int64),
+               PARAM("n", Int32))
+   {
+   Store("y",
+      Load("x"));
+   Store("z",
+      Load("y"));
+   Store("sum",
+      ConstInt64(0));
+
+   OMR::JitBuilder::IlBuilder *loop = NULL;
+   ForLoopUp("i", &loop, ConstInt32(0), Load("n"), ConstInt32(1));
+   loop->Store("sum",
+   loop->   Add(
+   loop->      Load("sum"),
+   loop->      Load("z")));
+
+   // y changes here, so the loads of z below must not become loads of y
+   loop->Store("y",
+   loop->   Add(
+   loop->      Load("y"),
+   loop->      ConstInt64(1)));
+   loop->Store("sum",
+   loop->   Add(
+   loop->      Load("sum"),
+   loop->      Load("z")));
+
+   Return(
+      Add(
+         Load("sum"),
+         Load("y")));
+   return true;
+   }
+
+/*
+ * A method large enough to be optimized with the sparse analyses only: a long
+ * chain of statements, each guarded by a condition that is constant once the
+ * values flowing into it are known.
+ */
+#define LARGE_METHOD_STATEMENTS 1500
+
+DEFINE_BUILDER(TestLargeMethod,
+               Int32,
+               PARAM("x", Int32))
+   {
+   Store("c",
+      ConstInt32(0));
+   Store("v",
+      Load("x"));
+
+   for (int32_t s = 0; s < LARGE_METHOD_STATEMENTS; s++)
+      {
+      OMR::JitBuilder::IlBuilder *taken = NULL;
+      OMR::JitBuilder::IlBuilder *notTaken = NULL;
+      IfThenElse(&taken, &notTaken,
+         LessThan(
+            Load("c"),
+            ConstInt32(s + 1)));
+      taken->Store("c",
+      taken->   Add(
+      taken->      Load("c"),
+      taken->      ConstInt32(1)));
+      taken->Store("v",
+      taken->   Add(
+      taken->      Load("v"),
+      taken->      Load("c")));
+      notTaken->Store("v",
+      notTaken->   ConstInt32(0));
+      }
+
+   Return(
+      Add(
+         Load("v"),
+         Load("c")));
+   return true;
+   }
+
+class SparsePropagationTest : public JitBuilderTest {};
+
+typedef int32_t (*Int32Function)(int32_t);
+
+TEST_F(SparsePropagationTest, ConstantThroughBranches)
+   {
+   Int32Function testFunction;
+   ASSERT_COMPILE(OMR::JitBuilder::TypeDictionary, TestConstantThroughBranches, testFunction);
+
+   ASSERT_EQ(700, testFunction(0));
+   ASSERT_EQ(700, testFunction(-5));
+   ASSERT_EQ(700 + 45, testFunction(10));
+   }
+
+TEST_F(SparsePropagationTest, ConstantChangedInLoop)
+   {
+   Int32Function testFunction;
+   ASSERT_COMPILE(OMR::JitBuilder::TypeDictionary, TestConstantChangedInLoop, testFunction);
+
+   ASSERT_EQ(1, testFunction(0));
+   ASSERT_EQ(1, testFunction(1));
+   ASSERT_EQ(2, testFunction(2));
+   ASSERT_EQ(512, testFunction(10));
+   }
+
+typedef int64_t (*CopyThroughLoopFunction)(int64_t, int32_t);
+TEST_F(SparsePropagationTest, CopyThroughLoop)
+   {
+   CopyThroughLoopFunction testFunction;
+   ASSERT_COMPILE(OMR::JitBuilder::TypeDictionary, TestCopyThroughLoop, testFunction);
+
+   ASSERT_EQ(5, testFunction(5, 0));
+   ASSERT_EQ(INT64_C(3) * 2 * 4 + 3 + 4, testFunction(3, 4));
+   ASSERT_EQ(INT64_C(-1) * 2 * 100 - 1 + 100, testFunction(-1, 100));
+   }
+
+TEST_F(SparsePropagationTest, LargeMethod)
+   {
+   Int32Function testFunction;
+   ASSERT_COMPILE(OMR::JitBuilder::TypeDictionary, TestLargeMethod, testFunction);
+
+   int32_t expected = LARGE_METHOD_STATEMENTS * (LARGE_METHOD_STATEMENTS + 1) / 2 + LARGE_METHOD_STATEMENTS;
+   ASSERT_EQ(expected, testFunction(0));
+   ASSERT_EQ(expected + 42, testFunction(42));
+   }
+
+static std::string
+readFile(const char *fileName)
+   {
+   std::string contents;
+   FILE *file = fopen(fileName, "r");
+   if (file != NULL)
+      {
+      char buffer[1024];
+      size_t length;
+      while ((length = fread(buffer, 1, sizeof(buffer), file)) > 0)
+         contents.append(buffer, length);
+      fclose(file);
+      }
+   return contents;
+   }
+
+TEST(SparsePropagationLargeMethodTest, DenseAnalysesSkipped)
+   {
+   const char *fileName = "SparsePropagationTest.csv";
+   remove(fileName);
+
+   ASSERT_TRUE(initializeJitWithOptions((char *)"-Xjit:acceptHugeMethods,enableBasicBlockHoisting,omitFramePointer,useILValidator,profileCompilationPhases,phaseProfileReport=SparsePropagationTest.csv")) << "Failed to initialize the JIT.";
+   Int32Function testFunction;
+   ASSERT_COMPILE(OMR::JitBuilder::TypeDictionary, TestLargeMethod, testFunction);
+   shutdownJit();
+
+   std::string report = readFile(fileName);
+   remove(fileName);
+
+   ASSERT_NE(std::string::npos, report.find("\nopt,sparseConditionalConstantPropagation,"));
+   ASSERT_NE(std::string::npos, report.find("\nopt,sparseCopyPropagation,"));
+   ASSERT_EQ(std::string::npos, report.find("\nopt,globalValuePropagation,"));
+   ASSERT_EQ(std::string::npos, report.find("\nopt,globalCopyPropagation,"));
+   }
@@ -0,0 +1,281 @@
+/*******************************************************************************
+ * Copyright (c) 2020, 2020 IBM Corp. and others
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at https://www.eclipse.org/legal/epl-2.0/
+ * or the Apache License, Version 2.0 which accompanies this distribution and
+ * is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following
+ * Secondary Licenses when the conditions for such availability set
+ * forth in the Eclipse Public License, v. 2.0 are satisfied: GNU
+ * General Public License, version 2 with the GNU Classpath
+ * Exception [1] and GNU General Public License, version 2 with the
+ * OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] http://openjdk.java.net/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
+ *******************************************************************************/
+
+#include "JBTestUtil.hpp"
+
+#include <chrono>
+#include <thread>
+
+/*
+ * Methods compiled with compileMethodBuilderTiered() start out as cheap first
+ * tier code that counts invocations and loop iterations. Once the count= option
+ * is exceeded they are recompiled on a compilation thread, and their first tier
+ * entry point is patched to jump to the new code. The first tier code also
+ * profiles its blocks and branches, and the second tier is compiled using the
+ * profile.
+ */
+
+DEFINE_BUILDER(TestTieredSumOfSquares,
+               Int64,
+               PARAM("count", Int32))
+   {
+   Store("sum",
+      ConstInt64(0));
+
+   OMR::JitBuilder::IlBuilder *loop = NULL;
+   ForLoopUp("i", &loop, ConstInt32(0), Load("count"), ConstInt32(1));
+
+   loop->Store("sum",
+   loop->   Add(
+   loop->      Load("sum"),
+   loop->      ConvertTo(Int64,
+   loop->         Mul(
+   loop->            Load("i"),
+   loop->            Load("i")))));
+
+   Return(
+      Load("sum"));
+   return true;
+   }
+
+DEFINE_BUILDER(TestTieredCollatzSteps,
+               Int32,
+               PARAM("value", Int64))
+   {
+   Store("steps",
+      ConstInt32(0));
+   Store("notDone",
+      NotEqualTo(
+         Load("value"),
+         ConstInt64(1)));
+
+   OMR::JitBuilder::IlBuilder *body = NULL;
+   WhileDoLoop("notDone", &body);
+
+   OMR::JitBuilder::IlBuilder *even = NULL, *odd = NULL;
+   body->IfThenElse(&even, &odd,
+   body->   EqualTo(
+   body->      And(
+   body->         Load("value"),
+   body->         ConstInt64(1)),
+   body->      ConstInt64(0)));
+   even->Store("value",
+   even->   Div(
+   even->      Load("value"),
+   even->      ConstInt64(2)));
+   odd->Store("value",
+   odd->   Add(
+   odd->      Mul(
+   odd->         Load("value"),
+   odd->         ConstInt64(3)),
+   odd->      ConstInt64(1)));
+
+   body->Store("steps",
+   body->   Add(
+   body->      Load("steps"),
+   body->      ConstInt32(1)));
+   body->Store("notDone",
+   body->   NotEqualTo(
+   body->      Load("value"),
+   body->      ConstInt64(1)));
+
+   Return(
+      Load("steps"));
+   return true;
+   }
+
+DEFINE_BUILDER(TestTieredAdd,
+               Int32,
+               PARAM("left", Int32),
+               PARAM("right", Int32))
+   {
+   Return(
+      Add(
+         Load("left"),
+         Load("right")));
+   return true;
+   }
+
+DEFINE_BUILDER(TestTieredClassify,
+               Int32,
+               PARAM("value", Int32))
+   {
+   OMR::JitBuilder::IlBuilder *negative = NULL;
+   IfThen(&negative,
+      LessThan(
+         Load("value"),
+         ConstInt32(0)));
+   negative->Return(
+   negative->   Mul(
+   negative->      Load("value"),
+   negative->      ConstInt32(-2)));
+
+   OMR::JitBuilder::IlBuilder *one = NULL, *two = NULL, *other = NULL;
+   Switch(Load("value"), &other, 2,
+          MakeCase(1, &one, false),
+          MakeCase(2, &two, false));
+   one->Store("result",
+   one->   ConstInt32(10));
+   two->Store("result",
+   two->   ConstInt32(20));
+   other->Store("result",
+   other->   Add(
+   other->      Load("value"),
+   other->      ConstInt32(100)));
+
+   Return(
+      Load("result"));
+   return true;
+   }
+
+class TieredCompilationTest : public ::testing::Test
+   {
+   public:
+
+   static void SetUpTestCase()
+      {
+      ASSERT_TRUE(initializeJitWithOptions((char *)"-Xjit:acceptHugeMethods,enableBasicBlockHoisting,omitFramePointer,useILValidator,count=50"))
+         << "Failed to initialize the JIT.";
+      }
+
+   static void TearDownTestCase()
+      {
+      shutdownJit();
+      }
+
+   protected:
+
+   // Wait for the compilation thread to patch tieredUpBefore + 1 methods
+   static bool waitForTierUp(int32_t tieredUpBefore)
+      {
+      for (int32_t waits = 0; waits < 1000; waits++)
+         {
+         if (getTieredRecompilationCount() > tieredUpBefore)
+            return true;
+         std::this_thread::sleep_for(std::chrono::milliseconds(10));
+         }
+      return false;
+      }
+   };
+
+typedef int64_t (*TieredSumOfSquaresFunction)(int32_t);
+TEST_F(TieredCompilationTest, LoopBackEdges)
+   {
+   OMR::JitBuilder::TypeDictionary types;
+   TestTieredSumOfSquares builder(&types);
+   void *entry;
+   ASSERT_EQ(0, compileMethodBuilderTiered(&builder, &entry));
+
+   int32_t tieredUpBefore = getTieredRecompilationCount();
+   TieredSumOfSquaresFunction sumOfSquares = (TieredSumOfSquaresFunction)entry;
+
+   // a single call iterates well past the count
+   ASSERT_EQ(328350, sumOfSquares(100));
+   ASSERT_TRUE(waitForTierUp(tieredUpBefore));
+
+   // the same entry point now runs the second tier
+   ASSERT_EQ(0, sumOfSquares(0));
+   ASSERT_EQ(285, sumOfSquares(10));
+   ASSERT_EQ(328350, sumOfSquares(100));
+   }
+
+typedef int32_t (*TieredCollatzStepsFunction)(int64_t);
+TEST_F(TieredCompilationTest, WhileDoBackEdges)
+   {
+   OMR::JitBuilder::TypeDictionary types;
+   TestTieredCollatzSteps builder(&types);
+   void *entry;
+   ASSERT_EQ(0, compileMethodBuilderTiered(&builder, &entry));
+
+   int32_t tieredUpBefore = getTieredRecompilationCount();
+   TieredCollatzStepsFunction collatzSteps = (TieredCollatzStepsFunction)entry;
+
+   ASSERT_EQ(111, collatzSteps(27));
+   ASSERT_TRUE(waitForTierUp(tieredUpBefore));
+
+   ASSERT_EQ(0, collatzSteps(1));
+   ASSERT_EQ(111, collatzSteps(27));
+   }
+
+typedef int32_t (*TieredAddFunction)(int32_t, int32_t);
+TEST_F(TieredCompilationTest, Invocations)
+   {
+   OMR::JitBuilder::TypeDictionary types;
+   TestTieredAdd builder(&types);
+   void *entry;
+   ASSERT_EQ(0, compileMethodBuilderTiered(&builder, &entry));
+
+   int32_t tieredUpBefore = getTieredRecompilationCount();
+   TieredAddFunction add = (TieredAddFunction)entry;
+
+   // calls made while the second tier is compiled keep running the first tier
+   for (int32_t i = 0; i < 100; i++)
+      ASSERT_EQ(2 * i + 1, add(i, i + 1));
+   ASSERT_TRUE(waitForTierUp(tieredUpBefore));
+
+   for (int32_t i = 0; i < 100; i++)
+      ASSERT_EQ(2 * i + 1, add(i, i + 1));
+   }
+
+typedef int32_t (*TieredClassifyFunction)(int32_t);
+TEST_F(TieredCompilationTest, ProfiledColdPaths)
+   {
+   OMR::JitBuilder::TypeDictionary types;
+   TestTieredClassify builder(&types);
+   void *entry;
+   ASSERT_EQ(0, compileMethodBuilderTiered(&builder, &entry));
+
+   int32_t tieredUpBefore = getTieredRecompilationCount();
+   int32_t profiledBefore = getProfileGuidedRecompilationCount();
+   TieredClassifyFunction classify = (TieredClassifyFunction)entry;
+
+   // the first tier never runs the negative or the second case
+   for (int32_t i = 0; i < 100; i++)
+      {
+      ASSERT_EQ(10, classify(1));
+      ASSERT_EQ(103, classify(3));
+      }
+   ASSERT_TRUE(waitForTierUp(tieredUpBefore));
+   ASSERT_LT(profiledBefore, getProfileGuidedRecompilationCount());
+
+   // the paths made cold by the profile still run correctly
+   ASSERT_EQ(10, classify(1));
+   ASSERT_EQ(20, classify(2));
+   ASSERT_EQ(103, classify(3));
+   ASSERT_EQ(14, classify(-7));
+   ASSERT_EQ(100, classify(0));
+   }
+
+TEST_F(TieredCompilationTest, RecompileMethodBuilder)
+   {
+   OMR::JitBuilder::TypeDictionary types;
+   TestTieredSumOfSquares builder(&types);
+
+   void *firstEntry;
+   ASSERT_EQ(0, compileMethodBuilder(&builder, &firstEntry));
+   void *secondEntry;
+   ASSERT_EQ(0, compileMethodBuilder(&builder, &secondEntry));
+
+   ASSERT_NE(firstEntry, secondEntry);
+   ASSERT_EQ(285, ((TieredSumOfSquaresFunction)firstEntry)(10));
+   ASSERT_EQ(285, ((TieredSumOfSquaresFunction)secondEntry)(10));
+   }
@@ -88,6 +88,8 @@ public:
 
 	MMINLINE uint32_t getObjectFlags() { return _objectFlags; }
 	MMINLINE bool getTenuredFlag() { return (_allocateFlags & OMR_GC_ALLOCATE_OBJECT_TENURED) == OMR_GC_ALLOCATE_OBJECT_TENURED; }
+	MMINLINE bool getPretenureBySiteFlag() { return OMR_GC_ALLOCATE_OBJECT_PRETENURE_BY_SITE == (_allocateFlags & OMR_GC_ALLOCATE_OBJECT_PRETENURE_BY_SITE); }
+	MMINLINE void setTenuredFlag() { _allocateFlags |= OMR_GC_ALLOCATE_OBJECT_TENURED; }
 	MMINLINE bool getPreHashFlag() { return OMR_GC_ALLOCATE_OBJECT_HASHED == (_allocateFlags & OMR_GC_ALLOCATE_OBJECT_HASHED); }
 
 	/* NON_ZERO_TLH flag set means JIT requested to skip zero in it (not what its name suggests to allocate from non zero TLH).
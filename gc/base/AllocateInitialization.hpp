@@ -79,6 +79,7 @@ protected:
 	const uintptr_t _allocationCategory;		/**< language-defined object category used in GC_ObjectModel::initializeAllocation() */
 	const uintptr_t _requestedSizeInBytes;		/**< minimum number of bytes to allocate for object header+instance data */
 	bool _isAllocatable;						/**< this is set if the allocation should not proceed */
+	uintptr_t _allocationSite;					/**< language-defined allocation site, or 0 if not known (see setAllocationSite()) */
 
 	MM_AllocateDescription _allocateDescription;/**< mutable allocation descriptor holds actual allocation terms */
 
@@ -93,6 +94,7 @@ public:
 		, allocate_no_zero_memory = OMR_GC_ALLOCATE_OBJECT_NON_ZERO_TLH	/**< select this flag to inhibit zeroing of allocated heap memory */
 		, allocate_no_gc = OMR_GC_ALLOCATE_OBJECT_NO_GC					/**< select this flag to inhibit collector cycle start on allocation failure */
 		, allocate_indexable = OMR_GC_ALLOCATE_OBJECT_INDEXABLE			/**< select this flag to allocate an indexable object */
+		, allocate_pretenure_by_site = OMR_GC_ALLOCATE_OBJECT_PRETENURE_BY_SITE	/**< select this flag to allocate in old space if the allocation site is known to be long lived (gencon only) */
 	};
 
 /*
@@ -139,9 +141,35 @@ public:
 	MMINLINE bool isAllocatable() { return _isAllocatable; }
 
 	MMINLINE uintptr_t getAllocationCategory() { return _allocationCategory; }
+	MMINLINE uintptr_t getAllocationSite() { return _allocationSite; }
 	MMINLINE uintptr_t getRequestedSizeInBytes() { return _requestedSizeInBytes; }
 	MMINLINE MM_AllocateDescription *getAllocateDescription() { return &_allocateDescription; }
 
+	/**
+	 * Associate this allocation with a language-defined allocation site (any non-zero value that identifies
+	 * where or why the object is allocated). The scavenger tracks the survival rate of objects per site; if
+	 * the allocate_pretenure_by_site flag is selected and objects from the site have been found to be long
+	 * lived, the allocation is redirected to old space. Must be called before allocateAndInitializeObject().
+	 *
+	 * @param[in] env pointer to environment for calling thread
+	 * @param[in] allocationSite language-defined allocation site
+	 */
+	MMINLINE void
+	setAllocationSite(MM_EnvironmentBase *env, uintptr_t allocationSite)
+	{
+		_allocationSite = allocationSite;
+#if defined(OMR_GC_MODRON_SCAVENGER)
+		MM_GCExtensionsBase *extensions = env->getExtensions();
+		if ((0 != allocationSite) && extensions->scavengerPretenureSites
+			&& _allocateDescription.getPretenureBySiteFlag() && !_allocateDescription.getTenuredFlag()
+			&& extensions->scavengerSiteSurvivalTracker.shouldPretenure(allocationSite)
+		) {
+			_allocateDescription.setTenuredFlag();
+			_allocateDescription.setMemorySpace(extensions->heap->getDefaultMemorySpace());
+		}
+#endif /* OMR_GC_MODRON_SCAVENGER */
+	}
+
 	MMINLINE bool
 	isGCAllowed()
 	{
@@ -224,6 +252,12 @@ public:
 					MM_AtomicOperations::writeBarrier();
 					/* reflect the current OMR flags in the object header back into allocate description */
 					_allocateDescription.setObjectFlags((uint32_t)objectModel->getObjectFlags(objectPtr));
+#if defined(OMR_GC_MODRON_SCAVENGER)
+					/* sample new space allocations from known sites for the scavenger's site survival tracking */
+					if ((0 != _allocationSite) && !_allocateDescription.getTenuredFlag() && env->getExtensions()->scavengerPretenureSites) {
+						env->getExtensions()->scavengerSiteSurvivalTracker.recordAllocation(&env->_pretenureSiteSampleBytes, _allocationSite, _allocateDescription.getContiguousBytes());
+					}
+#endif /* OMR_GC_MODRON_SCAVENGER */
 #if defined(OMR_GC_ALLOCATION_TAX)
 					/* if concurrent mark is enabled thread might have to pay tax - must save/restore allocated object in case of GC */
 					env->saveObjects(objectPtr);
@@ -272,6 +306,7 @@ public:
 		, _allocationCategory(allocationCategory)
 		, _requestedSizeInBytes(requiredSizeInBytes)
 		, _isAllocatable(true)
+		, _allocationSite(0)
 		, _allocateDescription(_requestedSizeInBytes, objectAllocationFlags,
 				0 == (OMR_GC_ALLOCATE_OBJECT_NO_GC & objectAllocationFlags),
 				0 == (OMR_GC_ALLOCATE_OBJECT_NO_GC & objectAllocationFlags))
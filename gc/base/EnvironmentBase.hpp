@@ -177,6 +177,9 @@ public:
 #if defined(OMR_GC_CONCURRENT_SCAVENGER)
 	uint64_t _concurrentScavengerSwitchCount; /**< local counter of cycle start and cycle end transitions */
 #endif /* defined(OMR_GC_CONCURRENT_SCAVENGER) */
+#if defined(OMR_GC_MODRON_SCAVENGER)
+	uintptr_t _pretenureSiteSampleBytes; /**< bytes allocated from tracked allocation sites since the last sample (see MM_ScavengerSiteSurvivalTracker) */
+#endif /* defined(OMR_GC_MODRON_SCAVENGER) */
 
 private:
 
@@ -662,6 +665,9 @@ public:
 #if defined(OMR_GC_CONCURRENT_SCAVENGER)
 		,_concurrentScavengerSwitchCount(0)
 #endif /* defined(OMR_GC_CONCURRENT_SCAVENGER) */
+#if defined(OMR_GC_MODRON_SCAVENGER)
+		,_pretenureSiteSampleBytes(0)
+#endif /* defined(OMR_GC_MODRON_SCAVENGER) */
 
 	{
 		_typeId = __FUNCTION__;
@@ -714,6 +720,9 @@ public:
 #if defined(OMR_GC_CONCURRENT_SCAVENGER)
 		,_concurrentScavengerSwitchCount(0)
 #endif /* defined(OMR_GC_CONCURRENT_SCAVENGER) */
+#if defined(OMR_GC_MODRON_SCAVENGER)
+		,_pretenureSiteSampleBytes(0)
+#endif /* defined(OMR_GC_MODRON_SCAVENGER) */
 	{
 		_typeId = __FUNCTION__;
 	}
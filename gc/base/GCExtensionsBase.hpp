@@ -44,6 +44,8 @@
 #include "OMRVMThreadListIterator.hpp"
 #include "ObjectModel.hpp"
 #include "ScavengerCopyScanRatio.hpp"
+#include "ScavengerSiteSurvivalTracker.hpp"
+#include "ScavengerThreadCountPredictor.hpp"
 #include "ScavengerStats.hpp"
 #include "SublistPool.hpp"
 
@@ -244,6 +246,8 @@ public:
 	MM_ScavengerStats incrementScavengerStats; /**< scavengerStats for the current phase/increment; typically just used for reporting purposes */
 	MM_ScavengerStats scavengerStats; /**< cumulative scavengerStats for all phases/increments (STW and concurrent) within a single cycle; typically used for various heursitics at the end of GC */
 	MM_ScavengerCopyScanRatio copyScanRatio; /* Most recent estimate of ratio of aggregate slots copied to slots scanned in completeScan() */
+	MM_ScavengerSiteSurvivalTracker scavengerSiteSurvivalTracker; /**< per allocation site survival rates used for pretenuring */
+	MM_ScavengerThreadCountPredictor scavengerThreadCountPredictor; /**< predicted scavenge work used to select the number of GC threads */
 #endif /* OMR_GC_MODRON_SCAVENGER */
 #if defined(OMR_GC_VLHGC)
 	MM_GlobalVLHGCStats globalVLHGCStats; /**< Global summary of all GC activity for VLHGC */
@@ -362,6 +366,8 @@ public:
 	float darkMatterCompactThreshold; /**< Value used to trigger compaction when dark matter ratio reaches this percentage of memory pools memory*/
 	
 	uintptr_t parSweepChunkSize;
+	uintptr_t parallelHeapWalkChunkFactor; /**< number of chunks per GC thread each region is split into by batched parallel heap walks */
+	uintptr_t parallelHeapWalkMinimumChunkSize; /**< lower bound (in bytes) on the chunk size used by batched parallel heap walks */
 	uintptr_t heapExpansionMinimumSize;
 	uintptr_t heapExpansionMaximumSize;
 	uintptr_t heapFreeMinimumRatioDivisor;
@@ -382,6 +388,7 @@ public:
 	
 	uintptr_t markingArraySplitMaximumAmount; /**< maximum number of elements to split array scanning work in marking scheme */
 	uintptr_t markingArraySplitMinimumAmount; /**< minimum number of elements to split array scanning work in marking scheme */
+	bool markingArraySplitInMarkingScheme; /**< if true, the marking scheme partitions indexable object scanners; false for delegates that split arrays themselves */
 
 	bool rootScannerStatsEnabled; /**< Enable/disable recording of performance statistics for the root scanner.  Defaults to false. */
 	bool rootScannerStatsUsed; /**< Flag that indicates if rootScannerStats are used for in the last increment (by any thread, for any of its roots) */
@@ -453,6 +460,15 @@ public:
 	bool scvTenureStrategyAdaptive; /**< Flag for enabling the Adaptive scavenger tenure strategy. */
 	bool scvTenureStrategyLookback; /**< Flag for enabling the Lookback scavenger tenure strategy. */
 	bool scvTenureStrategyHistory; /**< Flag for enabling the History scavenger tenure strategy. */
+	bool scavengerPretenureSites; /**< Flag for enabling allocation site survival tracking and pretenuring of long lived allocation sites. */
+	double scavengerPretenureSiteSurvivalThreshold; /**< The survival rate (from 0.0 to 1.0) of never flipped objects above which an allocation site is considered long lived. */
+	uintptr_t scavengerPretenureSiteMinimumScavenges; /**< The number of consecutive scavenges a site must be long lived in before it is pretenured. */
+	uintptr_t scavengerPretenureSiteRetryScavenges; /**< The number of scavenges after which a pretenured site is re-evaluated. */
+	bool scavengerAdaptiveThreadCount; /**< Flag for selecting the number of GC threads for each scavenge from its predicted work. */
+	uintptr_t scavengerAdaptiveThreadCountBytesPerThread; /**< The amount of predicted scavenge work, in bytes, that justifies dispatching one GC thread. */
+	uintptr_t scavengerAdaptiveThreadCountRememberedEntryWeight; /**< The work, in bytes, attributed to each remembered set entry. */
+	double scavengerAdaptiveThreadCountHistoryWeight; /**< The weight (from 0.0 to 1.0) given to history when predicting bytes copied by the next scavenge. */
+	uintptr_t scavengerRememberedSetPruneChunkSlots; /**< The number of remembered set slots pruned as a single work unit at the end of a scavenge. */
 	bool scavengerEnabled;
 	bool scavengerRsoScanUnsafe;
 	uintptr_t cacheListSplit; /**< the number of ways to split scanCache lists, set by -XXgc:cacheListLockSplit=, or determined heuristically based on the number of GC threads */
@@ -1347,6 +1363,8 @@ public:
 		, incrementScavengerStats()
 		, scavengerStats()
 		, copyScanRatio()
+		, scavengerSiteSurvivalTracker()
+		, scavengerThreadCountPredictor()
 #endif /* OMR_GC_MODRON_SCAVENGER */		
 #if defined(OMR_GC_VLHGC)
 		, globalVLHGCStats()
@@ -1435,6 +1453,8 @@ public:
 		, absoluteMinimumNewSubSpaceSize(MINIMUM_NEW_SPACE_SIZE)
 		, darkMatterCompactThreshold((float)0.15)
 		, parSweepChunkSize(0)
+		, parallelHeapWalkChunkFactor(8)
+		, parallelHeapWalkMinimumChunkSize(256 * 1024)
 		, heapExpansionMinimumSize(1024 * 1024)
 		, heapExpansionMaximumSize(0)
 		, heapFreeMinimumRatioDivisor(100)
@@ -1452,6 +1472,7 @@ public:
 		, packetListSplit(0)
 		, markingArraySplitMaximumAmount(DEFAULT_ARRAY_SPLIT_MAXIMUM_SIZE)
 		, markingArraySplitMinimumAmount(DEFAULT_ARRAY_SPLIT_MINIMUM_SIZE)
+		, markingArraySplitInMarkingScheme(true)
 		, rootScannerStatsEnabled(false)
 		, rootScannerStatsUsed(false)
 		, fvtest_forceOldResize(0)
@@ -1509,6 +1530,15 @@ public:
 		, scvTenureStrategyAdaptive(true)
 		, scvTenureStrategyLookback(true)
 		, scvTenureStrategyHistory(true)
+		, scavengerPretenureSites(false)
+		, scavengerPretenureSiteSurvivalThreshold(0.8)
+		, scavengerPretenureSiteMinimumScavenges(3)
+		, scavengerPretenureSiteRetryScavenges(32)
+		, scavengerAdaptiveThreadCount(false)
+		, scavengerAdaptiveThreadCountBytesPerThread(512 * 1024)
+		, scavengerAdaptiveThreadCountRememberedEntryWeight(64)
+		, scavengerAdaptiveThreadCountHistoryWeight(0.5)
+		, scavengerRememberedSetPruneChunkSlots(256)
 		, scavengerEnabled(false)
 		, scavengerRsoScanUnsafe(false)
 		, cacheListSplit(0)
@@ -108,8 +108,14 @@ public:
 	*/
 	MMINLINE omrobjectptr_t const getArrayObject() { return _arrayPtr; }
 
+	/**
+	 * Return the size of an array element in bytes
+	 */
+	MMINLINE uintptr_t getElementSize() { return _elementSize; }
+
 	/**
 	 * Split this instance and set split scan/end pointers to indicate split scan range.
+	 * The split scan range starts at the end pointer of this instance.
 	 *
 	 * @param env The scanning thread environment
 	 * @param allocSpace Pointer to memory where split scanner will be instantiated (in-place)
@@ -117,6 +123,23 @@ public:
 	 * @return Pointer to split scanner in allocSpace
 	 */
 	virtual GC_IndexableObjectScanner *splitTo(MM_EnvironmentBase *env, void *allocSpace, uintptr_t splitAmount) = 0;
+
+	/**
+	 * Split a scanner for the array elements starting at an arbitrary index. This instance is truncated
+	 * at startIndex and must not be used for scanning afterwards.
+	 *
+	 * @param env The scanning thread environment
+	 * @param allocSpace Pointer to memory where split scanner will be instantiated (in-place)
+	 * @param startIndex The index of the first array element to include
+	 * @param splitAmount The maximum number of array elements to include
+	 * @return Pointer to split scanner in allocSpace
+	 */
+	MMINLINE GC_IndexableObjectScanner *
+	splitAt(MM_EnvironmentBase *env, void *allocSpace, uintptr_t startIndex, uintptr_t splitAmount)
+	{
+		_endPtr = (fomrobject_t *)((uintptr_t)_basePtr + (startIndex * _elementSize));
+		return splitTo(env, allocSpace, splitAmount);
+	}
 };
 
 #endif /* INDEXABLEOBJECTSCANNER_HPP_ */
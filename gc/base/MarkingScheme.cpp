@@ -31,6 +31,7 @@
 #include "ConcurrentGCStats.hpp"
 #endif /* defined(OMR_GC_MODRON_CONCURRENT_MARK) */
 #include "Configuration.hpp"
+#include "Dispatcher.hpp"
 #include "EnvironmentBase.hpp"
 #include "GCExtensionsBase.hpp"
 #include "Heap.hpp"
@@ -295,8 +296,12 @@ MM_MarkingScheme::scanObject(MM_EnvironmentBase *env, omrobjectptr_t objectPtr)
 {
 	uintptr_t sizeToDo = UDATA_MAX;
 	GC_ObjectScannerState objectScannerState;
+	GC_ObjectScannerState splitScannerState;
 	GC_ObjectScanner *objectScanner = _delegate.getObjectScanner(env, objectPtr, &objectScannerState, SCAN_REASON_PACKET, &sizeToDo);
 	if (NULL != objectScanner) {
+		if (_extensions->markingArraySplitInMarkingScheme && objectScanner->isIndexableObject() && !objectScanner->isIndexableObjectNoSplit()) {
+			objectScanner = splitIndexableObjectScanner(env, objectScanner, &splitScannerState, SCAN_REASON_PACKET, &sizeToDo);
+		}
 		bool isLeafSlot = false;
 		GC_SlotObject *slotObject;
 #if defined(OMR_GC_LEAF_BITS)
@@ -313,6 +318,61 @@ MM_MarkingScheme::scanObject(MM_EnvironmentBase *env, omrobjectptr_t objectPtr)
 }
 
 
+uintptr_t
+MM_MarkingScheme::getArraySplitAmount(MM_EnvironmentBase *env, uintptr_t sizeInElements)
+{
+	/* the more threads are idle, the smaller the split amount, so that a large array is shared among them quickly */
+	uintptr_t splitAmount = sizeInElements / (_extensions->dispatcher->activeThreadCount() + (2 * _workPackets->getThreadWaitCount()));
+	splitAmount = OMR_MAX(splitAmount, _extensions->markingArraySplitMinimumAmount);
+	splitAmount = OMR_MIN(splitAmount, _extensions->markingArraySplitMaximumAmount);
+	return splitAmount;
+}
+
+GC_ObjectScanner *
+MM_MarkingScheme::splitIndexableObjectScanner(MM_EnvironmentBase *env, GC_ObjectScanner *objectScanner, void *splitScannerSpace, MM_MarkingSchemeScanReason reason, uintptr_t *sizeToDo)
+{
+	GC_IndexableObjectScanner *indexableScanner = (GC_IndexableObjectScanner *)objectScanner;
+	omrobjectptr_t arrayPtr = indexableScanner->getArrayObject();
+	uintptr_t elementSize = indexableScanner->getElementSize();
+	uintptr_t maxIndex = indexableScanner->getIndexableRange();
+	uintptr_t startIndex = 0;
+
+	if (SCAN_REASON_PACKET == reason) {
+		/* a split array work item is the array object on top of its tagged start index */
+		uintptr_t workItem = (uintptr_t)env->_workStack.peek(env);
+		if (PACKET_ARRAY_SPLIT_TAG == (workItem & PACKET_ARRAY_SPLIT_TAG)) {
+			env->_workStack.pop(env);
+			startIndex = workItem >> PACKET_ARRAY_SPLIT_SHIFT;
+			env->_markStats._splitArrayItemsScanned += 1;
+		}
+	}
+
+	uintptr_t splitAmount = getArraySplitAmount(env, maxIndex - startIndex);
+	if (UDATA_MAX != *sizeToDo) {
+		/* caller is working to a budget (concurrent tracing or card cleaning) -- do not scan much more than that */
+		splitAmount = OMR_MIN(splitAmount, OMR_MAX(*sizeToDo / elementSize, _extensions->markingArraySplitMinimumAmount));
+	}
+
+	if ((0 == startIndex) && ((maxIndex - startIndex) <= splitAmount)) {
+		/* array is small enough to be scanned in one piece by the delegate's scanner */
+		return objectScanner;
+	}
+
+	uintptr_t endIndex = OMR_MIN(startIndex + splitAmount, maxIndex);
+	if (endIndex < maxIndex) {
+		/* push the remainder before scanning so that idle threads can pick it up */
+		env->_workStack.push(env, (void *)arrayPtr, (void *)((endIndex << PACKET_ARRAY_SPLIT_SHIFT) | PACKET_ARRAY_SPLIT_TAG));
+		env->_markStats._splitArrayItemsCreated += 1;
+	}
+
+	*sizeToDo = (endIndex - startIndex) * elementSize;
+	if (0 == startIndex) {
+		/* the array header is accounted for with the first segment */
+		*sizeToDo += _extensions->objectModel.getHeaderSize(arrayPtr);
+	}
+	return indexableScanner->splitAt(env, splitScannerSpace, startIndex, endIndex - startIndex);
+}
+
 /**
  * Scan until there are no more work packets to be processed.
  * @note This is a joining scan: a thread will not exit this method until
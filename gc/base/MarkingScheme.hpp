@@ -31,6 +31,7 @@
 
 #include "EnvironmentBase.hpp"
 #include "GCExtensionsBase.hpp"
+#include "IndexableObjectScanner.hpp"
 #include "MarkingDelegate.hpp"
 #include "MarkMap.hpp"
 #include "ModronAssertions.h"
@@ -78,6 +79,32 @@ private:
 
 	MM_WorkPackets *createWorkPackets(MM_EnvironmentBase *env);
 
+	/**
+	 * Determine the number of array elements to scan as one work item. The split amount is proportional to
+	 * the remaining size of the array and shrinks as more threads are waiting for work, while obeying
+	 * GCExtensionsBase::markingArraySplitMinimumAmount and markingArraySplitMaximumAmount.
+	 *
+	 * @param[in] env calling thread environment
+	 * @param sizeInElements number of array elements remaining to be scanned
+	 * @return the number of elements to scan in the calling thread
+	 */
+	uintptr_t getArraySplitAmount(MM_EnvironmentBase *env, uintptr_t sizeInElements);
+
+	/**
+	 * Partition the elements of an indexable object for scanning by multiple threads. The calling thread
+	 * scans one segment of the array; the remaining elements are pushed back to the work stack as a split
+	 * array work item (the array object followed by its PACKET_ARRAY_SPLIT_TAG tagged start index) for any
+	 * thread to pick up.
+	 *
+	 * @param[in] env calling thread environment
+	 * @param[in] objectScanner the scanner for the whole indexable object, as provided by the marking delegate
+	 * @param[in] splitScannerSpace space to instantiate the scanner for the segment in
+	 * @param[in] reason enumerator identifying scanning context
+	 * @param[in/out] sizeToDo maximum number of bytes to scan; set to the number of bytes to be scanned
+	 * @return the scanner for the segment to be scanned by the calling thread
+	 */
+	GC_ObjectScanner *splitIndexableObjectScanner(MM_EnvironmentBase *env, GC_ObjectScanner *objectScanner, void *splitScannerSpace, MM_MarkingSchemeScanReason reason, uintptr_t *sizeToDo);
+
 protected:
 	virtual bool initialize(MM_EnvironmentBase *env);
 	virtual void tearDown(MM_EnvironmentBase *env);
@@ -232,8 +259,12 @@ public:
 	scanObject(MM_EnvironmentBase *env, omrobjectptr_t objectPtr, MM_MarkingSchemeScanReason reason, uintptr_t sizeToDo = UDATA_MAX)
 	{
 		GC_ObjectScannerState objectScannerState;
+		GC_ObjectScannerState splitScannerState;
 		GC_ObjectScanner *objectScanner = _delegate.getObjectScanner(env, objectPtr, &objectScannerState, reason, &sizeToDo);
 		if (NULL != objectScanner) {
+			if (_extensions->markingArraySplitInMarkingScheme && objectScanner->isIndexableObject() && !objectScanner->isIndexableObjectNoSplit()) {
+				objectScanner = splitIndexableObjectScanner(env, objectScanner, &splitScannerState, reason, &sizeToDo);
+			}
 			bool isLeafSlot = false;
 			GC_SlotObject *slotObject;
 #if defined(OMR_GC_LEAF_BITS)
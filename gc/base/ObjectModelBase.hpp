@@ -312,6 +312,19 @@ public:
 	{
 		_delegate.calculateObjectDetailsForCopy(env, forwardedHeader, objectCopySizeInBytes, objectReserveSizeInBytes, hotFieldAlignmentDescriptor);
 	}
+
+	/**
+	 * Get the language-defined allocation site of a forwarded object, as set with
+	 * MM_AllocateInitialization::setAllocationSite() when the object was allocated.
+	 *
+	 * @param[in] forwardedHeader pointer to the MM_ForwardedHeader instance encapsulating the object
+	 * @return the allocation site, or 0 if not known
+	 */
+	MMINLINE uintptr_t
+	getAllocationSite(MM_ForwardedHeader *forwardedHeader)
+	{
+		return _delegate.getAllocationSite(forwardedHeader);
+	}
 #endif /* defined(OMR_GC_MODRON_SCAVENGER) */
 
 	/**
@@ -27,6 +27,7 @@
 #include "GCExtensionsBase.hpp"
 #include "ParallelTask.hpp"
 #include "Dispatcher.hpp"
+#include "HeapMap.hpp"
 #include "HeapMapIterator.hpp"
 #include "HeapRegionIterator.hpp"
 #include "HeapRegionDescriptor.hpp"
@@ -80,6 +81,44 @@ public:
 	}
 };
 
+/**
+ * Task used to walk the heap in parallel, delivering objects to the callback in batches.
+ * @ingroup GC_Modron_Standard
+ */
+class MM_ParallelObjectBatchDoTask : public MM_ParallelTask
+{
+	/*
+	 * Data members
+	 */
+private:
+	MM_HeapWalkerObjectBatchFunc _function;
+	void *_userData;
+	uintptr_t _walkFlags;
+
+	MM_ParallelHeapWalker *_heapWalker;
+
+protected:
+public:
+
+	/*
+	 * Function members
+	 */
+public:
+	virtual uintptr_t getVMStateID() { return OMRVMSTATE_GC_PARALLEL_OBJECT_DO; };
+
+	virtual void run(MM_EnvironmentBase *env);
+
+	MM_ParallelObjectBatchDoTask(MM_EnvironmentBase *env, MM_ParallelHeapWalker *heapWalker, MM_HeapWalkerObjectBatchFunc function, void *userData, uintptr_t walkFlags)
+		: MM_ParallelTask(env, env->getExtensions()->dispatcher)
+		, _function(function)
+		, _userData(userData)
+		, _walkFlags(walkFlags)
+		, _heapWalker(heapWalker)
+	{
+		_typeId = __FUNCTION__;
+	}
+};
+
 /**
  * newInstance of Parallel Heap Walker
  */
@@ -137,6 +176,87 @@ MM_ParallelHeapWalker::allObjectsDoParallel(MM_EnvironmentBase *env, MM_HeapWalk
 	Trc_MM_ParallelHeapWalker_allObjectsDoParallel_Exit(env->getLanguageVMThread(), heapChunkFactor, parallelChunkSize, objectsWalked);
 }
 
+uintptr_t
+MM_ParallelHeapWalker::getBatchedChunkSize(MM_EnvironmentBase *env, MM_HeapRegionDescriptor *region, uintptr_t threadCount)
+{
+	MM_GCExtensionsBase *extensions = env->getExtensions();
+	uintptr_t regionSize = region->getSize();
+	uintptr_t chunkSize = regionSize;
+
+	/* without a valid mark map the start of a chunk can not be found, so the region is walked as a single unit */
+	if ((threadCount > 1) && _markMap->isMarkMapValid()) {
+		chunkSize = regionSize / (threadCount * extensions->parallelHeapWalkChunkFactor);
+		chunkSize = OMR_MAX(chunkSize, extensions->parallelHeapWalkMinimumChunkSize);
+	}
+	return MM_Math::roundToCeiling(J9MODRON_HEAP_BYTES_PER_HEAPMAP_SLOT, OMR_MAX(chunkSize, (uintptr_t)1));
+}
+
+/**
+ * Walk through all objects of the heap in parallel and apply the provided function to batches of objects.
+ * Regions are split into mark map aligned chunks independently of each other and chunks are handed out to
+ * threads on demand, so threads which finish early keep picking up the remaining work.
+ */
+void
+MM_ParallelHeapWalker::allObjectsDoParallelBatched(MM_EnvironmentBase *env, MM_HeapWalkerObjectBatchFunc function, void *userData, uintptr_t walkFlags)
+{
+	Trc_MM_ParallelHeapWalker_allObjectsDoParallelBatched_Entry(env->getLanguageVMThread());
+	MM_GCExtensionsBase *extensions = env->getExtensions();
+	uintptr_t threadCount = env->_currentTask->getThreadCount();
+
+	omrobjectptr_t batch[PARALLEL_HEAP_WALK_BATCH_SIZE];
+	uintptr_t batchCount = 0;
+	uintptr_t batchesDelivered = 0;
+	uintptr_t objectsWalked = 0;
+
+	MM_HeapRegionManager *regionManager = extensions->heap->getHeapRegionManager();
+	regionManager->lock();
+	GC_HeapRegionIterator regionIterator(regionManager);
+	MM_HeapRegionDescriptor *region = NULL;
+	OMR_VMThread *omrVMThread = env->getOmrVMThread();
+
+	while (NULL != (region = regionIterator.nextRegion())) {
+		if (walkFlags == (region->getTypeFlags() & walkFlags)) {
+			uintptr_t chunkSize = getBatchedChunkSize(env, region, threadCount);
+			GC_ParallelObjectHeapIterator objectHeapIterator(env, region, region->getLowAddress(), region->getHighAddress(), _markMap, chunkSize);
+			omrobjectptr_t object = NULL;
+			while (NULL != (object = objectHeapIterator.nextObject())) {
+				batch[batchCount] = object;
+				batchCount += 1;
+				if (PARALLEL_HEAP_WALK_BATCH_SIZE == batchCount) {
+					function(omrVMThread, region, batch, batchCount, userData);
+					objectsWalked += batchCount;
+					batchesDelivered += 1;
+					batchCount = 0;
+				}
+			}
+			/* a batch never spans regions */
+			if (0 != batchCount) {
+				function(omrVMThread, region, batch, batchCount, userData);
+				objectsWalked += batchCount;
+				batchesDelivered += 1;
+				batchCount = 0;
+			}
+		}
+	}
+	regionManager->unlock();
+	Trc_MM_ParallelHeapWalker_allObjectsDoParallelBatched_Exit(env->getLanguageVMThread(), batchesDelivered, objectsWalked);
+}
+
+/**
+ * Walk through all objects of the heap using the GC threads and apply the provided function to batches of objects.
+ */
+void
+MM_ParallelHeapWalker::allObjectsDoBatched(MM_EnvironmentBase *env, MM_HeapWalkerObjectBatchFunc function, void *userData, uintptr_t walkFlags, bool prepareHeapForWalk)
+{
+	GC_OMRVMInterface::flushCachesForWalk(env->getOmrVM());
+	if (prepareHeapForWalk) {
+		_globalCollector->prepareHeapForWalk(env);
+	}
+
+	MM_ParallelObjectBatchDoTask objectBatchDoTask(env, this, function, userData, walkFlags);
+	env->getExtensions()->dispatcher->run(env, &objectBatchDoTask);
+}
+
 /**
  * Walk through all live objects of the heap and apply the provided function.
  * If parallel is set to true, task is dispatched to GC threads and walks the heap segments in parallel,
@@ -166,3 +286,12 @@ MM_ParallelObjectDoTask::run(MM_EnvironmentBase *env)
 {
 	_heapWalker->allObjectsDoParallel(env, _function, _userData, _walkFlags);
 }
+
+/**
+ * gets the heap walker and calls the batched parallel object walk
+ */
+void
+MM_ParallelObjectBatchDoTask::run(MM_EnvironmentBase *env)
+{
+	_heapWalker->allObjectsDoParallelBatched(env, _function, _userData, _walkFlags);
+}
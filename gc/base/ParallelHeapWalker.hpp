@@ -29,9 +29,15 @@
 #include "HeapWalker.hpp"
 
 class MM_EnvironmentBase;
+class MM_HeapRegionDescriptor;
 class MM_ParallelGlobalGC;
 class MM_MarkMap;
 
+/**
+ * Maximum number of objects delivered to a MM_HeapWalkerObjectBatchFunc in a single call.
+ */
+#define PARALLEL_HEAP_WALK_BATCH_SIZE 256
+
 class MM_ParallelHeapWalker : public MM_HeapWalker
 {
 	/*
@@ -47,6 +53,11 @@ public:
 	 * Function members
 	 */
 private:
+	/**
+	 * Determine the chunk size used to split a region for a batched parallel walk.
+	 * The result is aligned to the span of a mark map word so that every chunk starts on a mark map word boundary.
+	 */
+	uintptr_t getBatchedChunkSize(MM_EnvironmentBase *env, MM_HeapRegionDescriptor *region, uintptr_t threadCount);
 protected:
 public:	
 	/**
@@ -54,6 +65,19 @@ public:
 	 */
 	void allObjectsDoParallel(MM_EnvironmentBase *env, MM_HeapWalkerObjectFunc function, void *userData, uintptr_t walkFlags);
 
+	/**
+	 * Walk through all objects of the heap in parallel, delivering them to the provided function in batches
+	 * of at most PARALLEL_HEAP_WALK_BATCH_SIZE objects. Each region is split into chunks of its own, so work
+	 * is balanced across threads even when the heap is made of a few very large regions.
+	 */
+	void allObjectsDoParallelBatched(MM_EnvironmentBase *env, MM_HeapWalkerObjectBatchFunc function, void *userData, uintptr_t walkFlags);
+
+	/**
+	 * Walk through all objects of the heap using the GC threads and apply the provided function to batches of objects.
+	 * All objects of a batch belong to the same region. The function may be invoked concurrently from several threads.
+	 */
+	void allObjectsDoBatched(MM_EnvironmentBase *env, MM_HeapWalkerObjectBatchFunc function, void *userData, uintptr_t walkFlags, bool prepareHeapForWalk);
+
 	/**
 	 * Walk through all live objects of the heap and apply the provided function.
 	 * If parallel is set to true, task is dispatched to GC threads and walks the heap segments in parallel,
@@ -85,6 +109,7 @@ public:
 	 * Friends
 	 */
 	friend class MM_ParallelObjectDoTask;
+	friend class MM_ParallelObjectBatchDoTask;
 };
 
 #endif /* PARALLEL_HEAP_WALKER_HPP_ */
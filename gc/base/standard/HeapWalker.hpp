@@ -35,6 +35,7 @@ class MM_HeapRegionDescriptor;
 class MM_MemorySubSpace;
 
 typedef void (*MM_HeapWalkerObjectFunc)(OMR_VMThread *, MM_HeapRegionDescriptor *, omrobjectptr_t, void *);
+typedef void (*MM_HeapWalkerObjectBatchFunc)(OMR_VMThread *, MM_HeapRegionDescriptor *, omrobjectptr_t *, uintptr_t, void *);
 typedef void (*MM_HeapWalkerSlotFunc)(OMR_VM *, omrobjectptr_t *, void *, uint32_t);
 
 class MM_HeapWalker : public MM_BaseVirtual
@@ -30,6 +30,7 @@
 
 #include "AllocateDescription.hpp"
 #include "AllocationFailureStats.hpp"
+#include "AtomicOperations.hpp"
 #include "CollectionStatisticsStandard.hpp"
 #include "CollectorLanguageInterface.hpp"
 #if defined(OMR_GC_MODRON_COMPACTION)
@@ -181,6 +182,24 @@ fixObject(OMR_VMThread *omrVMThread, MM_HeapRegionDescriptor *region, omrobjectp
 	}
 }
 
+/**
+ * Function to fix a batch of objects on the heap
+ *
+ * The dead objects of the batch are counted locally and published to the shared counter once per batch,
+ * as the batch may be delivered concurrently with batches on other GC threads.
+ */
+static void
+fixObjects(OMR_VMThread *omrVMThread, MM_HeapRegionDescriptor *region, omrobjectptr_t *objects, uintptr_t objectCount, void *userData)
+{
+	uintptr_t fixedObjectCount = 0;
+	for (uintptr_t i = 0; i < objectCount; i++) {
+		fixObject(omrVMThread, region, objects[i], &fixedObjectCount);
+	}
+	if (0 != fixedObjectCount) {
+		MM_AtomicOperations::add((uintptr_t *)userData, fixedObjectCount);
+	}
+}
+
 #if defined(OMR_GC_MODRON_SCAVENGER)
 /**
  * Fix the heap if the remembered set for the scavenger is in an overflow state.
@@ -195,7 +214,7 @@ hookGlobalGcSweepEndRsoSafetyFixHeap(J9HookInterface** hook, uintptr_t eventNum,
 	extensions->scavengerRsoScanUnsafe = !extensions->isRememberedSetInOverflowState();
 	if (!extensions->scavengerRsoScanUnsafe) {
 		MM_ParallelGlobalGC *pggc = (MM_ParallelGlobalGC *)userData;
-		pggc->fixHeapForWalk(env, MEMORY_TYPE_OLD_RAM, FIXUP_DEBUG_TOOLING, fixObject);
+		pggc->fixHeapForWalk(env, MEMORY_TYPE_OLD_RAM, FIXUP_DEBUG_TOOLING, fixObjects);
 	}
 }
 
@@ -514,7 +533,7 @@ MM_ParallelGlobalGC::masterThreadGarbageCollect(MM_EnvironmentBase *env, MM_Allo
 			} else
 #endif /* OMR_GC_MODRON_COMPACTION */
 			{
-				fixHeapForWalk(env, MEMORY_TYPE_RAM, FIXUP_DEBUG_TOOLING, fixObject);
+				fixHeapForWalk(env, MEMORY_TYPE_RAM, FIXUP_DEBUG_TOOLING, fixObjects);
 			}
 			/* since this is the superset of all walk operations, we can safely set the flag that states other walks
 			 * can be omitted for this cycle as redundant (CMVC 122959)
@@ -1284,6 +1303,26 @@ MM_ParallelGlobalGC::fixHeapForWalk(MM_EnvironmentBase *env, UDATA walkFlags, ui
 	return fixedObjectCount;
 }
 
+uintptr_t
+MM_ParallelGlobalGC::fixHeapForWalk(MM_EnvironmentBase *env, UDATA walkFlags, uintptr_t walkReason, MM_HeapWalkerObjectBatchFunc walkFunction)
+{
+	uintptr_t fixedObjectCount = 0;
+
+	Trc_MM_FixHeapForWalk_Entry(env->getLanguageVMThread(), walkFlags);
+
+	OMRPORT_ACCESS_FROM_ENVIRONMENT(env);
+	U_64 startTime = omrtime_hires_clock();
+
+	_heapWalker->allObjectsDoBatched(env, walkFunction, &fixedObjectCount, walkFlags, false);
+
+	_extensions->globalGCStats.fixHeapForWalkTime = omrtime_hires_delta(startTime, omrtime_hires_clock(), OMRPORT_TIME_DELTA_IN_MICROSECONDS);
+	_extensions->globalGCStats.fixHeapForWalkReason = walkReason;
+
+	Trc_MM_FixHeapForWalk_Exit(env->getLanguageVMThread(), fixedObjectCount);
+
+	return fixedObjectCount;
+}
+
 /* (non-doxygen)
  * @see MM_GlobalCollector::heapAddRange()
  */
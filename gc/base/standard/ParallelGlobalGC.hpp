@@ -284,6 +284,11 @@ public:
 	 *  @param reason fix heap reason
 	 */
 	uintptr_t fixHeapForWalk(MM_EnvironmentBase *env, UDATA walkFlags, uintptr_t walkReason, MM_HeapWalkerObjectFunc walkFunction);
+	/**
+	 *  Fixes up all unloaded objects so that the heap can be walked, delivering objects to walkFunction in batches
+	 *  @param reason fix heap reason
+	 */
+	uintptr_t fixHeapForWalk(MM_EnvironmentBase *env, UDATA walkFlags, uintptr_t walkReason, MM_HeapWalkerObjectBatchFunc walkFunction);
 	MM_HeapWalker *getHeapWalker() { return _heapWalker; }
 	virtual void prepareHeapForWalk(MM_EnvironmentBase *env);
 
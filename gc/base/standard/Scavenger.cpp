@@ -82,6 +82,7 @@
 #include "ScavengerRootScanner.hpp"
 #include "ScavengerStats.hpp"
 #include "SlotObject.hpp"
+#include "SublistChunkSlotIterator.hpp"
 #include "SublistFragment.hpp"
 #include "SublistIterator.hpp"
 #include "SublistPool.hpp"
@@ -483,7 +484,15 @@ MM_Scavenger::scavenge(MM_EnvironmentBase *envBase)
 {
 	MM_EnvironmentStandard *env = MM_EnvironmentStandard::getEnvironment(envBase);
 	MM_ParallelScavengeTask scavengeTask(env, _dispatcher, this, env->_cycleState);
-	_dispatcher->run(env, &scavengeTask);
+	if (_extensions->scavengerAdaptiveThreadCount && !_extensions->gcThreadCountForced) {
+		/* Dispatch only as many threads as the predicted work can keep busy */
+		uintptr_t threadCount = _extensions->scavengerThreadCountPredictor.predictThreadCount(env, _extensions->getRememberedCount(), _dispatcher->threadCount());
+		_dispatcher->run(env, &scavengeTask, threadCount);
+		/* thread stats have been merged into the increment stats by the time the task completes */
+		_extensions->scavengerThreadCountPredictor.update(env, &_extensions->incrementScavengerStats, scavengeTask.getThreadCount());
+	} else {
+		_dispatcher->run(env, &scavengeTask);
+	}
 
 	/* remove all scan caches temporary allocated in Heap */
 	_scavengeCacheFreeList.removeAllHeapAllocatedChunks(env);
@@ -717,6 +726,10 @@ MM_Scavenger::mergeGCStatsBase(MM_EnvironmentBase *env, MM_ScavengerStats *final
 		finalGCStats->getFlipHistory(0)->_tenureBytes[i] += scavStats->getFlipHistory(0)->_tenureBytes[i];
 	}
 
+	for (uintptr_t i = 0; i < OMR_SCAVENGER_PRETENURE_SITES; i++) {
+		finalGCStats->_siteSurvivedBytes[i] += scavStats->_siteSurvivedBytes[i];
+	}
+
 	finalGCStats->_tenureExpandedBytes += scavStats->_tenureExpandedBytes;
 	finalGCStats->_tenureExpandedCount += scavStats->_tenureExpandedCount;
 	finalGCStats->_tenureExpandedTime += scavStats->_tenureExpandedTime;
@@ -1631,6 +1644,17 @@ MM_Scavenger::copy(MM_EnvironmentStandard *env, MM_ForwardedHeader* forwardedHea
 			scavStats->_flipBytes += objectCopySizeInBytes;
 			scavStats->getFlipHistory(0)->_flipBytes[oldObjectAge + 1] += objectReserveSizeInBytes;
 		}
+
+		/* Attribute first time survivors to their allocation site */
+		if ((0 == oldObjectAge) && _extensions->scavengerPretenureSites) {
+			uintptr_t allocationSite = _extensions->objectModel.getAllocationSite(forwardedHeader);
+			if (0 != allocationSite) {
+				intptr_t siteSlot = _extensions->scavengerSiteSurvivalTracker.findSlot(allocationSite, false);
+				if (0 <= siteSlot) {
+					scavStats->_siteSurvivedBytes[siteSlot] += objectReserveSizeInBytes;
+				}
+			}
+		}
 	} else {
 		/* We have not used the reserved space now, but we will for subsequent allocations. If this space was reserved for an individual object,
 		 * we might have created a TLH remainder from previous cache just before reserving this space. This space eventaully can create another remainder.
@@ -2619,10 +2643,14 @@ MM_Scavenger::pruneRememberedSetOverflow(MM_EnvironmentStandard *env)
 		clearRememberedSetOverflowState();
 		clearRememberedSetLists(env);
 
-		/* Walk the tenure memory subspace finding all tenured objects flagged as remembered */
-		MM_HeapRegionDescriptorStandard *region = NULL;
-		GC_MemorySubSpaceRegionIteratorStandard regionIterator(_tenureMemorySubSpace);
-		while((region = regionIterator.nextRegion()) != NULL) {
+		env->_currentTask->releaseSynchronizedGCThreads(env);
+	}
+
+	/* Walk the tenure memory subspace finding all tenured objects flagged as remembered, one region per work unit */
+	MM_HeapRegionDescriptorStandard *region = NULL;
+	GC_MemorySubSpaceRegionIteratorStandard regionIterator(_tenureMemorySubSpace);
+	while((region = regionIterator.nextRegion()) != NULL) {
+		if (J9MODRON_HANDLE_NEXT_WORK_UNIT(env)) {
 			/* Verify or clear remembered bits for each tenured object currently flagged as remembered */
 			GC_ObjectHeapIteratorAddressOrderedList objectIterator(_extensions, region, false);
 			omrobjectptr_t objectPtr;
@@ -2658,18 +2686,20 @@ MM_Scavenger::pruneRememberedSetOverflow(MM_EnvironmentStandard *env)
 				}
 			}
 		}
+	}
+
+	/* Objects may have been remembered during scan, fragment must be flushed */
+	flushRememberedSet(env);
 
+	if (env->_currentTask->synchronizeGCThreadsAndReleaseMaster(env, UNIQUE_ID)) {
 #if defined(OMR_SCAVENGER_TRACE_REMEMBERED_SET)
+		OMRPORT_ACCESS_FROM_OMRPORT(env->getPortLibrary());
 		if(isRememberedSetInOverflowState()) {
 			omrtty_printf("{SCAV: Pruned remembered set still in overflow}\n");
 		} else {
 			omrtty_printf("{SCAV: Pruned remembered set no longer in overflow}\n");
 		}
 #endif /* OMR_SCAVENGER_TRACE_REMEMBERED_SET */
-
-		/* Objects may have been remembered during scan, fragment must be flushed */
-		flushRememberedSet(env);
-
 		env->_currentTask->releaseSynchronizedGCThreads(env);
 	}
 }
@@ -2681,66 +2711,86 @@ MM_Scavenger::pruneRememberedSetList(MM_EnvironmentStandard *env)
 	omrobjectptr_t *slotPtr;
 	omrobjectptr_t objectPtr;
 	MM_SublistPuddle *puddle;
+	uintptr_t chunkSlots = _extensions->scavengerRememberedSetPruneChunkSlots;
 
 #if defined(OMR_SCAVENGER_TRACE_REMEMBERED_SET)
 	OMRPORT_ACCESS_FROM_OMRPORT(env->getPortLibrary());
 	omrtty_printf("{SCAV: Begin prune remembered set list; count = %lld}\n", _extensions->rememberedSet.countElements());
 #endif /* OMR_SCAVENGER_TRACE_REMEMBERED_SET */
 
+	/* Each chunk of each puddle is a work unit, so that a few large puddles are still shared among all threads.
+	 * Removed slots are nulled, and compacted out of their puddles once every chunk has been processed.
+	 */
 	GC_SublistIterator remSetIterator(&(_extensions->rememberedSet));
 	while((puddle = remSetIterator.nextList()) != NULL) {
-		if(J9MODRON_HANDLE_NEXT_WORK_UNIT(env)) {
-			GC_SublistSlotIterator remSetSlotIterator(puddle);
-			while((slotPtr = (omrobjectptr_t *)remSetSlotIterator.nextSlot()) != NULL) {
-				objectPtr = *slotPtr;
-
-				if (NULL == objectPtr) {
-					remSetSlotIterator.removeSlot();
-				} else if((uintptr_t)objectPtr & DEFERRED_RS_REMOVE_FLAG) {
-					/* Is slot flagged for deferred removal ? */
-					/* Yes..so first remove tag bit from object address */
-					objectPtr = (omrobjectptr_t)((uintptr_t)objectPtr & ~(uintptr_t)DEFERRED_RS_REMOVE_FLAG);
-					/* The object did not have Nursery references at initial RS scan, but one could have been added during CS cycle by a mutator. */
-					if (!IS_CONCURRENT_ENABLED || !shouldRememberObject(env, objectPtr)) {
+		uintptr_t chunkCount = GC_SublistChunkSlotIterator::getChunkCount(puddle, chunkSlots);
+		for (uintptr_t chunkIndex = 0; chunkIndex < chunkCount; chunkIndex++) {
+			if(J9MODRON_HANDLE_NEXT_WORK_UNIT(env)) {
+				uintptr_t removedCount = 0;
+				GC_SublistChunkSlotIterator remSetSlotIterator(puddle, chunkIndex, chunkSlots);
+				while((slotPtr = (omrobjectptr_t *)remSetSlotIterator.nextSlot()) != NULL) {
+					objectPtr = *slotPtr;
+
+					if (NULL == objectPtr) {
+						/* Already empty, will be removed with the other null slots of the puddle */
+					} else if((uintptr_t)objectPtr & DEFERRED_RS_REMOVE_FLAG) {
+						/* Is slot flagged for deferred removal ? */
+						/* Yes..so first remove tag bit from object address */
+						objectPtr = (omrobjectptr_t)((uintptr_t)objectPtr & ~(uintptr_t)DEFERRED_RS_REMOVE_FLAG);
+						/* The object did not have Nursery references at initial RS scan, but one could have been added during CS cycle by a mutator. */
+						if (!IS_CONCURRENT_ENABLED || !shouldRememberObject(env, objectPtr)) {
 #if defined(OMR_SCAVENGER_TRACE_REMEMBERED_SET)
-						omrtty_printf("{SCAV: REMOVED remembered set object %p}\n", objectPtr);
+							omrtty_printf("{SCAV: REMOVED remembered set object %p}\n", objectPtr);
 #endif /* OMR_SCAVENGER_TRACE_REMEMBERED_SET */
 
-						/* A simple mask out can be used - we are guaranteed to be the only manipulator of the object */
-						_extensions->objectModel.clearRemembered(objectPtr);
-						remSetSlotIterator.removeSlot();
-						/* Inform interested parties (Concurrent Marker) that an object has been removed from the remembered set.
-						 * In non-concurrent Scavenger this is the only way to create an old-to-old reference, that has parent object being marked.
-						 * In Concurrent Scavenger, it can be created even with parent object that was not in RS to start with. So this is handled
-						 * in a more generic spot when object is scavenged and is unnecessary to do it here.
-						 */
+							/* A simple mask out can be used - we are guaranteed to be the only manipulator of the object */
+							_extensions->objectModel.clearRemembered(objectPtr);
+							*slotPtr = NULL;
+							removedCount += 1;
+							/* Inform interested parties (Concurrent Marker) that an object has been removed from the remembered set.
+							 * In non-concurrent Scavenger this is the only way to create an old-to-old reference, that has parent object being marked.
+							 * In Concurrent Scavenger, it can be created even with parent object that was not in RS to start with. So this is handled
+							 * in a more generic spot when object is scavenged and is unnecessary to do it here.
+							 */
 #if defined(OMR_GC_MODRON_CONCURRENT_MARK)
-						if (_extensions->shouldScavengeNotifyGlobalGCOfOldToOldReference() && !IS_CONCURRENT_ENABLED) {
-							oldToOldReferenceCreated(env, objectPtr);
-						}
+							if (_extensions->shouldScavengeNotifyGlobalGCOfOldToOldReference() && !IS_CONCURRENT_ENABLED) {
+								oldToOldReferenceCreated(env, objectPtr);
+							}
 #endif /* OMR_GC_MODRON_CONCURRENT_MARK */
-					}
+						}
 #if defined(OMR_GC_CONCURRENT_SCAVENGER)
-					else {
-						/* We are not removing it after all, since the object has Nursery references => reset the deferred flag.
-						 * todo: consider doing double remembering, if remembered during CS cycle, to avoid the rescan of the object
-						 */
-						*slotPtr = objectPtr;
-					}
+						else {
+							/* We are not removing it after all, since the object has Nursery references => reset the deferred flag.
+							 * todo: consider doing double remembering, if remembered during CS cycle, to avoid the rescan of the object
+							 */
+							*slotPtr = objectPtr;
+						}
 #endif /* OMR_GC_CONCURRENT_SCAVENGER */
 
-				} else {
-					/* Retain remembered object */
+					} else {
+						/* Retain remembered object */
 #if defined(OMR_SCAVENGER_TRACE_REMEMBERED_SET)
-					omrtty_printf("{SCAV: Remembered set object %p}\n", objectPtr);
+						omrtty_printf("{SCAV: Remembered set object %p}\n", objectPtr);
 #endif /* OMR_SCAVENGER_TRACE_REMEMBERED_SET */
 
-					if (!IS_CONCURRENT_ENABLED && processRememberedThreadReference(env, objectPtr)) {
-						/* the object was tenured from the stack on a previous scavenge -- keep it around for a bit longer */
-						Trc_MM_ParallelScavenger_scavengeRememberedSet_keepingRememberedObject(env->getLanguageVMThread(), objectPtr, _extensions->objectModel.getRememberedBits(objectPtr));
+						if (!IS_CONCURRENT_ENABLED && processRememberedThreadReference(env, objectPtr)) {
+							/* the object was tenured from the stack on a previous scavenge -- keep it around for a bit longer */
+							Trc_MM_ParallelScavenger_scavengeRememberedSet_keepingRememberedObject(env->getLanguageVMThread(), objectPtr, _extensions->objectModel.getRememberedBits(objectPtr));
+						}
 					}
-				}
-			} /* while non-null slots */
+				} /* while non-null slots */
+				_extensions->rememberedSet.decrementCount(removedCount);
+			}
+		}
+	}
+
+	/* All chunks must be pruned before any puddle is compacted */
+	env->_currentTask->synchronizeGCThreads(env, UNIQUE_ID);
+
+	GC_SublistIterator compactIterator(&(_extensions->rememberedSet));
+	while((puddle = compactIterator.nextList()) != NULL) {
+		if(J9MODRON_HANDLE_NEXT_WORK_UNIT(env)) {
+			puddle->removeNullSlots();
 		}
 	}
 #if defined(OMR_SCAVENGER_TRACE_REMEMBERED_SET)
@@ -3987,6 +4037,11 @@ MM_Scavenger::masterThreadGarbageCollect(MM_EnvironmentBase *envBase, MM_Allocat
 			/* Defer to collector language interface */
 			_delegate.masterThreadGarbageCollect_scavengeSuccess(env);
 
+			if (_extensions->scavengerPretenureSites) {
+				/* Flag allocation sites whose objects consistently survive for pretenuring */
+				_extensions->scavengerSiteSurvivalTracker.update(env, &_extensions->scavengerStats);
+			}
+
 			if(_extensions->scvTenureStrategyAdaptive) {
 				/* Adjust the tenure age based on the percentage of new space used.  Also, avoid / by 0 */
 				uintptr_t newSpaceTotalSize = _activeSubSpace->getMemorySubSpaceAllocate()->getActiveMemorySize();
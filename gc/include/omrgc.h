@@ -40,6 +40,10 @@ extern "C" {
 /* Allocation description will be initialized in call */
 omrobjectptr_t OMR_GC_AllocateObject(OMR_VMThread * omrVMThread, uintptr_t allocationCategory, uintptr_t requiredSizeInBytes, uintptr_t objectAllocationFlags);
 
+/* Allocation description will be initialized in call and associated with the language-defined (non-zero) allocation site.
+ * With OMR_GC_ALLOCATE_OBJECT_PRETENURE_BY_SITE selected, objects from sites found to be long lived are allocated in old space. */
+omrobjectptr_t OMR_GC_AllocateObjectAtSite(OMR_VMThread * omrVMThread, uintptr_t allocationCategory, uintptr_t allocationSite, uintptr_t requiredSizeInBytes, uintptr_t objectAllocationFlags);
+
 omr_error_t OMR_GC_SystemCollect(OMR_VMThread* omrVMThread, uint32_t gcCode);
 
 #ifdef __cplusplus
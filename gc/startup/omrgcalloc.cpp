@@ -46,6 +46,15 @@ OMR_GC_AllocateObject(OMR_VMThread * omrVMThread, uintptr_t allocationCategory,
 	return OMR_GC_AllocateObject(omrVMThread, &allocator);
 }
 
+omrobjectptr_t
+OMR_GC_AllocateObjectAtSite(OMR_VMThread * omrVMThread, uintptr_t allocationCategory, uintptr_t allocationSite, uintptr_t requiredSizeInBytes, uintptr_t allocationFlags)
+{
+	MM_EnvironmentBase *env = MM_EnvironmentBase::getEnvironment(omrVMThread);
+	MM_AllocateInitialization allocator(env, allocationCategory, requiredSizeInBytes, allocationFlags);
+	allocator.setAllocationSite(env, allocationSite);
+	return OMR_GC_AllocateObject(omrVMThread, &allocator);
+}
+
 omr_error_t
 OMR_GC_SystemCollect(OMR_VMThread* omrVMThread, uint32_t gcCode)
 {
@@ -0,0 +1,76 @@
+/*******************************************************************************
+ * Copyright (c) 2020, 2020 IBM Corp. and others
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at https://www.eclipse.org/legal/epl-2.0/
+ * or the Apache License, Version 2.0 which accompanies this distribution and
+ * is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following
+ * Secondary Licenses when the conditions for such availability set
+ * forth in the Eclipse Public License, v. 2.0 are satisfied: GNU
+ * General Public License, version 2 with the GNU Classpath
+ * Exception [1] and GNU General Public License, version 2 with the
+ * OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] http://openjdk.java.net/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
+ *******************************************************************************/
+
+#include "ModronAssertions.h"
+#include "ut_j9mm.h"
+
+#include "EnvironmentBase.hpp"
+#include "GCExtensionsBase.hpp"
+#include "ScavengerStats.hpp"
+
+#include "ScavengerSiteSurvivalTracker.hpp"
+
+void
+MM_ScavengerSiteSurvivalTracker::update(MM_EnvironmentBase *env, MM_ScavengerStats *scavengerStats)
+{
+	MM_GCExtensionsBase *extensions = env->getExtensions();
+	uintptr_t pretenuredSiteCount = 0;
+
+	for (uintptr_t slot = 0; slot < OMR_SCAVENGER_PRETENURE_SITES; slot++) {
+		SiteEntry *entry = &_sites[slot];
+		if (0 == entry->site) {
+			continue;
+		}
+
+		/* mutators are stopped, so the allocation sample can be harvested without atomics */
+		uintptr_t allocatedBytes = entry->allocatedBytes;
+		uintptr_t survivedBytes = scavengerStats->_siteSurvivedBytes[slot];
+		entry->allocatedBytes = 0;
+
+		if (0 != entry->pretenureScavengesRemaining) {
+			/* objects from pretenured sites bypass new space, so there is nothing to measure until the flag expires */
+			entry->pretenureScavengesRemaining -= 1;
+			if (0 == entry->pretenureScavengesRemaining) {
+				entry->survivingScavenges = 0;
+				Trc_MM_ScavengerSiteSurvivalTracker_siteReleased(env->getLanguageVMThread(), entry->site);
+			}
+		} else if (SCAVENGER_PRETENURE_SITE_MINIMUM_BYTES <= allocatedBytes) {
+			/* allocated bytes are sampled, so the ratio may slightly exceed 1.0 */
+			entry->survivalRate = OMR_MIN(1.0, (double)survivedBytes / (double)allocatedBytes);
+			if (entry->survivalRate >= extensions->scavengerPretenureSiteSurvivalThreshold) {
+				entry->survivingScavenges += 1;
+				if (entry->survivingScavenges >= extensions->scavengerPretenureSiteMinimumScavenges) {
+					entry->pretenureScavengesRemaining = extensions->scavengerPretenureSiteRetryScavenges;
+					Trc_MM_ScavengerSiteSurvivalTracker_sitePretenured(env->getLanguageVMThread(), entry->site, entry->survivalRate, entry->survivingScavenges);
+				}
+			} else {
+				entry->survivingScavenges = 0;
+			}
+		}
+
+		if (0 != entry->pretenureScavengesRemaining) {
+			pretenuredSiteCount += 1;
+		}
+	}
+
+	_pretenuredSiteCount = pretenuredSiteCount;
+}
@@ -0,0 +1,172 @@
+/*******************************************************************************
+ * Copyright (c) 2020, 2020 IBM Corp. and others
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at https://www.eclipse.org/legal/epl-2.0/
+ * or the Apache License, Version 2.0 which accompanies this distribution and
+ * is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following
+ * Secondary Licenses when the conditions for such availability set
+ * forth in the Eclipse Public License, v. 2.0 are satisfied: GNU
+ * General Public License, version 2 with the GNU Classpath
+ * Exception [1] and GNU General Public License, version 2 with the
+ * OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] http://openjdk.java.net/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
+ *******************************************************************************/
+
+#ifndef SCAVENGERSITESURVIVALTRACKER_HPP_
+#define SCAVENGERSITESURVIVALTRACKER_HPP_
+
+#include <string.h>
+
+#include "omrcfg.h"
+#include "modronbase.h"
+
+#include "AtomicOperations.hpp"
+#include "ScavengerStats.hpp"
+
+class MM_EnvironmentBase;
+
+/**
+ * Number of slots probed when looking up an allocation site. Sites that do not find a slot within this
+ * distance of their home slot are not tracked.
+ */
+#define SCAVENGER_PRETENURE_SITE_PROBES 4
+
+/**
+ * Each thread attributes its allocated bytes to the site of the allocation that crosses this many bytes
+ * since its previous sample, so that mutators do not update the shared table on every allocation.
+ */
+#define SCAVENGER_PRETENURE_SITE_SAMPLE_BYTES (4 * 1024)
+
+/**
+ * Minimum number of bytes a site must have allocated between two scavenges for its survival rate to be considered.
+ */
+#define SCAVENGER_PRETENURE_SITE_MINIMUM_BYTES (64 * 1024)
+
+/**
+ * Tracks the survival rate of objects per allocation site across scavenges and flags sites whose objects
+ * consistently survive their first scavenge. Allocations from flagged sites that select the
+ * OMR_GC_ALLOCATE_OBJECT_PRETENURE_BY_SITE allocation flag are made directly in tenure space.
+ *
+ * Allocation sites are opaque, language defined, non-zero values. Allocated bytes are sampled by mutator
+ * threads; survived bytes are accumulated per GC thread in MM_ScavengerStats::_siteSurvivedBytes and fed
+ * to update() once the scavenge completes.
+ *
+ * A pretenured site stops producing survival samples, so its flag is dropped after a number of scavenges
+ * (GCExtensionsBase::scavengerPretenureSiteRetryScavenges) and the site is measured again.
+ */
+class MM_ScavengerSiteSurvivalTracker
+{
+	/* Data members */
+public:
+	typedef struct SiteEntry {
+		volatile uintptr_t site;			/**< language defined allocation site owning this slot, 0 if the slot is free */
+		volatile uintptr_t allocatedBytes;	/**< sampled bytes allocated from the site since the last scavenge */
+		uintptr_t survivingScavenges;		/**< number of consecutive scavenges in which the site's survival rate exceeded the threshold */
+		uintptr_t pretenureScavengesRemaining; /**< if non zero the site is pretenured for this many more scavenges */
+		double survivalRate;				/**< survival rate of the site observed at the most recent scavenge */
+	} SiteEntry;
+
+protected:
+private:
+	SiteEntry _sites[OMR_SCAVENGER_PRETENURE_SITES];
+	uintptr_t _pretenuredSiteCount; /**< number of sites currently flagged for pretenuring */
+
+	/* Function members */
+public:
+	/**
+	 * Find the slot tracking the given allocation site.
+	 * @param site language defined allocation site
+	 * @param claim if true, claim a free slot for the site if it is not tracked yet
+	 * @return the slot index, or -1 if the site is not (and could not be) tracked
+	 */
+	MMINLINE intptr_t
+	findSlot(uintptr_t site, bool claim)
+	{
+		uintptr_t home = hashSite(site);
+		for (uintptr_t probe = 0; probe < SCAVENGER_PRETENURE_SITE_PROBES; probe++) {
+			uintptr_t slot = (home + probe) % OMR_SCAVENGER_PRETENURE_SITES;
+			uintptr_t owner = _sites[slot].site;
+			if (site == owner) {
+				return (intptr_t)slot;
+			}
+			if ((0 == owner) && claim) {
+				owner = MM_AtomicOperations::lockCompareExchange(&_sites[slot].site, 0, site);
+				if ((0 == owner) || (site == owner)) {
+					return (intptr_t)slot;
+				}
+			}
+		}
+		return -1;
+	}
+
+	/**
+	 * @param site language defined allocation site
+	 * @return true if objects allocated from the site should be allocated directly in tenure space
+	 */
+	MMINLINE bool
+	shouldPretenure(uintptr_t site)
+	{
+		bool result = false;
+		if (0 != _pretenuredSiteCount) {
+			intptr_t slot = findSlot(site, false);
+			result = (0 <= slot) && (0 != _sites[slot].pretenureScavengesRemaining);
+		}
+		return result;
+	}
+
+	/**
+	 * Sample an allocation of the given size from the given site. Called by mutator threads after a successful allocation.
+	 * @param[in/out] sampleBytes thread local count of bytes allocated since the last sample was taken
+	 * @param site language defined allocation site
+	 * @param bytes size of the allocation
+	 */
+	MMINLINE void
+	recordAllocation(uintptr_t *sampleBytes, uintptr_t site, uintptr_t bytes)
+	{
+		*sampleBytes += bytes;
+		if (SCAVENGER_PRETENURE_SITE_SAMPLE_BYTES <= *sampleBytes) {
+			intptr_t slot = findSlot(site, true);
+			if (0 <= slot) {
+				MM_AtomicOperations::add(&_sites[slot].allocatedBytes, *sampleBytes);
+			}
+			*sampleBytes = 0;
+		}
+	}
+
+	/**
+	 * Update per site survival rates from the merged statistics of a completed scavenge and flag or unflag sites
+	 * for pretenuring. Must be called by the master GC thread while holding exclusive VM access.
+	 * @param[in] scavengerStats merged statistics for the completed scavenge cycle
+	 */
+	void update(MM_EnvironmentBase *env, MM_ScavengerStats *scavengerStats);
+
+	/**
+	 * @return the entry for the given slot (for reporting)
+	 */
+	MMINLINE SiteEntry *getSiteEntry(uintptr_t slot) { return &_sites[slot]; }
+
+	MM_ScavengerSiteSurvivalTracker()
+		: _pretenuredSiteCount(0)
+	{
+		memset(_sites, 0, sizeof(_sites));
+	}
+
+private:
+	MMINLINE uintptr_t
+	hashSite(uintptr_t site)
+	{
+		/* sites are frequently aligned pointers, so mix the high bits down before selecting a slot */
+		uintptr_t hash = site ^ (site >> 7) ^ (site >> 17);
+		return hash % OMR_SCAVENGER_PRETENURE_SITES;
+	}
+};
+
+#endif /* SCAVENGERSITESURVIVALTRACKER_HPP_ */
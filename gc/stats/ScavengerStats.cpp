@@ -100,6 +100,7 @@ MM_ScavengerStats::MM_ScavengerStats()
 	memset(_flipHistory, 0, sizeof(_flipHistory));
 	memset(_copy_distance_counts, 0, sizeof(_copy_distance_counts));
 	memset(_copy_cachesize_counts, 0, sizeof(_copy_cachesize_counts));
+	memset(_siteSurvivedBytes, 0, sizeof(_siteSurvivedBytes));
 }
 
 struct MM_ScavengerStats::FlipHistory*
@@ -202,6 +203,7 @@ MM_ScavengerStats::clear(bool firstIncrement)
 	_copy_cachesize_sum = 0;
 	memset(_copy_distance_counts, 0, sizeof(_copy_distance_counts));
 	memset(_copy_cachesize_counts, 0, sizeof(_copy_cachesize_counts));
+	memset(_siteSurvivedBytes, 0, sizeof(_siteSurvivedBytes));
 }
 
 bool
@@ -39,6 +39,8 @@ class MM_EnvironmentBase;
 
 #define SCAVENGER_FLIP_HISTORY_SIZE 16
 
+#define OMR_SCAVENGER_PRETENURE_SITES 64
+
 /**
  * Storage for statistics relevant to a scavenging (semi-space copying) collector.
  * @ingroup GC_Stats
@@ -136,6 +138,7 @@ public:
 	uint64_t _copy_distance_counts[OMR_SCAVENGER_DISTANCE_BINS];
 	uint64_t _copy_cachesize_counts[OMR_SCAVENGER_CACHESIZE_BINS];
 	uint64_t _copy_cachesize_sum;
+	uintptr_t _siteSurvivedBytes[OMR_SCAVENGER_PRETENURE_SITES]; /**< Bytes of never flipped objects copied in this cycle, per tracked allocation site slot (see MM_ScavengerSiteSurvivalTracker) */
 
 	uint64_t _slotsCopied; /**< The number of slots copied by the thread since _slotsScanned was last sampled and reset */
 	uint64_t _slotsScanned; /**< The number of slots scanned by the thread since _slotsCopied was last sampled and reset */
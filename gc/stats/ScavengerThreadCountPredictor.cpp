@@ -0,0 +1,78 @@
+/*******************************************************************************
+ * Copyright (c) 2020, 2020 IBM Corp. and others
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at https://www.eclipse.org/legal/epl-2.0/
+ * or the Apache License, Version 2.0 which accompanies this distribution and
+ * is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following
+ * Secondary Licenses when the conditions for such availability set
+ * forth in the Eclipse Public License, v. 2.0 are satisfied: GNU
+ * General Public License, version 2 with the GNU Classpath
+ * Exception [1] and GNU General Public License, version 2 with the
+ * OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] http://openjdk.java.net/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
+ *******************************************************************************/
+
+#include "ModronAssertions.h"
+#include "ut_j9mm.h"
+
+#include "EnvironmentBase.hpp"
+#include "GCExtensionsBase.hpp"
+#include "ScavengerStats.hpp"
+
+#include "ScavengerThreadCountPredictor.hpp"
+
+uintptr_t
+MM_ScavengerThreadCountPredictor::predictThreadCount(MM_EnvironmentBase *env, uintptr_t rememberedSetCount, uintptr_t maximumThreadCount)
+{
+	MM_GCExtensionsBase *extensions = env->getExtensions();
+	uintptr_t threadCount = maximumThreadCount;
+
+	_rememberedSetCount = rememberedSetCount;
+	_threadCountMaximum = maximumThreadCount;
+
+	if (_averageValid) {
+		_predictedWork = (uintptr_t)_averageCopiedBytes + (rememberedSetCount * extensions->scavengerAdaptiveThreadCountRememberedEntryWeight);
+		/* round up so that any work at all gets a thread */
+		threadCount = (_predictedWork + extensions->scavengerAdaptiveThreadCountBytesPerThread - 1) / extensions->scavengerAdaptiveThreadCountBytesPerThread;
+		threadCount = OMR_MAX(1, OMR_MIN(threadCount, maximumThreadCount));
+	} else {
+		/* nothing observed yet, so run with every available thread */
+		_predictedWork = 0;
+	}
+
+	Trc_MM_ScavengerThreadCountPredictor_predictThreadCount(env->getLanguageVMThread(), _predictedWork, rememberedSetCount, threadCount, maximumThreadCount);
+
+	return threadCount;
+}
+
+void
+MM_ScavengerThreadCountPredictor::update(MM_EnvironmentBase *env, MM_ScavengerStats *scavengerStats, uintptr_t threadCount)
+{
+	MM_GCExtensionsBase *extensions = env->getExtensions();
+	uintptr_t copiedBytes = scavengerStats->_flipBytes + scavengerStats->_tenureAggregateBytes;
+
+	_threadCountChosen = threadCount;
+	_actualWork = copiedBytes + (_rememberedSetCount * extensions->scavengerAdaptiveThreadCountRememberedEntryWeight);
+	if (!_averageValid) {
+		/* there was no prediction to compare against */
+		_predictedWork = _actualWork;
+	}
+
+	Trc_MM_ScavengerThreadCountPredictor_update(env->getLanguageVMThread(), _predictedWork, _actualWork, threadCount, _threadCountMaximum);
+
+	if (_averageValid) {
+		double weight = extensions->scavengerAdaptiveThreadCountHistoryWeight;
+		_averageCopiedBytes = (_averageCopiedBytes * weight) + ((double)copiedBytes * (1.0 - weight));
+	} else {
+		_averageCopiedBytes = (double)copiedBytes;
+		_averageValid = true;
+	}
+}
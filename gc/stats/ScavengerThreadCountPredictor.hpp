@@ -0,0 +1,105 @@
+/*******************************************************************************
+ * Copyright (c) 2020, 2020 IBM Corp. and others
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at https://www.eclipse.org/legal/epl-2.0/
+ * or the Apache License, Version 2.0 which accompanies this distribution and
+ * is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following
+ * Secondary Licenses when the conditions for such availability set
+ * forth in the Eclipse Public License, v. 2.0 are satisfied: GNU
+ * General Public License, version 2 with the GNU Classpath
+ * Exception [1] and GNU General Public License, version 2 with the
+ * OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] http://openjdk.java.net/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
+ *******************************************************************************/
+
+#ifndef SCAVENGERTHREADCOUNTPREDICTOR_HPP_
+#define SCAVENGERTHREADCOUNTPREDICTOR_HPP_
+
+#include "omrcfg.h"
+#include "modronbase.h"
+
+#include "ScavengerStats.hpp"
+
+class MM_EnvironmentBase;
+
+/**
+ * Predicts the amount of work the next scavenge will perform and selects the number of GC threads to dispatch
+ * for it, so that small scavenges on hosts with many cores do not wake (and synchronize) more threads than
+ * the work can keep busy.
+ *
+ * Work is expressed in bytes: the bytes copied (flipped and tenured) by a scavenge plus the number of remembered
+ * set entries at its start, weighted by GCExtensionsBase::scavengerAdaptiveThreadCountRememberedEntryWeight. The
+ * remembered set size is known exactly when the scavenge starts; copied bytes are predicted from a weighted
+ * average of previous scavenges. One thread is selected for each
+ * GCExtensionsBase::scavengerAdaptiveThreadCountBytesPerThread bytes of predicted work.
+ */
+class MM_ScavengerThreadCountPredictor
+{
+	/* Data members */
+public:
+protected:
+private:
+	double _averageCopiedBytes; /**< weighted average of bytes copied by previous scavenges */
+	bool _averageValid; /**< true once at least one scavenge has been observed */
+	uintptr_t _rememberedSetCount; /**< number of remembered set entries at the start of the current scavenge */
+	uintptr_t _predictedWork; /**< work predicted for the current (or most recent) scavenge */
+	uintptr_t _actualWork; /**< work performed by the most recent scavenge */
+	uintptr_t _threadCountChosen; /**< number of threads that ran the most recent scavenge */
+	uintptr_t _threadCountMaximum; /**< number of threads available to the most recent scavenge */
+
+	/* Function members */
+public:
+	/**
+	 * Predict the work of the scavenge about to start and select a thread count for it.
+	 * @param rememberedSetCount number of remembered set entries at the start of the scavenge
+	 * @param maximumThreadCount number of GC threads available
+	 * @return number of threads to dispatch, between 1 and maximumThreadCount
+	 */
+	uintptr_t predictThreadCount(MM_EnvironmentBase *env, uintptr_t rememberedSetCount, uintptr_t maximumThreadCount);
+
+	/**
+	 * Record the work performed by a completed scavenge and fold it into the prediction for the next one.
+	 * @param[in] scavengerStats merged statistics for the completed scavenge
+	 * @param threadCount number of threads that actually ran the scavenge
+	 */
+	void update(MM_EnvironmentBase *env, MM_ScavengerStats *scavengerStats, uintptr_t threadCount);
+
+	MMINLINE uintptr_t getThreadCountChosen() { return _threadCountChosen; }
+	MMINLINE uintptr_t getThreadCountMaximum() { return _threadCountMaximum; }
+	MMINLINE uintptr_t getPredictedWork() { return _predictedWork; }
+	MMINLINE uintptr_t getActualWork() { return _actualWork; }
+
+	/**
+	 * @return the error of the most recent prediction, as a percentage of the actual work (negative if work was underestimated)
+	 */
+	MMINLINE double
+	getPredictionError()
+	{
+		double error = 0.0;
+		if (0 != _actualWork) {
+			error = (((double)_predictedWork - (double)_actualWork) * 100.0) / (double)_actualWork;
+		}
+		return error;
+	}
+
+	MM_ScavengerThreadCountPredictor()
+		: _averageCopiedBytes(0.0)
+		, _averageValid(false)
+		, _rememberedSetCount(0)
+		, _predictedWork(0)
+		, _actualWork(0)
+		, _threadCountChosen(0)
+		, _threadCountMaximum(0)
+	{
+	}
+};
+
+#endif /* SCAVENGERTHREADCOUNTPREDICTOR_HPP_ */
@@ -0,0 +1,89 @@
+/*******************************************************************************
+ * Copyright (c) 2020, 2020 IBM Corp. and others
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at https://www.eclipse.org/legal/epl-2.0/
+ * or the Apache License, Version 2.0 which accompanies this distribution and
+ * is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following
+ * Secondary Licenses when the conditions for such availability set
+ * forth in the Eclipse Public License, v. 2.0 are satisfied: GNU
+ * General Public License, version 2 with the GNU Classpath
+ * Exception [1] and GNU General Public License, version 2 with the
+ * OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] http://openjdk.java.net/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
+ *******************************************************************************/
+
+/**
+ * @file
+ * @ingroup GC_Structs
+ */
+
+#if !defined(SUBLISTCHUNKSLOTITERATOR_HPP_)
+#define SUBLISTCHUNKSLOTITERATOR_HPP_
+
+#include "omrcfg.h"
+#include "omrcomp.h"
+#include "modronbase.h"
+
+#include "SublistPuddle.hpp"
+
+/**
+ * Iterate over a fixed size chunk of the slots of an MM_SublistPuddle, so that a single puddle can be
+ * processed by several threads at once.
+ *
+ * Unlike GC_SublistSlotIterator, slots can not be removed while iterating, since removal moves slots from
+ * the end of the puddle (which may belong to another chunk). Slots are nulled instead; the caller is
+ * responsible for adjusting the element count of the parent pool and for removing the nulled slots with
+ * MM_SublistPuddle::removeNullSlots() once all chunks of the puddle have been processed.
+ * @ingroup GC_Structs
+ */
+class GC_SublistChunkSlotIterator
+{
+	uintptr_t *_scanPtr;
+	uintptr_t *_scanTop;
+
+public:
+	/**
+	 * @return the number of chunks of chunkSlots slots needed to cover the puddle
+	 */
+	static MMINLINE uintptr_t
+	getChunkCount(MM_SublistPuddle *puddle, uintptr_t chunkSlots)
+	{
+		uintptr_t slotCount = ((uintptr_t)puddle->_listCurrent - (uintptr_t)puddle->_listBase) / sizeof(uintptr_t);
+		return (slotCount + chunkSlots - 1) / chunkSlots;
+	}
+
+	/**
+	 * Return the next slot in the chunk.
+	 * @return slot pointer, or NULL when the chunk is exhausted
+	 */
+	MMINLINE void *
+	nextSlot()
+	{
+		void *result = NULL;
+		if (_scanPtr < _scanTop) {
+			result = (void *)_scanPtr;
+			_scanPtr += 1;
+		}
+		return result;
+	}
+
+	/**
+	 * @param puddle the puddle to iterate
+	 * @param chunkIndex index of the chunk to iterate, less than getChunkCount()
+	 * @param chunkSlots number of slots in each chunk
+	 */
+	GC_SublistChunkSlotIterator(MM_SublistPuddle *puddle, uintptr_t chunkIndex, uintptr_t chunkSlots)
+		: _scanPtr(puddle->_listBase + (chunkIndex * chunkSlots))
+		, _scanTop(OMR_MIN(_scanPtr + chunkSlots, (uintptr_t *)puddle->_listCurrent))
+	{}
+};
+
+#endif /* SUBLISTCHUNKSLOTITERATOR_HPP_ */
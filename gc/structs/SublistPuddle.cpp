@@ -188,5 +188,22 @@ MM_SublistPuddle::merge(MM_SublistPuddle *sourcePuddle)
 	sourcePuddle->_listCurrent = (uintptr_t *) (((uint8_t *)sourcePuddle->_listCurrent) - copySize);
 }
 
-
-
+/**
+ * Remove all null slots from the receiver, filling each hole with the last slot of the puddle.
+ * The element count of the parent pool is not adjusted; null slots are not counted as elements.
+ */
+void
+MM_SublistPuddle::removeNullSlots()
+{
+	uintptr_t *scanPtr = _listBase;
+	while (scanPtr < _listCurrent) {
+		if (0 == *scanPtr) {
+			/* Move the last slot into the hole and rescan it, it may be null as well */
+			_listCurrent--;
+			*scanPtr = *_listCurrent;
+			*_listCurrent = 0;
+		} else {
+			scanPtr++;
+		}
+	}
+}
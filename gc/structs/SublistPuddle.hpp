@@ -42,6 +42,7 @@ class MM_SublistPool;
 /* Forward declaration of Friends */
 class GC_SublistIterator;
 class GC_SublistSlotIterator;
+class GC_SublistChunkSlotIterator;
 
 /**
  * A portion of memory allocated for an MM_SublistPool.
@@ -90,6 +91,7 @@ public:
 	MMINLINE MM_SublistPool *getParent() {return _parent; }
 
 	void merge(MM_SublistPuddle *sourcePuddle);
+	void removeNullSlots();
 
 	MMINLINE MM_SublistPuddle *getNext() { return _next; }
 	MMINLINE void setNext(MM_SublistPuddle *next) { _next = next; }
@@ -98,6 +100,7 @@ public:
 
 	friend class GC_SublistIterator;
 	friend class GC_SublistSlotIterator;
+	friend class GC_SublistChunkSlotIterator;
 };
 
 #endif /* SUBLISTPUDDLE_HPP_ */
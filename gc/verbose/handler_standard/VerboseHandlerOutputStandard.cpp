@@ -419,6 +419,11 @@ MM_VerboseHandlerOutputStandard::handleScavengeEndNoLock(J9HookInterface** hook,
 	if (event->cycleEnd) {
 		writer->formatAndOutput(env, 1, "<scavenger-info tenureage=\"%zu\" tenuremask=\"%4zx\" tiltratio=\"%zu\" />",
 				cycleScavengerStats->_tenureAge, cycleScavengerStats->getFlipHistory(0)->_tenureMask, cycleScavengerStats->_tiltRatio);
+		if (extensions->scavengerAdaptiveThreadCount && !extensions->gcThreadCountForced && !extensions->isConcurrentScavengerEnabled()) {
+			MM_ScavengerThreadCountPredictor *predictor = &extensions->scavengerThreadCountPredictor;
+			writer->formatAndOutput(env, 1, "<scavenger-threads chosen=\"%zu\" maximum=\"%zu\" predictedwork=\"%zu\" actualwork=\"%zu\" predictionerror=\"%.1f\" />",
+					predictor->getThreadCountChosen(), predictor->getThreadCountMaximum(), predictor->getPredictedWork(), predictor->getActualWork(), predictor->getPredictionError());
+		}
 	}
 
 	if (0 != scavengerStats->_flipCount) {
@@ -119,6 +119,7 @@ typedef enum MM_MarkingSchemeScanReason {
 #define OMR_GC_ALLOCATE_OBJECT_NON_ZERO_TLH 0x10
 #define OMR_GC_ALLOCATE_OBJECT_NO_GC 0x20
 #define OMR_GC_ALLOCATE_OBJECT_INDEXABLE 0x40
+#define OMR_GC_ALLOCATE_OBJECT_PRETENURE_BY_SITE 0x80
 /* Languages may define additional allocation flags >= OMR_GC_ALLOCATE_OBJECT_LANGUAGE_DEFINED_BASE */
 #define OMR_GC_ALLOCATE_OBJECT_LANGUAGE_DEFINED_BASE 0x10000
 /* Language-defined allocation flags must fit in a uintptr_t */
@@ -46,6 +46,7 @@ JitBuilder::ResolvedMethod::ResolvedMethod(TR_OpaqueMethodBlock *method)
    _signature = resolvedMethod->getSignature();
    _externalName = 0;
    _entryPoint = resolvedMethod->getEntryPoint();
+   _allocationSizeParameter = resolvedMethod->getAllocationSizeParameter();
    strncpy(_signatureChars, resolvedMethod->signatureChars(), 62); // TODO: introduce concept of robustness
    }
 
@@ -59,7 +60,8 @@ JitBuilder::ResolvedMethod::ResolvedMethod(TR::MethodBuilder *m)
      _entryPoint(0),
      _signature(0),
      _externalName(0),
-     _ilInjector(static_cast<TR::IlInjector *>(m))
+     _ilInjector(static_cast<TR::IlInjector *>(m)),
+     _allocationSizeParameter(-1)
    {
    computeSignatureChars();
    }
@@ -101,11 +101,13 @@ class ResolvedMethod : public ResolvedMethodBase, public Method
         _lineNumber(lineNumber),
         _name(name),
         _signature(0),
+        _externalName(0),
         _numParms(numParms),
         _parmTypes(parmTypes),
         _returnType(returnType),
         _entryPoint(entryPoint),
-        _ilInjector(ilInjector)
+        _ilInjector(ilInjector),
+        _allocationSizeParameter(-1)
       {
       computeSignatureChars();
       }
@@ -145,6 +147,13 @@ class ResolvedMethod : public ResolvedMethodBase, public Method
    void                          setEntryPoint(void *ep)                    { _entryPoint = ep; }
    void                        * getEntryPoint()                            { return _entryPoint; }
 
+   /**
+    * @brief the index of the parameter giving the size in bytes of the object this function
+    *        allocates, or -1 if it is not an allocation function
+    */
+   int32_t                       getAllocationSizeParameter()               { return _allocationSizeParameter; }
+   void                          setAllocationSizeParameter(int32_t p)      { _allocationSizeParameter = p; }
+
    void                          computeSignatureCharsPrimitive();
    void                          computeSignatureChars();
 
@@ -167,6 +176,7 @@ class ResolvedMethod : public ResolvedMethodBase, public Method
    TR::IlType     * _returnType;
    void           * _entryPoint;
    TR::IlInjector * _ilInjector;
+   int32_t          _allocationSizeParameter;
    };
 
 
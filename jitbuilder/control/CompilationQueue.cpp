@@ -0,0 +1,214 @@
+/*******************************************************************************
+ * Copyright (c) 2020, 2020 IBM Corp. and others
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at https://www.eclipse.org/legal/epl-2.0/
+ * or the Apache License, Version 2.0 which accompanies this distribution and
+ * is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following
+ * Secondary Licenses when the conditions for such availability set
+ * forth in the Eclipse Public License, v. 2.0 are satisfied: GNU
+ * General Public License, version 2 with the GNU Classpath
+ * Exception [1] and GNU General Public License, version 2 with the
+ * OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] http://openjdk.java.net/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
+ *******************************************************************************/
+
+#include "control/CompilationQueue.hpp"
+
+#include <string.h>
+#include <algorithm>
+#include "env/CompilerEnv.hpp"
+#include "infra/Assert.hpp"
+#include "ilgen/MethodBuilder.hpp"
+
+extern int32_t internal_compileMethodBuilder(TR::MethodBuilder *m, void **entry);
+
+JitBuilder::CompilationRequest::CompilationRequest(
+      TR::MethodBuilder *methodBuilder,
+      int32_t priority,
+      uint64_t sequenceNumber,
+      CompilationCallback callback,
+      void *userData) :
+   _methodBuilder(methodBuilder),
+   _priority(priority),
+   _sequenceNumber(sequenceNumber),
+   _callback(callback),
+   _userData(userData),
+   _enqueueTime(std::chrono::steady_clock::now()),
+   _returnCode(0),
+   _entryPoint(NULL),
+   _complete(false)
+   {
+   }
+
+JitBuilder::CompilationQueue::CompilationQueue(TR::PersistentAllocator &allocator) :
+   _allocator(allocator),
+   _requests(RequestHeap::allocator_type(allocator)),
+   _threads(ThreadPool::allocator_type(allocator)),
+   _nextSequenceNumber(0),
+   _shuttingDown(false)
+   {
+   memset(&_stats, 0, sizeof(_stats));
+   }
+
+JitBuilder::CompilationQueue::~CompilationQueue()
+   {
+   shutdown();
+   }
+
+bool
+JitBuilder::CompilationQueue::startThreads(int32_t numThreads)
+   {
+   std::lock_guard<std::mutex> guard(_lock);
+   if (_shuttingDown)
+      return false;
+
+   while (_threads.size() < static_cast<size_t>(numThreads))
+      _threads.push_back(new (_allocator) std::thread(run, this));
+
+   return true;
+   }
+
+JitBuilder::CompilationRequest *
+JitBuilder::CompilationQueue::enqueue(
+      TR::MethodBuilder *methodBuilder,
+      int32_t priority,
+      CompilationCallback callback,
+      void *userData)
+   {
+   std::unique_lock<std::mutex> guard(_lock);
+   if (_shuttingDown)
+      return NULL;
+
+   if (_threads.empty())
+      _threads.push_back(new (_allocator) std::thread(run, this));
+
+   CompilationRequest *request = new (_allocator) CompilationRequest(methodBuilder, priority, _nextSequenceNumber++, callback, userData);
+   _requests.push_back(request);
+   std::push_heap(_requests.begin(), _requests.end(), RequestOrder());
+
+   _stats._queueDepth = _requests.size();
+   _stats._maxQueueDepth = std::max(_stats._maxQueueDepth, _stats._queueDepth);
+
+   guard.unlock();
+   _requestAvailable.notify_one();
+   return request;
+   }
+
+bool
+JitBuilder::CompilationQueue::isComplete(CompilationRequest *request)
+   {
+   std::lock_guard<std::mutex> guard(_lock);
+   return request->_complete;
+   }
+
+int32_t
+JitBuilder::CompilationQueue::wait(CompilationRequest *request, void **entryPoint)
+   {
+   TR_ASSERT_FATAL(request->_callback == NULL, "requests with a callback are released by the compilation queue");
+
+   std::unique_lock<std::mutex> guard(_lock);
+   _requestComplete.wait(guard, [request] { return request->_complete; });
+   guard.unlock();
+
+   int32_t returnCode = request->_returnCode;
+   *entryPoint = request->_entryPoint;
+   release(request);
+   return returnCode;
+   }
+
+void
+JitBuilder::CompilationQueue::shutdown()
+   {
+      {
+      std::lock_guard<std::mutex> guard(_lock);
+      _shuttingDown = true;
+      }
+   _requestAvailable.notify_all();
+
+   // Compilation threads only exit once the queue has been drained
+   for (auto it = _threads.begin(); it != _threads.end(); ++it)
+      {
+      std::thread *thread = *it;
+      thread->join();
+      thread->~thread();
+      _allocator.deallocate(thread);
+      }
+   _threads.clear();
+   }
+
+JitBuilder::CompilationQueue::Statistics
+JitBuilder::CompilationQueue::getStatistics()
+   {
+   std::lock_guard<std::mutex> guard(_lock);
+   return _stats;
+   }
+
+void
+JitBuilder::CompilationQueue::run(CompilationQueue *queue)
+   {
+   std::unique_lock<std::mutex> guard(queue->_lock);
+   while (true)
+      {
+      queue->_requestAvailable.wait(guard, [queue] { return !queue->_requests.empty() || queue->_shuttingDown; });
+      if (queue->_requests.empty())
+         break;
+
+      std::pop_heap(queue->_requests.begin(), queue->_requests.end(), RequestOrder());
+      CompilationRequest *request = queue->_requests.back();
+      queue->_requests.pop_back();
+      queue->_stats._queueDepth = queue->_requests.size();
+
+      guard.unlock();
+      queue->compile(request);
+      guard.lock();
+      }
+   }
+
+void
+JitBuilder::CompilationQueue::compile(CompilationRequest *request)
+   {
+   std::chrono::steady_clock::time_point startTime = std::chrono::steady_clock::now();
+   void *entryPoint = NULL;
+   int32_t returnCode = internal_compileMethodBuilder(request->_methodBuilder, &entryPoint);
+   std::chrono::steady_clock::time_point endTime = std::chrono::steady_clock::now();
+
+   uint64_t compileTime = std::chrono::duration_cast<std::chrono::microseconds>(endTime - startTime).count();
+   uint64_t latency = std::chrono::duration_cast<std::chrono::microseconds>(endTime - request->_enqueueTime).count();
+
+      {
+      std::lock_guard<std::mutex> guard(_lock);
+      request->_returnCode = returnCode;
+      request->_entryPoint = entryPoint;
+      request->_complete = true;
+
+      _stats._numCompiled++;
+      _stats._totalLatencyUSec += latency;
+      _stats._maxLatencyUSec = std::max(_stats._maxLatencyUSec, latency);
+      _stats._totalCompileTimeUSec += compileTime;
+      }
+
+   if (request->_callback != NULL)
+      {
+      request->_callback(request->_userData, returnCode, entryPoint);
+      release(request);
+      }
+   else
+      {
+      _requestComplete.notify_all();
+      }
+   }
+
+void
+JitBuilder::CompilationQueue::release(CompilationRequest *request)
+   {
+   request->~CompilationRequest();
+   _allocator.deallocate(request);
+   }
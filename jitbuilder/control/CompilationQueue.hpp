@@ -0,0 +1,170 @@
+/*******************************************************************************
+ * Copyright (c) 2020, 2020 IBM Corp. and others
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at https://www.eclipse.org/legal/epl-2.0/
+ * or the Apache License, Version 2.0 which accompanies this distribution and
+ * is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following
+ * Secondary Licenses when the conditions for such availability set
+ * forth in the Eclipse Public License, v. 2.0 are satisfied: GNU
+ * General Public License, version 2 with the GNU Classpath
+ * Exception [1] and GNU General Public License, version 2 with the
+ * OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] http://openjdk.java.net/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
+ *******************************************************************************/
+
+#ifndef JITBUILDER_COMPILATIONQUEUE_INCL
+#define JITBUILDER_COMPILATIONQUEUE_INCL
+
+#include <stdint.h>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include "env/PersistentAllocator.hpp"
+#include "infra/vector.hpp"
+
+namespace TR { class MethodBuilder; }
+
+namespace JitBuilder
+{
+
+/**
+ * @brief Signature of the function invoked once an asynchronous compilation
+ *        has finished, on the compilation thread that performed it.
+ */
+typedef void (*CompilationCallback)(void *userData, int32_t returnCode, void *entryPoint);
+
+/**
+ * @brief An asynchronous request to compile a MethodBuilder.
+ *
+ * A request is created by the CompilationQueue and acts as the future for
+ * the compilation result. Requests enqueued without a callback are owned by
+ * the client until they are passed to CompilationQueue::wait(); requests
+ * with a callback are released by the queue once the callback returns.
+ */
+class CompilationRequest
+   {
+   friend class CompilationQueue;
+
+   CompilationRequest(TR::MethodBuilder *methodBuilder, int32_t priority, uint64_t sequenceNumber,
+                      CompilationCallback callback, void *userData);
+
+   TR::MethodBuilder *_methodBuilder;
+   int32_t _priority;
+   uint64_t _sequenceNumber;
+   CompilationCallback _callback;
+   void *_userData;
+   std::chrono::steady_clock::time_point _enqueueTime;
+
+   int32_t _returnCode;
+   void *_entryPoint;
+   bool _complete;
+   };
+
+/**
+ * @brief A priority queue of compilation requests serviced by a pool of
+ *        background compilation threads.
+ *
+ * Requests with a higher priority are compiled first; requests of equal
+ * priority are compiled in the order they were enqueued. Every compilation
+ * runs through compileMethodFromDetails, which gives each one its own
+ * segment provider, TR::Region and TLSCompilationManager on the
+ * compilation thread that services it.
+ */
+class CompilationQueue
+   {
+public:
+
+   struct Statistics
+      {
+      int32_t  _queueDepth;           ///< requests waiting to be compiled
+      int32_t  _maxQueueDepth;        ///< high water mark of _queueDepth
+      uint64_t _numCompiled;          ///< requests whose compilation has completed
+      uint64_t _totalLatencyUSec;     ///< sum of enqueue-to-completion times
+      uint64_t _maxLatencyUSec;       ///< longest enqueue-to-completion time
+      uint64_t _totalCompileTimeUSec; ///< sum of the time spent compiling
+      };
+
+   CompilationQueue(TR::PersistentAllocator &allocator);
+   ~CompilationQueue();
+
+   /**
+    * @brief Start compilation threads until the pool has at least
+    *        numThreads of them.
+    *
+    * @return false if the queue is shutting down
+    */
+   bool startThreads(int32_t numThreads);
+
+   /**
+    * @brief Enqueue a MethodBuilder for compilation on a compilation thread,
+    *        starting one if the pool is still empty.
+    *
+    * @return the request, or NULL if the queue is shutting down
+    */
+   CompilationRequest *enqueue(TR::MethodBuilder *methodBuilder, int32_t priority,
+                               CompilationCallback callback = NULL, void *userData = NULL);
+
+   /**
+    * @brief Whether the compilation of a request has finished.
+    */
+   bool isComplete(CompilationRequest *request);
+
+   /**
+    * @brief Block until a request without a callback has been compiled,
+    *        then release it.
+    */
+   int32_t wait(CompilationRequest *request, void **entryPoint);
+
+   /**
+    * @brief Compile all outstanding requests, then stop and join every
+    *        compilation thread.
+    */
+   void shutdown();
+
+   Statistics getStatistics();
+
+private:
+
+   struct RequestOrder
+      {
+      bool operator()(const CompilationRequest *left, const CompilationRequest *right) const
+         {
+         if (left->_priority != right->_priority)
+            return left->_priority < right->_priority;
+         return left->_sequenceNumber > right->_sequenceNumber;
+         }
+      };
+
+   static void run(CompilationQueue *queue);
+   void compile(CompilationRequest *request);
+   void release(CompilationRequest *request);
+
+   TR::PersistentAllocator &_allocator;
+
+   std::mutex _lock;
+   std::condition_variable _requestAvailable;
+   std::condition_variable _requestComplete;
+
+   typedef TR::vector<CompilationRequest *, TR::PersistentAllocator &> RequestHeap;
+   typedef TR::vector<std::thread *, TR::PersistentAllocator &> ThreadPool;
+
+   RequestHeap _requests;
+   ThreadPool _threads;
+   uint64_t _nextSequenceNumber;
+   bool _shuttingDown;
+
+   Statistics _stats;
+   };
+
+} // namespace JitBuilder
+
+#endif // !defined(JITBUILDER_COMPILATIONQUEUE_INCL)
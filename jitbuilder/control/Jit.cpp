@@ -21,10 +21,13 @@
  *******************************************************************************/
 
 #include <stdio.h>
+#include <string.h>
 #include "codegen/CodeGenerator.hpp"
 #include "compile/CompilationTypes.hpp"
 #include "compile/Method.hpp"
+#include "control/CompilationQueue.hpp"
 #include "control/CompileMethod.hpp"
+#include "control/TieredCompilation.hpp"
 #include "env/CompilerEnv.hpp"
 #include "env/FrontEnd.hpp"
 #include "env/IO.hpp"
@@ -32,6 +35,7 @@
 #include "ilgen/IlGeneratorMethodDetails_inlines.hpp"
 #include "ilgen/MethodBuilder.hpp"
 #include "ilgen/TypeDictionary.hpp"
+#include "runtime/AOTCache.hpp"
 #include "runtime/CodeCache.hpp"
 #include "runtime/Runtime.hpp"
 #include "runtime/JBJitConfig.hpp"
@@ -43,6 +47,15 @@
 extern TR_RuntimeHelperTable runtimeHelpers;
 extern void setupCodeCacheParameters(int32_t *, OMR::CodeCacheCodeGenCallbacks *callBacks, int32_t *numHelpers, int32_t *CCPreLoadedCodeSize);
 
+// Services asynchronous compilation requests; created by initializeJitBuilder()
+static JitBuilder::CompilationQueue *compilationQueue = NULL;
+
+// Compiles methods in two tiers; created by initializeJitBuilder() where supported
+static JitBuilder::TieredCompilation *tieredCompilation = NULL;
+
+// Options the JIT was initialized with; persisted code is only valid under the same options
+static char *jitOptions = NULL;
+
 static void
 initHelper(void *helper, TR_RuntimeHelper id)
    {
@@ -145,6 +158,19 @@ initializeJitBuilder(TR_RuntimeHelper *helperIDs, void **helperAddresses, int32_
 
    initializeCodeCache(fe.codeCacheManager());
 
+   size_t optionsLength = strlen(options) + 1;
+   jitOptions = static_cast<char *>(TR::Compiler->persistentAllocator().allocate(optionsLength));
+   memcpy(jitOptions, options, optionsLength);
+
+   compilationQueue = new (TR::Compiler->persistentAllocator()) JitBuilder::CompilationQueue(TR::Compiler->persistentAllocator());
+
+   if (JitBuilder::TieredCompilation::isSupported())
+      {
+      tieredCompilation = new (TR::Compiler->persistentAllocator()) JitBuilder::TieredCompilation(TR::Compiler->persistentAllocator(),
+                                                                                               *compilationQueue,
+                                                                                               TR::Options::getCmdLineOptions()->getInitialCount());
+      }
+
    return true;
    }
 
@@ -166,6 +192,9 @@ initializeJitBuilder(TR_RuntimeHelper *helperIDs, void **helperAddresses, int32_
 // An individual program should link statically against JitBuilder, then call:
 //     initializeJit() or initializeJitWithOptions() to initialize the Jit
 //     compileMethodBuilder() as many times as needed to create compiled code
+//       or compileMethodBuilderAsync() to have a compilation thread create it
+//       or compileMethodBuilderTiered() to compile cheaply first and recompile once hot
+//     openAOTCache() first to reuse code compiled for the same IL by an earlier run
 //     shuwdownJit() when the test is complete
 //
 
@@ -222,11 +251,157 @@ internal_compileMethodBuilder(TR::MethodBuilder *m, void **entry)
    return rc;
    }
 
+int32_t
+internal_compileMethodBuilderTiered(TR::MethodBuilder *m, void **entry)
+   {
+   if (tieredCompilation == NULL)
+      return internal_compileMethodBuilder(m, entry);
+
+   return tieredCompilation->compile(m, entry);
+   }
+
+int32_t
+internal_getTieredRecompilationCount()
+   {
+   return tieredCompilation != NULL ? tieredCompilation->getNumTierUps() : 0;
+   }
+
+int32_t
+internal_getProfileGuidedRecompilationCount()
+   {
+   return tieredCompilation != NULL ? tieredCompilation->getNumProfiledTierUps() : 0;
+   }
+
+bool
+internal_startCompilationThreads(int32_t numThreads)
+   {
+   return compilationQueue->startThreads(numThreads);
+   }
+
+void *
+internal_compileMethodBuilderAsync(TR::MethodBuilder *m, int32_t priority)
+   {
+   return compilationQueue->enqueue(m, priority);
+   }
+
+bool
+internal_compileMethodBuilderWithCallback(TR::MethodBuilder *m, int32_t priority, void *callback, void *userData)
+   {
+   return compilationQueue->enqueue(m, priority, (JitBuilder::CompilationCallback) callback, userData) != NULL;
+   }
+
+bool
+internal_isCompilationComplete(void *request)
+   {
+   return compilationQueue->isComplete(static_cast<JitBuilder::CompilationRequest *>(request));
+   }
+
+int32_t
+internal_waitForCompilation(void *request, void **entry)
+   {
+   return compilationQueue->wait(static_cast<JitBuilder::CompilationRequest *>(request), entry);
+   }
+
+int32_t
+internal_getCompilationQueueDepth()
+   {
+   return compilationQueue->getStatistics()._queueDepth;
+   }
+
+int32_t
+internal_getMaxCompilationQueueDepth()
+   {
+   return compilationQueue->getStatistics()._maxQueueDepth;
+   }
+
+int64_t
+internal_getAverageCompilationLatency()
+   {
+   JitBuilder::CompilationQueue::Statistics stats = compilationQueue->getStatistics();
+   return stats._numCompiled > 0 ? stats._totalLatencyUSec / stats._numCompiled : 0;
+   }
+
+int64_t
+internal_getMaxCompilationLatency()
+   {
+   return compilationQueue->getStatistics()._maxLatencyUSec;
+   }
+
+static void *
+loadPersistedCode(TR::MethodBuilder *methodBuilder)
+   {
+   return JitBuilder::FrontEnd::instance()->aotCache()->load(methodBuilder);
+   }
+
+bool
+internal_openAOTCache(const char *fileName)
+   {
+   auto fe = JitBuilder::FrontEnd::instance();
+   if (fe->aotCache() != NULL || !JitBuilder::AOTCache::isSupported())
+      return false;
+
+   TR::PersistentAllocator &allocator = TR::Compiler->persistentAllocator();
+   JitBuilder::AOTCache *aotCache = new (allocator.allocate(sizeof(JitBuilder::AOTCache))) JitBuilder::AOTCache(allocator, jitOptions);
+   if (!aotCache->open(fileName))
+      {
+      aotCache->~AOTCache();
+      allocator.deallocate(aotCache);
+      return false;
+      }
+
+   fe->setAOTCache(aotCache);
+   TR::MethodBuilder::setPersistedCodeLoader(loadPersistedCode);
+   return true;
+   }
+
+bool
+internal_closeAOTCache()
+   {
+   auto fe = JitBuilder::FrontEnd::instance();
+   JitBuilder::AOTCache *aotCache = fe->aotCache();
+   if (aotCache == NULL)
+      return false;
+
+   TR::MethodBuilder::setPersistedCodeLoader(NULL);
+   fe->setAOTCache(NULL);
+
+   bool written = aotCache->close();
+   aotCache->~AOTCache();
+   TR::Compiler->persistentAllocator().deallocate(aotCache);
+   return written;
+   }
+
+int32_t
+internal_getAOTCacheLoadCount()
+   {
+   JitBuilder::AOTCache *aotCache = JitBuilder::FrontEnd::instance()->aotCache();
+   return aotCache != NULL ? aotCache->getNumLoads() : 0;
+   }
+
 void
 internal_shutdownJit()
    {
    auto fe = JitBuilder::FrontEnd::instance();
 
+   compilationQueue->shutdown();
+   compilationQueue->~CompilationQueue();
+   TR::Compiler->persistentAllocator().deallocate(compilationQueue);
+   compilationQueue = NULL;
+
+   // the queue has patched every method it recompiled
+   if (tieredCompilation != NULL)
+      {
+      tieredCompilation->~TieredCompilation();
+      TR::Compiler->persistentAllocator().deallocate(tieredCompilation);
+      tieredCompilation = NULL;
+      }
+
+   if (fe->aotCache() != NULL)
+      internal_closeAOTCache();
+
+   TR::Compiler->persistentAllocator().deallocate(jitOptions);
+   jitOptions = NULL;
+
    TR::CodeCacheManager &codeCacheManager = fe->codeCacheManager();
    codeCacheManager.destroy();
 
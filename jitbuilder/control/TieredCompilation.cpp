@@ -0,0 +1,158 @@
+/*******************************************************************************
+ * Copyright (c) 2020, 2020 IBM Corp. and others
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at https://www.eclipse.org/legal/epl-2.0/
+ * or the Apache License, Version 2.0 which accompanies this distribution and
+ * is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following
+ * Secondary Licenses when the conditions for such availability set
+ * forth in the Eclipse Public License, v. 2.0 are satisfied: GNU
+ * General Public License, version 2 with the GNU Classpath
+ * Exception [1] and GNU General Public License, version 2 with the
+ * OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] http://openjdk.java.net/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
+ *******************************************************************************/
+
+#include "control/TieredCompilation.hpp"
+
+#include "compile/Compilation.hpp"
+#include "control/CompilationQueue.hpp"
+#include "control/Options.hpp"
+#include "ilgen/MethodBuilder.hpp"
+#include "ilgen/TypeDictionary.hpp"
+
+#if defined(TR_HOST_X86) && defined(TR_HOST_64BIT)
+#define TIERED_COMPILATION_SUPPORTED
+// Atomically patches a jmp to destinationAddr over the instruction at locationAddr
+extern "C" void _patchVirtualGuard(uint8_t *locationAddr, uint8_t *destinationAddr, int32_t smpFlag);
+#endif
+
+// Name under which first tier code calls TieredCompilation::tierUp
+static const char *tierUpFunctionName = "JitBuilder_TierUp";
+
+JitBuilder::TieredCompilation::TieredMethod::TieredMethod(
+      TieredCompilation *tiers,
+      TR::MethodBuilder *methodBuilder,
+      int32_t count) :
+   _tiers(tiers),
+   _methodBuilder(methodBuilder),
+   _counter(count),
+   _state(FirstTier),
+   _entryPatchSite(NULL),
+   _profile(tiers->_allocator)
+   {
+   }
+
+JitBuilder::TieredCompilation::TieredCompilation(
+      TR::PersistentAllocator &allocator,
+      CompilationQueue &queue,
+      int32_t tierUpCount) :
+   _allocator(allocator),
+   _queue(queue),
+   _tierUpCount(tierUpCount > 0 ? tierUpCount : DEFAULT_TIER_UP_COUNT),
+   _methods(TieredMethodList::allocator_type(allocator)),
+   _numTierUps(0),
+   _numProfiledTierUps(0)
+   {
+   }
+
+JitBuilder::TieredCompilation::~TieredCompilation()
+   {
+   for (auto it = _methods.begin(); it != _methods.end(); ++it)
+      {
+      (*it)->~TieredMethod();
+      _allocator.deallocate(*it);
+      }
+   _methods.clear();
+   }
+
+bool
+JitBuilder::TieredCompilation::isSupported()
+   {
+#if defined(TIERED_COMPILATION_SUPPORTED)
+   return true;
+#else
+   return false;
+#endif
+   }
+
+int32_t
+JitBuilder::TieredCompilation::compile(TR::MethodBuilder *methodBuilder, void **entryPoint)
+   {
+   TieredMethod *method = new (_allocator.allocate(sizeof(TieredMethod))) TieredMethod(this, methodBuilder, _tierUpCount);
+      {
+      std::lock_guard<std::mutex> guard(_lock);
+      _methods.push_back(method);
+      }
+
+   if (methodBuilder->lookupFunction(tierUpFunctionName) == NULL)
+      {
+      TR::TypeDictionary *types = methodBuilder->typeDictionary();
+      methodBuilder->DefineFunction(tierUpFunctionName,
+                                    __FILE__,
+                                    "0",
+                                    (void *)&tierUp,
+                                    types->NoType,
+                                    1,
+                                    types->Address);
+      }
+
+   methodBuilder->setRecompilationCounter(&method->_counter, tierUpFunctionName, method);
+   if (!TR::Options::getCmdLineOptions()->getOption(TR_DisableFirstTierProfiling))
+      methodBuilder->setProfile(&method->_profile);
+   int32_t returnCode = methodBuilder->Compile(entryPoint);
+   method->_entryPatchSite = methodBuilder->getEntryPatchSite();
+
+   if (returnCode != COMPILATION_SUCCEEDED || method->_entryPatchSite == NULL)
+      {
+      // there is no first tier code to replace
+      methodBuilder->setRecompilationCounter(NULL, NULL, NULL);
+      methodBuilder->setProfile(NULL);
+      method->_state = RecompilationFailed;
+      }
+
+   return returnCode;
+   }
+
+void
+JitBuilder::TieredCompilation::tierUp(TieredMethod *method)
+   {
+   int32_t state = FirstTier;
+   if (!method->_state.compare_exchange_strong(state, RecompilationQueued))
+      return;
+
+   // the second tier does not count
+   method->_methodBuilder->setRecompilationCounter(NULL, NULL, NULL);
+
+   if (method->_tiers->_queue.enqueue(method->_methodBuilder, 0, recompiled, method) == NULL)
+      method->_state = RecompilationFailed;
+   }
+
+void
+JitBuilder::TieredCompilation::recompiled(void *userData, int32_t returnCode, void *entryPoint)
+   {
+   TieredMethod *method = static_cast<TieredMethod *>(userData);
+
+#if defined(TIERED_COMPILATION_SUPPORTED)
+   uint8_t *patchSite = static_cast<uint8_t *>(method->_entryPatchSite);
+   intptr_t distance = static_cast<uint8_t *>(entryPoint) - patchSite;
+   if (returnCode == COMPILATION_SUCCEEDED && distance == static_cast<int32_t>(distance))
+      {
+      _patchVirtualGuard(patchSite, static_cast<uint8_t *>(entryPoint), true);
+      method->_state = SecondTier;
+      if (method->_profile.getTimesApplied() > 0)
+         method->_tiers->_numProfiledTierUps++;
+      method->_tiers->_numTierUps++;
+      return;
+      }
+#endif
+
+   method->_state = RecompilationFailed;
+   }
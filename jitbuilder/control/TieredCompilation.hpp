@@ -0,0 +1,134 @@
+/*******************************************************************************
+ * Copyright (c) 2020, 2020 IBM Corp. and others
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at https://www.eclipse.org/legal/epl-2.0/
+ * or the Apache License, Version 2.0 which accompanies this distribution and
+ * is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following
+ * Secondary Licenses when the conditions for such availability set
+ * forth in the Eclipse Public License, v. 2.0 are satisfied: GNU
+ * General Public License, version 2 with the GNU Classpath
+ * Exception [1] and GNU General Public License, version 2 with the
+ * OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] http://openjdk.java.net/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
+ *******************************************************************************/
+
+#ifndef JITBUILDER_TIEREDCOMPILATION_INCL
+#define JITBUILDER_TIEREDCOMPILATION_INCL
+
+#include <stdint.h>
+#include <atomic>
+#include <mutex>
+#include "env/PersistentAllocator.hpp"
+#include "ilgen/MethodBuilderProfile.hpp"
+#include "infra/vector.hpp"
+
+namespace TR { class MethodBuilder; }
+
+namespace JitBuilder
+{
+
+class CompilationQueue;
+
+/**
+ * @brief Compiles MethodBuilders in two tiers.
+ *
+ * The first tier is compiled quickly with local optimizations only. Its code
+ * counts invocations and loop back edges; once the count runs out, the method
+ * is queued for recompilation at the second tier on a compilation thread.
+ * When the second tier code is ready, the entry of the first tier code is
+ * atomically patched into a jump to it, so callers holding the first tier
+ * entry point pick up the faster code without being told.
+ *
+ * Unless the disableFirstTierProfiling option is set, the first tier code also
+ * counts how often each of its blocks runs and each of its branches is taken,
+ * and the second tier lays out and optimizes the method for the paths that
+ * were actually executed, treating the blocks that never ran as cold.
+ */
+class TieredCompilation
+   {
+public:
+
+   /// count used when none is given by the count= option
+   static const int32_t DEFAULT_TIER_UP_COUNT = 1000;
+
+   TieredCompilation(TR::PersistentAllocator &allocator, CompilationQueue &queue, int32_t tierUpCount);
+   ~TieredCompilation();
+
+   /**
+    * @brief Whether first tier code can be patched on the target.
+    */
+   static bool isSupported();
+
+   /**
+    * @brief Compile a MethodBuilder at the first tier.
+    *
+    * The MethodBuilder is compiled again at the second tier once its code is
+    * hot, so it must stay alive until the JIT is shut down.
+    *
+    * @return the return code of the first tier compilation
+    */
+   int32_t compile(TR::MethodBuilder *methodBuilder, void **entryPoint);
+
+   /**
+    * @brief The number of methods whose first tier entry now jumps to their
+    *        second tier code.
+    */
+   int32_t getNumTierUps() { return _numTierUps; }
+
+   /**
+    * @brief The number of those methods whose second tier code was compiled
+    *        using the profile gathered by their first tier code.
+    */
+   int32_t getNumProfiledTierUps() { return _numProfiledTierUps; }
+
+private:
+
+   enum TierState
+      {
+      FirstTier,
+      RecompilationQueued,
+      SecondTier,
+      RecompilationFailed
+      };
+
+   struct TieredMethod
+      {
+      TieredMethod(TieredCompilation *tiers, TR::MethodBuilder *methodBuilder, int32_t count);
+
+      TieredCompilation *_tiers;
+      TR::MethodBuilder *_methodBuilder;
+      int32_t _counter;                 ///< decremented by the first tier code
+      std::atomic<int32_t> _state;      ///< a TierState
+      void *_entryPatchSite;            ///< patched to jump to the second tier code
+      TR::MethodBuilderProfile _profile; ///< gathered by the first tier code
+      };
+
+   // Called by first tier code when its counter runs out
+   static void tierUp(TieredMethod *method);
+
+   // Called on the compilation thread once the second tier has been compiled
+   static void recompiled(void *userData, int32_t returnCode, void *entryPoint);
+
+   TR::PersistentAllocator &_allocator;
+   CompilationQueue &_queue;
+   int32_t _tierUpCount;
+
+   std::mutex _lock;
+   typedef TR::vector<TieredMethod *, TR::PersistentAllocator &> TieredMethodList;
+   TieredMethodList _methods;
+
+   std::atomic<int32_t> _numTierUps;
+   std::atomic<int32_t> _numProfiledTierUps;
+   };
+
+} // namespace JitBuilder
+
+#endif // !defined(JITBUILDER_TIEREDCOMPILATION_INCL)
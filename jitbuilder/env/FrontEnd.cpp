@@ -36,6 +36,10 @@
 #include "env/jittypes.h"
 #include "il/DataTypes.hpp"
 #include "il/ILOps.hpp"
+#include "il/Node.hpp"
+#include "il/Node_inlines.hpp"
+#include "il/ResolvedMethodSymbol.hpp"
+#include "il/Symbol.hpp"
 #include "runtime/CodeMetaDataPOD.hpp"
 #include "runtime/StackAtlasPOD.hpp"
 
@@ -49,7 +53,8 @@ namespace JitBuilder
 FrontEnd *FrontEnd::_instance = 0;
 
 FrontEnd::FrontEnd()
-   : TR::FEBase<FrontEnd>()
+   : TR::FEBase<FrontEnd>(),
+   _aotCache(NULL)
    {
    TR_ASSERT(!_instance, "FrontEnd must be initialized only once");
    _instance = this;
@@ -70,6 +75,33 @@ FrontEnd::createResolvedMethod(TR_Memory * trMemory, TR_OpaqueMethodBlock * aMet
    return new (trMemory->trHeapMemory()) ResolvedMethod(aMethod);
    }
 
+bool
+FrontEnd::isObjectAllocation(TR::Compilation *comp, TR::Node *node, int32_t &sizeInBytes)
+   {
+   if (!node->getOpCode().isCallDirect() || node->getDataType() != TR::Address)
+      return false;
+
+   TR::ResolvedMethodSymbol *methodSymbol = node->getSymbol()->getResolvedMethodSymbol();
+   if (!methodSymbol)
+      return false;
+
+   TR::ResolvedMethod *method = static_cast<TR::ResolvedMethod *>(methodSymbol->getResolvedMethod());
+   int32_t sizeParameter = method->getAllocationSizeParameter();
+   if (sizeParameter < 0 || sizeParameter >= node->getNumChildren())
+      return false;
+
+   TR::Node *size = node->getChild(sizeParameter);
+   if (!size->getOpCode().isLoadConst() || !size->getDataType().isIntegral())
+      return false;
+
+   int64_t value = size->get64bitIntegralValue();
+   if (value <= 0 || value > INT_MAX)
+      return false;
+
+   sizeInBytes = (int32_t)value;
+   return true;
+   }
+
 intptr_t
 FrontEnd::methodTrampolineLookup(TR::Compilation *comp, TR::SymbolReference *symRef, void *callSite)
    {
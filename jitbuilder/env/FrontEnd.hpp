@@ -31,6 +31,7 @@
 
 namespace TR { class GCStackAtlas; }
 namespace OMR { struct MethodMetaDataPOD; }
+namespace JitBuilder { class AOTCache; }
 class TR_ResolvedMethod;
 
 namespace TR
@@ -52,10 +53,18 @@ class FrontEnd : public TR::FEBase<FrontEnd>
    private:
    static FrontEnd   *_instance; /* singleton */
 
+   AOTCache          *_aotCache;
+
    public:
    FrontEnd();
    static FrontEnd *instance()  { TR_ASSERT(_instance, "bad singleton"); return _instance; }
 
+   /**
+    * @brief the persistent code cache methods are loaded from and stored to, or NULL if none is open
+    */
+   AOTCache *aotCache()                   { return _aotCache; }
+   void setAOTCache(AOTCache *aotCache)   { _aotCache = aotCache; }
+
    virtual void reserveTrampolineIfNecessary(TR::Compilation *comp, TR::SymbolReference *symRef, bool inBinaryEncoding);
 
 #if defined(TR_TARGET_S390)
@@ -64,6 +73,12 @@ class FrontEnd : public TR::FEBase<FrontEnd>
 
    virtual intptr_t methodTrampolineLookup(TR::Compilation *comp, TR::SymbolReference *symRef,  void *currentCodeCache);
 
+   /**
+    * @brief a direct call to a function declared with MethodBuilder::DefineAllocator allocates
+    *        an object if its size argument is a constant
+    */
+   virtual bool isObjectAllocation(TR::Compilation *comp, TR::Node *node, int32_t &sizeInBytes);
+
   TR_ResolvedMethod * createResolvedMethod(TR_Memory * trMemory, TR_OpaqueMethodBlock * aMethod,
                                             TR_ResolvedMethod * owningMethod, TR_OpaqueClassBlock *classForNewInstance);
 
@@ -39,6 +39,7 @@
 #include "optimizer/UseDefInfo.hpp"
 #include "optimizer/ValueNumberInfo.hpp"
 
+#include "optimizer/AllocationEscapeAnalysis.hpp"
 #include "optimizer/CFGSimplifier.hpp"
 #include "optimizer/CompactLocals.hpp"
 #include "optimizer/CopyPropagation.hpp"
@@ -55,6 +56,7 @@
 #include "optimizer/LoopCanonicalizer.hpp"
 #include "optimizer/LoopReducer.hpp"
 #include "optimizer/LoopReplicator.hpp"
+#include "optimizer/LoopVectorizer.hpp"
 #include "optimizer/LoopVersioner.hpp"
 #include "optimizer/OrderBlocks.hpp"
 #include "optimizer/PartialRedundancy.hpp"
@@ -65,6 +67,8 @@
 #include "optimizer/GlobalValuePropagation.hpp"
 #include "optimizer/LocalValuePropagation.hpp"
 #include "optimizer/Inliner.hpp"
+#include "optimizer/SparseConditionalConstantPropagation.hpp"
+#include "optimizer/SparseCopyPropagation.hpp"
 #include "optimizer/SwitchAnalyzer.hpp"
 
 
@@ -94,13 +98,15 @@ static const OptimizationStrategy cheapTacticalGlobalRegisterAllocatorOpts[] =
    { OMR::endGroup                        }
    };
 
+// First tier of tiered compilation: local optimizations only, with no loop
+// optimizations and no global register allocation
 static const OptimizationStrategy JBcoldStrategyOpts[] =
    {
    { OMR::deadTreesElimination                                                     },
    { OMR::treeSimplification                                                       },
    { OMR::localCSE                                                                 },
    { OMR::basicBlockExtension                                                      },
-   { OMR::cheapTacticalGlobalRegisterAllocatorGroup                                },
+   { OMR::endOpts                                                                  },
    };
 
 static const OptimizationStrategy JBwarmStrategyOpts[] =
@@ -109,15 +115,19 @@ static const OptimizationStrategy JBwarmStrategyOpts[] =
    { OMR::inlining                                                                 },
    { OMR::treeSimplification                                                       },
    { OMR::localCSE                                                                 },
+   { OMR::escapeAnalysis,                            OMR::IfEAOpportunities        }, // after inlining exposes the uses of allocations
    { OMR::basicBlockOrdering                                                       }, // straighten goto's
-   { OMR::globalCopyPropagation                                                    },
+   { OMR::sparseCopyPropagation,                     OMR::IfMoreThanOneBlock       }, // linear time; the only copy propagation for large methods
+   { OMR::globalCopyPropagation,                     OMR::IfNotLargeMethod         },
    { OMR::globalDeadStoreElimination,                OMR::IfMoreThanOneBlock       },
    { OMR::deadTreesElimination                                                     },
    { OMR::treeSimplification                                                       },
    { OMR::basicBlockHoisting                                                       },
    { OMR::treeSimplification                                                       },
 
-   { OMR::globalValuePropagation,                    OMR::IfMoreThanOneBlock       },
+   { OMR::sparseConditionalConstantPropagation,      OMR::IfMoreThanOneBlock       }, // linear time; the only global constant propagation for large methods
+   { OMR::treeSimplification,                        OMR::IfEnabled                }, // fold the branches made constant
+   { OMR::globalValuePropagation,                    OMR::IfMoreThanOneBlockAndNotLargeMethod },
    { OMR::localValuePropagation,                     OMR::IfOneBlock               },
    { OMR::switchAnalyzer,                                                          },
    { OMR::localCSE                                                                 },
@@ -127,6 +137,9 @@ static const OptimizationStrategy JBwarmStrategyOpts[] =
    { OMR::basicBlockOrdering,                        OMR::IfLoops                  }, // clean up block order for loop canonicalization, if it will run
    { OMR::loopCanonicalization,                      OMR::IfLoops                  }, // canonicalization must run before inductionVariableAnalysis else indvar data gets messed up
    { OMR::inductionVariableAnalysis,                 OMR::IfLoops                  }, // needed for loop unroller
+   { OMR::loopVectorization,                         OMR::IfLoops                  }, // must run before the unroller changes the loop shape
+   { OMR::loopCanonicalization,                      OMR::IfEnabled                }, // canonicalize the vector and scalar epilogue loops
+   { OMR::inductionVariableAnalysis,                 OMR::IfEnabled                }, // recompute induction variables for the unroller
    { OMR::generalLoopUnroller,                       OMR::IfLoops                  },
    { OMR::basicBlockExtension,                       OMR::MarkLastRun              }, // clean up order and extend blocks now
    { OMR::treeSimplification                                                       },
@@ -187,6 +200,8 @@ Optimizer::Optimizer(TR::Compilation *comp, TR::ResolvedMethodSymbol *methodSymb
       new (comp->allocator()) TR::OptimizationManager(self(), TR_LoopCanonicalizer::create, OMR::loopCanonicalization);
    _opts[OMR::inductionVariableAnalysis] =
       new (comp->allocator()) TR::OptimizationManager(self(), TR_InductionVariableAnalysis::create, OMR::inductionVariableAnalysis);
+   _opts[OMR::loopVectorization] =
+      new (comp->allocator()) TR::OptimizationManager(self(), TR_LoopVectorizer::create, OMR::loopVectorization);
    _opts[OMR::liveRangeSplitter] =
       new (comp->allocator()) TR::OptimizationManager(self(), TR_LiveRangeSplitter::create, OMR::liveRangeSplitter);
    _opts[OMR::tacticalGlobalRegisterAllocator] =
@@ -195,8 +210,14 @@ Optimizer::Optimizer(TR::Compilation *comp, TR::ResolvedMethodSymbol *methodSymb
       new (comp->allocator()) TR::OptimizationManager(self(), TR::RegDepCopyRemoval::create, OMR::regDepCopyRemoval);
    _opts[OMR::inlining] =
       new (comp->allocator()) TR::OptimizationManager(self(), TR_TrivialInliner::create, OMR::inlining);
+   _opts[OMR::sparseConditionalConstantPropagation] =
+      new (comp->allocator()) TR::OptimizationManager(self(), TR_SparseConditionalConstantPropagation::create, OMR::sparseConditionalConstantPropagation);
+   _opts[OMR::sparseCopyPropagation] =
+      new (comp->allocator()) TR::OptimizationManager(self(), TR_SparseCopyPropagation::create, OMR::sparseCopyPropagation);
    _opts[OMR::switchAnalyzer] =
       new (comp->allocator()) TR::OptimizationManager(self(), TR::SwitchAnalyzer::create, OMR::switchAnalyzer);
+   _opts[OMR::escapeAnalysis] =
+      new (comp->allocator()) TR::OptimizationManager(self(), TR_AllocationEscapeAnalysis::create, OMR::escapeAnalysis);
 
    // Initialize optimization groups
    _opts[OMR::cheapTacticalGlobalRegisterAllocatorGroup] =
@@ -211,7 +232,7 @@ Optimizer::Optimizer(TR::Compilation *comp, TR::ResolvedMethodSymbol *methodSymb
 
 
    omrCompilationStrategies[noOpt] = JBwarmStrategyOpts;
-   omrCompilationStrategies[cold]  = JBwarmStrategyOpts;
+   omrCompilationStrategies[cold]  = JBcoldStrategyOpts;
    omrCompilationStrategies[warm]  = JBwarmStrategyOpts;
    omrCompilationStrategies[hot]   = JBwarmStrategyOpts;
 
@@ -0,0 +1,582 @@
+/*******************************************************************************
+ * Copyright (c) 2020, 2020 IBM Corp. and others
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at https://www.eclipse.org/legal/epl-2.0/
+ * or the Apache License, Version 2.0 which accompanies this distribution and
+ * is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following
+ * Secondary Licenses when the conditions for such availability set
+ * forth in the Eclipse Public License, v. 2.0 are satisfied: GNU
+ * General Public License, version 2 with the GNU Classpath
+ * Exception [1] and GNU General Public License, version 2 with the
+ * OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] http://openjdk.java.net/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
+ *******************************************************************************/
+
+#include "runtime/AOTCache.hpp"
+
+#include <errno.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#if !defined(OMR_OS_WINDOWS)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif /* !defined(OMR_OS_WINDOWS) */
+#include "codegen/CodeGenerator.hpp"
+#include "compile/Compilation.hpp"
+#include "compile/ResolvedMethod.hpp"
+#include "env/CompilerEnv.hpp"
+#include "il/Block.hpp"
+#include "il/Node.hpp"
+#include "il/MethodSymbol.hpp"
+#include "il/Node_inlines.hpp"
+#include "il/ResolvedMethodSymbol.hpp"
+#include "il/StaticSymbol.hpp"
+#include "il/Symbol.hpp"
+#include "il/SymbolReference.hpp"
+#include "il/TreeTop.hpp"
+#include "il/TreeTop_inlines.hpp"
+#include "ilgen/IlType.hpp"
+#include "ilgen/MethodBuilder.hpp"
+#include "infra/Assert.hpp"
+#include "infra/Cfg.hpp"
+
+static const char     AOTCacheMagic[8] = { 'O', 'M', 'R', 'J', 'B', 'A', 'O', 'T' };
+static const uint32_t AOTCacheVersion  = 1;
+
+namespace
+{
+
+// 64-bit FNV-1a
+class Hasher
+   {
+public:
+   Hasher() : _hash(0xcbf29ce484222325ULL) { }
+
+   void add(const void *data, size_t size)
+      {
+      const uint8_t *bytes = static_cast<const uint8_t *>(data);
+      for (size_t i = 0; i < size; i++)
+         {
+         _hash ^= bytes[i];
+         _hash *= 0x100000001b3ULL;
+         }
+      }
+
+   void add(uint64_t value) { add(&value, sizeof(value)); }
+
+   void addString(const char *string)
+      {
+      size_t length = string ? strlen(string) : 0;
+      add(length);
+      add(string, length);
+      }
+
+   uint64_t value() { return _hash; }
+
+private:
+   uint64_t _hash;
+   };
+
+}
+
+static size_t
+alignRecordSize(size_t size)
+   {
+   return (size + 7) & ~static_cast<size_t>(7);
+   }
+
+static void
+hashSymbolReference(Hasher &hasher, TR::SymbolReference *symRef)
+   {
+   TR::Symbol *symbol = symRef->getSymbol();
+   hasher.add(symRef->getReferenceNumber());
+   hasher.add(symRef->getOffset());
+   hasher.add(symbol->getFlags());
+   hasher.add(symbol->getDataType());
+   hasher.add(symbol->getSize());
+
+   if (symbol->isStatic())
+      {
+      // a different address is a different method, not a relocation
+      hasher.add(reinterpret_cast<uintptr_t>(symbol->getStaticSymbol()->getStaticAddress()));
+      }
+   else if (symbol->isMethod())
+      {
+      // calls are relocated to wherever the callee is defined in this run
+      TR::Method *method = symbol->castToMethodSymbol()->getMethod();
+      if (method != NULL)
+         {
+         hasher.addString(method->nameChars());
+         hasher.addString(method->signatureChars());
+         }
+      }
+   }
+
+static void
+hashNode(Hasher &hasher, TR::Node *node, vcount_t visitCount, int32_t &nextIndex)
+   {
+   if (node->getVisitCount() == visitCount)
+      {
+      // commoned reference to a node hashed already
+      hasher.add(~static_cast<uint64_t>(node->getLocalIndex()));
+      return;
+      }
+
+   node->setVisitCount(visitCount);
+   node->setLocalIndex(nextIndex++);
+
+   TR::ILOpCode &op = node->getOpCode();
+   hasher.add(node->getOpCodeValue());
+   hasher.add(node->getDataType());
+   hasher.add(node->getFlags().getValue());
+   hasher.add(node->getNumChildren());
+
+   if (op.isLoadConst())
+      {
+      switch (node->getDataType())
+         {
+         case TR::Int8:
+         case TR::Int16:
+         case TR::Int32:
+         case TR::Int64:
+            hasher.add(node->get64bitIntegralValue());
+            break;
+         case TR::Address:
+            hasher.add(node->getAddress());
+            break;
+         case TR::Float:
+            hasher.add(node->getFloatBits());
+            break;
+         case TR::Double:
+            hasher.add(node->getDoubleBits());
+            break;
+         default:
+            break;
+         }
+      }
+
+   if (op.hasSymbolReference() && node->getSymbolReference() != NULL)
+      hashSymbolReference(hasher, node->getSymbolReference());
+
+   if (op.isCase())
+      hasher.add(node->getCaseConstant());
+
+   if ((op.isBranch() || op.isCase()) && node->getBranchDestination() != NULL)
+      hasher.add(node->getBranchDestination()->getNode()->getBlock()->getNumber());
+
+   if (op.getOpCodeValue() == TR::BBStart)
+      {
+      TR::Block *block = node->getBlock();
+      hasher.add(block->getNumber());
+      hasher.add(block->isCold());
+      hasher.add(block->isCatchBlock());
+      for (auto edge = block->getExceptionSuccessors().begin(); edge != block->getExceptionSuccessors().end(); ++edge)
+         hasher.add((*edge)->getTo()->getNumber());
+      }
+
+   for (int32_t i = 0; i < node->getNumChildren(); i++)
+      hashNode(hasher, node->getChild(i), visitCount, nextIndex);
+   }
+
+uint64_t
+JitBuilder::AOTCache::hashIL(TR::MethodBuilder *methodBuilder, TR::Compilation *comp)
+   {
+   Hasher hasher;
+
+   hasher.addString(methodBuilder->GetMethodName());
+   TR::IlType **parameterTypes = methodBuilder->getParameterTypes();
+   hasher.add(methodBuilder->getNumParameters());
+   for (int32_t p = 0; p < methodBuilder->getNumParameters(); p++)
+      hasher.add(parameterTypes[p]->getPrimitiveType());
+   hasher.add(methodBuilder->getReturnType()->getPrimitiveType());
+
+   vcount_t visitCount = comp->incVisitCount();
+   int32_t nextIndex = 0;
+   for (TR::TreeTop *tt = comp->getMethodSymbol()->getFirstTreeTop(); tt != NULL; tt = tt->getNextTreeTop())
+      hashNode(hasher, tt->getNode(), visitCount, nextIndex);
+
+   return hasher.value();
+   }
+
+uint64_t
+JitBuilder::AOTCache::hashEnvironment(const char *options)
+   {
+   Hasher hasher;
+
+   hasher.add(AOTCacheVersion);
+   hasher.add(sizeof(void *));
+
+   // code may use any instruction the processor offers
+   const OMRProcessorDesc &processor = TR::Compiler->target.cpu.getProcessorDescription();
+   hasher.add(&processor, sizeof(processor));
+
+   hasher.addString(options);
+   hasher.addString(getenv("TR_Options"));
+
+   return hasher.value();
+   }
+
+JitBuilder::AOTCache::AOTCache(TR::PersistentAllocator &allocator, const char *options) :
+   _allocator(allocator),
+   _environmentHash(hashEnvironment(options)),
+   _fileName(NULL),
+   _mapping(NULL),
+   _mappingSize(0),
+   _mappingIsAllocated(false),
+   _records(std::less<uint64_t>(), RecordMapAllocator(allocator)),
+   _storedRecords(TR::vector<RecordHeader *, TR::PersistentAllocator &>::allocator_type(allocator)),
+   _pendingStores(std::less<TR::Compilation *>(), PendingMapAllocator(allocator)),
+   _numLoads(0),
+   _numStores(0)
+   {
+   }
+
+JitBuilder::AOTCache::~AOTCache()
+   {
+   close();
+   }
+
+bool
+JitBuilder::AOTCache::isSupported()
+   {
+#if defined(TR_TARGET_X86) && defined(TR_TARGET_64BIT)
+   return true;
+#else
+   // relocations are only described for AMD64 so far
+   return false;
+#endif
+   }
+
+bool
+JitBuilder::AOTCache::open(const char *fileName)
+   {
+   TR_ASSERT_FATAL(_fileName == NULL, "AOT cache is already open");
+
+   size_t nameLength = strlen(fileName) + 1;
+   _fileName = static_cast<char *>(_allocator.allocate(nameLength));
+   memcpy(_fileName, fileName, nameLength);
+
+#if defined(OMR_OS_WINDOWS)
+   FILE *file = fopen(fileName, "rb");
+   if (file == NULL)
+      return errno == ENOENT;
+
+   fseek(file, 0, SEEK_END);
+   long size = ftell(file);
+   fseek(file, 0, SEEK_SET);
+   if (size > 0)
+      {
+      _mapping = static_cast<uint8_t *>(_allocator.allocate(size));
+      _mappingSize = size;
+      _mappingIsAllocated = true;
+      if (fread(_mapping, 1, size, file) != static_cast<size_t>(size))
+         {
+         fclose(file);
+         unmap();
+         return false;
+         }
+      }
+   fclose(file);
+#else
+   int fd = ::open(fileName, O_RDONLY);
+   if (fd < 0)
+      return errno == ENOENT;
+
+   struct stat fileStat;
+   if (fstat(fd, &fileStat) != 0)
+      {
+      ::close(fd);
+      return false;
+      }
+
+   if (fileStat.st_size > 0)
+      {
+      void *mapping = mmap(NULL, fileStat.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+      if (mapping == MAP_FAILED)
+         {
+         ::close(fd);
+         return false;
+         }
+      _mapping = static_cast<uint8_t *>(mapping);
+      _mappingSize = fileStat.st_size;
+      }
+   ::close(fd);
+#endif /* defined(OMR_OS_WINDOWS) */
+
+   if (!readRecords(_mapping, _mappingSize))
+      {
+      // stale or damaged; its entries are dropped when the cache is closed
+      _records.clear();
+      }
+
+   return true;
+   }
+
+bool
+JitBuilder::AOTCache::readRecords(const uint8_t *contents, size_t size)
+   {
+   if (size < sizeof(FileHeader))
+      return false;
+
+   FileHeader header;
+   memcpy(&header, contents, sizeof(header));
+   if (memcmp(header._magic, AOTCacheMagic, sizeof(AOTCacheMagic)) != 0 ||
+       header._version != AOTCacheVersion ||
+       header._environmentHash != _environmentHash)
+      return false;
+
+   size_t cursor = sizeof(FileHeader);
+   for (uint32_t r = 0; r < header._numRecords; r++)
+      {
+      if (size - cursor < sizeof(RecordHeader))
+         return false;
+
+      const RecordHeader *record = reinterpret_cast<const RecordHeader *>(contents + cursor);
+      size_t contentsSize = sizeof(RecordHeader) + record->_numRelocations * sizeof(RecordRelocation) + record->_codeSize;
+      if (record->_recordSize < contentsSize ||
+          record->_recordSize > size - cursor ||
+          record->_recordSize != alignRecordSize(record->_recordSize) ||
+          record->_entryOffset >= record->_codeSize)
+         return false;
+
+      _records[record->_ilHash] = record;
+      cursor += record->_recordSize;
+      }
+
+   return true;
+   }
+
+bool
+JitBuilder::AOTCache::close()
+   {
+   if (_fileName == NULL)
+      return true;
+
+   bool written = true;
+   if (!_storedRecords.empty())
+      {
+      // write a new file and replace the old one, which may still be mapped
+      size_t nameLength = strlen(_fileName);
+      char *tempFileName = static_cast<char *>(_allocator.allocate(nameLength + sizeof(".tmp")));
+      memcpy(tempFileName, _fileName, nameLength);
+      memcpy(tempFileName + nameLength, ".tmp", sizeof(".tmp"));
+
+      FILE *file = fopen(tempFileName, "wb");
+      written = file != NULL;
+      if (written)
+         {
+         FileHeader header;
+         memcpy(header._magic, AOTCacheMagic, sizeof(AOTCacheMagic));
+         header._version = AOTCacheVersion;
+         header._numRecords = static_cast<uint32_t>(_records.size());
+         header._environmentHash = _environmentHash;
+         written = fwrite(&header, sizeof(header), 1, file) == 1;
+
+         for (auto it = _records.begin(); written && it != _records.end(); ++it)
+            written = fwrite(it->second, it->second->_recordSize, 1, file) == 1;
+
+         written = (fclose(file) == 0) && written;
+         }
+
+#if defined(OMR_OS_WINDOWS)
+      if (written)
+         remove(_fileName);
+#endif /* defined(OMR_OS_WINDOWS) */
+      if (written)
+         written = rename(tempFileName, _fileName) == 0;
+      if (!written)
+         remove(tempFileName);
+
+      _allocator.deallocate(tempFileName);
+      }
+
+   _records.clear();
+   _pendingStores.clear();
+   for (auto it = _storedRecords.begin(); it != _storedRecords.end(); ++it)
+      _allocator.deallocate(*it);
+   _storedRecords.clear();
+   unmap();
+
+   _allocator.deallocate(_fileName);
+   _fileName = NULL;
+
+   return written;
+   }
+
+void
+JitBuilder::AOTCache::unmap()
+   {
+   if (_mapping == NULL)
+      return;
+
+#if !defined(OMR_OS_WINDOWS)
+   if (!_mappingIsAllocated)
+      munmap(_mapping, _mappingSize);
+   else
+#endif /* !defined(OMR_OS_WINDOWS) */
+      _allocator.deallocate(_mapping);
+
+   _mapping = NULL;
+   _mappingSize = 0;
+   _mappingIsAllocated = false;
+   }
+
+void *
+JitBuilder::AOTCache::load(TR::MethodBuilder *methodBuilder)
+   {
+   TR::Compilation *comp = TR::comp();
+   uint64_t ilHash = hashIL(methodBuilder, comp);
+
+   std::lock_guard<std::mutex> guard(_lock);
+
+   // if the method has to be compiled, store() persists it under this hash
+   _pendingStores[comp] = ilHash;
+
+   auto it = _records.find(ilHash);
+   if (it == _records.end())
+      return NULL;
+
+   const RecordHeader *record = it->second;
+   const RecordRelocation *relocations = reinterpret_cast<const RecordRelocation *>(record + 1);
+   const uint8_t *recordCode = reinterpret_cast<const uint8_t *>(relocations + record->_numRelocations);
+   const char *names = reinterpret_cast<const char *>(recordCode + record->_codeSize);
+
+   // every function called must be defined in this run before any code is bound
+   for (uint32_t r = 0; r < record->_numRelocations; r++)
+      {
+      if (relocations[r]._nameOffset == SelfReference)
+         continue;
+      TR::ResolvedMethod *function = methodBuilder->lookupFunction(names + relocations[r]._nameOffset);
+      if (function == NULL || function->getEntryPoint() == NULL)
+         return NULL;
+      }
+
+   TR::CodeGenerator *cg = comp->cg();
+   if (cg->getCodeCache() == NULL)
+      cg->reserveCodeCache();
+
+   uint8_t *code = cg->allocateCodeMemory(record->_codeSize, false);
+   memcpy(code, recordCode, record->_codeSize);
+
+   for (uint32_t r = 0; r < record->_numRelocations; r++)
+      {
+      uint8_t *location = code + relocations[r]._offset;
+      uintptr_t target;
+      if (relocations[r]._nameOffset == SelfReference)
+         {
+         uint64_t offset;
+         memcpy(&offset, location, sizeof(offset));
+         target = reinterpret_cast<uintptr_t>(code) + static_cast<uintptr_t>(offset);
+         }
+      else
+         {
+         TR::ResolvedMethod *function = methodBuilder->lookupFunction(names + relocations[r]._nameOffset);
+         target = reinterpret_cast<uintptr_t>(function->getEntryPoint());
+         }
+      memcpy(location, &target, sizeof(target));
+      }
+
+   cg->syncCode(code, record->_codeSize);
+
+   _pendingStores.erase(comp);
+   _numLoads++;
+   return code + record->_entryOffset;
+   }
+
+void
+JitBuilder::AOTCache::store(TR::CodeGenerator *cg)
+   {
+   std::lock_guard<std::mutex> guard(_lock);
+
+   auto pending = _pendingStores.find(cg->comp());
+   if (pending == _pendingStores.end())
+      return;
+
+   uint64_t ilHash = pending->second;
+   _pendingStores.erase(pending);
+   if (_records.find(ilHash) != _records.end())
+      return;
+
+   // the method must be a single range that static relocations fully describe
+   if (cg->getColdCodeStart() != NULL)
+      return;
+
+   uint8_t *bufferStart = cg->getBinaryBufferStart();
+   size_t codeSize = cg->getCodeEnd() - bufferStart;
+   size_t namesSize = 0;
+   uint32_t numRelocations = 0;
+   auto &staticRelocations = cg->getStaticRelocations();
+   for (auto it = staticRelocations.begin(); it != staticRelocations.end(); ++it)
+      {
+      if (it->size() != TR::StaticRelocationSize::word64 ||
+          it->type() != TR::StaticRelocationType::Absolute ||
+          it->location() < bufferStart ||
+          it->location() + sizeof(uint64_t) > bufferStart + codeSize)
+         return;
+
+      if (it->symbol() != NULL)
+         namesSize += strlen(it->symbol()) + 1;
+      numRelocations++;
+      }
+
+   size_t recordSize = alignRecordSize(sizeof(RecordHeader) + numRelocations * sizeof(RecordRelocation) + codeSize + namesSize);
+   RecordHeader *record = static_cast<RecordHeader *>(_allocator.allocate(recordSize));
+   memset(record, 0, recordSize);
+   record->_ilHash = ilHash;
+   record->_recordSize = static_cast<uint32_t>(recordSize);
+   record->_codeSize = static_cast<uint32_t>(codeSize);
+   record->_entryOffset = static_cast<uint32_t>(cg->getCodeStart() - bufferStart);
+   record->_numRelocations = numRelocations;
+
+   RecordRelocation *relocations = reinterpret_cast<RecordRelocation *>(record + 1);
+   uint8_t *recordCode = reinterpret_cast<uint8_t *>(relocations + numRelocations);
+   char *names = reinterpret_cast<char *>(recordCode + codeSize);
+   memcpy(recordCode, bufferStart, codeSize);
+
+   uint32_t nameOffset = 0;
+   RecordRelocation *relocation = relocations;
+   for (auto it = staticRelocations.begin(); it != staticRelocations.end(); ++it, ++relocation)
+      {
+      relocation->_offset = static_cast<uint32_t>(it->location() - bufferStart);
+
+      // addresses are rebound on load: persist the offset of a reference to
+      // the method itself, and nothing for a function
+      uint64_t value = 0;
+      if (it->symbol() == NULL)
+         {
+         uintptr_t address;
+         memcpy(&address, it->location(), sizeof(address));
+         if (address < reinterpret_cast<uintptr_t>(bufferStart) ||
+             address > reinterpret_cast<uintptr_t>(bufferStart) + codeSize)
+            {
+            _allocator.deallocate(record);
+            return;
+            }
+         value = address - reinterpret_cast<uintptr_t>(bufferStart);
+         relocation->_nameOffset = SelfReference;
+         }
+      else
+         {
+         size_t nameLength = strlen(it->symbol()) + 1;
+         memcpy(names + nameOffset, it->symbol(), nameLength);
+         relocation->_nameOffset = nameOffset;
+         nameOffset += static_cast<uint32_t>(nameLength);
+         }
+      memcpy(recordCode + relocation->_offset, &value, sizeof(value));
+      }
+
+   _storedRecords.push_back(record);
+   _records[ilHash] = record;
+   _numStores++;
+   }
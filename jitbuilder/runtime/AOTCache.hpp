@@ -0,0 +1,173 @@
+/*******************************************************************************
+ * Copyright (c) 2020, 2020 IBM Corp. and others
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at https://www.eclipse.org/legal/epl-2.0/
+ * or the Apache License, Version 2.0 which accompanies this distribution and
+ * is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following
+ * Secondary Licenses when the conditions for such availability set
+ * forth in the Eclipse Public License, v. 2.0 are satisfied: GNU
+ * General Public License, version 2 with the GNU Classpath
+ * Exception [1] and GNU General Public License, version 2 with the
+ * OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] http://openjdk.java.net/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
+ *******************************************************************************/
+
+#ifndef JITBUILDER_AOTCACHE_INCL
+#define JITBUILDER_AOTCACHE_INCL
+
+#include <stddef.h>
+#include <stdint.h>
+#include <map>
+#include <mutex>
+#include "env/PersistentAllocator.hpp"
+#include "env/TypedAllocator.hpp"
+#include "infra/vector.hpp"
+
+namespace TR { class CodeGenerator; }
+namespace TR { class Compilation; }
+namespace TR { class MethodBuilder; }
+
+namespace JitBuilder
+{
+
+/**
+ * @brief A file backed cache of compiled MethodBuilder code.
+ *
+ * Methods are keyed by a hash of the IL their buildIL() generates, so a
+ * MethodBuilder whose IL is unchanged from a previous run is bound to the
+ * code compiled then instead of being optimized and compiled again. The
+ * hash covers constants and the addresses of memory the IL refers to, so
+ * only references described by TR::StaticRelocation records need to be
+ * rebound when code is loaded: absolute references to the method itself
+ * and to the functions it calls. Methods with any other reference out of
+ * their own code, such as calls to runtime helpers, are not persisted.
+ *
+ * Entries only match the environment that created them: the file records a
+ * hash of the JIT options and the processor description, and a file
+ * created under a different environment is ignored and rewritten.
+ *
+ * The cache file is mapped when the cache is opened and written back to
+ * when it is closed. Loads and stores may run on concurrent compilation
+ * threads; opening and closing must not.
+ */
+class AOTCache
+   {
+public:
+
+   AOTCache(TR::PersistentAllocator &allocator, const char *options);
+   ~AOTCache();
+
+   /**
+    * @brief Whether methods can be persisted for the target at all.
+    */
+   static bool isSupported();
+
+   /**
+    * @brief Map the named cache file, which need not exist yet.
+    *
+    * @return false if the file exists but cannot be read
+    */
+   bool open(const char *fileName);
+
+   /**
+    * @brief Write every entry to the cache file and unmap it.
+    *
+    * @return false if the file could not be written
+    */
+   bool close();
+
+   /**
+    * @brief Bind the persisted code for the IL just generated by a
+    *        MethodBuilder, which is being compiled on this thread.
+    *
+    * @return the entry point of the bound code, or NULL if the method is
+    *         not in the cache and has to be compiled
+    */
+   void *load(TR::MethodBuilder *methodBuilder);
+
+   /**
+    * @brief Persist the code of a method compiled after a cache miss, once
+    *        its relocations have been applied.
+    */
+   void store(TR::CodeGenerator *cg);
+
+   /**
+    * @brief Hash the IL generated for a MethodBuilder.
+    */
+   static uint64_t hashIL(TR::MethodBuilder *methodBuilder, TR::Compilation *comp);
+
+   int32_t getNumLoads()  { return _numLoads; }
+   int32_t getNumStores() { return _numStores; }
+
+private:
+
+   struct FileHeader
+      {
+      char     _magic[8];
+      uint32_t _version;
+      uint32_t _numRecords;
+      uint64_t _environmentHash;
+      };
+
+   /**
+    * A record is followed by its relocations, its code and the names of the
+    * functions the relocations refer to, and is padded to 8 bytes.
+    */
+   struct RecordHeader
+      {
+      uint64_t _ilHash;
+      uint32_t _recordSize;
+      uint32_t _codeSize;
+      uint32_t _entryOffset;
+      uint32_t _numRelocations;
+      };
+
+   struct RecordRelocation
+      {
+      uint32_t _offset;       ///< offset of the 64-bit address in the code
+      uint32_t _nameOffset;   ///< offset of the function name, or SelfReference
+      };
+
+   static const uint32_t SelfReference = 0xffffffff;
+
+   static uint64_t hashEnvironment(const char *options);
+   bool readRecords(const uint8_t *contents, size_t size);
+   void unmap();
+
+   TR::PersistentAllocator &_allocator;
+   uint64_t _environmentHash;
+   char *_fileName;
+
+   uint8_t *_mapping;
+   size_t _mappingSize;
+   bool _mappingIsAllocated;
+
+   std::mutex _lock;
+
+   typedef TR::typed_allocator<std::pair<const uint64_t, const RecordHeader *>, TR::PersistentAllocator &> RecordMapAllocator;
+   typedef std::map<uint64_t, const RecordHeader *, std::less<uint64_t>, RecordMapAllocator> RecordMap;
+   RecordMap _records;
+
+   // records created by store(), owned by the cache
+   TR::vector<RecordHeader *, TR::PersistentAllocator &> _storedRecords;
+
+   // IL hashes of the methods that missed in the cache, by compilation
+   typedef TR::typed_allocator<std::pair<TR::Compilation * const, uint64_t>, TR::PersistentAllocator &> PendingMapAllocator;
+   typedef std::map<TR::Compilation *, uint64_t, std::less<TR::Compilation *>, PendingMapAllocator> PendingMap;
+   PendingMap _pendingStores;
+
+   int32_t _numLoads;
+   int32_t _numStores;
+   };
+
+} // namespace JitBuilder
+
+#endif // !defined(JITBUILDER_AOTCACHE_INCL)
@@ -0,0 +1,135 @@
+/*******************************************************************************
+ * Copyright (c) 2020, 2020 IBM Corp. and others
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at https://www.eclipse.org/legal/epl-2.0/
+ * or the Apache License, Version 2.0 which accompanies this distribution and
+ * is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following
+ * Secondary Licenses when the conditions for such availability set
+ * forth in the Eclipse Public License, v. 2.0 are satisfied: GNU
+ * General Public License, version 2 with the GNU Classpath
+ * Exception [1] and GNU General Public License, version 2 with the
+ * OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] http://openjdk.java.net/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
+ *******************************************************************************/
+
+
+#include "codegen/CodeGenerator.hpp"
+#include "codegen/CodeGenerator_inlines.hpp"
+#include "compile/Compilation.hpp"
+#include "compile/ResolvedMethod.hpp"
+#include "env/CompilerEnv.hpp"
+#include "env/FrontEnd.hpp"
+#include "ilgen/MethodBuilder.hpp"
+#include "runtime/AOTCache.hpp"
+#include "x/codegen/X86Instruction.hpp"
+
+// The MethodBuilder being compiled, if the method is one
+static TR::MethodBuilder *
+compiledMethodBuilder(TR::Compilation *comp)
+   {
+   TR::IlInjector *injector = static_cast<TR::IlInjector *>(comp->getCurrentMethod()->resolvedMethodAddress());
+   return injector != NULL ? injector->asMethodBuilder() : NULL;
+   }
+
+namespace JitBuilder
+{
+namespace X86
+{
+
+CodeGenerator::CodeGenerator() :
+   JitBuilder::CodeGenerator(),
+   _canPersistCode(true),
+   _entryPatchInstruction(NULL)
+   {
+   }
+
+TR::Instruction *
+CodeGenerator::generateProjectSpecializedEntryCode(TR::Instruction *cursor)
+   {
+   TR::MethodBuilder *methodBuilder = compiledMethodBuilder(self()->comp());
+   if (methodBuilder == NULL || !methodBuilder->hasRecompilationCounter())
+      return cursor;
+
+   // A thread is either before or past a single NOP instruction, never inside
+   // it, so the NOP can be safely patched into a 5-byte jmp.
+   _entryPatchInstruction = generatePaddingInstruction(cursor, 5, self());
+   generatePatchableCodeAlignmentInstruction(TR::X86PatchableCodeAlignmentInstruction::CALLImm4AtomicRegions, _entryPatchInstruction, self());
+
+   // counters are process specific
+   _canPersistCode = false;
+
+   return _entryPatchInstruction;
+   }
+
+void
+CodeGenerator::doBinaryEncoding()
+   {
+   JitBuilder::CodeGenerator::doBinaryEncoding();
+
+   if (_entryPatchInstruction != NULL)
+      compiledMethodBuilder(self()->comp())->setEntryPatchSite(_entryPatchInstruction->getBinaryEncoding());
+   }
+
+bool
+CodeGenerator::needStaticRelocations()
+   {
+   return JitBuilder::CodeGenerator::needStaticRelocations()
+      || JitBuilder::FrontEnd::instance()->aotCache() != NULL;
+   }
+
+void
+CodeGenerator::processRelocations()
+   {
+   JitBuilder::CodeGenerator::processRelocations();
+
+   JitBuilder::AOTCache *aotCache = JitBuilder::FrontEnd::instance()->aotCache();
+   if (aotCache != NULL && _canPersistCode)
+      aotCache->store(self());
+   }
+
+void
+CodeGenerator::addProjectSpecializedRelocation(uint8_t *location,
+                                               uint8_t *target,
+                                               uint8_t *target2,
+                                               TR_ExternalRelocationTargetKind kind,
+                                               char *generatingFileName,
+                                               uintptr_t generatingLineNumber,
+                                               TR::Node *node)
+   {
+   _canPersistCode = false;
+   }
+
+void
+CodeGenerator::addProjectSpecializedPairRelocation(uint8_t *location1,
+                                                   uint8_t *location2,
+                                                   uint8_t *target,
+                                                   TR_ExternalRelocationTargetKind kind,
+                                                   char *generatingFileName,
+                                                   uintptr_t generatingLineNumber,
+                                                   TR::Node *node)
+   {
+   _canPersistCode = false;
+   }
+
+void
+CodeGenerator::addProjectSpecializedRelocation(TR::Instruction *instr,
+                                               uint8_t *target,
+                                               uint8_t *target2,
+                                               TR_ExternalRelocationTargetKind kind,
+                                               char *generatingFileName,
+                                               uintptr_t generatingLineNumber,
+                                               TR::Node *node)
+   {
+   _canPersistCode = false;
+   }
+
+} // namespace X86
+} // namespace JitBuilder
@@ -0,0 +1,110 @@
+/*******************************************************************************
+ * Copyright (c) 2020, 2020 IBM Corp. and others
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at https://www.eclipse.org/legal/epl-2.0/
+ * or the Apache License, Version 2.0 which accompanies this distribution and
+ * is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following
+ * Secondary Licenses when the conditions for such availability set
+ * forth in the Eclipse Public License, v. 2.0 are satisfied: GNU
+ * General Public License, version 2 with the GNU Classpath
+ * Exception [1] and GNU General Public License, version 2 with the
+ * OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] http://openjdk.java.net/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
+ *******************************************************************************/
+
+#ifndef JITBUILDER_X86_CODEGENERATORBASE_INCL
+#define JITBUILDER_X86_CODEGENERATORBASE_INCL
+
+/*
+ * The following #define and typedef must appear before any #includes in this file
+ */
+#ifndef JITBUILDER_CODEGENERATORBASE_CONNECTOR
+#define JITBUILDER_CODEGENERATORBASE_CONNECTOR
+
+namespace JitBuilder { namespace X86 { class CodeGenerator; } }
+namespace JitBuilder { typedef X86::CodeGenerator CodeGeneratorConnector; }
+
+#else
+#error JitBuilder::X86::CodeGenerator expected to be a primary connector, but a JitBuilder connector is already defined
+#endif
+
+
+#include "jitbuilder/codegen/JBCodeGenerator.hpp"
+
+
+namespace JitBuilder
+{
+namespace X86
+{
+
+class OMR_EXTENSIBLE CodeGenerator : public JitBuilder::CodeGenerator
+   {
+   public:
+
+   CodeGenerator();
+
+   /**
+    * @brief Code compiled as a first tier starts with a patch site that can
+    *        later redirect it to the recompiled method.
+    */
+   TR::Instruction *generateProjectSpecializedEntryCode(TR::Instruction *cursor);
+
+   void doBinaryEncoding();
+
+   /**
+    * @brief Static relocations are also needed when compiled code may be
+    *        persisted to an AOT cache.
+    */
+   bool needStaticRelocations();
+
+   /**
+    * @brief Persist the method to the open AOT cache, if any, once its
+    *        relocations have been applied.
+    */
+   void processRelocations();
+
+   // Any reference to the runtime is a reference the AOT cache cannot rebind
+   void addProjectSpecializedRelocation(uint8_t *location,
+                                          uint8_t *target,
+                                          uint8_t *target2,
+                                          TR_ExternalRelocationTargetKind kind,
+                                          char *generatingFileName,
+                                          uintptr_t generatingLineNumber,
+                                          TR::Node *node);
+   void addProjectSpecializedPairRelocation(uint8_t *location1,
+                                          uint8_t *location2,
+                                          uint8_t *target,
+                                          TR_ExternalRelocationTargetKind kind,
+                                          char *generatingFileName,
+                                          uintptr_t generatingLineNumber,
+                                          TR::Node *node);
+   void addProjectSpecializedRelocation(TR::Instruction *instr,
+                                          uint8_t *target,
+                                          uint8_t *target2,
+                                          TR_ExternalRelocationTargetKind kind,
+                                          char *generatingFileName,
+                                          uintptr_t generatingLineNumber,
+                                          TR::Node *node);
+
+   private:
+
+   // whether the method refers to nothing outside itself but the functions it calls
+   bool _canPersistCode;
+
+   // 5-byte NOP at the start of first tier code, patched to jump to the next tier
+   TR::Instruction *_entryPatchInstruction;
+
+   };
+
+} // namespace X86
+} // namespace JitBuilder
+
+#endif // !defined(JITBUILDER_X86_CODEGENERATORBASE_INCL)